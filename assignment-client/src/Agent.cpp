@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
+#include <QtCore/QJsonObject>
 #include <QtCore/QStandardPaths>
 #include <QtNetwork/QNetworkDiskCache>
 #include <QtNetwork/QNetworkRequest>
@@ -48,6 +49,7 @@
 #include "AbstractAudioInterface.h"
 
 #include "AvatarAudioTimer.h"
+#include "AvatarLoadGenerator.h"
 
 static const int RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES = 10;
 
@@ -441,25 +443,15 @@ void Agent::executeScript() {
 
     DependencyManager::set<AssignmentParentFinder>(_entityViewer.getTree());
 
-    // 100Hz timer for audio
-    AvatarAudioTimer* audioTimerWorker = new AvatarAudioTimer();
-    audioTimerWorker->moveToThread(&_avatarAudioTimerThread);
-    connect(audioTimerWorker, &AvatarAudioTimer::avatarTick, this, &Agent::processAgentAvatarAudio);
-    connect(this, &Agent::startAvatarAudioTimer, audioTimerWorker, &AvatarAudioTimer::start);
-    connect(this, &Agent::stopAvatarAudioTimer, audioTimerWorker, &AvatarAudioTimer::stop);
-    connect(&_avatarAudioTimerThread, &QThread::finished, audioTimerWorker, &QObject::deleteLater);
+    // 100Hz timer for audio, which also drives our 45Hz avatar data sends
+    _avatarAudioTimer = new AvatarAudioTimer();
+    _avatarAudioTimer->moveToThread(&_avatarAudioTimerThread);
+    connect(_avatarAudioTimer, &AvatarAudioTimer::avatarTick, this, &Agent::processAgentAvatarAudio);
+    connect(_avatarAudioTimer, &AvatarAudioTimer::avatarDataTick, this, &Agent::processAgentAvatar);
+    connect(this, &Agent::startAvatarAudioTimer, _avatarAudioTimer, &AvatarAudioTimer::start);
+    connect(&_avatarAudioTimerThread, &QThread::finished, _avatarAudioTimer, &QObject::deleteLater);
     _avatarAudioTimerThread.start();
 
-    // Agents should run at 45hz
-    static const int AVATAR_DATA_HZ = 45;
-    static const int AVATAR_DATA_IN_MSECS = MSECS_PER_SECOND / AVATAR_DATA_HZ;
-    QTimer* avatarDataTimer = new QTimer(this);
-    connect(avatarDataTimer, &QTimer::timeout, this, &Agent::processAgentAvatar);
-    avatarDataTimer->setSingleShot(false);
-    avatarDataTimer->setInterval(AVATAR_DATA_IN_MSECS);
-    avatarDataTimer->setTimerType(Qt::PreciseTimer);
-    avatarDataTimer->start();
-
     _scriptEngine->run();
 
     Frame::clearFrameHandler(AUDIO_FRAME_TYPE);
@@ -523,10 +515,6 @@ void Agent::setIsAvatar(bool isAvatar) {
 
         // start the timers
         _avatarIdentityTimer->start(AVATAR_IDENTITY_PACKET_SEND_INTERVAL_MSECS);
-
-        // tell the avatarAudioTimer to start ticking
-        emit startAvatarAudioTimer();
-
     }
 
     if (!_isAvatar) {
@@ -554,10 +542,67 @@ void Agent::setIsAvatar(bool isAvatar) {
                 nodeList->sendPacket(std::move(packet), *node);
             });
         }
-        emit stopAvatarAudioTimer();
+    }
+
+    updateAvatarAudioTimer();
+}
+
+void Agent::updateAvatarAudioTimer() {
+    bool shouldRun = _isAvatar || (_loadGenerator && _loadGenerator->isRunning());
+    if (!_avatarAudioTimer || shouldRun == _avatarAudioTimer->isRunning()) {
+        return;
+    }
+
+    // the timer loop occupies its thread until it sees the flag drop, so only starting it goes through a signal
+    _avatarAudioTimer->setRunning(shouldRun);
+    if (shouldRun) {
+        emit startAvatarAudioTimer();
     }
 }
 
+void Agent::startLoadGenerator(const QVariantMap& options) {
+    // this must happen on Agent's main thread
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "startLoadGenerator", Q_ARG(QVariantMap, options));
+        return;
+    }
+
+    if (!_avatarAudioTimer) {
+        qWarning() << "Agent can only start a load generator once its script is running";
+        return;
+    }
+
+    if (!_loadGenerator) {
+        // the simulated avatars join the same domain as this agent
+        auto nodeList = DependencyManager::get<NodeList>();
+        auto& domainHandler = nodeList->getDomainHandler();
+        _loadGenerator = new AvatarLoadGenerator(domainHandler.getSockAddr(), domainHandler.getHostname(), this);
+
+        connect(_avatarAudioTimer, &AvatarAudioTimer::avatarTick, _loadGenerator, &AvatarLoadGenerator::sendAudio);
+        connect(_avatarAudioTimer, &AvatarAudioTimer::avatarDataTick, _loadGenerator, &AvatarLoadGenerator::sendAvatarData);
+    }
+
+    _loadGenerator->start(options);
+    updateAvatarAudioTimer();
+}
+
+void Agent::stopLoadGenerator() {
+    // this must happen on Agent's main thread
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "stopLoadGenerator");
+        return;
+    }
+
+    if (_loadGenerator) {
+        _loadGenerator->stop();
+    }
+    updateAvatarAudioTimer();
+}
+
+QVariantMap Agent::getLoadGeneratorStats() const {
+    return _loadGenerator ? _loadGenerator->getStats() : QVariantMap();
+}
+
 void Agent::sendAvatarIdentityPacket() {
     if (_isAvatar) {
         auto scriptedAvatar = DependencyManager::get<ScriptableAvatar>();
@@ -581,7 +626,7 @@ void Agent::processAgentAvatar() {
 
         auto nodeList = DependencyManager::get<NodeList>();
 
-        nodeList->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
+        _numAvatarDataPacketsSent += nodeList->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
     }
 }
 
@@ -729,13 +774,33 @@ void Agent::processAgentAvatarAudio() {
                 audioPacket->writePrimitive(sequence);
                 // send audio packet
                 nodeList->sendUnreliablePacket(*audioPacket, *node);
+                ++_numAudioPacketsSent;
             }
         });
     }
 }
 
+void Agent::sendStatsPacket() {
+    auto& stats = beginStatsPacket();
+
+    stats.write("is_avatar", _isAvatar);
+    stats.write("avatar_data_packets_sent", _numAvatarDataPacketsSent);
+    stats.write("audio_packets_sent", _numAudioPacketsSent);
+    stats.write("codec", _selectedCodecName);
+    if (_loadGenerator && _loadGenerator->isRunning()) {
+        stats.write("load_generator", QJsonObject::fromVariantMap(_loadGenerator->getStats()));
+    }
+
+    // reset the counters so each stats packet covers the last interval
+    _numAvatarDataPacketsSent = 0;
+    _numAudioPacketsSent = 0;
+
+    addPacketStatsAndSendStatsPacket();
+}
+
 void Agent::aboutToFinish() {
     setIsAvatar(false);// will stop timers for sending identity packets
+    stopLoadGenerator();
 
     if (_scriptEngine) {
         _scriptEngine->stop();
@@ -750,7 +815,11 @@ void Agent::aboutToFinish() {
     DependencyManager::destroy<AudioInjectorManager>();
     DependencyManager::destroy<ScriptEngines>();
 
-    emit stopAvatarAudioTimer();
+    if (_avatarAudioTimer) {
+        // the timer loop polls this flag, a queued stop would never be delivered to it
+        _avatarAudioTimer->setRunning(false);
+        _avatarAudioTimer = nullptr;
+    }
     _avatarAudioTimerThread.quit();
 
     // cleanup codec & encoder
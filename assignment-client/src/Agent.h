@@ -33,6 +33,9 @@
 #include "MixedAudioStream.h"
 #include "avatars/ScriptableAvatar.h"
 
+class AvatarAudioTimer;
+class AvatarLoadGenerator;
+
 class Agent : public ThreadedAssignment {
     Q_OBJECT
 
@@ -60,12 +63,20 @@ public:
     float getLastReceivedAudioLoudness() const { return _lastReceivedAudioLoudness; }
     QUuid getSessionUUID() const;
 
+    // Simulate many avatars from this agent to load the mixers, see AvatarLoadGenerator for the options.
+    // The simulated avatars are paced by the same timer loop as the agent's own avatar.
+    Q_INVOKABLE void startLoadGenerator(const QVariantMap& options);
+    Q_INVOKABLE void stopLoadGenerator();
+    Q_INVOKABLE QVariantMap getLoadGeneratorStats() const;
+
     virtual void aboutToFinish() override;
 
 public slots:
     void run() override;
     void playAvatarSound(SharedSoundPointer avatarSound);
 
+    virtual void sendStatsPacket() override;
+
 private slots:
     void requestScript();
     void scriptRequestFinished();
@@ -83,8 +94,8 @@ private slots:
 
 signals:
     void startAvatarAudioTimer();
-    void stopAvatarAudioTimer();
 private:
+    void updateAvatarAudioTimer();
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
     void encodeFrameOfZeros(QByteArray& encodedZeros);
@@ -118,7 +129,13 @@ private:
     QString _selectedCodecName;
     Encoder* _encoder { nullptr };
     QThread _avatarAudioTimerThread;
+    AvatarAudioTimer* _avatarAudioTimer { nullptr };
+    AvatarLoadGenerator* _loadGenerator { nullptr };
     bool _flushEncoder { false };
+
+    // packets sent since the last stats packet, touched only on the Agent's thread
+    quint64 _numAvatarDataPacketsSent { 0 };
+    quint64 _numAudioPacketsSent { 0 };
 };
 
 #endif // hifi_Agent_h
@@ -9,16 +9,26 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 #include <QDebug>
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include "AvatarAudioTimer.h"
 
 // this should send a signal every 10ms, with pretty good precision.  Hardcoding
-// to 10ms since that's what you'd want for audio.  
+// to 10ms since that's what you'd want for audio.  The avatar data tick is folded into
+// the same loop and fires at 45hz, on the first audio tick at or after it is due.
 void AvatarAudioTimer::start() {
+    if (!_running) {
+        // we were stopped again before our queued start arrived
+        return;
+    }
+
     auto startTime = usecTimestampNow();
     quint64 frameCounter = 0;
+    quint64 avatarDataFrameCounter = 0;
     const int TARGET_INTERVAL_USEC = 10000; // 10ms
-    while (!_quit) {
+    const int AVATAR_DATA_HZ = 45;
+    const quint64 AVATAR_DATA_INTERVAL_USEC = USECS_PER_SECOND / AVATAR_DATA_HZ;
+    while (_running) {
         ++frameCounter;
 
         // tick every 10ms from startTime
@@ -31,6 +41,13 @@ void AvatarAudioTimer::start() {
         }
 
         emit avatarTick();
+
+        // don't try to catch up on missed avatar data frames, the avatar-mixer only wants the latest state
+        quint64 avatarDataTargetTime = startTime + (avatarDataFrameCounter + 1) * AVATAR_DATA_INTERVAL_USEC;
+        if (targetTime >= avatarDataTargetTime) {
+            avatarDataFrameCounter = (targetTime - startTime) / AVATAR_DATA_INTERVAL_USEC;
+            emit avatarDataTick();
+        }
     }
     qDebug() << "AvatarAudioTimer is finished";
 }
@@ -12,20 +12,30 @@
 #ifndef hifi_AvatarAudioTimer_h
 #define hifi_AvatarAudioTimer_h
 
+#include <atomic>
+
 #include <QtCore/QObject>
 
+// Drives both the audio (100Hz) and avatar data (45Hz) sends of an Agent from a single loop,
+// so that an agent only pays for one timing thread.
 class AvatarAudioTimer : public QObject {
     Q_OBJECT
 
 signals:
     void avatarTick();
+    void avatarDataTick();
+
+public:
+    // start() blocks this object's thread in its loop, so a queued stop could never be delivered;
+    // the loop polls this flag instead, which may be set from any thread
+    void setRunning(bool running) { _running = running; }
+    bool isRunning() const { return _running; }
 
 public slots:
     void start();
-    void stop() { _quit = true; }
 
 private:
-    bool _quit { false };
+    std::atomic<bool> _running { false };
 };
 
 #endif //hifi_AvatarAudioTimer_h
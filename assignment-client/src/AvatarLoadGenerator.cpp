@@ -0,0 +1,371 @@
+//
+//  AvatarLoadGenerator.cpp
+//  assignment-client/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarLoadGenerator.h"
+
+#include <algorithm>
+#include <random>
+
+#include <QtCore/QDebug>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QUrl>
+
+#include <AudioConstants.h>
+#include <AvatarData.h>
+#include <GLMHelpers.h>
+#include <NLPacket.h>
+#include <NLPacketList.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <RegisteredMetaTypes.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+#include <udt/PacketHeaders.h>
+
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+
+static const int DEFAULT_NUM_AVATARS = 10;
+static const float DEFAULT_SPREAD = 20.0f; // meters
+static const unsigned int DEFAULT_SEED = 1;
+
+// synthetic avatars walk around a small circle through their spawn position
+static const float WALK_RADIUS = 2.0f; // meters
+static const float WALK_SPEED = 1.4f; // meters per second
+
+static const float MIN_TONE_FREQUENCY = 220.0f;
+static const float MAX_TONE_FREQUENCY = 880.0f;
+static const float TONE_AMPLITUDE = 0.1f * AudioConstants::MAX_SAMPLE_VALUE;
+
+AvatarLoadGenerator::AvatarLoadGenerator(const HifiSockAddr& domainSockAddr, const QString& domainHostname, QObject* parent) :
+    QObject(parent),
+    _domainSockAddr(domainSockAddr),
+    _domainHostname(domainHostname),
+    _checkInTimer(this)
+{
+    connect(&_checkInTimer, &QTimer::timeout, this, &AvatarLoadGenerator::checkIn);
+}
+
+AvatarLoadGenerator::~AvatarLoadGenerator() {
+    stop();
+}
+
+bool AvatarLoadGenerator::start(const QVariantMap& options) {
+    if (isRunning()) {
+        qWarning() << "AvatarLoadGenerator is already running, stop it before starting it again";
+        return false;
+    }
+
+    if (_domainSockAddr.isNull()) {
+        qWarning() << "AvatarLoadGenerator has no domain to connect its avatars to";
+        return false;
+    }
+
+    int numAvatars = options.value("numAvatars", DEFAULT_NUM_AVATARS).toInt();
+    if (numAvatars <= 0) {
+        qWarning() << "AvatarLoadGenerator needs a positive numAvatars, got" << options.value("numAvatars");
+        return false;
+    }
+
+    _clipFrames.clear();
+    _clipDuration = 0;
+    QString clipPath = options.value("clip").toString();
+    if (!clipPath.isEmpty() && !loadClip(clipPath)) {
+        return false;
+    }
+
+    glm::vec3 center = options.contains("center") ? vec3FromVariant(options["center"]) : glm::vec3(0.0f);
+    float spread = options.value("spread", DEFAULT_SPREAD).toFloat();
+
+    std::mt19937 generator(options.value("seed", DEFAULT_SEED).toUInt());
+    std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+    _avatars.resize(numAvatars);
+    for (int i = 0; i < numAvatars; ++i) {
+        auto& simulated = _avatars[i];
+
+        // scatter the avatars uniformly over a disc around the center
+        float distance = spread * sqrtf(unitDistribution(generator));
+        float angle = TWO_PI * unitDistribution(generator);
+        simulated.spawnPosition = center + glm::vec3(distance * cosf(angle), 0.0f, distance * sinf(angle));
+        simulated.walkPhase = TWO_PI * unitDistribution(generator);
+        simulated.clipTimeOffset = (quint64)(unitDistribution(generator) * _clipDuration);
+        simulated.toneFrequency = MIN_TONE_FREQUENCY + unitDistribution(generator) * (MAX_TONE_FREQUENCY - MIN_TONE_FREQUENCY);
+
+        simulated.avatar = std::make_shared<AvatarData>();
+        simulated.avatar->setForceFaceTrackerConnected(true);
+        simulated.avatar->setDisplayName(QString("Load %1").arg(i));
+        simulated.avatar->setPosition(simulated.spawnPosition);
+        simulated.avatar->setOrientation(glm::angleAxis(TWO_PI * unitDistribution(generator), Vectors::UP));
+        // clip frames are replayed relative to each avatar's own spawn pose
+        simulated.avatar->setRecordingBasis();
+
+        auto nodeList = NodeList::createDetached(NodeType::Agent);
+        nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AvatarMixer << NodeType::AudioMixer);
+
+        auto& packetReceiver = nodeList->getPacketReceiver();
+        packetReceiver.registerListenerForTypes(
+            { PacketType::BulkAvatarData, PacketType::AvatarIdentity, PacketType::KillAvatar },
+            this, "handleAvatarMixerPacket");
+        packetReceiver.registerListenerForTypes(
+            { PacketType::MixedAudio, PacketType::SilentAudioFrame, PacketType::AudioStreamStats,
+              PacketType::AudioEnvironment, PacketType::NoisyMute, PacketType::MuteEnvironment },
+            this, "handleAudioMixerPacket");
+
+        nodeList->getDomainHandler().setSockAddr(_domainSockAddr, _domainHostname);
+        simulated.nodeList = nodeList;
+    }
+
+    _startTime = usecTimestampNow();
+    _statsTime = _startTime;
+
+    checkIn();
+    _checkInTimer.start(AVATAR_IDENTITY_PACKET_SEND_INTERVAL_MSECS);
+
+    if (_clipFrames.empty()) {
+        qDebug() << "AvatarLoadGenerator started" << numAvatars << "walking avatars";
+    } else {
+        qDebug() << "AvatarLoadGenerator started" << numAvatars << "avatars replaying" << clipPath;
+    }
+    return true;
+}
+
+void AvatarLoadGenerator::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    _checkInTimer.stop();
+
+    for (auto& simulated : _avatars) {
+        auto nodeList = simulated.nodeList;
+        QUuid sessionUUID = nodeList->getSessionUUID();
+
+        // the mixers keep an avatar for as long as its node is connected, so tell them we're gone
+        nodeList->eachMatchingNode(
+            [&](const SharedNodePointer& node)->bool {
+                return (node->getType() == NodeType::AvatarMixer || node->getType() == NodeType::AudioMixer)
+                    && node->getActiveSocket();
+            },
+            [&](const SharedNodePointer& node) {
+                auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
+                packet->write(sessionUUID.toRfc4122());
+                packet->writePrimitive(KillAvatarReason::NoReason);
+                nodeList->sendPacket(std::move(packet), *node);
+            });
+
+        nodeList->getDomainHandler().disconnect();
+        nodeList->deleteLater();
+    }
+    _avatars.clear();
+
+    _clipFrames.clear();
+    _clipDuration = 0;
+
+    qDebug() << "AvatarLoadGenerator stopped";
+}
+
+bool AvatarLoadGenerator::loadClip(const QString& clipPath) {
+    QString filePath = clipPath;
+    QUrl clipURL(clipPath);
+    if (clipURL.isLocalFile()) {
+        filePath = clipURL.toLocalFile();
+    }
+
+    auto clip = recording::Clip::fromFile(filePath);
+    if (!clip) {
+        qWarning() << "AvatarLoadGenerator could not read the clip" << filePath;
+        return false;
+    }
+
+    static const auto AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+
+    // parse the avatar frames once up front, every avatar replays the same frames every tick
+    clip->seek(0);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        if (frame->type == AVATAR_FRAME_TYPE) {
+            _clipFrames.emplace_back(frame->timeOffset, QJsonDocument::fromBinaryData(frame->data).object());
+        }
+    }
+
+    if (_clipFrames.empty()) {
+        qWarning() << "AvatarLoadGenerator found no avatar frames in the clip" << filePath;
+        return false;
+    }
+
+    _clipDuration = _clipFrames.back().first + 1;
+    return true;
+}
+
+void AvatarLoadGenerator::updatePose(SimulatedAvatar& simulated, quint64 now) {
+    quint64 elapsedMsecs = (now - _startTime) / USECS_PER_MSEC;
+
+    if (!_clipFrames.empty()) {
+        // apply the last frame at or before our position in the clip, looping it
+        quint64 clipTime = (elapsedMsecs + simulated.clipTimeOffset) % _clipDuration;
+        auto frame = std::upper_bound(_clipFrames.begin(), _clipFrames.end(), clipTime,
+            [](quint64 time, const std::pair<quint64, QJsonObject>& frame) {
+                return time < frame.first;
+            });
+        if (frame != _clipFrames.begin()) {
+            --frame;
+        }
+        simulated.avatar->fromJson(frame->second, false);
+        return;
+    }
+
+    float angle = simulated.walkPhase + (WALK_SPEED / WALK_RADIUS) * ((float)elapsedMsecs / MSECS_PER_SECOND);
+    glm::vec3 offset(cosf(angle), 0.0f, sinf(angle));
+    simulated.avatar->setPosition(simulated.spawnPosition + WALK_RADIUS * offset);
+
+    // face along the circle, avatars look down -z
+    glm::vec3 direction(-sinf(angle), 0.0f, cosf(angle));
+    glm::quat orientation = glm::angleAxis(atan2f(-direction.x, -direction.z), Vectors::UP);
+    simulated.avatar->setOrientation(orientation);
+    simulated.avatar->setHeadOrientation(orientation);
+}
+
+void AvatarLoadGenerator::sendAvatarData() {
+    auto now = usecTimestampNow();
+
+    for (auto& simulated : _avatars) {
+        updatePose(simulated, now);
+
+        auto& avatar = *simulated.avatar;
+        AvatarData::AvatarDataDetail dataDetail = (randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO) ? AvatarData::SendAllData : AvatarData::CullSmallData;
+        QByteArray avatarByteArray = avatar.toByteArrayStateful(dataDetail);
+        avatar.doneEncoding(true);
+
+        auto avatarPacket = NLPacket::create(PacketType::AvatarData, avatarByteArray.size() + sizeof(AvatarDataSequenceNumber));
+        avatarPacket->writePrimitive(simulated.avatarDataSequenceNumber++);
+        avatarPacket->write(avatarByteArray);
+
+        _avatarDataPacketsSent += simulated.nodeList->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
+    }
+}
+
+void AvatarLoadGenerator::sendAudio() {
+    AudioConstants::AudioSample samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
+    for (auto& simulated : _avatars) {
+        auto audioMixer = simulated.nodeList->soloNodeOfType(NodeType::AudioMixer);
+        if (!audioMixer || !audioMixer->getActiveSocket()) {
+            continue;
+        }
+
+        auto audioPacket = NLPacket::create(PacketType::MicrophoneAudioNoEcho);
+        audioPacket->writePrimitive(simulated.audioSequenceNumber++);
+
+        // we never negotiate a codec, which the audio-mixer takes as raw PCM
+        audioPacket->writeString(QString());
+
+        // mono, so the channel flag is zero
+        audioPacket->writePrimitive((quint8)0);
+
+        // use the orientation and position of this avatar for the source of this audio
+        auto& avatar = *simulated.avatar;
+        audioPacket->writePrimitive(avatar.getPosition());
+        audioPacket->writePrimitive(avatar.getHeadOrientation());
+        audioPacket->writePrimitive(avatar.getPosition());
+        audioPacket->writePrimitive(glm::vec3(0));
+
+        float phaseStep = TWO_PI * simulated.toneFrequency / AudioConstants::SAMPLE_RATE;
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+            samples[i] = (AudioConstants::AudioSample)(TONE_AMPLITUDE * sinf(simulated.tonePhase));
+            simulated.tonePhase += phaseStep;
+        }
+        simulated.tonePhase = fmodf(simulated.tonePhase, TWO_PI);
+        audioPacket->write(reinterpret_cast<const char*>(samples), sizeof(samples));
+
+        simulated.nodeList->sendUnreliablePacket(*audioPacket, *audioMixer);
+        ++_audioPacketsSent;
+    }
+}
+
+void AvatarLoadGenerator::checkIn() {
+    for (auto& simulated : _avatars) {
+        auto nodeList = simulated.nodeList;
+        nodeList->sendDomainServerCheckIn();
+
+        // the domain-server hands out our session ID with its first list reply
+        QUuid sessionUUID = nodeList->getSessionUUID();
+        if (sessionUUID.isNull()) {
+            continue;
+        }
+        if (simulated.avatar->getSessionUUID() != sessionUUID) {
+            simulated.avatar->setSessionUUID(sessionUUID);
+        }
+
+        // keep our identity fresh at the avatar-mixer, like the agent does for its own avatar
+        QByteArray identityData = simulated.avatar->identityByteArray();
+        nodeList->eachMatchingNode(
+            [&](const SharedNodePointer& node)->bool {
+                return node->getType() == NodeType::AvatarMixer && node->getActiveSocket();
+            },
+            [&](const SharedNodePointer& node) {
+                auto packetList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
+                packetList->write(identityData);
+                nodeList->sendPacketList(std::move(packetList), *node);
+            });
+    }
+
+    updateStats();
+}
+
+void AvatarLoadGenerator::handleAvatarMixerPacket(QSharedPointer<ReceivedMessage> message) {
+    ++_avatarMixerPacketsReceived;
+    _avatarMixerBytesReceived += message->getSize();
+}
+
+void AvatarLoadGenerator::handleAudioMixerPacket(QSharedPointer<ReceivedMessage> message) {
+    ++_audioMixerPacketsReceived;
+    _audioMixerBytesReceived += message->getSize();
+}
+
+void AvatarLoadGenerator::updateStats() {
+    auto now = usecTimestampNow();
+    if (now <= _statsTime) {
+        return;
+    }
+    float intervalSecs = (float)(now - _statsTime) / USECS_PER_SECOND;
+
+    int avatarMixerConnections = 0;
+    int audioMixerConnections = 0;
+    for (auto& simulated : _avatars) {
+        auto avatarMixer = simulated.nodeList->soloNodeOfType(NodeType::AvatarMixer);
+        if (avatarMixer && avatarMixer->getActiveSocket()) {
+            ++avatarMixerConnections;
+        }
+        auto audioMixer = simulated.nodeList->soloNodeOfType(NodeType::AudioMixer);
+        if (audioMixer && audioMixer->getActiveSocket()) {
+            ++audioMixerConnections;
+        }
+    }
+
+    QVariantMap stats;
+    stats["avatars"] = (int)_avatars.size();
+    stats["avatar_mixer_connections"] = avatarMixerConnections;
+    stats["audio_mixer_connections"] = audioMixerConnections;
+    stats["avatar_data_packets_sent_per_second"] = _avatarDataPacketsSent / intervalSecs;
+    stats["audio_packets_sent_per_second"] = _audioPacketsSent / intervalSecs;
+    stats["avatar_mixer_packets_received_per_second"] = _avatarMixerPacketsReceived / intervalSecs;
+    stats["avatar_mixer_bytes_received_per_second"] = _avatarMixerBytesReceived / intervalSecs;
+    stats["audio_mixer_packets_received_per_second"] = _audioMixerPacketsReceived / intervalSecs;
+    stats["audio_mixer_bytes_received_per_second"] = _audioMixerBytesReceived / intervalSecs;
+    _stats = stats;
+
+    _statsTime = now;
+    _avatarDataPacketsSent = 0;
+    _audioPacketsSent = 0;
+    _avatarMixerPacketsReceived = 0;
+    _avatarMixerBytesReceived = 0;
+    _audioMixerPacketsReceived = 0;
+    _audioMixerBytesReceived = 0;
+}
@@ -0,0 +1,107 @@
+//
+//  AvatarLoadGenerator.h
+//  assignment-client/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarLoadGenerator_h
+#define hifi_AvatarLoadGenerator_h
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QTimer>
+#include <QtCore/QVariantMap>
+
+#include <glm/glm.hpp>
+
+#include <HifiSockAddr.h>
+#include <ReceivedMessage.h>
+
+class AvatarData;
+class NodeList;
+
+// Drives many simulated avatars from a single agent, to load test the avatar and audio mixers.
+//
+// The mixers key one avatar per node session, so every simulated avatar gets its own detached NodeList
+// (socket and domain session). Motion is either replayed from a recording clip, with a per avatar time
+// offset and recording basis, or a synthetic walk around a circle. Each avatar also streams a sine tone.
+// The sends are paced by the agent's AvatarAudioTimer; what the mixers send back is counted as throughput.
+class AvatarLoadGenerator : public QObject {
+    Q_OBJECT
+
+public:
+    AvatarLoadGenerator(const HifiSockAddr& domainSockAddr, const QString& domainHostname, QObject* parent = nullptr);
+    ~AvatarLoadGenerator();
+
+    // options:
+    //   numAvatars - how many avatars to simulate (default 10)
+    //   clip       - path or file: URL of a local .hfr recording to replay, synthetic motion if empty
+    //   center     - vec3 the avatars are scattered around (default origin)
+    //   spread     - radius in meters of the area the avatars are scattered over (default 20)
+    //   seed       - seed for placement, time offsets and tones, so runs are reproducible (default 1)
+    bool start(const QVariantMap& options);
+    void stop();
+    bool isRunning() const { return !_avatars.empty(); }
+
+    // rates over the last stats interval
+    QVariantMap getStats() const { return _stats; }
+
+public slots:
+    void sendAvatarData();
+    void sendAudio();
+
+private slots:
+    void checkIn();
+    void handleAvatarMixerPacket(QSharedPointer<ReceivedMessage> message);
+    void handleAudioMixerPacket(QSharedPointer<ReceivedMessage> message);
+
+private:
+    struct SimulatedAvatar {
+        NodeList* nodeList { nullptr };
+        std::shared_ptr<AvatarData> avatar;
+        glm::vec3 spawnPosition;
+        float walkPhase { 0.0f };
+        quint64 clipTimeOffset { 0 };
+        float tonePhase { 0.0f };
+        float toneFrequency { 0.0f };
+        quint16 avatarDataSequenceNumber { 0 };
+        quint16 audioSequenceNumber { 0 };
+    };
+
+    bool loadClip(const QString& clipPath);
+    void updatePose(SimulatedAvatar& simulated, quint64 now);
+    void updateStats();
+
+    HifiSockAddr _domainSockAddr;
+    QString _domainHostname;
+
+    std::vector<SimulatedAvatar> _avatars;
+
+    // avatar frames of the clip, pre-parsed once so that every avatar can share them
+    std::vector<std::pair<quint64, QJsonObject>> _clipFrames;
+    quint64 _clipDuration { 0 };
+
+    quint64 _startTime { 0 };
+    QTimer _checkInTimer;
+
+    // counters since the last stats update, touched only on our thread
+    quint64 _statsTime { 0 };
+    quint64 _avatarDataPacketsSent { 0 };
+    quint64 _audioPacketsSent { 0 };
+    quint64 _avatarMixerPacketsReceived { 0 };
+    quint64 _avatarMixerBytesReceived { 0 };
+    quint64 _audioMixerPacketsReceived { 0 };
+    quint64 _audioMixerBytesReceived { 0 };
+    QVariantMap _stats;
+};
+
+#endif // hifi_AvatarLoadGenerator_h
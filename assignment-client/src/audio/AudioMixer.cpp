@@ -23,6 +23,7 @@
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
+#include <Profile.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <StDev.h>
@@ -225,34 +226,34 @@ QString AudioMixer::percentageForMixStats(int counter) {
 }
 
 void AudioMixer::sendStatsPacket() {
-    QJsonObject statsObject;
-
     if (_numStatFrames == 0) {
         return;
     }
 
+    auto& stats = beginStatsPacket();
+
     // general stats
-    statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == -1;
+    stats.write("useDynamicJitterBuffers", _numStaticJitterFrames == -1);
 
-    statsObject["threads"] = _slavePool.numThreads();
+    stats.write("threads", _slavePool.numThreads());
 
-    statsObject["trailing_mix_ratio"] = _trailingMixRatio;
-    statsObject["throttling_ratio"] = _throttlingRatio;
+    stats.write("trailing_mix_ratio", _trailingMixRatio);
+    stats.write("throttling_ratio", _throttlingRatio);
 
-    statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
-    statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
-    statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
+    stats.write("avg_streams_per_frame", (float)_stats.sumStreams / (float)_numStatFrames);
+    stats.write("avg_listeners_per_frame", (float)_stats.sumListeners / (float)_numStatFrames);
+    stats.write("avg_listeners_(silent)_per_frame", (float)_stats.sumListenersSilent / (float)_numStatFrames);
 
-    statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
+    stats.write("silent_packets_per_frame", (float)_numSilentPackets / (float)_numStatFrames);
 
-    // timing stats
-    QJsonObject timingStats;
+    // timing stats, call it "avg_..." to keep it higher in the display, sorted alphabetically
+    stats.beginObject("avg_timing_stats");
 
     auto addTiming = [&](Timer& timer, std::string name) {
         uint64_t timing, trailing;
         timer.get(timing, trailing);
-        timingStats[("us_per_" + name).c_str()] = (qint64)(timing / _numStatFrames);
-        timingStats[("us_per_" + name + "_trailing").c_str()] = (qint64)(trailing / _numStatFrames);
+        stats.write(("us_per_" + name).c_str(), (qint64)(timing / _numStatFrames));
+        stats.write(("us_per_" + name + "_trailing").c_str(), (qint64)(trailing / _numStatFrames));
     };
 
     addTiming(_ticTiming, "tic");
@@ -264,53 +265,53 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_packetsTiming, "packets");
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
-    timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
+    stats.write("ns_per_mix", (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0);
 #endif
 
-    // call it "avg_..." to keep it higher in the display, sorted alphabetically
-    statsObject["avg_timing_stats"] = timingStats;
+    stats.endObject();
 
     // mix stats
-    QJsonObject mixStats;
+    stats.beginObject("mix_stats");
 
-    mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
-    mixStats["%_hrtf_silent_mixes"] = percentageForMixStats(_stats.hrtfSilentRenders);
-    mixStats["%_hrtf_throttle_mixes"] = percentageForMixStats(_stats.hrtfThrottleRenders);
-    mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
-    mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
+    stats.write("%_hrtf_mixes", percentageForMixStats(_stats.hrtfRenders));
+    stats.write("%_hrtf_silent_mixes", percentageForMixStats(_stats.hrtfSilentRenders));
+    stats.write("%_hrtf_throttle_mixes", percentageForMixStats(_stats.hrtfThrottleRenders));
+    stats.write("%_manual_stereo_mixes", percentageForMixStats(_stats.manualStereoMixes));
+    stats.write("%_manual_echo_mixes", percentageForMixStats(_stats.manualEchoMixes));
 
-    mixStats["total_mixes"] = _stats.totalMixes;
-    mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
+    stats.write("total_mixes", _stats.totalMixes);
+    stats.write("avg_mixes_per_block", _stats.totalMixes / _numStatFrames);
 
-    statsObject["mix_stats"] = mixStats;
+    stats.endObject();
 
     _numStatFrames = _numSilentPackets = 0;
     _stats.reset();
 
     // add stats for each listerner
     auto nodeList = DependencyManager::get<NodeList>();
-    QJsonObject listenerStats;
+    stats.beginObject("z_listeners");
 
     nodeList->eachNode([&](const SharedNodePointer& node) {
         AudioMixerClientData* clientData = static_cast<AudioMixerClientData*>(node->getLinkedData());
         if (clientData) {
-            QJsonObject nodeStats;
             QString uuidString = uuidStringWithoutCurlyBraces(node->getUUID());
+            stats.beginObject(uuidString);
 
-            nodeStats["outbound_kbps"] = node->getOutboundBandwidth();
-            nodeStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidString;
+            stats.write("outbound_kbps", node->getOutboundBandwidth());
+            stats.write(USERNAME_UUID_REPLACEMENT_STATS_KEY, uuidString);
 
-            nodeStats["jitter"] = clientData->getAudioStreamStats();
+            stats.beginObject("jitter");
+            clientData->writeAudioStreamStats(stats);
+            stats.endObject();
 
-            listenerStats[uuidString] = nodeStats;
+            stats.endObject();
         }
     });
 
-    // add the listeners object to the root object
-    statsObject["z_listeners"] = listenerStats;
+    stats.endObject();
 
     // send off the stats packets
-    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket();
 }
 
 void AudioMixer::run() {
@@ -360,16 +361,23 @@ void AudioMixer::start() {
 
         {
             auto timer = _sleepTiming.timer();
+            PROFILE_RANGE(mixer, "AudioMixer::sleep");
             auto frameDuration = timeFrame(frameTimestamp);
             throttle(frameDuration, frame);
         }
 
+        if (tracing::enabled()) {
+            PROFILE_COUNTER(mixer, "AudioMixer", { { "throttlingRatio", _throttlingRatio } });
+        }
+
         auto frameTimer = _frameTiming.timer();
+        PROFILE_RANGE(mixer, "AudioMixer::frame");
 
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // prepare frames; pop off any new audio from their streams
             {
                 auto prepareTimer = _prepareTiming.timer();
+                PROFILE_RANGE(mixer, "AudioMixer::prepare");
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     _stats.sumStreams += prepareFrame(node, frame);
                 });
@@ -378,6 +386,7 @@ void AudioMixer::start() {
             // mix across slave threads
             {
                 auto mixTimer = _mixTiming.timer();
+                PROFILE_RANGE(mixer, "AudioMixer::mix");
                 _slavePool.mix(cbegin, cend, frame, _throttlingRatio);
             }
         });
@@ -394,6 +403,7 @@ void AudioMixer::start() {
         // process queued events (networking, global audio packets, &c.)
         {
             auto eventsTimer = _eventsTiming.timer();
+            PROFILE_RANGE(mixer, "AudioMixer::events");
 
             // since we're a while loop we need to yield to qt's event processing
             QCoreApplication::processEvents();
@@ -366,58 +366,56 @@ void AudioMixerClientData::sendAudioStreamStatsPackets(const SharedNodePointer&
     }
 }
 
-QJsonObject AudioMixerClientData::getAudioStreamStats() {
-    QJsonObject result;
-
-    QJsonObject downstreamStats;
+void AudioMixerClientData::writeAudioStreamStats(NodeStatsEncoder& stats) {
+    stats.beginObject("downstream");
     AudioStreamStats streamStats = _downstreamAudioStreamStats;
-    downstreamStats["desired"] = streamStats._desiredJitterBufferFrames;
-    downstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
-    downstreamStats["available"] = (double) streamStats._framesAvailable;
-    downstreamStats["unplayed"] = (double) streamStats._unplayedMs;
-    downstreamStats["starves"] = (double) streamStats._starveCount;
-    downstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
-    downstreamStats["overflows"] = (double) streamStats._overflowCount;
-    downstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
-    downstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
-    downstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
-    downstreamStats["max_gap"] = formatUsecTime(streamStats._timeGapMax);
-    downstreamStats["avg_gap"] = formatUsecTime(streamStats._timeGapAverage);
-    downstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
-    downstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
-    downstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
-
-    result["downstream"] = downstreamStats;
+    stats.write("desired", streamStats._desiredJitterBufferFrames);
+    stats.write("available_avg_10s", streamStats._framesAvailableAverage);
+    stats.write("available", streamStats._framesAvailable);
+    stats.write("unplayed", streamStats._unplayedMs);
+    stats.write("starves", streamStats._starveCount);
+    stats.write("not_mixed", streamStats._consecutiveNotMixedCount);
+    stats.write("overflows", streamStats._overflowCount);
+    stats.write("lost%", streamStats._packetStreamStats.getLostRate() * 100.0f);
+    stats.write("lost%_30s", streamStats._packetStreamWindowStats.getLostRate() * 100.0f);
+    stats.write("min_gap", formatUsecTime(streamStats._timeGapMin));
+    stats.write("max_gap", formatUsecTime(streamStats._timeGapMax));
+    stats.write("avg_gap", formatUsecTime(streamStats._timeGapAverage));
+    stats.write("min_gap_30s", formatUsecTime(streamStats._timeGapWindowMin));
+    stats.write("max_gap_30s", formatUsecTime(streamStats._timeGapWindowMax));
+    stats.write("avg_gap_30s", formatUsecTime(streamStats._timeGapWindowAverage));
+    stats.endObject();
 
     AvatarAudioStream* avatarAudioStream = getAvatarAudioStream();
 
     if (avatarAudioStream) {
-        QJsonObject upstreamStats;
+        stats.beginObject("upstream");
 
         AudioStreamStats streamStats = avatarAudioStream->getAudioStreamStats();
-        upstreamStats["mic.desired"] = streamStats._desiredJitterBufferFrames;
-        upstreamStats["desired_calc"] = avatarAudioStream->getCalculatedJitterBufferFrames();
-        upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
-        upstreamStats["available"] = (double) streamStats._framesAvailable;
-        upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
-        upstreamStats["starves"] = (double) streamStats._starveCount;
-        upstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
-        upstreamStats["overflows"] = (double) streamStats._overflowCount;
-        upstreamStats["silents_dropped"] = (double) streamStats._framesDropped;
-        upstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
-        upstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
-        upstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
-        upstreamStats["max_gap"] = formatUsecTime(streamStats._timeGapMax);
-        upstreamStats["avg_gap"] = formatUsecTime(streamStats._timeGapAverage);
-        upstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
-        upstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
-        upstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
-
-        result["upstream"] = upstreamStats;
+        stats.write("mic.desired", streamStats._desiredJitterBufferFrames);
+        stats.write("desired_calc", avatarAudioStream->getCalculatedJitterBufferFrames());
+        stats.write("available_avg_10s", streamStats._framesAvailableAverage);
+        stats.write("available", streamStats._framesAvailable);
+        stats.write("unplayed", streamStats._unplayedMs);
+        stats.write("starves", streamStats._starveCount);
+        stats.write("not_mixed", streamStats._consecutiveNotMixedCount);
+        stats.write("overflows", streamStats._overflowCount);
+        stats.write("silents_dropped", streamStats._framesDropped);
+        stats.write("lost%", streamStats._packetStreamStats.getLostRate() * 100.0f);
+        stats.write("lost%_30s", streamStats._packetStreamWindowStats.getLostRate() * 100.0f);
+        stats.write("min_gap", formatUsecTime(streamStats._timeGapMin));
+        stats.write("max_gap", formatUsecTime(streamStats._timeGapMax));
+        stats.write("avg_gap", formatUsecTime(streamStats._timeGapAverage));
+        stats.write("min_gap_30s", formatUsecTime(streamStats._timeGapWindowMin));
+        stats.write("max_gap_30s", formatUsecTime(streamStats._timeGapWindowMax));
+        stats.write("avg_gap_30s", formatUsecTime(streamStats._timeGapWindowAverage));
+
+        stats.endObject();
     } else {
-        result["upstream"] = "mic unknown";
+        stats.write("upstream", "mic unknown");
     }
 
+    // injectors come and go, so they are sent whole as an array
     QJsonArray injectorArray;
     auto streamsCopy = getAudioStreams();
     for (auto& injectorPair : streamsCopy) {
@@ -447,9 +445,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         }
     }
 
-    result["injectors"] = injectorArray;
-
-    return result;
+    stats.write("injectors", injectorArray);
 }
 
 void AudioMixerClientData::handleMismatchAudioFormat(SharedNodePointer node, const QString& currentCodec, const QString& recievedCodec) {
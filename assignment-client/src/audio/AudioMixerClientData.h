@@ -19,6 +19,7 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
+#include <NodeStatsCodec.h>
 #include <UUIDHasher.h>
 
 #include <plugins/CodecPlugin.h>
@@ -74,7 +75,7 @@ public:
 
     void removeDeadInjectedStreams();
 
-    QJsonObject getAudioStreamStats();
+    void writeAudioStreamStats(NodeStatsEncoder& stats);
 
     void sendAudioStreamStatsPackets(const SharedNodePointer& destinationNode);
 
@@ -26,6 +26,7 @@
 #include <AvatarLogging.h>
 #include <LogHandler.h>
 #include <NodeList.h>
+#include <Profile.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
@@ -112,13 +113,21 @@ void AvatarMixer::start() {
 
     while (!_isFinished) {
 
-        auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
-        throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
+        {
+            PROFILE_RANGE(mixer, "AvatarMixer::sleep");
+            auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
+            throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
+        }
+
+        if (tracing::enabled()) {
+            PROFILE_COUNTER(mixer, "AvatarMixer", { { "throttlingRatio", _throttlingRatio } });
+        }
 
         int lockWait, nodeTransform, functor;
 
         // Allow nodes to process any pending/queued packets across our worker threads
         {
+            PROFILE_RANGE(mixer, "AvatarMixer::processPackets");
             auto start = usecTimestampNow();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
@@ -147,6 +156,7 @@ void AvatarMixer::start() {
 
         // this is where we need to put the real work...
         {
+            PROFILE_RANGE(mixer, "AvatarMixer::broadcast");
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
@@ -169,6 +179,7 @@ void AvatarMixer::start() {
         // play nice with qt event-looping
         {
             // since we're a while loop we need to yield to qt's event processing
+            PROFILE_RANGE(mixer, "AvatarMixer::events");
             auto start = usecTimestampNow();
             QCoreApplication::processEvents();
             if (_isFinished) {
@@ -470,132 +481,109 @@ void AvatarMixer::sendStatsPacket() {
     auto start = usecTimestampNow();
 
 
-    QJsonObject statsObject;
+    auto& stats = beginStatsPacket();
 
-    statsObject["broadcast_loop_rate"] = _loopRate.rate();
-    statsObject["threads"] = _slavePool.numThreads();
-    statsObject["trailing_mix_ratio"] = _trailingMixRatio;
-    statsObject["throttling_ratio"] = _throttlingRatio;
+    stats.write("broadcast_loop_rate", _loopRate.rate());
+    stats.write("threads", _slavePool.numThreads());
+    stats.write("trailing_mix_ratio", _trailingMixRatio);
+    stats.write("throttling_ratio", _throttlingRatio);
 
     // this things all occur on the frequency of the tight loop
     int tightLoopFrames = _numTightLoopFrames;
     int tenTimesPerFrame = tightLoopFrames * 10;
-    #define TIGHT_LOOP_STAT(x) (x > tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames);
-    #define TIGHT_LOOP_STAT_UINT64(x) (x > (quint64)tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames);
-
-    statsObject["average_listeners_last_second"] = TIGHT_LOOP_STAT(_sumListeners);
-
-    QJsonObject singleCoreTasks;
-    singleCoreTasks["processEvents"] = TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime);
-    singleCoreTasks["queueIncomingPacket"] = TIGHT_LOOP_STAT_UINT64(_queueIncomingPacketElapsedTime);
+    #define TIGHT_LOOP_STAT(x) ((x > tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames))
+    #define TIGHT_LOOP_STAT_UINT64(x) ((x > (quint64)tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames))
 
-    QJsonObject incomingPacketStats;
-    incomingPacketStats["handleAvatarIdentityPacket"] = TIGHT_LOOP_STAT_UINT64(_handleAvatarIdentityPacketElapsedTime);
-    incomingPacketStats["handleKillAvatarPacket"] = TIGHT_LOOP_STAT_UINT64(_handleKillAvatarPacketElapsedTime);
-    incomingPacketStats["handleNodeIgnoreRequestPacket"] = TIGHT_LOOP_STAT_UINT64(_handleNodeIgnoreRequestPacketElapsedTime);
-    incomingPacketStats["handleRadiusIgnoreRequestPacket"] = TIGHT_LOOP_STAT_UINT64(_handleRadiusIgnoreRequestPacketElapsedTime);
-    incomingPacketStats["handleRequestsDomainListDataPacket"] = TIGHT_LOOP_STAT_UINT64(_handleRequestsDomainListDataPacketElapsedTime);
-    incomingPacketStats["handleViewFrustumPacket"] = TIGHT_LOOP_STAT_UINT64(_handleViewFrustumPacketElapsedTime);
+    stats.write("average_listeners_last_second", TIGHT_LOOP_STAT(_sumListeners));
 
-    singleCoreTasks["incoming_packets"] = incomingPacketStats;
-    singleCoreTasks["sendStats"] = (float)_sendStatsElapsedTime;
+    stats.beginObject("singleCoreTasks");
+    stats.write("processEvents", TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime));
+    stats.write("queueIncomingPacket", TIGHT_LOOP_STAT_UINT64(_queueIncomingPacketElapsedTime));
 
-    statsObject["singleCoreTasks"] = singleCoreTasks;
+    stats.beginObject("incoming_packets");
+    stats.write("handleAvatarIdentityPacket", TIGHT_LOOP_STAT_UINT64(_handleAvatarIdentityPacketElapsedTime));
+    stats.write("handleKillAvatarPacket", TIGHT_LOOP_STAT_UINT64(_handleKillAvatarPacketElapsedTime));
+    stats.write("handleNodeIgnoreRequestPacket", TIGHT_LOOP_STAT_UINT64(_handleNodeIgnoreRequestPacketElapsedTime));
+    stats.write("handleRadiusIgnoreRequestPacket", TIGHT_LOOP_STAT_UINT64(_handleRadiusIgnoreRequestPacketElapsedTime));
+    stats.write("handleRequestsDomainListDataPacket", TIGHT_LOOP_STAT_UINT64(_handleRequestsDomainListDataPacketElapsedTime));
+    stats.write("handleViewFrustumPacket", TIGHT_LOOP_STAT_UINT64(_handleViewFrustumPacketElapsedTime));
+    stats.endObject();
 
-    QJsonObject parallelTasks;
+    stats.write("sendStats", (float)_sendStatsElapsedTime);
+    stats.endObject();
 
-    QJsonObject processQueuedAvatarDataPacketsStats;
-    processQueuedAvatarDataPacketsStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsElapsedTime);
-    processQueuedAvatarDataPacketsStats["2_lockWait"] = TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsLockWaitElapsedTime);
-    parallelTasks["processQueuedAvatarDataPackets"] = processQueuedAvatarDataPacketsStats;
+    stats.beginObject("parallelTasks");
 
-    QJsonObject broadcastAvatarDataStats;
+    stats.beginObject("processQueuedAvatarDataPackets");
+    stats.write("1_total", TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsElapsedTime));
+    stats.write("2_lockWait", TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsLockWaitElapsedTime));
+    stats.endObject();
 
-    broadcastAvatarDataStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataElapsedTime);
-    broadcastAvatarDataStats["2_innner"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataInner);
-    broadcastAvatarDataStats["3_lockWait"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataLockWait);
-    broadcastAvatarDataStats["4_NodeTransform"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeTransform);
-    broadcastAvatarDataStats["5_Functor"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeFunctor);
+    stats.beginObject("broadcastAvatarData");
+    stats.write("1_total", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataElapsedTime));
+    stats.write("2_innner", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataInner));
+    stats.write("3_lockWait", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataLockWait));
+    stats.write("4_NodeTransform", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeTransform));
+    stats.write("5_Functor", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeFunctor));
+    stats.endObject();
 
-    parallelTasks["broadcastAvatarData"] = broadcastAvatarDataStats;
+    stats.beginObject("displayNameManagement");
+    stats.write("1_total", TIGHT_LOOP_STAT_UINT64(_displayNameManagementElapsedTime));
+    stats.endObject();
 
-    QJsonObject displayNameManagementStats;
-    displayNameManagementStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_displayNameManagementElapsedTime);
-    parallelTasks["displayNameManagement"] = displayNameManagementStats;
+    stats.endObject();
 
-    statsObject["parallelTasks"] = parallelTasks;
 
+    float secondsSinceLastStats = (float)(start - _lastStatsTime) / (float)USECS_PER_SECOND;
 
-    AvatarMixerSlaveStats aggregateStats;
-    QJsonObject slavesObject;
+    auto writeSlaveStats = [&](const AvatarMixerSlaveStats& slaveStats) {
+        stats.write("recevied_1_nodesProcessed", TIGHT_LOOP_STAT(slaveStats.nodesProcessed));
+        stats.write("received_2_numPacketsReceived", TIGHT_LOOP_STAT(slaveStats.packetsProcessed));
 
-    float secondsSinceLastStats = (float)(start - _lastStatsTime) / (float)USECS_PER_SECOND;
-    // gather stats
-    int slaveNumber = 1;
-    _slavePool.each([&](AvatarMixerSlave& slave) {
-        QJsonObject slaveObject;
-        AvatarMixerSlaveStats stats;
-        slave.harvestStats(stats);
-        slaveObject["recevied_1_nodesProcessed"] = TIGHT_LOOP_STAT(stats.nodesProcessed);
-        slaveObject["received_2_numPacketsReceived"] = TIGHT_LOOP_STAT(stats.packetsProcessed);
-
-        slaveObject["sent_1_nodesBroadcastedTo"] = TIGHT_LOOP_STAT(stats.nodesBroadcastedTo);
-        slaveObject["sent_2_numBytesSent"] = TIGHT_LOOP_STAT(stats.numBytesSent);
-        slaveObject["sent_3_numPacketsSent"] = TIGHT_LOOP_STAT(stats.numPacketsSent);
-        slaveObject["sent_4_numIdentityPackets"] = TIGHT_LOOP_STAT(stats.numIdentityPackets);
-
-        float averageNodes = ((float)stats.nodesBroadcastedTo / (float)tightLoopFrames);
-        float averageOutboundAvatarKbps = averageNodes ? ((stats.numBytesSent / secondsSinceLastStats) / BYTES_PER_KILOBIT) / averageNodes : 0.0f;
-        slaveObject["sent_5_averageOutboundAvatarKbps"] = averageOutboundAvatarKbps;
-
-        float averageOthersIncluded = averageNodes ? stats.numOthersIncluded / averageNodes : 0.0f;
-        slaveObject["sent_6_averageOthersIncluded"] = TIGHT_LOOP_STAT(averageOthersIncluded);
-
-        float averageOverBudgetAvatars = averageNodes ? stats.overBudgetAvatars / averageNodes : 0.0f;
-        slaveObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
-
-        slaveObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(stats.processIncomingPacketsElapsedTime);
-        slaveObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(stats.ignoreCalculationElapsedTime);
-        slaveObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(stats.toByteArrayElapsedTime);
-        slaveObject["timing_4_avatarDataPacking"] = TIGHT_LOOP_STAT_UINT64(stats.avatarDataPackingElapsedTime);
-        slaveObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(stats.packetSendingElapsedTime);
-        slaveObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(stats.jobElapsedTime);
-
-        slavesObject[QString::number(slaveNumber)] = slaveObject;
-        slaveNumber++;
+        stats.write("sent_1_nodesBroadcastedTo", TIGHT_LOOP_STAT(slaveStats.nodesBroadcastedTo));
+        stats.write("sent_2_numBytesSent", TIGHT_LOOP_STAT(slaveStats.numBytesSent));
+        stats.write("sent_3_numPacketsSent", TIGHT_LOOP_STAT(slaveStats.numPacketsSent));
+        stats.write("sent_4_numIdentityPackets", TIGHT_LOOP_STAT(slaveStats.numIdentityPackets));
 
-        aggregateStats += stats;
-    });
+        float averageNodes = ((float)slaveStats.nodesBroadcastedTo / (float)tightLoopFrames);
+        float averageOutboundAvatarKbps = averageNodes ? ((slaveStats.numBytesSent / secondsSinceLastStats) / BYTES_PER_KILOBIT) / averageNodes : 0.0f;
+        stats.write("sent_5_averageOutboundAvatarKbps", averageOutboundAvatarKbps);
 
-    QJsonObject slavesAggregatObject;
+        float averageOthersIncluded = averageNodes ? slaveStats.numOthersIncluded / averageNodes : 0.0f;
+        stats.write("sent_6_averageOthersIncluded", TIGHT_LOOP_STAT(averageOthersIncluded));
 
-    slavesAggregatObject["recevied_1_nodesProcessed"] = TIGHT_LOOP_STAT(aggregateStats.nodesProcessed);
-    slavesAggregatObject["received_2_numPacketsReceived"] = TIGHT_LOOP_STAT(aggregateStats.packetsProcessed);
+        float averageOverBudgetAvatars = averageNodes ? slaveStats.overBudgetAvatars / averageNodes : 0.0f;
+        stats.write("sent_7_averageOverBudgetAvatars", TIGHT_LOOP_STAT(averageOverBudgetAvatars));
 
-    slavesAggregatObject["sent_1_nodesBroadcastedTo"] = TIGHT_LOOP_STAT(aggregateStats.nodesBroadcastedTo);
-    slavesAggregatObject["sent_2_numBytesSent"] = TIGHT_LOOP_STAT(aggregateStats.numBytesSent);
-    slavesAggregatObject["sent_3_numPacketsSent"] = TIGHT_LOOP_STAT(aggregateStats.numPacketsSent);
-    slavesAggregatObject["sent_4_numIdentityPackets"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityPackets);
+        stats.write("timing_1_processIncomingPackets", TIGHT_LOOP_STAT_UINT64(slaveStats.processIncomingPacketsElapsedTime));
+        stats.write("timing_2_ignoreCalculation", TIGHT_LOOP_STAT_UINT64(slaveStats.ignoreCalculationElapsedTime));
+        stats.write("timing_3_toByteArray", TIGHT_LOOP_STAT_UINT64(slaveStats.toByteArrayElapsedTime));
+        stats.write("timing_4_avatarDataPacking", TIGHT_LOOP_STAT_UINT64(slaveStats.avatarDataPackingElapsedTime));
+        stats.write("timing_5_packetSending", TIGHT_LOOP_STAT_UINT64(slaveStats.packetSendingElapsedTime));
+        stats.write("timing_6_jobElapsedTime", TIGHT_LOOP_STAT_UINT64(slaveStats.jobElapsedTime));
+    };
 
-    float averageNodes = ((float)aggregateStats.nodesBroadcastedTo / (float)tightLoopFrames);
-    float averageOutboundAvatarKbps = averageNodes ? ((aggregateStats.numBytesSent / secondsSinceLastStats) / BYTES_PER_KILOBIT) / averageNodes : 0.0f;
-    slavesAggregatObject["sent_5_averageOutboundAvatarKbps"] = averageOutboundAvatarKbps;
+    // gather stats
+    AvatarMixerSlaveStats aggregateStats;
+    int slaveNumber = 1;
 
-    float averageOthersIncluded = averageNodes ? aggregateStats.numOthersIncluded / averageNodes : 0.0f;
-    slavesAggregatObject["sent_6_averageOthersIncluded"] = TIGHT_LOOP_STAT(averageOthersIncluded);
+    stats.beginObject("slaves_individual");
+    _slavePool.each([&](AvatarMixerSlave& slave) {
+        AvatarMixerSlaveStats slaveStats;
+        slave.harvestStats(slaveStats);
 
-    float averageOverBudgetAvatars = averageNodes ? aggregateStats.overBudgetAvatars / averageNodes : 0.0f;
-    slavesAggregatObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
+        stats.beginObject(QString::number(slaveNumber));
+        writeSlaveStats(slaveStats);
+        stats.endObject();
+        slaveNumber++;
 
-    slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
-    slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
-    slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
-    slavesAggregatObject["timing_4_avatarDataPacking"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.avatarDataPackingElapsedTime);
-    slavesAggregatObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.packetSendingElapsedTime);
-    slavesAggregatObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.jobElapsedTime);
+        aggregateStats += slaveStats;
+    });
+    stats.endObject();
 
-    statsObject["slaves_aggregate"] = slavesAggregatObject;
-    statsObject["slaves_individual"] = slavesObject;
+    stats.beginObject("slaves_aggregate");
+    writeSlaveStats(aggregateStats);
+    stats.endObject();
 
     _handleViewFrustumPacketElapsedTime = 0;
     _handleAvatarIdentityPacketElapsedTime = 0;
@@ -608,39 +596,36 @@ void AvatarMixer::sendStatsPacket() {
     _processQueuedAvatarDataPacketsElapsedTime = 0;
     _processQueuedAvatarDataPacketsLockWaitElapsedTime = 0;
 
-    QJsonObject avatarsObject;
     auto nodeList = DependencyManager::get<NodeList>();
     // add stats for each listerner
+    stats.beginObject("z_avatars");
     nodeList->eachNode([&](const SharedNodePointer& node) {
-        QJsonObject avatarStats;
-
-        const QString NODE_OUTBOUND_KBPS_STAT_KEY = "outbound_kbps";
-        const QString NODE_INBOUND_KBPS_STAT_KEY = "inbound_kbps";
+        QString uuidString = uuidStringWithoutCurlyBraces(node->getUUID());
+        stats.beginObject(uuidString);
 
         // add the key to ask the domain-server for a username replacement, if it has it
-        avatarStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidStringWithoutCurlyBraces(node->getUUID());
+        stats.write(USERNAME_UUID_REPLACEMENT_STATS_KEY, uuidString);
 
-        avatarStats[NODE_OUTBOUND_KBPS_STAT_KEY] = node->getOutboundBandwidth();
-        avatarStats[NODE_INBOUND_KBPS_STAT_KEY] = node->getInboundBandwidth();
+        float outboundKbps = node->getOutboundBandwidth();
+        stats.write("outbound_kbps", outboundKbps);
+        stats.write("inbound_kbps", node->getInboundBandwidth());
 
         AvatarMixerClientData* clientData = static_cast<AvatarMixerClientData*>(node->getLinkedData());
         if (clientData) {
             MutexTryLocker lock(clientData->getMutex());
             if (lock.isLocked()) {
-                clientData->loadJSONStats(avatarStats);
+                clientData->writeStats(stats);
 
                 // add the diff between the full outbound bandwidth and the measured bandwidth for AvatarData send only
-                avatarStats["delta_full_vs_avatar_data_kbps"] =
-                    avatarStats[NODE_OUTBOUND_KBPS_STAT_KEY].toDouble() - avatarStats[OUTBOUND_AVATAR_DATA_STATS_KEY].toDouble();
+                stats.write("delta_full_vs_avatar_data_kbps", outboundKbps - clientData->getOutboundAvatarDataKbps());
             }
         }
 
-        avatarsObject[uuidStringWithoutCurlyBraces(node->getUUID())] = avatarStats;
+        stats.endObject();
     });
+    stats.endObject();
 
-    statsObject["z_avatars"] = avatarsObject;
-
-    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket();
 
     _sumListeners = 0;
     _sumIdentityPackets = 0;
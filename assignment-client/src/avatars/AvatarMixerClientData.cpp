@@ -115,17 +115,17 @@ bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
     return _currentViewFrustum.boxIntersectsKeyhole(otherAvatarBox);
 }
 
-void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
-    jsonObject["display_name"] = _avatar->getDisplayName();
-    jsonObject["num_avs_sent_last_frame"] = _numAvatarsSentLastFrame;
-    jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
-    jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
-    jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
-
-    jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
-    jsonObject[INBOUND_AVATAR_DATA_STATS_KEY] = _avatar->getAverageBytesReceivedPerSecond() / (float) BYTES_PER_KILOBIT;
-
-    jsonObject["av_data_receive_rate"] = _avatar->getReceiveRate();
-    jsonObject["recent_other_av_in_view"] = _recentOtherAvatarsInView;
-    jsonObject["recent_other_av_out_of_view"] = _recentOtherAvatarsOutOfView;
+void AvatarMixerClientData::writeStats(NodeStatsEncoder& stats) const {
+    stats.write("display_name", _avatar->getDisplayName());
+    stats.write("num_avs_sent_last_frame", _numAvatarsSentLastFrame);
+    stats.write("avg_other_av_starves_per_second", getAvgNumOtherAvatarStarvesPerSecond());
+    stats.write("avg_other_av_skips_per_second", getAvgNumOtherAvatarSkipsPerSecond());
+    stats.write("total_num_out_of_order_sends", _numOutOfOrderSends);
+
+    stats.write(OUTBOUND_AVATAR_DATA_STATS_KEY, getOutboundAvatarDataKbps());
+    stats.write(INBOUND_AVATAR_DATA_STATS_KEY, _avatar->getAverageBytesReceivedPerSecond() / (float) BYTES_PER_KILOBIT);
+
+    stats.write("av_data_receive_rate", _avatar->getReceiveRate());
+    stats.write("recent_other_av_in_view", _recentOtherAvatarsInView);
+    stats.write("recent_other_av_out_of_view", _recentOtherAvatarsOutOfView);
 }
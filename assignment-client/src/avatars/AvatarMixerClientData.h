@@ -23,6 +23,7 @@
 
 #include <AvatarData.h>
 #include <NodeData.h>
+#include <NodeStatsCodec.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PortableHighResolutionClock.h>
@@ -87,7 +88,7 @@ public:
     float getOutboundAvatarDataKbps() const
         { return _avgOtherAvatarDataRate.getAverageSampleValuePerSecond() / (float) BYTES_PER_KILOBIT; }
 
-    void loadJSONStats(QJsonObject& jsonObject) const;
+    void writeStats(NodeStatsEncoder& stats) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getPosition() : glm::vec3(0); }
     glm::vec3 getGlobalBoundingBoxCorner() const { return _avatar ? _avatar->getGlobalBoundingBoxCorner() : glm::vec3(0); }
@@ -68,19 +68,21 @@ void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> me
 }
 
 void MessagesMixer::sendStatsPacket() {
-    QJsonObject statsObject, messagesMixerObject;
+    auto& stats = beginStatsPacket();
 
     // add stats for each listerner
+    stats.beginObject("messages");
     DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
-        QJsonObject clientStats;
-        clientStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidStringWithoutCurlyBraces(node->getUUID());
-        clientStats["outbound_kbps"] = node->getOutboundBandwidth();
-        clientStats["inbound_kbps"] = node->getInboundBandwidth();
-        messagesMixerObject[uuidStringWithoutCurlyBraces(node->getUUID())] = clientStats;
+        QString uuidString = uuidStringWithoutCurlyBraces(node->getUUID());
+        stats.beginObject(uuidString);
+        stats.write(USERNAME_UUID_REPLACEMENT_STATS_KEY, uuidString);
+        stats.write("outbound_kbps", node->getOutboundBandwidth());
+        stats.write("inbound_kbps", node->getInboundBandwidth());
+        stats.endObject();
     });
+    stats.endObject();
 
-    statsObject["messages"] = messagesMixerObject;
-    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket();
 }
 
 void MessagesMixer::run() {
@@ -1467,80 +1467,81 @@ QString OctreeServer::getStatusLink() {
 }
 
 void OctreeServer::sendStatsPacket() {
+    auto& stats = beginStatsPacket();
+    stats.beginObject(QString(getMyServerName()) + "Server");
+
     // Stats Array 1
-    QJsonObject threadsStats;
+    stats.beginObject("1. misc");
+    stats.write("1. configuration", getConfiguration());
+    stats.write("2. detailed_stats_url", getStatusLink());
+    stats.write("3. uptime", getUptime());
+    stats.write("4. persistFileLoadTime", getFileLoadTime());
+    stats.write("5. clients", getCurrentClientCount());
+
     quint64 oneSecondAgo = usecTimestampNow() - USECS_PER_SECOND;
-    threadsStats["1. processing"] = (double)howManyThreadsDidProcess(oneSecondAgo);
-    threadsStats["2. packetDistributor"] = (double)howManyThreadsDidPacketDistributor(oneSecondAgo);
-    threadsStats["3. handlePacektSend"] = (double)howManyThreadsDidHandlePacketSend(oneSecondAgo);
-    threadsStats["4. writeDatagram"] = (double)howManyThreadsDidCallWriteDatagram(oneSecondAgo);
-    
-    QJsonObject statsArray1;
-    statsArray1["1. configuration"] = getConfiguration();
-    statsArray1["2. detailed_stats_url"] = getStatusLink();
-    statsArray1["3. uptime"] = getUptime();
-    statsArray1["4. persistFileLoadTime"] = getFileLoadTime();
-    statsArray1["5. clients"] = getCurrentClientCount();
-    statsArray1["6. threads"] = threadsStats;
-    
+    stats.beginObject("6. threads");
+    stats.write("1. processing", howManyThreadsDidProcess(oneSecondAgo));
+    stats.write("2. packetDistributor", howManyThreadsDidPacketDistributor(oneSecondAgo));
+    stats.write("3. handlePacektSend", howManyThreadsDidHandlePacketSend(oneSecondAgo));
+    stats.write("4. writeDatagram", howManyThreadsDidCallWriteDatagram(oneSecondAgo));
+    stats.endObject();
+    stats.endObject();
+
     // Octree Stats
-    QJsonObject octreeStats;
-    octreeStats["1. elementCount"] = (double)OctreeElement::getNodeCount();
-    octreeStats["2. internalElementCount"] = (double)OctreeElement::getInternalNodeCount();
-    octreeStats["3. leafElementCount"] = (double)OctreeElement::getLeafNodeCount();
-    
-    // Stats Object 2
-    QJsonObject dataObject1;
-    dataObject1["1. totalPackets"] = (double)OctreeSendThread::_totalPackets;
-    dataObject1["2. totalBytes"] = (double)OctreeSendThread::_totalBytes;
-    dataObject1["3. totalBytesWasted"] = (double)OctreeSendThread::_totalWastedBytes;
-    dataObject1["4. totalBytesOctalCodes"] = (double)OctreePacketData::getTotalBytesOfOctalCodes();
-    dataObject1["5. totalBytesBitMasks"] = (double)OctreePacketData::getTotalBytesOfBitMasks();
-    dataObject1["6. totalBytesBitMasks"] = (double)OctreePacketData::getTotalBytesOfColor();
-
-    QJsonObject timingArray1;
-    timingArray1["1. avgLoopTime"] = getAverageLoopTime();
-    timingArray1["2. avgInsideTime"] = getAverageInsideTime();
-    timingArray1["3. avgTreeLockTime"] = getAverageTreeWaitTime();
-    timingArray1["4. avgEncodeTime"] = getAverageEncodeTime();
-    timingArray1["5. avgCompressAndWriteTime"] = getAverageCompressAndWriteTime();
-    timingArray1["6. avgSendTime"] = getAveragePacketSendingTime();
-    timingArray1["7. nodeWaitTime"] = getAverageNodeWaitTime();
-    
-    QJsonObject statsObject2;
-    statsObject2["data"] = dataObject1;
-    statsObject2["timing"] = timingArray1;
+    stats.beginObject("2. octree");
+    stats.write("1. elementCount", OctreeElement::getNodeCount());
+    stats.write("2. internalElementCount", OctreeElement::getInternalNodeCount());
+    stats.write("3. leafElementCount", OctreeElement::getLeafNodeCount());
+    stats.endObject();
 
-    QJsonObject dataArray2;
-    QJsonObject timingArray2;
+    // Stats Object 2
+    stats.beginObject("3. outbound");
+
+    stats.beginObject("data");
+    stats.write("1. totalPackets", (double)OctreeSendThread::_totalPackets);
+    stats.write("2. totalBytes", (double)OctreeSendThread::_totalBytes);
+    stats.write("3. totalBytesWasted", (double)OctreeSendThread::_totalWastedBytes);
+    stats.write("4. totalBytesOctalCodes", OctreePacketData::getTotalBytesOfOctalCodes());
+    stats.write("5. totalBytesBitMasks", OctreePacketData::getTotalBytesOfBitMasks());
+    stats.write("6. totalBytesBitMasks", OctreePacketData::getTotalBytesOfColor());
+    stats.endObject();
+
+    stats.beginObject("timing");
+    stats.write("1. avgLoopTime", getAverageLoopTime());
+    stats.write("2. avgInsideTime", getAverageInsideTime());
+    stats.write("3. avgTreeLockTime", getAverageTreeWaitTime());
+    stats.write("4. avgEncodeTime", getAverageEncodeTime());
+    stats.write("5. avgCompressAndWriteTime", getAverageCompressAndWriteTime());
+    stats.write("6. avgSendTime", getAveragePacketSendingTime());
+    stats.write("7. nodeWaitTime", getAverageNodeWaitTime());
+    stats.endObject();
+
+    stats.endObject();
 
     // Stats Object 3
+    stats.beginObject("4. inbound");
     if (_octreeInboundPacketProcessor) {
-        dataArray2["1. packetQueue"] = (double)_octreeInboundPacketProcessor->packetsToProcessCount();
-        dataArray2["2. totalPackets"] = (double)_octreeInboundPacketProcessor->getTotalPacketsProcessed();
-        dataArray2["3. totalElements"] = (double)_octreeInboundPacketProcessor->getTotalElementsProcessed();
-
-        timingArray2["1. avgTransitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageTransitTimePerPacket();
-        timingArray2["2. avgProcessTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerPacket();
-        timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
-        timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
-        timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        stats.beginObject("data");
+        stats.write("1. packetQueue", _octreeInboundPacketProcessor->packetsToProcessCount());
+        stats.write("2. totalPackets", _octreeInboundPacketProcessor->getTotalPacketsProcessed());
+        stats.write("3. totalElements", _octreeInboundPacketProcessor->getTotalElementsProcessed());
+        stats.endObject();
+
+        stats.beginObject("timing");
+        stats.write("1. avgTransitTimePerPacket", _octreeInboundPacketProcessor->getAverageTransitTimePerPacket());
+        stats.write("2. avgProcessTimePerPacket", _octreeInboundPacketProcessor->getAverageProcessTimePerPacket());
+        stats.write("3. avgLockWaitTimePerPacket", _octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket());
+        stats.write("4. avgProcessTimePerElement", _octreeInboundPacketProcessor->getAverageProcessTimePerElement());
+        stats.write("5. avgLockWaitTimePerElement", _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement());
+        stats.endObject();
+    } else {
+        stats.write("data", QJsonObject());
+        stats.write("timing", QJsonObject());
     }
-    
-    QJsonObject statsObject3;
-    statsObject3["data"] = dataArray2;
-    statsObject3["timing"] = timingArray2;
-    
-    // Merge everything
-    QJsonObject jsonArray;
-    jsonArray["1. misc"] = statsArray1;
-    jsonArray["2. octree"] = octreeStats;
-    jsonArray["3. outbound"] = statsObject2;
-    jsonArray["4. inbound"] = statsObject3;
-    
-    QJsonObject statsObject;
-    statsObject[QString(getMyServerName()) + "Server"] = jsonArray;
-    addPacketStatsAndSendStatsPacket(statsObject);
+    stats.endObject();
+
+    stats.endObject();
+    addPacketStatsAndSendStatsPacket();
 }
 
 QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidProcess;
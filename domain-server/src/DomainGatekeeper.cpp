@@ -15,8 +15,12 @@
 #include <openssl/rsa.h>
 #include <openssl/x509.h>
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFutureWatcher>
+
 #include <AccountManager.h>
 #include <Assignment.h>
+#include <SharedUtil.h>
 
 #include "DomainServer.h"
 #include "DomainServerNodeData.h"
@@ -104,10 +108,14 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         node = processAgentConnectRequest(nodeConnection, username, usernameSignature);
     }
 
+    finishConnectRequest(nodeConnection, node);
+}
+
+void DomainGatekeeper::finishConnectRequest(const NodeConnectionData& nodeConnection, const SharedNodePointer& node) {
     if (node) {
         // set the sending sock addr and node interest set on this node
         DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-        nodeData->setSendingSockAddr(message->getSenderSockAddr());
+        nodeData->setSendingSockAddr(nodeConnection.senderSockAddr);
 
         // guard against patched agents asking to hear about other agents
         auto safeInterestSet = nodeConnection.interestList.toSet();
@@ -119,14 +127,14 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         nodeData->setPlaceName(nodeConnection.placeName);
 
         qDebug() << "Allowed connection from node" << uuidStringWithoutCurlyBraces(node->getUUID())
-            << "on" << message->getSenderSockAddr() << "with MAC" << nodeConnection.hardwareAddress
+            << "on" << nodeConnection.senderSockAddr << "with MAC" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint;
 
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
         emit connectedNode(node);
     } else {
-        qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
+        qDebug() << "Refusing connection from node at" << nodeConnection.senderSockAddr
             << "with hardware address" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint;
     }
@@ -291,7 +299,13 @@ void DomainGatekeeper::updateNodePermissions() {
             userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        // other nodes hear about permission changes through the node list, which only carries the permission flags,
+        // so only a change to those needs a new list version
+        bool permissionsChanged = node->getPermissions().permissions != userPerms.permissions;
         node->setPermissions(userPerms);
+        if (permissionsChanged) {
+            _server->bumpNodeListVersion(node);
+        }
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
@@ -391,17 +405,27 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             qDebug() << "stalling login because we have no username-signature:" << username;
 #endif
             return SharedNodePointer();
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username;
         } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
+            auto verification = verifyUserSignature(username, usernameSignature, nodeConnection);
+
+            if (verification == SignatureVerification::Verified) {
+                // they sent us a username and the signature verifies it
+                getGroupMemberships(username);
+                verifiedUsername = username;
+            } else if (verification == SignatureVerification::Pending) {
+                // the signature is being checked on the verification pool, we'll pick this request back up once it's done
 #ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
+                qDebug() << "stalling login while signature verification is queued:" << username;
 #endif
-            return SharedNodePointer();
+                return SharedNodePointer();
+            } else {
+                // they sent us a username, but it didn't check out
+                requestUserPublicKey(username);
+#ifdef WANT_DEBUG
+                qDebug() << "stalling login because signature verification failed:" << username;
+#endif
+                return SharedNodePointer();
+            }
         }
     }
 
@@ -510,55 +534,59 @@ SharedNodePointer DomainGatekeeper::addVerifiedNodeFromConnectRequest(const Node
     return newNode;
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const HifiSockAddr& senderSockAddr) {
-    // it's possible this user can be allowed to connect, but we need to check their username signature
+DomainGatekeeper::SignatureVerification DomainGatekeeper::verifyUserSignature(const QString& username,
+                                                                             const QByteArray& usernameSignature,
+                                                                             const NodeConnectionData& nodeConnection) {
+    const HifiSockAddr& senderSockAddr = nodeConnection.senderSockAddr;
     auto lowerUsername = username.toLower();
-    QByteArray publicKeyArray = _userPublicKeys.value(lowerUsername);
 
-    const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
+    // if the verification pool already checked this signature, use that result
+    auto completed = _completedSignatureVerifications.find(lowerUsername);
+    if (completed != _completedSignatureVerifications.end() && completed->usernameSignature == usernameSignature) {
+        bool verified = completed->verified;
+        _completedSignatureVerifications.erase(completed);
 
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
-        // if we do have a public key for the user, check for a signature match
+        if (verified) {
+            qDebug() << "Username signature matches for" << username;
 
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
+            // remove connection token before we return
+            _connectionTokenHash.remove(username);
 
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+            return SignatureVerification::Verified;
+        } else if (!senderSockAddr.isNull()) {
+            qDebug() << "Error decrypting username signature for " << username << "- denying connection.";
+            sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginError);
+        }
 
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
+        requestUserPublicKey(username); // no joy.  maybe next time?
+        return SignatureVerification::Failed;
+    }
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+    if (_pendingSignatureVerifications.contains(lowerUsername)) {
+        // we're already verifying a signature for this user - hold on to the latest request so it's the one we answer
+        _pendingSignatureVerifications[lowerUsername] = { nodeConnection, username, usernameSignature };
+        return SignatureVerification::Pending;
+    }
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+    // it's possible this user can be allowed to connect, but we need to check their username signature
+    QByteArray publicKeyArray = _userPublicKeys.value(lowerUsername);
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+    const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-                return true;
+    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
+        // if we do have a public key for the user, check for a signature match
+        RSAPointer rsaPublicKey = parsedPublicKeyForUser(lowerUsername, publicKeyArray);
 
-            } else {
-                if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting username signature for " << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginError);
-                }
+        if (rsaPublicKey) {
+            QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
+            QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
+                                                                    QCryptographicHash::Sha256);
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
-            }
+            _pendingSignatureVerifications[lowerUsername] = { nodeConnection, username, usernameSignature };
+            queueSignatureVerification(lowerUsername, rsaPublicKey, usernameWithToken, usernameSignature);
 
+            return SignatureVerification::Pending;
         } else {
 
             // we can't let this user in since we couldn't convert their public key to an RSA key we could use
@@ -575,7 +603,87 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
     }
 
     requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    return SignatureVerification::Failed;
+}
+
+DomainGatekeeper::RSAPointer DomainGatekeeper::parsedPublicKeyForUser(const QString& lowerUsername,
+                                                                     const QByteArray& publicKeyArray) {
+    // re-use the parsed key unless the public key for this user has changed since we parsed it
+    auto it = _parsedUserPublicKeys.find(lowerUsername);
+    if (it != _parsedUserPublicKeys.end() && it->publicKeyArray == publicKeyArray) {
+        return it->rsaPublicKey;
+    }
+
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
+
+    // load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+    if (!rsaPublicKey) {
+        _parsedUserPublicKeys.remove(lowerUsername);
+        return RSAPointer();
+    }
+
+    RSAPointer result(rsaPublicKey, RSA_free);
+    _parsedUserPublicKeys[lowerUsername] = { publicKeyArray, result };
+    return result;
+}
+
+void DomainGatekeeper::queueSignatureVerification(const QString& lowerUsername, RSAPointer publicKey,
+                                                  const QByteArray& usernameWithToken, const QByteArray& usernameSignature) {
+    quint64 queuedTimestamp = usecTimestampNow();
+
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [=] {
+        handleSignatureVerificationResult(lowerUsername, usernameSignature, watcher->result(), queuedTimestamp);
+        watcher->deleteLater();
+    });
+
+    // the RSA key is only read by RSA_verify, so the shared parsed key is safe to use from the pool
+    watcher->setFuture(QtConcurrent::run(&_signatureVerificationPool, [=]() -> bool {
+        int decryptResult = RSA_verify(NID_sha256,
+                                       reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
+                                       usernameWithToken.size(),
+                                       reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
+                                       usernameSignature.size(),
+                                       publicKey.get());
+        return decryptResult == 1;
+    }));
+}
+
+void DomainGatekeeper::handleSignatureVerificationResult(const QString& lowerUsername, const QByteArray& usernameSignature,
+                                                         bool verified, quint64 queuedTimestamp) {
+    quint64 elapsedUsecs = usecTimestampNow() - queuedTimestamp;
+    ++_numSignatureVerifications;
+    _totalSignatureVerificationUsecs += elapsedUsecs;
+    _maxSignatureVerificationUsecs = std::max(_maxSignatureVerificationUsecs, elapsedUsecs);
+
+    _completedSignatureVerifications[lowerUsername] = { usernameSignature, verified };
+
+    auto pendingIt = _pendingSignatureVerifications.find(lowerUsername);
+    if (pendingIt == _pendingSignatureVerifications.end()) {
+        return;
+    }
+
+    // replay the latest connect request from this user now that we have a result for it
+    PendingSignatureVerification pending = pendingIt.value();
+    _pendingSignatureVerifications.erase(pendingIt);
+
+    SharedNodePointer node = processAgentConnectRequest(pending.nodeConnection, pending.username, pending.usernameSignature);
+    finishConnectRequest(pending.nodeConnection, node);
+}
+
+QJsonObject DomainGatekeeper::getStatsJSON() const {
+    QJsonObject statsObject;
+
+    statsObject["signature_verification_queue_depth"] = _pendingSignatureVerifications.size();
+    statsObject["signature_verification_threads"] = _signatureVerificationPool.maxThreadCount();
+    statsObject["signature_verifications"] = (double)_numSignatureVerifications;
+    statsObject["signature_verification_avg_usecs"] = _numSignatureVerifications > 0
+        ? (double)_totalSignatureVerificationUsecs / _numSignatureVerifications : 0.0;
+    statsObject["signature_verification_max_usecs"] = (double)_maxSignatureVerificationUsecs;
+    statsObject["cached_public_keys"] = _parsedUserPublicKeys.size();
+
+    return statsObject;
 }
 
 bool DomainGatekeeper::isWithinMaxCapacity() {
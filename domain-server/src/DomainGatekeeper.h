@@ -14,11 +14,16 @@
 #ifndef hifi_DomainGatekeeper_h
 #define hifi_DomainGatekeeper_h
 
+#include <memory>
 #include <unordered_map>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QNetworkReply>
 
+#include <openssl/ossl_typ.h>
+
 #include <DomainHandler.h>
 
 #include <NLPacket.h>
@@ -43,6 +48,8 @@ public:
     
     void removeICEPeer(const QUuid& peerUUID) { _icePeers.remove(peerUUID); }
 
+    QJsonObject getStatsJSON() const;
+
     static void sendProtocolMismatchConnectionDenial(const HifiSockAddr& senderSockAddr);
 public slots:
     void processConnectRequestPacket(QSharedPointer<ReceivedMessage> message);
@@ -78,9 +85,23 @@ private:
                                                  const QByteArray& usernameSignature);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection,
                                                         QUuid nodeID = QUuid());
-    
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const HifiSockAddr& senderSockAddr);
+    void finishConnectRequest(const NodeConnectionData& nodeConnection, const SharedNodePointer& node);
+
+    enum class SignatureVerification {
+        Verified,
+        Failed,
+        Pending
+    };
+
+    SignatureVerification verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
+                                              const NodeConnectionData& nodeConnection);
+
+    using RSAPointer = std::shared_ptr<RSA>;
+    RSAPointer parsedPublicKeyForUser(const QString& lowerUsername, const QByteArray& publicKeyArray);
+    void queueSignatureVerification(const QString& lowerUsername, RSAPointer publicKey,
+                                    const QByteArray& usernameWithToken, const QByteArray& usernameSignature);
+    void handleSignatureVerificationResult(const QString& lowerUsername, const QByteArray& usernameSignature,
+                                           bool verified, quint64 queuedTimestamp);
     bool isWithinMaxCapacity();
     
     bool shouldAllowConnectionFromNode(const QString& username, const QByteArray& usernameSignature,
@@ -107,6 +128,30 @@ private:
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
 
+    // RSA_verify runs on a worker pool so that reconnect storms don't stall the main thread,
+    // connect requests for a user are parked until the verification for them completes
+    struct ParsedPublicKey {
+        QByteArray publicKeyArray;
+        RSAPointer rsaPublicKey;
+    };
+    struct PendingSignatureVerification {
+        NodeConnectionData nodeConnection;
+        QString username;
+        QByteArray usernameSignature;
+    };
+    struct CompletedSignatureVerification {
+        QByteArray usernameSignature;
+        bool verified;
+    };
+    QHash<QString, ParsedPublicKey> _parsedUserPublicKeys;
+    QHash<QString, PendingSignatureVerification> _pendingSignatureVerifications;
+    QHash<QString, CompletedSignatureVerification> _completedSignatureVerifications;
+    QThreadPool _signatureVerificationPool;
+
+    quint64 _numSignatureVerifications { 0 };
+    quint64 _totalSignatureVerificationUsecs { 0 };
+    quint64 _maxSignatureVerificationUsecs { 0 };
+
     NodePermissions setPermissionsForUser(bool isLocalUser, QString verifiedUsername, const QHostAddress& senderAddress, 
                                           const QString& hardwareAddress, const QUuid& machineFingerprint);
 
@@ -11,6 +11,7 @@
 
 #include "DomainServer.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
 
@@ -82,6 +83,9 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     Setting::init();
 
     qDebug() << "Setting up domain-server";
+
+    // seed the node list version from the clock so that versions stay increasing across domain-server restarts
+    _nodeListVersion = _oldestDeltaBaseVersion = usecTimestampNow();
     qDebug() << "[VERSION] Build sequence:" << qPrintable(applicationVersion());
     qDebug() << "[VERSION] MODIFIED_ORGANIZATION:" << BuildInfo::MODIFIED_ORGANIZATION;
     qDebug() << "[VERSION] VERSION:" << BuildInfo::VERSION;
@@ -527,6 +531,7 @@ void DomainServer::setupNodeListAndAssignments() {
     packetReceiver.registerListener(PacketType::DomainListRequest, this, "processListRequestPacket");
     packetReceiver.registerListener(PacketType::DomainServerPathQuery, this, "processPathQueryPacket");
     packetReceiver.registerListener(PacketType::NodeJsonStats, this, "processNodeJSONStatsPacket");
+    packetReceiver.registerListener(PacketType::NodeProfileReply, this, "processNodeProfileReplyPacket");
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest, this, "processNodeDisconnectRequestPacket");
 
     // NodeList won't be available to the settings manager when it is created, so call registerListener here
@@ -543,6 +548,11 @@ void DomainServer::setupNodeListAndAssignments() {
     packetReceiver.registerListener(PacketType::ICEServerHeartbeatDenied, this, "processICEServerHeartbeatDenialPacket");
     packetReceiver.registerListener(PacketType::ICEServerHeartbeatACK, this, "processICEServerHeartbeatACK");
 
+    // the domain-server can capture a profile of itself too
+    connect(&_profileCapture, &ProfileCapture::finished, this, [this](QByteArray trace) {
+        respondWithProfileCapture(QUuid(), "domain-server", trace);
+    });
+
     // add whatever static assignments that have been parsed to the queue
     addStaticAssignmentsToQueue();
 
@@ -834,11 +844,10 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
-    // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    // the version of the node list this node last received in full
+    quint64 lastKnownListVersion = 0;
+    packetStream >> lastKnownListVersion;
 
-    // update the NodeInterestSet in case there have been any changes
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
     // guard against patched agents asking to hear about other agents
@@ -847,12 +856,26 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
+    // if the sockets or interest set changed then other nodes need to hear about it, and this node needs a full list
+    bool hasChanged = sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr
+        || nodeData->getNodeInterestSet() != safeInterestSet;
+
+    // update this node's sockets in case they have changed
+    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+
+    // update the NodeInterestSet in case there have been any changes
     nodeData->setNodeInterestSet(safeInterestSet);
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    if (hasChanged) {
+        bumpNodeListVersion(sendingNode);
+    }
+
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), lastKnownListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -950,6 +973,8 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(newNode->getLinkedData());
 
+    bumpNodeListVersion(newNode);
+
     // reply back to the user with a PacketType::DomainList
     sendDomainListToNode(newNode, nodeData->getSendingSockAddr());
 
@@ -962,51 +987,112 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+void DomainServer::bumpNodeListVersion(const SharedNodePointer& node) {
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (nodeData) {
+        nodeData->setNodeListVersion(++_nodeListVersion);
+    }
+}
+
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint64 lastKnownListVersion) {
+    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2
+        + sizeof(quint64) + sizeof(quint64) + sizeof(quint32) + sizeof(quint32);
+
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    // we can only send the changes since lastKnownListVersion if we still have the removals since then,
+    // and if nothing about this node (interest set, permissions) changed that would alter what it should see
+    bool isDelta = lastKnownListVersion != 0
+        && lastKnownListVersion >= _oldestDeltaBaseVersion
+        && lastKnownListVersion <= _nodeListVersion
+        && nodeData->getNodeListVersion() <= lastKnownListVersion;
+
+    // gather the entries for this list first, the total goes in the header of every packet
+    std::vector<SharedNodePointer> listedNodes;
+    std::vector<QUuid> removedNodeIDs;
+
+    if (isDelta) {
+        for (auto it = _removedNodes.rbegin(); it != _removedNodes.rend() && it->version > lastKnownListVersion; ++it) {
+            removedNodeIDs.push_back(it->uuid);
+        }
+    }
+
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+    if (nodeInterestSet.size() > 0 && nodeData->isAuthenticated()) {
+        // if this authenticated node has any interest types, send back those nodes as well
+        limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+            if (otherNode->getUUID() == node->getUUID()) {
+                return;
+            }
+
+            if (isDelta) {
+                auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                if (!otherNodeData || otherNodeData->getNodeListVersion() <= lastKnownListVersion) {
+                    // nothing new about this node since the requesting node's list
+                    return;
+                }
+
+                if (!isInInterestSet(node, otherNode)) {
+                    // this node changed in a way that makes it no longer interesting (e.g. permissions)
+                    removedNodeIDs.push_back(otherNode->getUUID());
+                    return;
+                }
+
+                listedNodes.push_back(otherNode);
+            } else if (isInInterestSet(node, otherNode)) {
+                listedNodes.push_back(otherNode);
+            }
+        });
+    }
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
 
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << _nodeListVersion;
+    extendedHeaderStream << (isDelta ? lastKnownListVersion : (quint64)0);
+    extendedHeaderStream << _nextDomainListReplyID++;
+    extendedHeaderStream << (quint32)(removedNodeIDs.size() + listedNodes.size());
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    // every entry carries its index in the reply, so the node can tell lost and duplicated packets apart
+    quint32 entryIndex = 0;
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+    // removals go first so that a node removed and re-added with the same UUID ends up present
+    for (const auto& removedNodeID : removedNodeIDs) {
+        domainListPackets->startSegment();
+        domainListStream << entryIndex++ << DomainListEntryType::RemovedNode << removedNodeID;
+        domainListPackets->endSegment();
+    }
 
-    if (nodeInterestSet.size() > 0) {
+    for (const auto& otherNode : listedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+        domainListStream << entryIndex++ << DomainListEntryType::Node;
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -1545,10 +1631,87 @@ void DomainServer::sendHeartbeatToIceServer() {
 void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
     auto nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
     if (nodeData) {
-        nodeData->updateJSONStats(packetList->getMessage());
+        nodeData->updateStats(packetList->getMessage());
     }
 }
 
+void DomainServer::processNodeProfileReplyPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    bool hasTrace;
+    packetList->readPrimitive(&hasTrace);
+
+    QString name = NodeType::getNodeTypeName(sendingNode->getType()).toLower().replace(' ', '-');
+    respondWithProfileCapture(sendingNode->getUUID(), name, hasTrace ? packetList->readAll() : QByteArray());
+}
+
+void DomainServer::startProfileCapture(HTTPConnection* connection, const QUrl& url, const QUuid& nodeID) {
+    const int DEFAULT_CAPTURE_SECONDS = 10;
+
+    bool isValidSeconds = false;
+    int seconds = QUrlQuery(url).queryItemValue("seconds").toInt(&isValidSeconds);
+    if (!isValidSeconds) {
+        seconds = DEFAULT_CAPTURE_SECONDS;
+    }
+    seconds = std::max(1, std::min(seconds, ProfileCapture::MAX_CAPTURE_SECONDS));
+
+    if (_pendingProfileCaptures.contains(nodeID)) {
+        connection->respond(HTTPConnection::StatusCode400, "A capture is already in progress.");
+        return;
+    }
+
+    if (nodeID.isNull()) {
+        if (!_profileCapture.start(seconds)) {
+            connection->respond(HTTPConnection::StatusCode500, "The capture could not be started.");
+            return;
+        }
+    } else {
+        // captures are only made of assignment clients, never of a user's interface
+        auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+        auto matchingNode = limitedNodeList->nodeWithUUID(nodeID);
+        if (!matchingNode || matchingNode->getType() == NodeType::Agent) {
+            connection->respond(HTTPConnection::StatusCode404, "Resource not found.");
+            return;
+        }
+
+        auto profileRequestPacket = NLPacket::create(PacketType::NodeProfileRequest, sizeof(quint16), true);
+        profileRequestPacket->writePrimitive((quint16)seconds);
+        limitedNodeList->sendPacket(std::move(profileRequestPacket), *matchingNode);
+    }
+
+    QPointer<HTTPConnection> pendingConnection { connection };
+    _pendingProfileCaptures.insert(nodeID, pendingConnection);
+
+    // don't keep the request open forever if the node doesn't know about captures
+    const int REPLY_TIMEOUT_SECONDS = 30;
+    QTimer::singleShot((seconds + REPLY_TIMEOUT_SECONDS) * (int)MSECS_PER_SECOND, this, [this, nodeID, pendingConnection] {
+        auto it = _pendingProfileCaptures.find(nodeID);
+        if (it != _pendingProfileCaptures.end() && it.value() == pendingConnection) {
+            _pendingProfileCaptures.erase(it);
+            if (pendingConnection) {
+                pendingConnection->respond(HTTPConnection::StatusCode500, "The node did not reply with a capture.");
+            }
+        }
+    });
+}
+
+void DomainServer::respondWithProfileCapture(const QUuid& nodeID, const QString& name, const QByteArray& trace) {
+    QPointer<HTTPConnection> connection = _pendingProfileCaptures.take(nodeID);
+    if (!connection) {
+        // the request timed out, or whoever made it went away
+        return;
+    }
+
+    if (trace.isEmpty()) {
+        connection->respond(HTTPConnection::StatusCode500, "The capture could not be made, the node may already be tracing.");
+        return;
+    }
+
+    // the trace can be loaded as is in chrome://tracing
+    QString filename = QString("%1-%2.json.gz").arg(name).arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+    Headers headers;
+    headers.insert("Content-Disposition", QString("attachment; filename=\"%1\"").arg(filename).toUtf8());
+    connection->respond(HTTPConnection::StatusCode200, trace, "application/gzip", headers);
+}
+
 QJsonObject DomainServer::jsonForSocket(const HifiSockAddr& socket) {
     QJsonObject socketJSON;
 
@@ -1640,6 +1803,7 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
     const QString URI_ASSIGNMENT = "/assignment";
     const QString URI_NODES = "/nodes";
     const QString URI_SETTINGS = "/settings";
+    const QString URI_PROFILE_CAPTURE = "/profile-capture";
 
     const QString UUID_REGEX_STRING = "[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}";
 
@@ -1774,6 +1938,12 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             QJsonDocument transactionsDocument(rootObject);
             connection->respond(HTTPConnection::StatusCode200, transactionsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == "/gatekeeper.json") {
+            // connection gatekeeping stats, e.g. username signature verification queue depth and latency
+            QJsonDocument gatekeeperDocument(_gatekeeper.getStatsJSON());
+            connection->respond(HTTPConnection::StatusCode200, gatekeeperDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+
             return true;
         } else if (url.path() == QString("%1.json").arg(URI_NODES)) {
             // setup the JSON
@@ -1794,8 +1964,22 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             // send the response
             connection->respond(HTTPConnection::StatusCode200, nodesDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == URI_PROFILE_CAPTURE) {
+            // a capture of the domain-server itself
+            startProfileCapture(connection, url, QUuid());
             return true;
         } else {
+            // check if this is for a profile capture of a node
+            const QString NODE_PROFILE_CAPTURE_REGEX_STRING =
+                QString("\\%1\\/(%2)\\%3\\/?$").arg(URI_NODES).arg(UUID_REGEX_STRING).arg(URI_PROFILE_CAPTURE);
+            QRegExp nodeProfileCaptureRegex(NODE_PROFILE_CAPTURE_REGEX_STRING);
+
+            if (nodeProfileCaptureRegex.indexIn(url.path()) != -1) {
+                startProfileCapture(connection, url, QUuid(nodeProfileCaptureRegex.cap(1)));
+                return true;
+            }
+
             // check if this is for json stats for a node
             const QString NODE_JSON_REGEX_STRING = QString("\\%1\\/(%2).json\\/?$").arg(URI_NODES).arg(UUID_REGEX_STRING);
             QRegExp nodeShowRegex(NODE_JSON_REGEX_STRING);
@@ -2188,9 +2372,24 @@ void DomainServer::nodeAdded(SharedNodePointer node) {
 }
 
 void DomainServer::nodeKilled(SharedNodePointer node) {
+    // a capture this node was making will never come
+    QPointer<HTTPConnection> pendingProfileCapture = _pendingProfileCaptures.take(node->getUUID());
+    if (pendingProfileCapture) {
+        pendingProfileCapture->respond(HTTPConnection::StatusCode500, "The node went away before replying with a capture.");
+    }
+
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.removeICEPeer(node->getUUID());
 
+    // remember the removal so it can be included in delta node lists, nodes further behind than our
+    // history get a full list
+    static const size_t MAX_REMOVED_NODE_HISTORY = 1024;
+    _removedNodes.push_back({ ++_nodeListVersion, node->getUUID() });
+    if (_removedNodes.size() > MAX_REMOVED_NODE_HISTORY) {
+        _oldestDeltaBaseVersion = _removedNodes.front().version;
+        _removedNodes.pop_front();
+    }
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
@@ -12,9 +12,12 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
+#include <QtCore/QPointer>
 #include <QtCore/QQueue>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QStringList>
@@ -24,6 +27,7 @@
 #include <Assignment.h>
 #include <HTTPSConnection.h>
 #include <LimitedNodeList.h>
+#include <ProfileCapture.h>
 
 #include "DomainGatekeeper.h"
 #include "DomainMetadata.h"
@@ -69,6 +73,7 @@ public slots:
     void processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> packet);
     void processListRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
+    void processNodeProfileReplyPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
     void processPathQueryPacket(QSharedPointer<ReceivedMessage> packet);
     void processNodeDisconnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message);
@@ -130,7 +135,9 @@ private:
 
     void handleKillNode(SharedNodePointer nodeToKill);
 
-    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr,
+                              quint64 lastKnownListVersion = 0);
+    void bumpNodeListVersion(const SharedNodePointer& node);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -153,6 +160,9 @@ private:
 
     bool isAuthenticatedRequest(HTTPConnection* connection, const QUrl& url);
 
+    void startProfileCapture(HTTPConnection* connection, const QUrl& url, const QUuid& nodeID);
+    void respondWithProfileCapture(const QUuid& nodeID, const QString& name, const QByteArray& trace);
+
     QNetworkReply* profileRequestGivenTokenReply(QNetworkReply* tokenReply);
     Headers setupCookieHeadersFromProfileReply(QNetworkReply* profileReply);
 
@@ -168,6 +178,10 @@ private:
     HTTPManager _httpManager;
     HTTPSManager* _httpsManager;
 
+    // the requests waiting for a profile capture, by node, the domain-server's own capture is under a null ID
+    QHash<QUuid, QPointer<HTTPConnection>> _pendingProfileCaptures;
+    ProfileCapture _profileCapture { this };
+
     QHash<QUuid, SharedAssignmentPointer> _allAssignments;
     QQueue<SharedAssignmentPointer> _unfulfilledAssignments;
     TransactionHash _pendingAssignmentCredits;
@@ -197,6 +211,18 @@ private:
     QTimer* _metaverseHeartbeatTimer { nullptr };
     QTimer* _metaverseGroupCacheTimer { nullptr };
 
+    // every add, change or removal of a node bumps the node list version, so that list requests can
+    // be answered with only what changed since the version the requesting node last saw
+    struct RemovedNode {
+        quint64 version;
+        QUuid uuid;
+    };
+    quint64 _nodeListVersion { 0 };
+    quint64 _oldestDeltaBaseVersion { 0 };
+    // tags the packets of each DomainList reply, so nodes can tell replies with the same list version apart
+    quint32 _nextDomainListReplyID { 0 };
+    std::deque<RemovedNode> _removedNodes;
+
     QList<QHostAddress> _iceServerAddresses;
     QSet<QHostAddress> _failedIceServerAddresses;
     int _iceAddressLookupID { -1 };
@@ -25,13 +25,22 @@ DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
 
-void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
-    auto document = QJsonDocument::fromBinaryData(statsByteArray);
-    Q_ASSERT(document.isObject());
-    _statsJSONObject = overrideValuesIfNeeded(document.object());
+void DomainServerNodeData::updateStats(const QByteArray& encodedStats) {
+    if (_statsDecoder.decode(encodedStats)) {
+        _statsJSONObjectDirty = true;
+    }
+}
+
+QJsonObject DomainServerNodeData::getStatsJSONObject() const {
+    if (_statsJSONObjectDirty) {
+        _statsJSONObject = overrideValuesIfNeeded(_statsDecoder.toJSON());
+        _statsJSONObjectDirty = false;
+    }
+
+    return _statsJSONObject;
 }
 
-QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) {
+QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) const {
     QJsonObject result;
     for (auto it = newStats.constBegin(); it != newStats.constEnd(); ++it) {
         const auto& key = it.key();
@@ -52,7 +61,7 @@ QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newS
     return result;
 }
 
-QJsonArray DomainServerNodeData::overrideValuesIfNeeded(const QJsonArray& newStats) {
+QJsonArray DomainServerNodeData::overrideValuesIfNeeded(const QJsonArray& newStats) const {
     QJsonArray result;
     for (const auto& value : newStats) {
         if (value.isObject()) {
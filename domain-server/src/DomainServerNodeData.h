@@ -19,15 +19,17 @@
 #include <HifiSockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
+#include <NodeStatsCodec.h>
 #include <NodeType.h>
 
 class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
 
-    const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
+    // the JSON for our stats is only built when someone asks for it (e.g. the web interface)
+    QJsonObject getStatsJSONObject() const;
 
-    void updateJSONStats(QByteArray statsByteArray);
+    void updateStats(const QByteArray& encodedStats);
 
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
@@ -68,10 +70,14 @@ public:
 
     bool wasAssigned() const { return _wasAssigned; };
     void setWasAssigned(bool wasAssigned) { _wasAssigned = wasAssigned; }
+
+    // the domain-server node list version at which this node was last added or changed
+    quint64 getNodeListVersion() const { return _nodeListVersion; }
+    void setNodeListVersion(quint64 nodeListVersion) { _nodeListVersion = nodeListVersion; }
     
 private:
-    QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
-    QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
+    QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats) const;
+    QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats) const;
     
     QHash<QUuid, QUuid> _sessionSecretHash;
     QUuid _assignmentUUID;
@@ -80,7 +86,9 @@ private:
     QElapsedTimer _paymentIntervalTimer;
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
-    QJsonObject _statsJSONObject;
+    NodeStatsDecoder _statsDecoder;
+    mutable QJsonObject _statsJSONObject;
+    mutable bool _statsJSONObjectDirty { false };
     static StringPairHash _overrideHash;
     
     HifiSockAddr _sendingSockAddr;
@@ -93,6 +101,8 @@ private:
     QString _placeName;
 
     bool _wasAssigned { false };
+
+    quint64 _nodeListVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
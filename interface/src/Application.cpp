@@ -890,6 +890,9 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     }
     ResourceCache::setRequestLimit(concurrentDownloads);
 
+    // an explicit download limit on the command line is used as-is, otherwise it is tuned to the connection
+    ResourceCache::setAdaptiveRequestLimit(!success);
+
     _glWidget = new GLCanvas();
     getApplicationCompositor().setRenderingWidget(_glWidget);
     _window->setCentralWidget(_glWidget);
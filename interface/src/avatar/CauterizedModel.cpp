@@ -207,33 +207,31 @@ void CauterizedModel::updateRenderItems() {
 
             render::PendingChanges pendingChanges;
             QList<render::ItemID> keys = self->getRenderItems().keys();
-            foreach (auto itemID, keys) {
-                pendingChanges.updateItem<CauterizedMeshPartPayload>(itemID, [modelTransform, deleteGeometryCounter](CauterizedMeshPartPayload& data) {
-                    if (data._model && data._model->isLoaded()) {
-                        // Ensure the model geometry was not reset between frames
-                        if (deleteGeometryCounter == data._model->getGeometryCounter()) {
-                            // this stuff identical to what happens in regular Model
-                            const Model::MeshState& state = data._model->getMeshState(data._meshIndex);
-                            Transform renderTransform = modelTransform;
-                            if (state.clusterMatrices.size() == 1) {
-                                renderTransform = modelTransform.worldTransform(Transform(state.clusterMatrices[0]));
-                            }
-                            data.updateTransformForSkinnedMesh(renderTransform, modelTransform, state.clusterBuffer);
-
-                            // this stuff for cauterized mesh
-                            CauterizedModel* cModel = static_cast<CauterizedModel*>(data._model);
-                            const Model::MeshState& cState = cModel->getCauterizeMeshState(data._meshIndex);
-                            renderTransform = modelTransform;
-                            if (cState.clusterMatrices.size() == 1) {
-                                renderTransform = modelTransform.worldTransform(Transform(cState.clusterMatrices[0]));
-                            }
-                            data.updateTransformForCauterizedMesh(renderTransform, cState.clusterBuffer);
+            pendingChanges.updateItems<CauterizedMeshPartPayload>(keys, [modelTransform, deleteGeometryCounter](CauterizedMeshPartPayload& data) {
+                if (data._model && data._model->isLoaded()) {
+                    // Ensure the model geometry was not reset between frames
+                    if (deleteGeometryCounter == data._model->getGeometryCounter()) {
+                        // this stuff identical to what happens in regular Model
+                        const Model::MeshState& state = data._model->getMeshState(data._meshIndex);
+                        Transform renderTransform = modelTransform;
+                        if (state.clusterMatrices.size() == 1) {
+                            renderTransform = modelTransform.worldTransform(Transform(state.clusterMatrices[0]));
                         }
+                        data.updateTransformForSkinnedMesh(renderTransform, modelTransform, state.clusterBuffer);
+
+                        // this stuff for cauterized mesh
+                        CauterizedModel* cModel = static_cast<CauterizedModel*>(data._model);
+                        const Model::MeshState& cState = cModel->getCauterizeMeshState(data._meshIndex);
+                        renderTransform = modelTransform;
+                        if (cState.clusterMatrices.size() == 1) {
+                            renderTransform = modelTransform.worldTransform(Transform(cState.clusterMatrices[0]));
+                        }
+                        data.updateTransformForCauterizedMesh(renderTransform, cState.clusterBuffer);
                     }
-                });
-            }
+                }
+            });
 
-            scene->enqueuePendingChanges(pendingChanges);
+            scene->enqueuePendingChanges(std::move(pendingChanges));
         });
     } else {
         Model::updateRenderItems();
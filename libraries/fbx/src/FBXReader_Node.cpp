@@ -11,9 +11,19 @@
 
 #include "FBXReader.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <zlib.h>
+
+#include <tbb/parallel_for.h>
+
 #include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
+#include <QtCore/QFileDevice>
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
@@ -24,195 +34,308 @@
 #include <shared/NsightHelpers.h>
 #include "ModelFormatLogging.h"
 
-template<class T> int streamSize() {
-    return sizeof(T);
+// A cursor over the bytes of a binary FBX file, which are either memory mapped or already in memory,
+// so that parsing doesn't go through a QDataStream (and a virtual device read) for every value.
+class FBXBinaryReader {
+public:
+    FBXBinaryReader(const char* data, qint64 size) : _data(data), _size(size) { }
+
+    qint64 position() const { return _position; }
+    bool atEnd() const { return _position >= _size; }
+
+    template<class T> T read() {
+        T value;
+        memcpy(&value, readRaw(sizeof(T)), sizeof(T));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        std::reverse((char*)&value, (char*)&value + sizeof(T));
+#endif
+        return value;
+    }
+
+    const char* readRaw(qint64 length) {
+        if (length < 0 || length > _size - _position) {
+            throw QString("corrupt fbx file");
+        }
+        const char* bytes = _data + _position;
+        _position += length;
+        return bytes;
+    }
+
+    void seek(qint64 position) { _position = position; }
+
+    // Deflated arrays are located in a first pass over the file and inflated (in parallel) into vectors
+    // that only the reader holds, so the second pass that builds the tree hands out finished arrays.
+    struct CompressedArray {
+        const char* compressed;
+        quint32 compressedLength;
+        char* destination;
+        quint32 destinationLength;
+        int elementSize;
+        QVariant value;
+    };
+    std::vector<CompressedArray> compressedArrays;
+
+    QVariant takeInflatedArray(quint32 destinationLength) {
+        if (_nextCompressedArray >= compressedArrays.size()
+            || compressedArrays[_nextCompressedArray].destinationLength != destinationLength) {
+            throw QString("corrupt fbx file");
+        }
+        return std::move(compressedArrays[_nextCompressedArray++].value);
+    }
+
+private:
+    const char* _data;
+    qint64 _size;
+    qint64 _position { 0 };
+    size_t _nextCompressedArray { 0 };
+};
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+static void swapArrayElements(char* data, quint32 length, int elementSize) {
+    for (quint32 i = 0; i < length; i += elementSize) {
+        std::reverse(data + i, data + i + elementSize);
+    }
 }
+#endif
 
-template<bool> int streamSize() {
-    return 1;
+template<class T> quint32 readBinaryArrayHeader(FBXBinaryReader& reader, quint32& arrayLength, quint32& encoding,
+                                                 quint32& compressedLength) {
+    static_assert(sizeof(T) == 1 || std::is_arithmetic<T>::value, "FBX arrays hold plain numbers");
+
+    arrayLength = reader.read<quint32>();
+    encoding = reader.read<quint32>();
+    compressedLength = reader.read<quint32>();
+
+    const quint32 MAX_ARRAY_LENGTH = std::numeric_limits<int>::max() / sizeof(T);
+    if (arrayLength > MAX_ARRAY_LENGTH) {
+        throw QString("corrupt fbx file");
+    }
+    return arrayLength * sizeof(T);
 }
 
-template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
-
-    in >> arrayLength;
-    in >> encoding;
-    in >> compressedLength;
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        const unsigned int DEFLATE_ENCODING = 1;
-        QByteArray arrayData;
-        if (encoding == DEFLATE_ENCODING) {
-            // preface encoded data with uncompressed length
-            QByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
+const unsigned int DEFLATE_ENCODING = 1;
+
+template<class T> void scanBinaryArray(FBXBinaryReader& reader) {
+    quint32 arrayLength, encoding, compressedLength;
+    quint32 dataLength = readBinaryArrayHeader<T>(reader, arrayLength, encoding, compressedLength);
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
+    if (encoding == DEFLATE_ENCODING) {
+        const char* compressed = reader.readRaw(compressedLength);
+        if (dataLength > 0) {
+            QVector<T> values(arrayLength);
+            char* destination = reinterpret_cast<char*>(values.data());
+            reader.compressedArrays.push_back({ compressed, compressedLength, destination, dataLength, (int)sizeof(T),
+                                                QVariant::fromValue(values) });
         }
     } else {
-        values.reserve(arrayLength);
-        const unsigned int DEFLATE_ENCODING = 1;
-        if (encoding == DEFLATE_ENCODING) {
-            // preface encoded data with uncompressed length
-            QByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            QByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+        reader.readRaw(dataLength);
+    }
+}
+
+template<class T> QVariant readBinaryArray(FBXBinaryReader& reader) {
+    quint32 arrayLength, encoding, compressedLength;
+    quint32 dataLength = readBinaryArrayHeader<T>(reader, arrayLength, encoding, compressedLength);
+
+    if (encoding == DEFLATE_ENCODING) {
+        reader.readRaw(compressedLength);
+        if (dataLength > 0) {
+            return reader.takeInflatedArray(dataLength);
         }
+        return QVariant::fromValue(QVector<T>());
+    }
+
+    QVector<T> values(arrayLength);
+    if (dataLength > 0) {
+        char* destination = reinterpret_cast<char*>(values.data());
+        memcpy(destination, reader.readRaw(dataLength), dataLength);
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        swapArrayElements(destination, dataLength, sizeof(T));
+#endif
     }
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+static void inflateArrays(const std::vector<FBXBinaryReader::CompressedArray>& arrays) {
+    std::atomic<bool> corrupt { false };
+    tbb::parallel_for(size_t(0), arrays.size(), [&](size_t i) {
+        const auto& array = arrays[i];
+        uLongf inflatedLength = array.destinationLength;
+        int result = uncompress(reinterpret_cast<Bytef*>(array.destination), &inflatedLength,
+            reinterpret_cast<const Bytef*>(array.compressed), array.compressedLength);
+        if (result != Z_OK || inflatedLength != array.destinationLength) {
+            corrupt = true;
+            return;
+        }
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        swapArrayElements(array.destination, array.destinationLength, array.elementSize);
+#endif
+    });
+
+    if (corrupt) {
+        throw QString("corrupt fbx file");
+    }
+}
+
+static void scanBinaryFBXProperty(FBXBinaryReader& reader) {
+    char ch = reader.read<char>();
+    switch (ch) {
+        case 'C': {
+            reader.readRaw(sizeof(quint8));
+            break;
+        }
+        case 'Y': {
+            reader.readRaw(sizeof(qint16));
+            break;
+        }
+        case 'I':
+        case 'F': {
+            reader.readRaw(sizeof(qint32));
+            break;
+        }
+        case 'D':
+        case 'L': {
+            reader.readRaw(sizeof(qint64));
+            break;
+        }
+        case 'f': {
+            scanBinaryArray<float>(reader);
+            break;
+        }
+        case 'd': {
+            scanBinaryArray<double>(reader);
+            break;
+        }
+        case 'l': {
+            scanBinaryArray<qint64>(reader);
+            break;
+        }
+        case 'i': {
+            scanBinaryArray<qint32>(reader);
+            break;
+        }
+        case 'b': {
+            scanBinaryArray<bool>(reader);
+            break;
+        }
+        case 'S':
+        case 'R': {
+            reader.readRaw(reader.read<quint32>());
+            break;
+        }
+        default:
+            throw QString("Unknown property type: ") + ch;
+    }
+}
+
+static void readBinaryFBXNodeHeader(FBXBinaryReader& reader, bool has64BitPositions, qint64& endOffset,
+                                    quint64& propertyCount, quint8& nameLength) {
+    // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
+    // our code generally doesn't care about the size that much, so we will use 64bit values
+    // from here on out, but if the file is an older format we read the 32bit values and widen them.
+    if (has64BitPositions) {
+        endOffset = reader.read<qint64>();
+        propertyCount = reader.read<quint64>();
+        reader.read<quint64>(); // property list length
+    } else {
+        endOffset = reader.read<qint32>();
+        propertyCount = reader.read<quint32>();
+        reader.read<quint32>(); // property list length
+    }
+    nameLength = reader.read<quint8>();
+}
+
+const int MIN_VALID_OFFSET = 40;
+
+// walks a node the same way parseBinaryFBXNode does without building it, returns false for a null node
+static bool scanBinaryFBXNode(FBXBinaryReader& reader, bool has64BitPositions) {
+    qint64 endOffset;
+    quint64 propertyCount;
+    quint8 nameLength;
+    readBinaryFBXNodeHeader(reader, has64BitPositions, endOffset, propertyCount, nameLength);
+
+    if (endOffset < MIN_VALID_OFFSET || nameLength == 0) {
+        return false;
+    }
+    reader.readRaw(nameLength);
+
+    for (quint64 i = 0; i < propertyCount; i++) {
+        scanBinaryFBXProperty(reader);
+    }
+
+    while (endOffset > reader.position()) {
+        if (!scanBinaryFBXNode(reader, has64BitPositions)) {
+            break;
+        }
+    }
+    return true;
+}
+
+QVariant parseBinaryFBXProperty(FBXBinaryReader& reader) {
+    char ch = reader.read<char>();
     switch (ch) {
         case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(reader.read<qint16>());
         }
         case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(reader.read<quint8>() != 0);
         }
         case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(reader.read<qint32>());
         }
         case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(reader.read<float>());
         }
         case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(reader.read<double>());
         }
         case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(reader.read<qint64>());
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readBinaryArray<float>(reader);
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readBinaryArray<double>(reader);
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readBinaryArray<qint64>(reader);
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readBinaryArray<qint32>(reader);
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readBinaryArray<bool>(reader);
         }
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = reader.read<quint32>();
+            // copy out of the file data, which goes away once parsing is done
+            return QVariant::fromValue(QByteArray(reader.readRaw(length), length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(FBXBinaryReader& reader, bool has64BitPositions = false) {
     qint64 endOffset;
     quint64 propertyCount;
-    quint64 propertyListLength;
     quint8 nameLength;
-
-    // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
-    // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit 
-    // values and then assign to our actual 64bit values.
-    if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
-    } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+    readBinaryFBXNodeHeader(reader, has64BitPositions, endOffset, propertyCount, nameLength);
 
     FBXNode node;
-    const int MIN_VALID_OFFSET = 40;
     if (endOffset < MIN_VALID_OFFSET || nameLength == 0) {
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    node.name = QByteArray(reader.readRaw(nameLength), nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(reader));
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > reader.position()) {
+        FBXNode child = parseBinaryFBXNode(reader, has64BitPositions);
         if (child.name.isNull()) {
             return node;
 
@@ -224,6 +347,43 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     return node;
 }
 
+static FBXNode parseBinaryFBX(FBXBinaryReader& reader) {
+    // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
+    // of the FBX binary format
+
+    // The first 27 bytes contain the header.
+    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
+    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
+    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
+    const int HEADER_BEFORE_VERSION = 23;
+    const quint32 VERSION_FBX2016 = 7500;
+    reader.readRaw(HEADER_BEFORE_VERSION);
+    quint32 fileVersion = reader.read<quint32>();
+    qCDebug(modelformat) << "fileVersion:" << fileVersion;
+    bool has64BitPositions = (fileVersion >= VERSION_FBX2016);
+
+    // find and inflate the compressed arrays first, so that the tree only ever shares finished arrays
+    qint64 nodesStart = reader.position();
+    while (!reader.atEnd() && scanBinaryFBXNode(reader, has64BitPositions)) {
+    }
+    inflateArrays(reader.compressedArrays);
+    reader.seek(nodesStart);
+
+    // parse the top-level node
+    FBXNode top;
+    while (!reader.atEnd()) {
+        FBXNode next = parseBinaryFBXNode(reader, has64BitPositions);
+        if (next.name.isNull()) {
+            break;
+
+        } else {
+            top.children.append(next);
+        }
+    }
+
+    return top;
+}
+
 class Tokenizer {
 public:
 
@@ -366,39 +526,38 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-
-    // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
-    // of the FBX binary format
 
-    // The first 27 bytes contain the header.
-    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
-    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
-    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    const int HEADER_BEFORE_VERSION = 23;
-    const quint32 VERSION_FBX2016 = 7500;
-    in.skipRawData(HEADER_BEFORE_VERSION);
-    int position = HEADER_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
-    qCDebug(modelformat) << "fileVersion:" << fileVersion;
-    bool has64BitPositions = (fileVersion >= VERSION_FBX2016);
+    // parse straight out of memory: a buffer's own data, a mapping of the file, or as a last resort a copy
+    QByteArray deviceData;
+    const char* data = nullptr;
+    qint64 size = 0;
+    uchar* mappedData = nullptr;
+    QFileDevice* file = qobject_cast<QFileDevice*>(device);
+    if (QBuffer* buffer = qobject_cast<QBuffer*>(device)) {
+        data = buffer->data().constData() + buffer->pos();
+        size = buffer->size() - buffer->pos();
+    } else if (file && (mappedData = file->map(file->pos(), file->size() - file->pos()))) {
+        data = reinterpret_cast<const char*>(mappedData);
+        size = file->size() - file->pos();
+    } else {
+        deviceData = device->readAll();
+        data = deviceData.constData();
+        size = deviceData.size();
+    }
 
-    // parse the top-level node
+    FBXBinaryReader reader(data, size);
     FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
-        if (next.name.isNull()) {
-            return top;
-
-        } else {
-            top.children.append(next);
+    try {
+        top = parseBinaryFBX(reader);
+    } catch (...) {
+        if (mappedData) {
+            file->unmap(mappedData);
         }
+        throw;
+    }
+    if (mappedData) {
+        file->unmap(mappedData);
     }
-
     return top;
 }
 
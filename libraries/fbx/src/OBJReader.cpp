@@ -14,9 +14,15 @@
 
 #include "OBJReader.h"
 
-#include <ctype.h>  // .obj files are not locale-specific. The C/ASCII charset applies.
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
-#include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
 #include <QtNetwork/QNetworkAccessManager>
@@ -33,16 +39,6 @@ QHash<QString, float> COMMENT_SCALE_HINTS = {{"This file uses centimeters as uni
 
 const QString SMART_DEFAULT_MATERIAL_NAME = "High Fidelity smart default material name";
 
-namespace {
-template<class T>
-T& checked_at(QVector<T>& vector, int i) {
-    if (i < 0 || i >= vector.size()) {
-        throw std::out_of_range("index " + std::to_string(i) + "is out of range");
-    }
-    return vector[i];
-}
-}
-
 OBJTokenizer::OBJTokenizer(QIODevice* device) : _device(device), _pushedBackToken(-1) {
 }
 
@@ -138,61 +134,6 @@ void setMeshPartDefaults(FBXMeshPart& meshPart, QString materialID) {
     meshPart.materialID = materialID;
 }
 
-// OBJFace
-bool OBJFace::add(const QByteArray& vertexIndex, const QByteArray& textureIndex, const QByteArray& normalIndex, const QVector<glm::vec3>& vertices) {
-    bool ok;
-    int index = vertexIndex.toInt(&ok);
-    if (!ok) {
-        return false;
-    }
-    vertexIndices.append(index - 1);
-    if (!textureIndex.isEmpty()) {
-        index = textureIndex.toInt(&ok);
-        if (!ok) {
-            return false;
-        }
-        if (index < 0) { // Count backwards from the last one added.
-            index = vertices.count() + 1 + index;
-        }
-        textureUVIndices.append(index - 1);
-    }
-    if (!normalIndex.isEmpty()) {
-        index = normalIndex.toInt(&ok);
-        if (!ok) {
-            return false;
-        }
-        normalIndices.append(index - 1);
-    }
-    return true;
-}
-QVector<OBJFace> OBJFace::triangulate() {
-    QVector<OBJFace> newFaces;
-    const int nVerticesInATriangle = 3;
-    if (vertexIndices.count() == nVerticesInATriangle) {
-        newFaces.append(*this);
-    } else {
-        for (int i = 1; i < vertexIndices.count() - 1; i++) {
-            OBJFace newFace;
-            newFace.addFrom(this, 0);
-            newFace.addFrom(this, i);
-            newFace.addFrom(this, i + 1);
-            newFace.groupName = groupName;
-            newFace.materialName = materialName;
-            newFaces.append(newFace);
-        }
-    }
-    return newFaces;
-}
-void OBJFace::addFrom(const OBJFace* face, int index) { // add using data from f at index i
-    vertexIndices.append(face->vertexIndices[index]);
-    if (face->textureUVIndices.count() > 0) { // Any at all. Runtime error if not consistent.
-        textureUVIndices.append(face->textureUVIndices[index]);
-    }
-    if (face->normalIndices.count() > 0) {
-        normalIndices.append(face->normalIndices[index]);
-    }
-}
-
 static bool replyOK(QNetworkReply* netReply, QUrl url) { // This will be reworked when we make things asynchronous
     return (netReply && netReply->isFinished() &&
             (url.toString().startsWith("file", Qt::CaseInsensitive) ? // file urls don't have http status codes
@@ -302,131 +243,515 @@ QNetworkReply* OBJReader::request(QUrl& url, bool isTest) {
 }
 
 
-bool OBJReader::parseOBJGroup(OBJTokenizer& tokenizer, const QVariantHash& mapping, FBXGeometry& geometry, float& scaleGuess) {
-    FaceGroup faces;
-    FBXMesh& mesh = geometry.meshes[0];
-    mesh.parts.append(FBXMeshPart());
-    FBXMeshPart& meshPart = mesh.parts.last();
-    bool sawG = false;
-    bool result = true;
-    int originalFaceCountForDebugging = 0;
-    QString currentGroup;
+// Files are split into chunks of about this many bytes, each parsed on its own thread
+static const int OBJ_CHUNK_SIZE = 1 << 20;
 
-    setMeshPartDefaults(meshPart, QString("dontknow") + QString::number(mesh.parts.count()));
+namespace {
 
-    while (true) {
-        int tokenType = tokenizer.nextToken();
-        if (tokenType == OBJTokenizer::COMMENT_TOKEN) {
-            // loop through the list of known comments which suggest a scaling factor.
-            // if we find one, save the scaling hint into scaleGuess
-            QString comment = tokenizer.getComment();
-            QHashIterator<QString, float> i(COMMENT_SCALE_HINTS);
-            while (i.hasNext()) {
-                i.next();
-                if (comment.contains(i.key())) {
-                    scaleGuess = i.value();
+enum class OBJLineType {
+    Vertex,
+    TextureUV,
+    Normal,
+    Face,
+    Group,
+    UseMaterial,
+    MaterialLibrary,
+    Comment,
+    Other
+};
+
+// A run of whole lines of the file, and what was read from it
+struct OBJChunk {
+    const char* begin { nullptr };
+    const char* end { nullptr };
+
+    // counted in a first pass, so that every chunk knows what relative face indices refer to
+    int numVertices { 0 };
+    int numTextureUVs { 0 };
+    int numNormals { 0 };
+    int firstVertex { 0 };
+    int firstTextureUV { 0 };
+    int firstNormal { 0 };
+
+    QVector<glm::vec3> vertices;
+    QVector<glm::vec2> textureUVs;
+    QVector<glm::vec3> normals;
+    std::vector<OBJTriangle> triangles;
+
+    // group and material statements, in file order, with the number of triangles that came before them
+    struct Statement {
+        size_t triangleCount;
+        OBJLineType type;
+        QString name;
+    };
+    std::vector<Statement> statements;
+    std::vector<QByteArray> libraries;
+
+    float scaleGuess { 1.0f };
+    bool hasScaleGuess { false };
+    const char* error { nullptr };
+};
+
+// .obj files are not locale-specific, only the C/ASCII charset applies
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline void skipSpaces(const char*& cursor, const char* end) {
+    while (cursor < end && isSpace(*cursor)) {
+        ++cursor;
+    }
+}
+
+template <typename F>
+void forEachLine(const char* begin, const char* end, F f) {
+    while (begin < end) {
+        auto lineEnd = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+        f(begin, lineEnd);
+        begin = (lineEnd < end) ? lineEnd + 1 : end;
+    }
+}
+
+// Reads the keyword that starts a line, and leaves the cursor after it
+OBJLineType readLineType(const char*& cursor, const char* end) {
+    skipSpaces(cursor, end);
+    if (cursor < end && *cursor == '#') {
+        ++cursor;
+        return OBJLineType::Comment;
+    }
+
+    const char* keyword = cursor;
+    while (cursor < end && !isSpace(*cursor)) {
+        ++cursor;
+    }
+
+    switch (cursor - keyword) {
+        case 1:
+            switch (keyword[0]) {
+                case 'v':
+                    return OBJLineType::Vertex;
+                case 'f':
+                    return OBJLineType::Face;
+                case 'g':
+                case 'o': // we don't support separate objects in the same file, so treat "o" the same as "g"
+                    return OBJLineType::Group;
+            }
+            break;
+        case 2:
+            if (keyword[0] == 'v' && keyword[1] == 't') {
+                return OBJLineType::TextureUV;
+            }
+            if (keyword[0] == 'v' && keyword[1] == 'n') {
+                return OBJLineType::Normal;
+            }
+            break;
+        case 6:
+            if (memcmp(keyword, "usemtl", 6) == 0) {
+                return OBJLineType::UseMaterial;
+            }
+            if (memcmp(keyword, "mtllib", 6) == 0) {
+                return OBJLineType::MaterialLibrary;
+            }
+            break;
+    }
+    return OBJLineType::Other;
+}
+
+const double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const int MAX_EXACT_POWER_OF_TEN = 22;
+
+// Reads a decimal float like strtod does in the C locale, without its locale lookups.
+// The cursor only moves when a number was read.
+bool readFloat(const char*& cursor, const char* end, float& value) {
+    const char* p = cursor;
+    skipSpaces(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    // up to 19 significant digits fit in the mantissa, far more than a float can tell apart
+    const int MAX_MANTISSA_DIGITS = 19;
+    uint64_t mantissa = 0;
+    int mantissaDigits = 0;
+    int exponent = 0;
+    bool sawDigits = false;
+
+    for (; p < end && isDigit(*p); ++p) {
+        sawDigits = true;
+        if (mantissaDigits < MAX_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + (*p - '0');
+            mantissaDigits += (mantissa != 0);
+        } else {
+            ++exponent;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && isDigit(*p); ++p) {
+            sawDigits = true;
+            if (mantissaDigits < MAX_MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + (*p - '0');
+                mantissaDigits += (mantissa != 0);
+                --exponent;
+            }
+        }
+    }
+    if (!sawDigits) {
+        return false;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* e = p + 1;
+        bool negativeExponent = false;
+        if (e < end && (*e == '-' || *e == '+')) {
+            negativeExponent = (*e == '-');
+            ++e;
+        }
+        if (e < end && isDigit(*e)) {
+            int explicitExponent = 0;
+            for (; e < end && isDigit(*e); ++e) {
+                if (explicitExponent < 1000) {
+                    explicitExponent = explicitExponent * 10 + (*e - '0');
                 }
             }
-            continue;
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            p = e;
         }
-        if (tokenType != OBJTokenizer::DATUM_TOKEN) {
-            result = false;
-            break;
+    }
+
+    if (p < end && !isSpace(*p)) {
+        return false;
+    }
+
+    double result = (double)mantissa;
+    if (exponent < 0) {
+        result = (-exponent <= MAX_EXACT_POWER_OF_TEN) ? result / POWERS_OF_TEN[-exponent] : result * pow(10.0, exponent);
+    } else if (exponent > 0) {
+        result = (exponent <= MAX_EXACT_POWER_OF_TEN) ? result * POWERS_OF_TEN[exponent] : result * pow(10.0, exponent);
+    }
+
+    value = (float)(negative ? -result : result);
+    cursor = p;
+    return true;
+}
+
+bool readIndex(const char*& cursor, const char* end, int& value) {
+    const char* p = cursor;
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) {
+        return false;
+    }
+    int index = 0;
+    for (; p < end && isDigit(*p); ++p) {
+        index = index * 10 + (*p - '0');
+    }
+    value = negative ? -index : index;
+    cursor = p;
+    return true;
+}
+
+// Indices start at 1, negative ones count back from the last element read so far
+inline int resolveIndex(int index, int count) {
+    return (index > 0) ? index - 1 : count + index;
+}
+
+// Names are a single word, or anything between quotes
+QByteArray readName(const char*& cursor, const char* end) {
+    skipSpaces(cursor, end);
+    const char* begin = cursor;
+    if (cursor < end && *cursor == '"') {
+        begin = ++cursor;
+        while (cursor < end && *cursor != '"') {
+            ++cursor;
         }
-        QByteArray token = tokenizer.getDatum();
-        //qCDebug(modelformat) << token;
-        // we don't support separate objects in the same file, so treat "o" the same as "g".
-        if (token == "g" || token == "o") {
-            if (sawG) {
-                // we've encountered the beginning of the next group.
-                tokenizer.pushBackToken(OBJTokenizer::DATUM_TOKEN);
+        return QByteArray(begin, (int)(cursor - begin));
+    }
+    while (cursor < end && !isSpace(*cursor) && *cursor != '"') {
+        ++cursor;
+    }
+    return QByteArray(begin, (int)(cursor - begin));
+}
+
+void countChunk(OBJChunk& chunk) {
+    forEachLine(chunk.begin, chunk.end, [&](const char* cursor, const char* lineEnd) {
+        switch (readLineType(cursor, lineEnd)) {
+            case OBJLineType::Vertex:
+                ++chunk.numVertices;
                 break;
-            }
-            sawG = true;
-            if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
+            case OBJLineType::TextureUV:
+                ++chunk.numTextureUVs;
                 break;
-            }
-            QByteArray groupName = tokenizer.getDatum();
-            currentGroup = groupName;
-        } else if (token == "mtllib" && !_url.isEmpty()) {
-            if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
+            case OBJLineType::Normal:
+                ++chunk.numNormals;
                 break;
-            }
-            QByteArray libraryName = tokenizer.getDatum();
-            librariesSeen[libraryName] = true;
-            // We'll read it later only if we actually need it.
-        } else if (token == "usemtl") {
-            if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
+            default:
+                break;
+        }
+    });
+}
+
+void parseChunk(OBJChunk& chunk) {
+    chunk.vertices.reserve(chunk.numVertices);
+    chunk.textureUVs.reserve(chunk.numTextureUVs);
+    chunk.normals.reserve(chunk.numNormals);
+
+    // the corners of the face being read
+    std::vector<int> vertexIndices;
+    std::vector<int> textureUVIndices;
+    std::vector<int> normalIndices;
+
+    forEachLine(chunk.begin, chunk.end, [&](const char* cursor, const char* lineEnd) {
+        if (chunk.error) {
+            return;
+        }
+
+        auto type = readLineType(cursor, lineEnd);
+        switch (type) {
+            case OBJLineType::Vertex:
+            case OBJLineType::Normal: {
+                glm::vec3 v;
+                if (!readFloat(cursor, lineEnd, v.x) || !readFloat(cursor, lineEnd, v.y) || !readFloat(cursor, lineEnd, v.z)) {
+                    chunk.error = "malformed vertex";
+                    return;
+                }
+                // the spec(s) get(s) vague about what follows, might be w, might be a color... chop it off.
+                if (type == OBJLineType::Vertex) {
+                    chunk.vertices.push_back(v);
+                } else {
+                    chunk.normals.push_back(v);
+                }
                 break;
             }
-            QString nextName = tokenizer.getDatum();
-            if (nextName != currentMaterialName) {
-                currentMaterialName = nextName;
-                #ifdef WANT_DEBUG
-                qCDebug(modelformat) << "OBJ Reader new current material:" << currentMaterialName;
-                #endif
-            }
-        } else if (token == "v") {
-            vertices.append(tokenizer.getVec3());
-        } else if (token == "vn") {
-            normals.append(tokenizer.getVec3());
-        } else if (token == "vt") {
-            textureUVs.append(tokenizer.getVec2());
-        } else if (token == "f") {
-            OBJFace face;
-            while (true) {
-                if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
-                    if (face.vertexIndices.count() == 0) {
-                        // nonsense, bail out.
-                        goto done;
-                    }
-                    break;
+
+            case OBJLineType::TextureUV: {
+                float u;
+                float v = 0.0f;
+                if (!readFloat(cursor, lineEnd, u)) {
+                    chunk.error = "malformed texture coordinate";
+                    return;
                 }
+                // there can be a w, but we don't handle that
+                readFloat(cursor, lineEnd, v);
+                chunk.textureUVs.push_back(glm::vec2(u, 1.0f - v));
+                break;
+            }
+
+            case OBJLineType::Face: {
                 // faces can be:
                 //   vertex-index
                 //   vertex-index/texture-index
+                //   vertex-index//surface-normal-index
                 //   vertex-index/texture-index/surface-normal-index
-                QByteArray token = tokenizer.getDatum();
-                if (!isdigit(token[0])) { // Tokenizer treats line endings as whitespace. Non-digit indicates done;
-                    tokenizer.pushBackToken(OBJTokenizer::DATUM_TOKEN);
-                    break;
+                vertexIndices.clear();
+                textureUVIndices.clear();
+                normalIndices.clear();
+                int vertexCount = chunk.firstVertex + chunk.vertices.size();
+                int textureUVCount = chunk.firstTextureUV + chunk.textureUVs.size();
+                int normalCount = chunk.firstNormal + chunk.normals.size();
+
+                while (true) {
+                    skipSpaces(cursor, lineEnd);
+                    int index;
+                    if (!readIndex(cursor, lineEnd, index)) {
+                        break;
+                    }
+                    vertexIndices.push_back(resolveIndex(index, vertexCount));
+                    if (cursor < lineEnd && *cursor == '/') {
+                        ++cursor;
+                        if (readIndex(cursor, lineEnd, index)) {
+                            textureUVIndices.push_back(resolveIndex(index, textureUVCount));
+                        }
+                        if (cursor < lineEnd && *cursor == '/') {
+                            ++cursor;
+                            if (readIndex(cursor, lineEnd, index)) {
+                                normalIndices.push_back(resolveIndex(index, normalCount));
+                            }
+                        }
+                    }
                 }
-                QList<QByteArray> parts = token.split('/');
-                assert(parts.count() >= 1);
-                assert(parts.count() <= 3);
-                const QByteArray noData {};
-                face.add(parts[0], (parts.count() > 1) ? parts[1] : noData, (parts.count() > 2) ? parts[2] : noData, vertices);
-                face.groupName = currentGroup;
-                face.materialName = currentMaterialName;
+
+                const size_t numCorners = vertexIndices.size();
+                OBJTriangle triangle;
+                triangle.hasTextureUVs = (textureUVIndices.size() == numCorners);
+                triangle.hasNormals = (normalIndices.size() == numCorners);
+                for (size_t i = 1; i + 1 < numCorners; ++i) {
+                    const size_t corners[3] = { 0, i, i + 1 };
+                    for (int c = 0; c < 3; ++c) {
+                        triangle.vertexIndices[c] = vertexIndices[corners[c]];
+                        triangle.textureUVIndices[c] = triangle.hasTextureUVs ? textureUVIndices[corners[c]] : -1;
+                        triangle.normalIndices[c] = triangle.hasNormals ? normalIndices[corners[c]] : -1;
+                    }
+                    chunk.triangles.push_back(triangle);
+                }
+                break;
             }
-            originalFaceCountForDebugging++;
-            foreach(OBJFace face, face.triangulate()) {
-                faces.append(face);
+
+            case OBJLineType::Group:
+            case OBJLineType::UseMaterial: {
+                OBJChunk::Statement statement { chunk.triangles.size(), type, QString::fromUtf8(readName(cursor, lineEnd)) };
+                chunk.statements.push_back(statement);
+                break;
             }
-        } else {
-            // something we don't (yet) care about
-            // qCDebug(modelformat) << "OBJ parser is skipping a line with" << token;
-            tokenizer.skipLine();
+
+            case OBJLineType::MaterialLibrary:
+                chunk.libraries.push_back(readName(cursor, lineEnd));
+                break;
+
+            case OBJLineType::Comment: {
+                // loop through the list of known comments which suggest a scaling factor.
+                // if we find one, save the scaling hint
+                QString comment = QString::fromUtf8(cursor, (int)(lineEnd - cursor));
+                QHashIterator<QString, float> i(COMMENT_SCALE_HINTS);
+                while (i.hasNext()) {
+                    i.next();
+                    if (comment.contains(i.key())) {
+                        chunk.scaleGuess = i.value();
+                        chunk.hasScaleGuess = true;
+                    }
+                }
+                break;
+            }
+
+            default:
+                // something we don't (yet) care about
+                break;
         }
+    });
+}
+
+template <class T>
+inline bool fetch(const QVector<T>& vector, int i, T& value) {
+    if (i < 0 || i >= vector.size()) {
+        return false;
     }
-done:
-    if (faces.count() == 0) { // empty mesh
-        mesh.parts.pop_back();
-    } else {
-        faceGroups.append(faces); // We're done with this group. Add the faces.
-    }
-    return result;
+    value = vector.at(i);
+    return true;
 }
 
+}
+
+void OBJReader::parseOBJ(const QByteArray& model, float& scaleGuess) {
+    const char* data = model.constData();
+    const char* end = data + model.size();
+
+    // chunks always end after a newline, so that no line is split between two of them
+    std::vector<OBJChunk> chunks;
+    for (const char* chunkBegin = data; chunkBegin < end;) {
+        const char* chunkEnd = chunkBegin + std::min<ptrdiff_t>(OBJ_CHUNK_SIZE, end - chunkBegin);
+        if (chunkEnd < end) {
+            auto newline = static_cast<const char*>(memchr(chunkEnd, '\n', end - chunkEnd));
+            chunkEnd = newline ? newline + 1 : end;
+        }
+        chunks.emplace_back();
+        chunks.back().begin = chunkBegin;
+        chunks.back().end = chunkEnd;
+        chunkBegin = chunkEnd;
+    }
+
+    tbb::parallel_for(size_t(0), chunks.size(), [&](size_t i) {
+        countChunk(chunks[i]);
+    });
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        chunks[i].firstVertex = chunks[i - 1].firstVertex + chunks[i - 1].numVertices;
+        chunks[i].firstTextureUV = chunks[i - 1].firstTextureUV + chunks[i - 1].numTextureUVs;
+        chunks[i].firstNormal = chunks[i - 1].firstNormal + chunks[i - 1].numNormals;
+    }
+    tbb::parallel_for(size_t(0), chunks.size(), [&](size_t i) {
+        parseChunk(chunks[i]);
+    });
+
+    if (!chunks.empty()) {
+        const auto& last = chunks.back();
+        vertices.reserve(last.firstVertex + last.numVertices);
+        textureUVs.reserve(last.firstTextureUV + last.numTextureUVs);
+        normals.reserve(last.firstNormal + last.numNormals);
+    }
+
+    // replay the group and material statements in file order, so the parts come out as if read in one go
+    QString currentMaterialName;
+    bool sawG = false;
+    faceGroups.append(OBJFaceGroup());
+    auto addTriangles = [&](const OBJChunk& chunk, size_t from, size_t to) {
+        if (from == to) {
+            return;
+        }
+        OBJFaceGroup& group = faceGroups.last();
+        if (group.triangles.empty()) {
+            group.materialName = currentMaterialName;
+        }
+        for (size_t i = from; i < to; ++i) {
+            group.specifiesUV |= chunk.triangles[i].hasTextureUVs;
+        }
+        group.triangles.insert(group.triangles.end(), chunk.triangles.begin() + from, chunk.triangles.begin() + to);
+    };
+
+    for (auto& chunk : chunks) {
+        if (chunk.error) {
+            throw std::runtime_error(chunk.error);
+        }
+
+        vertices += chunk.vertices;
+        textureUVs += chunk.textureUVs;
+        normals += chunk.normals;
+
+        size_t triangleCount = 0;
+        for (const auto& statement : chunk.statements) {
+            addTriangles(chunk, triangleCount, statement.triangleCount);
+            triangleCount = statement.triangleCount;
+            if (statement.type == OBJLineType::Group) {
+                if (sawG) {
+                    // we've encountered the beginning of the next group.
+                    faceGroups.append(OBJFaceGroup());
+                }
+                sawG = true;
+            } else if (statement.name != currentMaterialName) {
+                currentMaterialName = statement.name;
+                #ifdef WANT_DEBUG
+                qCDebug(modelformat) << "OBJ Reader new current material:" << currentMaterialName;
+                #endif
+            }
+        }
+        addTriangles(chunk, triangleCount, chunk.triangles.size());
+
+        if (!_url.isEmpty()) {
+            for (const auto& libraryName : chunk.libraries) {
+                librariesSeen[libraryName] = true; // We'll read it later only if we actually need it.
+            }
+        }
+        if (chunk.hasScaleGuess) {
+            scaleGuess = chunk.scaleGuess;
+        }
+
+        // the triangles have been copied into their group
+        std::vector<OBJTriangle>().swap(chunk.triangles);
+    }
+
+    // groups without faces don't make a mesh part
+    faceGroups.erase(std::remove_if(faceGroups.begin(), faceGroups.end(), [](const OBJFaceGroup& group) {
+        return group.triangles.empty();
+    }), faceGroups.end());
+}
 
 FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping, const QUrl& url) {
     PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xffff0000, nullptr);
-    QBuffer buffer { &model };
-    buffer.open(QIODevice::ReadOnly);
-
     FBXGeometry* geometryPtr = new FBXGeometry();
     FBXGeometry& geometry = *geometryPtr;
-    OBJTokenizer tokenizer { &buffer };
     float scaleGuess = 1.0f;
 
     bool needsMaterialLibrary = false;
@@ -436,9 +761,8 @@ FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping,
     geometry.meshes.append(FBXMesh());
 
     try {
-        // call parseOBJGroup as long as it's returning true.  Each successful call will
-        // add a new meshPart to the geometry's single mesh.
-        while (parseOBJGroup(tokenizer, mapping, geometry, scaleGuess)) {}
+        // each group of faces becomes a meshPart of the geometry's single mesh.
+        parseOBJ(model, scaleGuess);
 
         FBXMesh& mesh = geometry.meshes[0];
         mesh.meshIndex = 0;
@@ -463,44 +787,76 @@ FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping,
                                               0, 0, 0, 1);
         mesh.clusters.append(cluster);
 
-        for (int i = 0, meshPartCount = 0; i < mesh.parts.count(); i++, meshPartCount++) {
-            FBXMeshPart& meshPart = mesh.parts[i];
-            FaceGroup faceGroup = faceGroups[meshPartCount];
-            bool specifiesUV = false;
-            foreach(OBJFace face, faceGroup) {
-                glm::vec3 v0 = checked_at(vertices, face.vertexIndices[0]);
-                glm::vec3 v1 = checked_at(vertices, face.vertexIndices[1]);
-                glm::vec3 v2 = checked_at(vertices, face.vertexIndices[2]);
-                meshPart.triangleIndices.append(mesh.vertices.count()); // not face.vertexIndices into vertices
-                mesh.vertices << v0;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v1;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v2;
-
-                glm::vec3 n0, n1, n2;
-                if (face.normalIndices.count()) {
-                    n0 = checked_at(normals, face.normalIndices[0]);
-                    n1 = checked_at(normals, face.normalIndices[1]);
-                    n2 = checked_at(normals, face.normalIndices[2]);
-                } else { // generate normals from triangle plane if not provided
-                    n0 = n1 = n2 = glm::cross(v1 - v0, v2 - v0);
-                }
-                mesh.normals << n0 << n1 << n2;
-                if (face.textureUVIndices.count()) {
-                    specifiesUV = true;
-                    mesh.texCoords <<
-                    checked_at(textureUVs, face.textureUVIndices[0]) <<
-                    checked_at(textureUVs, face.textureUVIndices[1]) <<
-                    checked_at(textureUVs, face.textureUVIndices[2]);
-                } else {
-                    glm::vec2 corner(0.0f, 1.0f);
-                    mesh.texCoords << corner << corner << corner;
+        int numTriangles = 0;
+        foreach (const OBJFaceGroup& faceGroup, faceGroups) {
+            numTriangles += (int)faceGroup.triangles.size();
+        }
+        // every triangle gets three vertices of its own in the mesh
+        mesh.vertices.resize(3 * numTriangles);
+        mesh.normals.resize(3 * numTriangles);
+        mesh.texCoords.resize(3 * numTriangles);
+        glm::vec3* meshVertices = mesh.vertices.data();
+        glm::vec3* meshNormals = mesh.normals.data();
+        glm::vec2* meshTexCoords = mesh.texCoords.data();
+
+        std::atomic<bool> indexOutOfRange { false };
+        int firstIndex = 0;
+        foreach (const OBJFaceGroup& faceGroup, faceGroups) {
+            mesh.parts.append(FBXMeshPart());
+            FBXMeshPart& meshPart = mesh.parts.last();
+            setMeshPartDefaults(meshPart, QString("dontknow") + QString::number(mesh.parts.count()));
+
+            const int numGroupTriangles = (int)faceGroup.triangles.size();
+            meshPart.triangleIndices.resize(3 * numGroupTriangles);
+            int* triangleIndices = meshPart.triangleIndices.data();
+
+            tbb::parallel_for(tbb::blocked_range<int>(0, numGroupTriangles), [&](const tbb::blocked_range<int>& range) {
+                for (int t = range.begin(); t < range.end(); ++t) {
+                    const OBJTriangle& triangle = faceGroup.triangles[t];
+                    const int index = firstIndex + 3 * t;
+
+                    glm::vec3 v[3];
+                    bool valid = true;
+                    for (int c = 0; c < 3; ++c) {
+                        valid &= fetch(vertices, triangle.vertexIndices[c], v[c]);
+                    }
+                    glm::vec3 n[3];
+                    if (triangle.hasNormals) {
+                        for (int c = 0; c < 3; ++c) {
+                            valid &= fetch(normals, triangle.normalIndices[c], n[c]);
+                        }
+                    } else { // generate normals from triangle plane if not provided
+                        n[0] = n[1] = n[2] = glm::cross(v[1] - v[0], v[2] - v[0]);
+                    }
+                    glm::vec2 uv[3];
+                    if (triangle.hasTextureUVs) {
+                        for (int c = 0; c < 3; ++c) {
+                            valid &= fetch(textureUVs, triangle.textureUVIndices[c], uv[c]);
+                        }
+                    } else {
+                        uv[0] = uv[1] = uv[2] = glm::vec2(0.0f, 1.0f);
+                    }
+
+                    if (!valid) {
+                        indexOutOfRange = true;
+                        return;
+                    }
+                    for (int c = 0; c < 3; ++c) {
+                        triangleIndices[3 * t + c] = index + c;
+                        meshVertices[index + c] = v[c];
+                        meshNormals[index + c] = n[c];
+                        meshTexCoords[index + c] = uv[c];
+                    }
                 }
+            });
+            if (indexOutOfRange) {
+                throw std::out_of_range("face index is out of range");
             }
+            firstIndex += 3 * numGroupTriangles;
+
             // All the faces in the same group will have the same name and material.
-            OBJFace leadFace = faceGroup[0];
-            QString groupMaterialName = leadFace.materialName;
+            QString groupMaterialName = faceGroup.materialName;
+            bool specifiesUV = faceGroup.specifiesUV;
             if (groupMaterialName.isEmpty() && specifiesUV) {
                 #ifdef WANT_DEBUG
                 qCDebug(modelformat) << "OBJ Reader WARNING: " << url
@@ -30,20 +30,22 @@ private:
     QString _comment;
 };
 
-class OBJFace { // A single face, with three or more planar vertices. But see triangulate().
+// A triangle of a face, with indices into OBJReader's vertices, textureUVs and normals. Faces with more
+// than three vertices are split into a fan of triangles, FBXMeshPart could take quads but mixing the two is messy.
+struct OBJTriangle {
+    int vertexIndices[3];
+    int textureUVIndices[3];
+    int normalIndices[3];
+    bool hasTextureUVs;
+    bool hasNormals;
+};
+
+// The faces between two "g" or "o" statements, which become one FBXMeshPart.
+class OBJFaceGroup {
 public:
-    QVector<int> vertexIndices;
-    QVector<int> textureUVIndices;
-    QVector<int> normalIndices;
-    QString groupName; // We don't make use of hierarchical structure, but it can be preserved for debugging and future use.
-    QString materialName;
-    // Add one more set of vertex data. Answers true if successful
-    bool add(const QByteArray& vertexIndex, const QByteArray& textureIndex, const QByteArray& normalIndex, const QVector<glm::vec3>& vertices);
-    // Return a set of one or more OBJFaces from this one, in which each is just a triangle.
-    // Even though FBXMeshPart can handle quads, it would be messy to try to keep track of mixed-size faces, so we treat everything as triangles.
-    QVector<OBJFace> triangulate();
-private:
-    void addFrom(const OBJFace* face, int index);
+    QString materialName; // the material in use at the first face, all faces of a part share it
+    bool specifiesUV { false };
+    std::vector<OBJTriangle> triangles;
 };
 
 // Materials and references to material names can come in any order, and different mesh parts can refer to the same material.
@@ -64,12 +66,10 @@ public:
 class OBJReader: public QObject { // QObject so we can make network requests.
     Q_OBJECT
 public:
-    typedef QVector<OBJFace> FaceGroup;
     QVector<glm::vec3> vertices;  // all that we ever encounter while reading
     QVector<glm::vec2> textureUVs;
     QVector<glm::vec3> normals;
-    QVector<FaceGroup> faceGroups;
-    QString currentMaterialName;
+    QVector<OBJFaceGroup> faceGroups;
     QHash<QString, OBJMaterial> materials;
 
     QNetworkReply* request(QUrl& url, bool isTest);
@@ -79,7 +79,8 @@ private:
     QUrl _url;
 
     QHash<QByteArray, bool> librariesSeen;
-    bool parseOBJGroup(OBJTokenizer& tokenizer, const QVariantHash& mapping, FBXGeometry& geometry, float& scaleGuess);
+    // splits the file into chunks of whole lines that are parsed in parallel, then merged in file order
+    void parseOBJ(const QByteArray& model, float& scaleGuess);
     void parseMaterialLibrary(QIODevice* device);
     bool isValidTexture(const QByteArray &filename); // true if the file exists. TODO?: check content-type header and that it is a supported format.
 };
@@ -70,6 +70,8 @@ GLTexture* GL41Backend::syncGPUObject(const TexturePointer& texturePointer) {
 GL41Texture::GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture) 
     : GLTexture(backend, texture, allocate()), _storageStamp { texture.getStamp() }, _size(texture.evalTotalSize()) {
     incrementTextureGPUCount();
+    // No memory management here, a streamed texture should fetch all of its mips
+    _gpuObject.setDesiredMipLevel(0);
     withPreservedTexture([&] {
         GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(_gpuObject.getTexelFormat(), _gpuObject.getStoredMipFormat());
         auto numMips = _gpuObject.evalNumMips();
@@ -157,7 +159,8 @@ void GL41Texture::syncSampler() const {
     glTexParameteri(_target, GL_TEXTURE_WRAP_R, WRAP_MODES[sampler.getWrapModeW()]);
 
     glTexParameterfv(_target, GL_TEXTURE_BORDER_COLOR, (const float*)&sampler.getBorderColor());
-    glTexParameteri(_target, GL_TEXTURE_BASE_LEVEL, (uint16)sampler.getMipOffset());
+    // Don't sample the mips a streamed texture hasn't received yet
+    glTexParameteri(_target, GL_TEXTURE_BASE_LEVEL, std::max<uint16>(sampler.getMipOffset(), _gpuObject.minAvailableMipLevel()));
     glTexParameterf(_target, GL_TEXTURE_MIN_LOD, (float)sampler.getMinMip());
     glTexParameterf(_target, GL_TEXTURE_MAX_LOD, (sampler.getMaxMip() == Sampler::MAX_MIP_LEVEL ? 1000.f : sampler.getMaxMip()));
     glTexParameterf(_target, GL_TEXTURE_MAX_ANISOTROPY_EXT, sampler.getMaxAnisotropy());
@@ -171,7 +171,8 @@ public:
         //bool canPromoteNoAllocate() const { return _allocatedMip < _populatedMip; }
         bool canPromote() const { return _allocatedMip > 0; }
         bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
-        bool hasPendingTransfers() const { return _populatedMip > _allocatedMip; }
+        // Streamed textures may not have the next mip yet, in which case there is nothing to transfer
+        bool hasPendingTransfers() const { return _populatedMip > _allocatedMip && _gpuObject.isStoredMipFaceAvailable(_populatedMip - 1); }
         void executeNextTransfer(const TexturePointer& currentTexture);
         uint32 size() const override { return _size; }
         virtual void populateTransferQueue() = 0;
@@ -189,6 +190,8 @@ public:
         // of mips in the gpu::Texture object
         uint16 _maxAllocatedMip { 0 };
         uint32 _size { 0 };
+        // The data stamp of the gpu::Texture when we last looked for newly arrived mips
+        Stamp _storageStamp { 0 };
         // Contains a series of lambdas that when executed will transfer data to the GPU, modify 
         // the _populatedMip and update the sampler in order to fully populate the allocated texture 
         // until _populatedMip == _allocatedMip
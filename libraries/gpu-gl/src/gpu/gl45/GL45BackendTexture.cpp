@@ -81,6 +81,14 @@ GLTexture* GL45Backend::syncGPUObject(const TexturePointer& texturePointer) {
             default:
                 Q_UNREACHABLE();
         }
+    } else if (TextureUsageType::RESOURCE == texture.getUsageType()) {
+        // Streamed textures receive mips after the GL object was created, let the memory manager pick them up
+        auto varObject = static_cast<GL45VariableAllocationTexture*>(object);
+        if (varObject->_storageStamp != texture.getDataStamp()) {
+            varObject->_storageStamp = texture.getDataStamp();
+            GL45VariableAllocationTexture::_memoryPressureStateStale = true;
+            GL45VariableAllocationTexture::addToWorkQueue(texturePointer);
+        }
     }
 
     return object;
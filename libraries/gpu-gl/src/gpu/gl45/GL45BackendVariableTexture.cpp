@@ -409,6 +409,7 @@ size_t GL45VariableAllocationTexture::_frameTexturesCreated { 0 };
 
 GL45VariableAllocationTexture::GL45VariableAllocationTexture(const std::weak_ptr<GLBackend>& backend, const Texture& texture) : GL45Texture(backend, texture) {
     ++_frameTexturesCreated;
+    _storageStamp = texture.getDataStamp();
 }
 
 GL45VariableAllocationTexture::~GL45VariableAllocationTexture() {
@@ -417,7 +418,7 @@ GL45VariableAllocationTexture::~GL45VariableAllocationTexture() {
 }
 
 void GL45VariableAllocationTexture::executeNextTransfer(const TexturePointer& currentTexture) {
-    if (_populatedMip <= _allocatedMip) {
+    if (!hasPendingTransfers()) {
         return;
     }
 
@@ -449,6 +450,11 @@ GL45ResourceTexture::GL45ResourceTexture(const std::weak_ptr<GLBackend>& backend
         }
     }
 
+    // A streamed texture may not have received all of its small mips yet
+    while (_populatedMip < mipLevels - 1 && !texture.isStoredMipFaceAvailable(_populatedMip)) {
+        ++_populatedMip;
+    }
+
     uint16_t allocatedMip = _populatedMip - std::min<uint16_t>(_populatedMip, 2);
     allocateStorage(allocatedMip);
     _memoryPressureStateStale = true;
@@ -459,6 +465,8 @@ GL45ResourceTexture::GL45ResourceTexture(const std::weak_ptr<GLBackend>& backend
 
 void GL45ResourceTexture::allocateStorage(uint16 allocatedMip) {
     _allocatedMip = allocatedMip;
+    // Let a streamed texture know how much of it we have room for
+    _gpuObject.setDesiredMipLevel(_allocatedMip);
     const GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(_gpuObject.getTexelFormat());
     const auto dimensions = _gpuObject.evalMipDimensions(_allocatedMip);
     const auto totalMips = _gpuObject.evalNumMips();
@@ -569,12 +577,19 @@ void GL45ResourceTexture::populateTransferQueue() {
     uint16_t sourceMip = _populatedMip;
     do {
         --sourceMip;
+        // Mips of a streamed texture arrive from the smallest up, stop at the first one we don't have yet
+        // so that _populatedMip never claims a mip that was not transferred
+        bool mipAvailable = true;
+        for (uint8_t face = 0; face < maxFace; ++face) {
+            mipAvailable &= _gpuObject.isStoredMipFaceAvailable(sourceMip, face);
+        }
+        if (!mipAvailable) {
+            break;
+        }
+
         auto targetMip = sourceMip - _allocatedMip;
         auto mipDimensions = _gpuObject.evalMipDimensions(sourceMip);
         for (uint8_t face = 0; face < maxFace; ++face) {
-            if (!_gpuObject.isStoredMipFaceAvailable(sourceMip, face)) {
-                continue;
-            }
 
             // If the mip is less than the max transfer size, then just do it in one transfer
             if (glm::all(glm::lessThanEqual(mipDimensions, MAX_TRANSFER_DIMENSIONS))) {
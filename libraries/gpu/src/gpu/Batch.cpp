@@ -102,6 +102,16 @@ void Batch::clear() {
     _framebuffers.clear();
     _objects.clear();
     _drawCallInfos.clear();
+    _queries.clear();
+    _lambdas.clear();
+    _profileRanges.clear();
+    _names.clear();
+    _namedData.clear();
+    _currentNamedCall.clear();
+    _invalidModel = true;
+    _currentModel = Transform();
+    _enableStereo = true;
+    _enableSkybox = false;
 }
 
 size_t Batch::cacheData(size_t size, const void* data) {
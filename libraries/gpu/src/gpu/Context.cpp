@@ -34,6 +34,34 @@ void ContextStats::evalDelta(const ContextStats& begin, const ContextStats& end)
 }
 
 
+// beyond this, batches given back are simply released
+static const size_t MAX_POOLED_BATCHES = 256;
+
+BatchPointer BatchPool::acquire() {
+    {
+        Lock lock(_mutex);
+        if (!_batches.empty()) {
+            auto batch = _batches.back();
+            _batches.pop_back();
+            return batch;
+        }
+    }
+    return std::make_shared<Batch>();
+}
+
+void BatchPool::recycle(const BatchPointer& batch) {
+    // a batch still referenced elsewhere can't be reused
+    if (!batch || batch.use_count() > 1) {
+        return;
+    }
+    batch->clear();
+
+    Lock lock(_mutex);
+    if (_batches.size() < MAX_POOLED_BATCHES) {
+        _batches.push_back(batch);
+    }
+}
+
 Context::CreateBackend Context::_createBackendCallback = nullptr;
 Context::MakeProgram Context::_makeProgramCallback = nullptr;
 std::once_flag Context::_initialized;
@@ -55,6 +83,10 @@ void Context::beginFrame(const glm::mat4& renderPose) {
     _frameActive = true;
     _currentFrame = std::make_shared<Frame>();
     _currentFrame->pose = renderPose;
+    auto batchPool = _batchPool;
+    _currentFrame->batchRecycler = [batchPool](const BatchPointer& batch) {
+        batchPool->recycle(batch);
+    };
 
     if (!_frameRangeTimer) {
         _frameRangeTimer = std::make_shared<RangeTimer>("gpu::Context::Frame");
@@ -62,6 +94,14 @@ void Context::beginFrame(const glm::mat4& renderPose) {
 }
 
 void Context::appendFrameBatch(Batch& batch) {
+    if (!_frameActive) {
+        qWarning() << "Batch executed outside of frame boundaries";
+        return;
+    }
+    _currentFrame->batches.push_back(std::make_shared<Batch>(batch));
+}
+
+void Context::appendFrameBatch(const BatchPointer& batch) {
     if (!_frameActive) {
         qWarning() << "Batch executed outside of frame boundaries";
         return;
@@ -111,7 +151,7 @@ void Context::executeFrame(const FramePointer& frame) const {
 
         // Execute the frame rendering commands
         for (auto& batch : frame->batches) {
-            _backend->render(batch);
+            _backend->render(*batch);
         }
 
         Batch endBatch;
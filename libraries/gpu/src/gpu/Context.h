@@ -132,6 +132,20 @@ protected:
 
 };
 
+// The batches of the frames that are done, cleared but keeping their storage,
+// so that recording the next frames doesn't grow the same vectors over and over
+class BatchPool {
+public:
+    // Can be called from any thread
+    BatchPointer acquire();
+    void recycle(const BatchPointer& batch);
+
+protected:
+    Mutex _mutex;
+    std::vector<BatchPointer> _batches;
+};
+using BatchPoolPointer = std::shared_ptr<BatchPool>;
+
 class Context {
 public:
     using Size = Resource::Size;
@@ -154,8 +168,13 @@ public:
 
     void beginFrame(const glm::mat4& renderPose = glm::mat4());
     void appendFrameBatch(Batch& batch);
+    void appendFrameBatch(const BatchPointer& batch);
     FramePointer endFrame();
 
+    // A batch from the pool, it is given back once the frame it is appended to is done.
+    // Can be called from any thread, e.g. to record several batches of a frame concurrently
+    BatchPointer acquireBatch() { return _batchPool->acquire(); }
+
     // MUST only be called on the rendering thread
     // 
     // Handle any pending operations to clean up (recycle / deallocate) resources no longer in use
@@ -234,6 +253,7 @@ protected:
     std::shared_ptr<Backend> _backend;
     bool _frameActive { false };
     FramePointer _currentFrame;
+    BatchPoolPointer _batchPool { std::make_shared<BatchPool>() };
     RangeTimerPointer _frameRangeTimer;
     StereoState  _stereo;
 
@@ -295,8 +315,8 @@ typedef std::shared_ptr<Context> ContextPointer;
 
 template<typename F>
 void doInBatch(std::shared_ptr<gpu::Context> context, F f) {
-    gpu::Batch batch;
-    f(batch);
+    auto batch = context->acquireBatch();
+    f(*batch);
     context->appendFrameBatch(batch);
 }
 
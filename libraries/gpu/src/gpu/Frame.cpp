@@ -17,6 +17,12 @@ Frame::~Frame() {
         framebuffer.reset();
     }
 
+    if (batchRecycler) {
+        for (auto& batch : batches) {
+            batchRecycler(batch);
+        }
+    }
+
     assert(bufferUpdates.empty());
     if (!bufferUpdates.empty()) {
         qFatal("Buffer sync error... frame destroyed without buffer updates being applied");
@@ -24,8 +30,8 @@ Frame::~Frame() {
 }
 
 void Frame::finish() {
-    for (Batch& batch : batches) {
-        batch.finishFrame(bufferUpdates);
+    for (auto& batch : batches) {
+        batch->finishFrame(bufferUpdates);
     }
 }
 
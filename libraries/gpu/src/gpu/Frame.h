@@ -22,7 +22,8 @@ namespace gpu {
     public:
         virtual ~Frame();
 
-        using Batches = std::vector<Batch>;
+        using Batches = std::vector<BatchPointer>;
+        using BatchRecycler = std::function<void(const BatchPointer&)>;
         using FramebufferRecycler = std::function<void(const FramebufferPointer&)>;
         using OverlayRecycler = std::function<void(const TexturePointer&)>;
 
@@ -40,6 +41,8 @@ namespace gpu {
         TexturePointer overlay;
         /// How to process the framebuffer when the frame dies.  MUST BE THREAD SAFE
         FramebufferRecycler framebufferRecycler;
+        /// How to reuse the batches when the frame dies.  MUST BE THREAD SAFE
+        BatchRecycler batchRecycler;
 
     protected:
         // Should be called once per frame, on the recording thred
@@ -12,7 +12,9 @@
 #define hifi_gpu_Texture_h
 
 #include <algorithm> //min max and more
+#include <atomic>
 #include <bitset>
+#include <limits>
 
 #include <QMetaType>
 #include <QUrl>
@@ -26,6 +28,7 @@ namespace ktx {
     class KTX;
     using KTXUniquePointer = std::unique_ptr<KTX>;
     struct Header;
+    struct KeyValue;
 }
 
 namespace gpu {
@@ -264,6 +267,8 @@ public:
         virtual void assignMipData(uint16 level, const storage::StoragePointer& storage) = 0;
         virtual void assignMipFaceData(uint16 level, uint8 face, const storage::StoragePointer& storage) = 0;
         virtual bool isMipAvailable(uint16 level, uint8 face = 0) const = 0;
+        // All the mips from this level down to the smallest one are available
+        virtual uint16 minAvailableMipLevel() const { return 0; }
         Texture::Type getType() const { return _type; }
 
         Stamp getStamp() const { return _stamp; }
@@ -297,14 +302,14 @@ public:
 
     class KtxStorage : public Storage {
     public:
-        KtxStorage(ktx::KTXUniquePointer& ktxData);
+        // All mip levels and faces of ktxData from minMipLevelAvailable down are populated. The missing ones can only be
+        // in a KTX made by ktx::KTX::createBare, and are streamed in through assignMipData from the smallest one up.
+        KtxStorage(ktx::KTXUniquePointer& ktxData, uint16 minMipLevelAvailable = 0);
         PixelsPointer getMipFace(uint16 level, uint8 face = 0) const override;
-        // By convention, all mip levels and faces MUST be populated when using KTX backing
-        bool isMipAvailable(uint16 level, uint8 face = 0) const override { return true; }
+        bool isMipAvailable(uint16 level, uint8 face = 0) const override { return level >= _minMipLevelAvailable; }
+        uint16 minAvailableMipLevel() const override { return _minMipLevelAvailable; }
 
-        void assignMipData(uint16 level, const storage::StoragePointer& storage) override {
-            throw std::runtime_error("Invalid call");
-        }
+        void assignMipData(uint16 level, const storage::StoragePointer& storage) override;
 
         void assignMipFaceData(uint16 level, uint8 face, const storage::StoragePointer& storage) override {
             throw std::runtime_error("Invalid call");
@@ -313,6 +318,7 @@ public:
 
     protected:
         ktx::KTXUniquePointer _ktxData;
+        std::atomic<uint16> _minMipLevelAvailable;
         friend class Texture;
     };
 
@@ -482,6 +488,14 @@ public:
     void setStorage(std::unique_ptr<Storage>& newStorage);
     void setKtxBacking(ktx::KTXUniquePointer& newBacking);
 
+    // Streamed textures (see createStreamed) start out with only their smallest mips
+    uint16 minAvailableMipLevel() const { return _storage->minAvailableMipLevel(); }
+
+    // The highest resolution mip the backend has made room for within its memory budget, which tells the owner
+    // of a streamed texture how far to fetch mips. Until a backend sets it no more mips are wanted.
+    void setDesiredMipLevel(uint16 level) const { _desiredMipLevel = level; }
+    uint16 getDesiredMipLevel() const { return _desiredMipLevel; }
+
     // access sizes for the stored mips
     uint16 getStoredMipWidth(uint16 level) const;
     uint16 getStoredMipHeight(uint16 level) const;
@@ -519,6 +533,9 @@ public:
     // Textures can be serialized directly to  ktx data file, here is how
     static ktx::KTXUniquePointer serialize(const Texture& texture);
     static Texture* unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType = TextureUsageType::RESOURCE, Usage usage = Usage(), const Sampler::Desc& sampler = Sampler::Desc());
+    // Creates a texture backed by a KTX made with ktx::KTX::createBare, which has no mips available until they are
+    // assigned with assignStoredMip, from the smallest one up
+    static Texture* createStreamed(ktx::KTXUniquePointer& bareKtx, TextureUsageType usageType = TextureUsageType::RESOURCE, Usage usage = Usage(), const Sampler::Desc& sampler = Sampler::Desc());
     static bool evalKTXFormat(const Element& mipFormat, const Element& texelFormat, ktx::Header& header);
     static bool evalTextureFormat(const ktx::Header& header, Element& mipFormat, Element& texelFormat);
 
@@ -538,6 +555,8 @@ protected:
 
     Stamp _stamp { 0 };
 
+    mutable std::atomic<uint16> _desiredMipLevel { std::numeric_limits<uint16>::max() };
+
     Sampler _sampler;
     Stamp _samplerStamp { 0 };
 
@@ -564,6 +583,7 @@ protected:
     bool _defined = false;
    
     static Texture* create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, const Sampler& sampler);
+    static Texture* createFromKTXHeader(const ktx::Header& header, const std::list<ktx::KeyValue>& keyValues, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler);
 
     Size resize(Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices);
 };
@@ -13,6 +13,9 @@
 #include "Texture.h"
 
 #include <ktx/KTX.h>
+
+#include "GPULogging.h"
+
 using namespace gpu;
 
 using PixelsPointer = Texture::PixelsPointer;
@@ -42,7 +45,8 @@ struct GPUKTXPayload {
 
 std::string GPUKTXPayload::KEY { "hifi.gpu" };
 
-KtxStorage::KtxStorage(ktx::KTXUniquePointer& ktxData) {
+KtxStorage::KtxStorage(ktx::KTXUniquePointer& ktxData, uint16 minMipLevelAvailable) :
+    _minMipLevelAvailable(minMipLevelAvailable) {
 
     // if the source ktx is valid let's config this KtxStorage correctly
     if (ktxData && ktxData->getHeader()) {
@@ -64,11 +68,52 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
     return _ktxData->getMipFaceTexelsData(level, face);
 }
 
+void KtxStorage::assignMipData(uint16 level, const storage::StoragePointer& storage) {
+    // the backend relies on the available mips being contiguous, so they have to come in from the smallest one up
+    if (level + 1 != _minMipLevelAvailable) {
+        qCWarning(gpulogging) << "Ignoring mip" << level << "which isn't next to the available ones, starting at" << (uint16)_minMipLevelAvailable;
+        return;
+    }
+
+    if (!_ktxData->writeMipData(level, storage->data(), storage->size())) {
+        qCWarning(gpulogging) << "Ignoring mip" << level << "of" << storage->size() << "bytes, which doesn't fit the KTX";
+        return;
+    }
+
+    // publish the level only once its texels are in place, the backend reads them from another thread
+    _minMipLevelAvailable = level;
+    bumpStamp();
+}
+
 void Texture::setKtxBacking(ktx::KTXUniquePointer& ktxBacking) {
     auto newBacking = std::unique_ptr<Storage>(new KtxStorage(ktxBacking));
     setStorage(newBacking);
 }
 
+// KTX rows are padded to 4 bytes, so that a reader can find any mip from the header alone. The stored mips may have been
+// assigned with tightly packed rows, or rows padded some other way, and are copied into that layout when they differ.
+static PixelsPointer repackKTXRows(const PixelsPointer& face, const ktx::Header& header, uint32_t level) {
+    const size_t rowSize = header.evalRowSize(level);
+    const size_t numRows = header.evalPixelHeight(level) * header.evalPixelDepth(level);
+    const size_t srcSize = face->getSize();
+    if (srcSize == rowSize * numRows) {
+        return face;
+    }
+
+    const size_t texelsRowSize = header.evalPixelWidth(level) * header.evalPixelSize();
+    const size_t srcRowSize = srcSize / numRows;
+    if (srcSize % numRows != 0 || srcRowSize < texelsRowSize) {
+        qCWarning(gpulogging) << "Unable to serialize mip" << level << "of" << srcSize << "bytes";
+        return PixelsPointer();
+    }
+
+    auto repacked = std::make_shared<storage::MemoryStorage>(rowSize * numRows);
+    for (size_t row = 0; row < numRows; ++row) {
+        memcpy(repacked->data() + row * rowSize, face->readData() + row * srcRowSize, texelsRowSize);
+    }
+    return repacked;
+}
+
 ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     ktx::Header header;
 
@@ -124,16 +169,29 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     header.numberOfMipmapLevels = texture.maxMip() + 1;
 
     ktx::Images images;
+    // keeps the faces that had to be repacked alive until they are copied into the KTX
+    std::vector<PixelsPointer> repackedFaces;
     for (uint32_t level = 0; level < header.numberOfMipmapLevels; level++) {
-        auto mip = texture.accessStoredMipFace(level);
-        if (mip) {
+        auto storedMip = texture.accessStoredMipFace(level);
+        if (storedMip) {
+            auto mip = repackKTXRows(storedMip, header, level);
+            if (!mip) {
+                return nullptr;
+            }
+            repackedFaces.push_back(mip);
             if (numFaces == 1) {
                 images.emplace_back(ktx::Image((uint32_t)mip->getSize(), 0, mip->readData()));
             } else {
                 ktx::Image::FaceBytes cubeFaces(Texture::CUBE_FACE_COUNT);
                 cubeFaces[0] = mip->readData();
                 for (uint32_t face = 1; face < Texture::CUBE_FACE_COUNT; face++) {
-                    cubeFaces[face] = texture.accessStoredMipFace(level, face)->readData();
+                    auto storedFace = texture.accessStoredMipFace(level, face);
+                    auto faceMip = storedFace ? repackKTXRows(storedFace, header, level) : PixelsPointer();
+                    if (!faceMip) {
+                        return nullptr;
+                    }
+                    repackedFaces.push_back(faceMip);
+                    cubeFaces[face] = faceMip->readData();
                 }
                 images.emplace_back(ktx::Image((uint32_t)mip->getSize(), 0, cubeFaces));
             }
@@ -177,12 +235,7 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     return ktxBuffer;
 }
 
-Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
-    if (!srcData) {
-        return nullptr;
-    }
-    const auto& header = *srcData->getHeader();
-
+Texture* Texture::createFromKTXHeader(const ktx::Header& header, const ktx::KeyValues& keyValues, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
     Format mipFormat = Format::COLOR_BGRA_32;
     Format texelFormat = Format::COLOR_SRGBA_32;
 
@@ -209,7 +262,7 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
     
     // If found, use the 
     GPUKTXPayload gpuktxKeyValue;
-    bool isGPUKTXPayload = GPUKTXPayload::findInKeyValues(srcData->_keyValues, gpuktxKeyValue);
+    bool isGPUKTXPayload = GPUKTXPayload::findInKeyValues(keyValues, gpuktxKeyValue);
 
     auto tex = Texture::create( (isGPUKTXPayload ? gpuktxKeyValue._usageType : usageType),
                                 type,
@@ -223,8 +276,22 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
 
     tex->setUsage((isGPUKTXPayload ? gpuktxKeyValue._usage : usage));
 
-    // Assing the mips availables
     tex->setStoredMipFormat(mipFormat);
+
+    return tex;
+}
+
+Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
+    if (!srcData) {
+        return nullptr;
+    }
+
+    auto tex = createFromKTXHeader(*srcData->getHeader(), srcData->_keyValues, usageType, usage, sampler);
+    if (!tex) {
+        return nullptr;
+    }
+
+    // Assing the mips availables
     uint16_t level = 0;
     for (auto& image : srcData->_images) {
         for (uint32_t face = 0; face < image._numFaces; face++) {
@@ -236,6 +303,25 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
     return tex;
 }
 
+Texture* Texture::createStreamed(ktx::KTXUniquePointer& bareKtx, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
+    if (!bareKtx) {
+        return nullptr;
+    }
+
+    auto tex = createFromKTXHeader(*bareKtx->getHeader(), bareKtx->_keyValues, usageType, usage, sampler);
+    if (!tex) {
+        return nullptr;
+    }
+
+    // the mips are all there as far as the texture is concerned, the storage knows which ones hold texels yet
+    auto numMips = (uint16)bareKtx->getHeader()->getNumberOfLevels();
+    tex->_maxMip = numMips - 1;
+    std::unique_ptr<Storage> storage(new KtxStorage(bareKtx, numMips));
+    tex->setStorage(storage);
+
+    return tex;
+}
+
 bool Texture::evalKTXFormat(const Element& mipFormat, const Element& texelFormat, ktx::Header& header) {
     if (texelFormat == Format::COLOR_RGBA_32 && mipFormat == Format::COLOR_BGRA_32) {
         header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::BGRA, ktx::GLInternalFormat_Uncompressed::RGBA8, ktx::GLBaseInternalFormat::RGBA);
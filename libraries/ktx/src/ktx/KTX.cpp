@@ -45,7 +45,24 @@ uint32_t Header::evalPixelDepth(uint32_t level) const {
 }
 
 size_t Header::evalPixelSize() const {
-    return glTypeSize; // Really we should generate the size from the FOrmat etc
+    // glTypeSize is the size of one component
+    switch ((GLFormat) glFormat) {
+        case GLFormat::RG:
+        case GLFormat::RG_INTEGER:
+            return 2 * glTypeSize;
+        case GLFormat::RGB:
+        case GLFormat::BGR:
+        case GLFormat::RGB_INTEGER:
+        case GLFormat::BGR_INTEGER:
+            return 3 * glTypeSize;
+        case GLFormat::RGBA:
+        case GLFormat::BGRA:
+        case GLFormat::RGBA_INTEGER:
+        case GLFormat::BGRA_INTEGER:
+            return 4 * glTypeSize;
+        default:
+            return glTypeSize;
+    }
 }
 
 size_t Header::evalRowSize(uint32_t level) const {
@@ -71,6 +88,24 @@ size_t Header::evalImageSize(uint32_t level) const {
 }
 
 
+size_t Header::evalMipDataSize(uint32_t level) const {
+    return evalFaceSize(level) * numberOfFaces * getNumberOfSlices();
+}
+
+size_t Header::evalMipByteSize(uint32_t level) const {
+    // the faces are made of padded rows, so there is never any cube padding between them
+    auto dataSize = evalMipDataSize(level);
+    return sizeof(uint32_t) + dataSize + evalPadding(dataSize);
+}
+
+size_t Header::evalMipByteOffset(uint32_t level) const {
+    size_t offset = sizeof(Header) + bytesOfKeyValueData;
+    for (uint32_t l = 0; l < level; ++l) {
+        offset += evalMipByteSize(l);
+    }
+    return offset;
+}
+
 KeyValue::KeyValue(const std::string& key, uint32_t valueByteSize, const Byte* value) :
     _byteSize((uint32_t) key.size() + 1 + valueByteSize), // keyString size + '\0' ending char + the value size
     _key(key),
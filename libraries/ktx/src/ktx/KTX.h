@@ -344,6 +344,14 @@ namespace ktx {
         size_t evalFaceSize(uint32_t level) const;
         size_t evalImageSize(uint32_t level) const;
 
+        // Layout of the mips as laid out above, and as KTX::write writes them, worked out from the header alone so that
+        // a reader can fetch single mips of a file it doesn't have yet. A mip is its image size (evalImageSize, a single
+        // face for non-array cube maps), the texels of all its faces, whose rows are padded to 4 bytes, and its padding.
+        size_t evalMipDataSize(uint32_t level) const; // all the faces, unlike evalImageSize for cube maps
+        size_t evalMipByteOffset(uint32_t level) const;
+        size_t evalMipByteSize(uint32_t level) const;
+        size_t evalStorageSize() const { return evalMipByteOffset(getNumberOfLevels()); }
+
         void setUncompressed(GLType type, uint32_t typeSize, GLFormat format, GLInternalFormat_Uncompressed internalFormat, GLBaseInternalFormat baseInternalFormat) {
             glType = (uint32_t) type;
             glTypeSize = typeSize;
@@ -470,6 +478,12 @@ namespace ktx {
         // Parse a block of memory and create a KTX object from it
         static std::unique_ptr<KTX> create(const StoragePointer& src);
 
+        // Create a KTX holding only the header and key values, with room for all the mips which are left empty
+        // and copied in with writeMipData as they become available
+        static std::unique_ptr<KTX> createBare(const Header& header, const KeyValues& keyValues = KeyValues());
+        // Copy the image of a mip, all faces, into a KTX made by createBare
+        bool writeMipData(uint16_t level, const Byte* data, size_t size);
+
         static bool checkHeaderFromStorage(size_t srcSize, const Byte* srcBytes);
         static KeyValues parseKeyValues(size_t srcSize, const Byte* srcBytes);
         static Images parseImages(const Header& header, size_t srcSize, const Byte* srcBytes);
@@ -487,6 +501,10 @@ namespace ktx {
         StoragePointer _storage;
         KeyValues _keyValues;
         Images _images;
+
+    private:
+        // bare KTX own their storage, which is the only case where mips can be written into it
+        std::shared_ptr<storage::MemoryStorage> _bareStorage;
     };
 
 }
@@ -139,6 +139,8 @@ namespace ktx {
         Images images;
         auto currentPtr = srcBytes;
         auto numFaces = header.numberOfFaces;
+        // the image size of a non-array cube map is the size of a single face, which is padded on its own
+        bool isCubeFaceImageSize = (numFaces == NUM_CUBEMAPFACES && header.numberOfArrayElements == 0);
 
         // Keep identifying new mip as long as we can at list query the next imageSize
         while ((currentPtr - srcBytes) + sizeof(uint32_t) <= (srcSize)) {
@@ -147,16 +149,24 @@ namespace ktx {
             size_t imageSize = *reinterpret_cast<const uint32_t*>(currentPtr);
             currentPtr += sizeof(uint32_t);
 
+            size_t faceSize = imageSize;
+            size_t faceStride = imageSize;
+            if (isCubeFaceImageSize) {
+                faceStride = faceSize + Header::evalPadding(faceSize);
+            } else if (numFaces == NUM_CUBEMAPFACES) {
+                faceSize = faceStride = imageSize / NUM_CUBEMAPFACES;
+            }
+            size_t dataSize = (numFaces == NUM_CUBEMAPFACES) ? NUM_CUBEMAPFACES * faceStride : imageSize;
+
             // If enough data ahead then capture the pointer
-            if ((currentPtr - srcBytes) + imageSize <= (srcSize)) {
-                auto padding = Header::evalPadding(imageSize);
+            if ((currentPtr - srcBytes) + dataSize <= (srcSize)) {
+                auto padding = Header::evalPadding(dataSize);
 
                 if (numFaces == NUM_CUBEMAPFACES) {
-                    size_t faceSize = imageSize / NUM_CUBEMAPFACES;
                     Image::FaceBytes faces(NUM_CUBEMAPFACES);
                     for (uint32_t face = 0; face < NUM_CUBEMAPFACES; face++) {
                         faces[face] = currentPtr;
-                        currentPtr += faceSize;
+                        currentPtr += faceStride;
                     }
                     images.emplace_back(Image((uint32_t) faceSize, padding, faces));
                     currentPtr += padding;
@@ -40,6 +40,39 @@ namespace ktx {
         return create(storagePointer);
     }
 
+    std::unique_ptr<KTX> KTX::createBare(const Header& header, const KeyValues& keyValues) {
+        Header bareHeader = header;
+        bareHeader.bytesOfKeyValueData = (uint32_t) KeyValue::serializedKeyValuesByteSize(keyValues);
+
+        auto memoryStorage = std::make_shared<storage::MemoryStorage>(bareHeader.evalStorageSize());
+        auto destBytes = memoryStorage->data();
+        memcpy(destBytes, &bareHeader, sizeof(Header));
+        writeKeyValues(destBytes + sizeof(Header), bareHeader.bytesOfKeyValueData, keyValues);
+
+        // the image sizes are all that's needed to parse the images, their texels stay zeroed until written
+        for (uint32_t level = 0; level < bareHeader.getNumberOfLevels(); ++level) {
+            auto imageSize = (uint32_t) bareHeader.evalImageSize(level);
+            *reinterpret_cast<uint32_t*>(destBytes + bareHeader.evalMipByteOffset(level)) = imageSize;
+        }
+
+        auto result = create(memoryStorage);
+        if (result) {
+            result->_bareStorage = memoryStorage;
+        }
+        return result;
+    }
+
+    bool KTX::writeMipData(uint16_t level, const Byte* data, size_t size) {
+        if (!_bareStorage || level >= _images.size() || size != _images[level]._imageSize) {
+            return false;
+        }
+
+        // the faces of a mip are contiguous
+        auto offset = _images[level]._faceBytes[0] - _bareStorage->data();
+        memcpy(_bareStorage->data() + offset, data, size);
+        return true;
+    }
+
     size_t KTX::evalStorageSize(const Header& header, const Images& images, const KeyValues& keyValues) {
         size_t storageSize = sizeof(Header);
 
@@ -134,8 +167,9 @@ namespace ktx {
 
         for (uint32_t l = 0; l < srcImages.size(); l++) {
             if (currentDataSize + sizeof(uint32_t) < allocatedImagesDataSize) {
+                // the image size of a cube map only counts one face, Image can't describe cube map arrays
                 size_t imageSize = srcImages[l]._imageSize;
-                *(reinterpret_cast<uint32_t*> (currentPtr)) = (uint32_t) imageSize;
+                *(reinterpret_cast<uint32_t*> (currentPtr)) = (uint32_t) srcImages[l]._faceSize;
                 currentPtr += sizeof(uint32_t);
                 currentDataSize += sizeof(uint32_t);
 
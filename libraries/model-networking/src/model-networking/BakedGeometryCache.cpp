@@ -0,0 +1,622 @@
+//
+//  BakedGeometryCache.cpp
+//  libraries/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakedGeometryCache.h"
+
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <shared/Storage.h>
+
+#include "ModelNetworkingLogging.h"
+
+using File = cache::File;
+using FilePointer = cache::FilePointer;
+
+// A baked geometry file is a header, followed by a structure section holding everything but the bulk arrays
+// (joints, materials, mesh parts...) and then a data section holding the bulk arrays (vertices, normals,
+// indices...), each starting on a DATA_ALIGNMENT boundary so that they can be copied straight out of the mapping.
+// The layout is whatever the baking machine has in memory, files never leave the machine that wrote them.
+static const char BAKED_GEOMETRY_MAGIC[4] = { 'H', 'F', 'B', 'G' };
+
+// bump this whenever the layout, or what the readers extract from a model, changes
+static const quint32 BAKED_GEOMETRY_VERSION = 1;
+
+static const int DATA_ALIGNMENT = 16;
+
+struct BakedGeometryHeader {
+    char magic[4];
+    quint32 version;
+    quint64 structureLength;
+    quint64 dataOffset;
+    quint64 dataLength;
+};
+
+class BakedGeometryWriter {
+public:
+    template <typename T> void write(const T& value) {
+        _structure.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(const QByteArray& bytes) {
+        write<quint32>(bytes.size());
+        _structure.append(bytes);
+    }
+
+    void write(const QString& string) { write(string.toUtf8()); }
+
+    template <typename T> void writeArray(const QVector<T>& values) {
+        _data.append(QByteArray((DATA_ALIGNMENT - _data.size() % DATA_ALIGNMENT) % DATA_ALIGNMENT, 0));
+        write<quint64>(_data.size());
+        write<quint32>(values.size());
+        _data.append(reinterpret_cast<const char*>(values.constData()), values.size() * sizeof(T));
+    }
+
+    QByteArray finish() const {
+        BakedGeometryHeader header;
+        memcpy(header.magic, BAKED_GEOMETRY_MAGIC, sizeof(header.magic));
+        header.version = BAKED_GEOMETRY_VERSION;
+        header.structureLength = _structure.size();
+        header.dataOffset = sizeof(header) + _structure.size();
+        header.dataOffset += (DATA_ALIGNMENT - header.dataOffset % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+        header.dataLength = _data.size();
+
+        QByteArray file(header.dataOffset + header.dataLength, 0);
+        memcpy(file.data(), &header, sizeof(header));
+        memcpy(file.data() + sizeof(header), _structure.constData(), _structure.size());
+        memcpy(file.data() + header.dataOffset, _data.constData(), _data.size());
+        return file;
+    }
+
+private:
+    QByteArray _structure;
+    QByteArray _data;
+};
+
+class BakedGeometryReader {
+public:
+    BakedGeometryReader(const uint8_t* file, size_t size) {
+        BakedGeometryHeader header;
+        if (size < sizeof(header)) {
+            throw QString("truncated baked geometry");
+        }
+        memcpy(&header, file, sizeof(header));
+        if (memcmp(header.magic, BAKED_GEOMETRY_MAGIC, sizeof(header.magic)) != 0) {
+            throw QString("not a baked geometry");
+        }
+        if (header.version != BAKED_GEOMETRY_VERSION) {
+            throw QString("baked geometry version %1 is not %2").arg(header.version).arg(BAKED_GEOMETRY_VERSION);
+        }
+        if (header.structureLength > size - sizeof(header) || header.dataOffset > size ||
+            header.dataLength > size - header.dataOffset) {
+            throw QString("truncated baked geometry");
+        }
+
+        _structure = reinterpret_cast<const char*>(file) + sizeof(header);
+        _structureLength = header.structureLength;
+        _data = reinterpret_cast<const char*>(file) + header.dataOffset;
+        _dataLength = header.dataLength;
+    }
+
+    template <typename T> T read() {
+        T value;
+        memcpy(&value, readRaw(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template <typename T> void read(T& value) { value = read<T>(); }
+
+    QByteArray readBytes() {
+        quint32 length = read<quint32>();
+        return QByteArray(readRaw(length), length);
+    }
+
+    QString readString() { return QString::fromUtf8(readBytes()); }
+
+    // every element of a counted section takes at least a byte of the structure, so that a corrupt count
+    // is caught before anything is allocated for it
+    quint32 readCount() {
+        quint32 count = read<quint32>();
+        if (count > _structureLength - _position) {
+            throw QString("corrupt baked geometry");
+        }
+        return count;
+    }
+
+    template <typename T> QVector<T> readArray() {
+        quint64 offset = read<quint64>();
+        quint32 count = read<quint32>();
+        quint64 length = (quint64)count * sizeof(T);
+        if (offset > _dataLength || length > _dataLength - offset) {
+            throw QString("corrupt baked geometry");
+        }
+
+        QVector<T> values(count);
+        if (length > 0) {
+            memcpy(values.data(), _data + offset, length);
+        }
+        return values;
+    }
+
+private:
+    const char* readRaw(quint64 length) {
+        if (length > _structureLength - _position) {
+            throw QString("corrupt baked geometry");
+        }
+        const char* bytes = _structure + _position;
+        _position += length;
+        return bytes;
+    }
+
+    const char* _structure;
+    quint64 _structureLength;
+    quint64 _position { 0 };
+    const char* _data;
+    quint64 _dataLength;
+};
+
+static void write(BakedGeometryWriter& out, const Transform& transform) {
+    bool isIdentity = transform.isIdentity();
+    out.write<quint8>(isIdentity);
+    if (!isIdentity) {
+        out.write(transform.getTranslation());
+        out.write(transform.getRotation());
+        out.write(transform.getScale());
+    }
+}
+
+static void read(BakedGeometryReader& in, Transform& transform) {
+    transform = Transform();
+    if (!in.read<quint8>()) {
+        transform.setTranslation(in.read<glm::vec3>());
+        transform.setRotation(in.read<glm::quat>());
+        transform.setScale(in.read<glm::vec3>());
+    }
+}
+
+static void write(BakedGeometryWriter& out, const Extents& extents) {
+    out.write(extents.minimum);
+    out.write(extents.maximum);
+}
+
+static void read(BakedGeometryReader& in, Extents& extents) {
+    in.read(extents.minimum);
+    in.read(extents.maximum);
+}
+
+static void write(BakedGeometryWriter& out, const FBXJoint& joint) {
+    out.writeArray(joint.shapeInfo.points);
+    out.writeArray(joint.freeLineage);
+    out.write<quint8>(joint.isFree);
+    out.write<qint32>(joint.parentIndex);
+    out.write(joint.distanceToParent);
+    out.write(joint.translation);
+    out.write(joint.preTransform);
+    out.write(joint.preRotation);
+    out.write(joint.rotation);
+    out.write(joint.postRotation);
+    out.write(joint.postTransform);
+    out.write(joint.transform);
+    out.write(joint.rotationMin);
+    out.write(joint.rotationMax);
+    out.write(joint.inverseDefaultRotation);
+    out.write(joint.inverseBindRotation);
+    out.write(joint.bindTransform);
+    out.write(joint.name);
+    out.write<quint8>(joint.isSkeletonJoint);
+    out.write<quint8>(joint.bindTransformFoundInCluster);
+    out.write<quint8>(joint.hasGeometricOffset);
+    out.write(joint.geometricTranslation);
+    out.write(joint.geometricRotation);
+    out.write(joint.geometricScaling);
+}
+
+static void read(BakedGeometryReader& in, FBXJoint& joint) {
+    joint.shapeInfo.points = in.readArray<glm::vec3>();
+    joint.freeLineage = in.readArray<int>();
+    joint.isFree = in.read<quint8>();
+    joint.parentIndex = in.read<qint32>();
+    in.read(joint.distanceToParent);
+    in.read(joint.translation);
+    in.read(joint.preTransform);
+    in.read(joint.preRotation);
+    in.read(joint.rotation);
+    in.read(joint.postRotation);
+    in.read(joint.postTransform);
+    in.read(joint.transform);
+    in.read(joint.rotationMin);
+    in.read(joint.rotationMax);
+    in.read(joint.inverseDefaultRotation);
+    in.read(joint.inverseBindRotation);
+    in.read(joint.bindTransform);
+    joint.name = in.readString();
+    joint.isSkeletonJoint = in.read<quint8>();
+    joint.bindTransformFoundInCluster = in.read<quint8>();
+    joint.hasGeometricOffset = in.read<quint8>();
+    in.read(joint.geometricTranslation);
+    in.read(joint.geometricRotation);
+    in.read(joint.geometricScaling);
+}
+
+static void write(BakedGeometryWriter& out, const FBXTexture& texture) {
+    out.write(texture.name);
+    out.write(texture.filename);
+    out.write(texture.content);
+    write(out, texture.transform);
+    out.write<qint32>(texture.maxNumPixels);
+    out.write<qint32>(texture.texcoordSet);
+    out.write(texture.texcoordSetName);
+    out.write<quint8>(texture.isBumpmap);
+}
+
+static void read(BakedGeometryReader& in, FBXTexture& texture) {
+    texture.name = in.readString();
+    texture.filename = in.readBytes();
+    texture.content = in.readBytes();
+    read(in, texture.transform);
+    texture.maxNumPixels = in.read<qint32>();
+    texture.texcoordSet = in.read<qint32>();
+    texture.texcoordSetName = in.readString();
+    texture.isBumpmap = in.read<quint8>();
+}
+
+static void write(BakedGeometryWriter& out, const FBXMaterial& material) {
+    out.write(material.diffuseColor);
+    out.write(material.diffuseFactor);
+    out.write(material.specularColor);
+    out.write(material.specularFactor);
+    out.write(material.emissiveColor);
+    out.write(material.emissiveFactor);
+    out.write(material.shininess);
+    out.write(material.opacity);
+    out.write(material.metallic);
+    out.write(material.roughness);
+    out.write(material.emissiveIntensity);
+    out.write(material.ambientFactor);
+    out.write(material.materialID);
+    out.write(material.name);
+    out.write(material.shadingModel);
+
+    // the model::Material only carries the schema values at this point, textures are fetched by NetworkMaterial
+    const auto& modelMaterial = material._material;
+    out.write<quint8>((bool)modelMaterial);
+    if (modelMaterial) {
+        out.write(modelMaterial->getEmissive(false));
+        out.write(modelMaterial->getAlbedo(false));
+        out.write(modelMaterial->getFresnel(false));
+        out.write(modelMaterial->getRoughness());
+        out.write(modelMaterial->getMetallic());
+        out.write(modelMaterial->getScattering());
+        out.write(modelMaterial->getOpacity());
+        out.write<quint8>(modelMaterial->isUnlit());
+    }
+
+    for (auto texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+                          &material.glossTexture, &material.roughnessTexture, &material.specularTexture,
+                          &material.metallicTexture, &material.emissiveTexture, &material.occlusionTexture,
+                          &material.scatteringTexture, &material.lightmapTexture }) {
+        write(out, *texture);
+    }
+    out.write(material.lightmapParams);
+
+    out.write<quint8>(material.isPBSMaterial);
+    out.write<quint8>(material.useNormalMap);
+    out.write<quint8>(material.useAlbedoMap);
+    out.write<quint8>(material.useOpacityMap);
+    out.write<quint8>(material.useRoughnessMap);
+    out.write<quint8>(material.useSpecularMap);
+    out.write<quint8>(material.useMetallicMap);
+    out.write<quint8>(material.useEmissiveMap);
+    out.write<quint8>(material.useOcclusionMap);
+}
+
+static void read(BakedGeometryReader& in, FBXMaterial& material) {
+    in.read(material.diffuseColor);
+    in.read(material.diffuseFactor);
+    in.read(material.specularColor);
+    in.read(material.specularFactor);
+    in.read(material.emissiveColor);
+    in.read(material.emissiveFactor);
+    in.read(material.shininess);
+    in.read(material.opacity);
+    in.read(material.metallic);
+    in.read(material.roughness);
+    in.read(material.emissiveIntensity);
+    in.read(material.ambientFactor);
+    material.materialID = in.readString();
+    material.name = in.readString();
+    material.shadingModel = in.readString();
+
+    if (in.read<quint8>()) {
+        // replay the setters in the order the readers call them, so that the material key comes out the same
+        auto modelMaterial = std::make_shared<model::Material>();
+        modelMaterial->setEmissive(in.read<glm::vec3>(), false);
+        modelMaterial->setAlbedo(in.read<glm::vec3>(), false);
+        modelMaterial->setFresnel(in.read<glm::vec3>(), false);
+        modelMaterial->setRoughness(in.read<float>());
+        modelMaterial->setMetallic(in.read<float>());
+        modelMaterial->setScattering(in.read<float>());
+        modelMaterial->setOpacity(in.read<float>());
+        modelMaterial->setUnlit(in.read<quint8>());
+        material._material = modelMaterial;
+    }
+
+    for (auto texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+                          &material.glossTexture, &material.roughnessTexture, &material.specularTexture,
+                          &material.metallicTexture, &material.emissiveTexture, &material.occlusionTexture,
+                          &material.scatteringTexture, &material.lightmapTexture }) {
+        read(in, *texture);
+    }
+    in.read(material.lightmapParams);
+
+    material.isPBSMaterial = in.read<quint8>();
+    material.useNormalMap = in.read<quint8>();
+    material.useAlbedoMap = in.read<quint8>();
+    material.useOpacityMap = in.read<quint8>();
+    material.useRoughnessMap = in.read<quint8>();
+    material.useSpecularMap = in.read<quint8>();
+    material.useMetallicMap = in.read<quint8>();
+    material.useEmissiveMap = in.read<quint8>();
+    material.useOcclusionMap = in.read<quint8>();
+}
+
+static void write(BakedGeometryWriter& out, const FBXMesh& mesh) {
+    out.write<quint32>(mesh.parts.size());
+    for (const FBXMeshPart& part : mesh.parts) {
+        out.writeArray(part.quadIndices);
+        out.writeArray(part.quadTrianglesIndices);
+        out.writeArray(part.triangleIndices);
+        out.write(part.materialID);
+    }
+
+    out.writeArray(mesh.vertices);
+    out.writeArray(mesh.normals);
+    out.writeArray(mesh.tangents);
+    out.writeArray(mesh.colors);
+    out.writeArray(mesh.texCoords);
+    out.writeArray(mesh.texCoords1);
+    out.writeArray(mesh.clusterIndices);
+    out.writeArray(mesh.clusterWeights);
+
+    out.write<quint32>(mesh.clusters.size());
+    for (const FBXCluster& cluster : mesh.clusters) {
+        out.write<qint32>(cluster.jointIndex);
+        out.write(cluster.inverseBindMatrix);
+    }
+
+    write(out, mesh.meshExtents);
+    out.write(mesh.modelTransform);
+    out.write<quint8>(mesh.isEye);
+
+    out.write<quint32>(mesh.blendshapes.size());
+    for (const FBXBlendshape& blendshape : mesh.blendshapes) {
+        out.writeArray(blendshape.indices);
+        out.writeArray(blendshape.vertices);
+        out.writeArray(blendshape.normals);
+    }
+
+    out.write<quint32>(mesh.meshIndex);
+}
+
+static void read(BakedGeometryReader& in, FBXMesh& mesh) {
+    mesh.parts.resize(in.readCount());
+    for (FBXMeshPart& part : mesh.parts) {
+        part.quadIndices = in.readArray<int>();
+        part.quadTrianglesIndices = in.readArray<int>();
+        part.triangleIndices = in.readArray<int>();
+        part.materialID = in.readString();
+    }
+
+    mesh.vertices = in.readArray<glm::vec3>();
+    mesh.normals = in.readArray<glm::vec3>();
+    mesh.tangents = in.readArray<glm::vec3>();
+    mesh.colors = in.readArray<glm::vec3>();
+    mesh.texCoords = in.readArray<glm::vec2>();
+    mesh.texCoords1 = in.readArray<glm::vec2>();
+    mesh.clusterIndices = in.readArray<glm::vec4>();
+    mesh.clusterWeights = in.readArray<glm::vec4>();
+
+    mesh.clusters.resize(in.readCount());
+    for (FBXCluster& cluster : mesh.clusters) {
+        cluster.jointIndex = in.read<qint32>();
+        in.read(cluster.inverseBindMatrix);
+    }
+
+    read(in, mesh.meshExtents);
+    in.read(mesh.modelTransform);
+    mesh.isEye = in.read<quint8>();
+
+    mesh.blendshapes.resize(in.readCount());
+    for (FBXBlendshape& blendshape : mesh.blendshapes) {
+        blendshape.indices = in.readArray<int>();
+        blendshape.vertices = in.readArray<glm::vec3>();
+        blendshape.normals = in.readArray<glm::vec3>();
+    }
+
+    mesh.meshIndex = in.read<quint32>();
+}
+
+static QByteArray bakeGeometry(const FBXGeometry& geometry) {
+    BakedGeometryWriter out;
+
+    out.write(geometry.originalURL);
+    out.write(geometry.author);
+    out.write(geometry.applicationName);
+
+    out.write<quint32>(geometry.joints.size());
+    for (const FBXJoint& joint : geometry.joints) {
+        write(out, joint);
+    }
+    out.write<quint32>(geometry.jointIndices.size());
+    for (auto it = geometry.jointIndices.constBegin(); it != geometry.jointIndices.constEnd(); ++it) {
+        out.write(it.key());
+        out.write<qint32>(it.value());
+    }
+    out.write<quint8>(geometry.hasSkeletonJoints);
+
+    out.write<quint32>(geometry.meshes.size());
+    for (const FBXMesh& mesh : geometry.meshes) {
+        write(out, mesh);
+    }
+
+    out.write<quint32>(geometry.materials.size());
+    for (auto it = geometry.materials.constBegin(); it != geometry.materials.constEnd(); ++it) {
+        out.write(it.key());
+        write(out, it.value());
+    }
+
+    out.write(geometry.offset);
+    for (int index : { geometry.leftEyeJointIndex, geometry.rightEyeJointIndex, geometry.neckJointIndex,
+                       geometry.rootJointIndex, geometry.leanJointIndex, geometry.headJointIndex,
+                       geometry.leftHandJointIndex, geometry.rightHandJointIndex,
+                       geometry.leftToeJointIndex, geometry.rightToeJointIndex }) {
+        out.write<qint32>(index);
+    }
+    out.write(geometry.leftEyeSize);
+    out.write(geometry.rightEyeSize);
+    out.writeArray(geometry.humanIKJointIndices);
+    out.write(geometry.palmDirection);
+    out.write(geometry.neckPivot);
+    write(out, geometry.bindExtents);
+    write(out, geometry.meshExtents);
+
+    out.write<quint32>(geometry.animationFrames.size());
+    for (const FBXAnimationFrame& frame : geometry.animationFrames) {
+        out.writeArray(frame.rotations);
+        out.writeArray(frame.translations);
+    }
+
+    out.write<quint32>(geometry.meshIndicesToModelNames.size());
+    for (auto it = geometry.meshIndicesToModelNames.constBegin(); it != geometry.meshIndicesToModelNames.constEnd(); ++it) {
+        out.write<qint32>(it.key());
+        out.write(it.value());
+    }
+
+    out.write<quint32>(geometry.blendshapeChannelNames.size());
+    for (const QString& name : geometry.blendshapeChannelNames) {
+        out.write(name);
+    }
+
+    return out.finish();
+}
+
+static FBXGeometry::Pointer unbakeGeometry(BakedGeometryReader& in, const QString& url) {
+    auto geometry = std::make_shared<FBXGeometry>();
+
+    geometry->originalURL = in.readString();
+    geometry->author = in.readString();
+    geometry->applicationName = in.readString();
+
+    geometry->joints.resize(in.readCount());
+    for (FBXJoint& joint : geometry->joints) {
+        read(in, joint);
+    }
+    for (quint32 i = 0, count = in.readCount(); i < count; ++i) {
+        QString name = in.readString();
+        geometry->jointIndices.insert(name, in.read<qint32>());
+    }
+    geometry->hasSkeletonJoints = in.read<quint8>();
+
+    geometry->meshes.resize(in.readCount());
+    for (FBXMesh& mesh : geometry->meshes) {
+        read(in, mesh);
+        FBXReader::buildModelMesh(mesh, url);
+    }
+
+    for (quint32 i = 0, count = in.readCount(); i < count; ++i) {
+        QString materialID = in.readString();
+        read(in, geometry->materials[materialID]);
+    }
+
+    in.read(geometry->offset);
+    for (int* index : { &geometry->leftEyeJointIndex, &geometry->rightEyeJointIndex, &geometry->neckJointIndex,
+                        &geometry->rootJointIndex, &geometry->leanJointIndex, &geometry->headJointIndex,
+                        &geometry->leftHandJointIndex, &geometry->rightHandJointIndex,
+                        &geometry->leftToeJointIndex, &geometry->rightToeJointIndex }) {
+        *index = in.read<qint32>();
+    }
+    in.read(geometry->leftEyeSize);
+    in.read(geometry->rightEyeSize);
+    geometry->humanIKJointIndices = in.readArray<int>();
+    in.read(geometry->palmDirection);
+    in.read(geometry->neckPivot);
+    read(in, geometry->bindExtents);
+    read(in, geometry->meshExtents);
+
+    geometry->animationFrames.resize(in.readCount());
+    for (FBXAnimationFrame& frame : geometry->animationFrames) {
+        frame.rotations = in.readArray<glm::quat>();
+        frame.translations = in.readArray<glm::vec3>();
+    }
+
+    for (quint32 i = 0, count = in.readCount(); i < count; ++i) {
+        int meshIndex = in.read<qint32>();
+        geometry->meshIndicesToModelNames.insert(meshIndex, in.readString());
+    }
+
+    for (quint32 i = 0, count = in.readCount(); i < count; ++i) {
+        geometry->blendshapeChannelNames.append(in.readString());
+    }
+
+    return geometry;
+}
+
+BakedGeometryCache::BakedGeometryCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) {
+    initialize();
+}
+
+BakedGeometryCache::~BakedGeometryCache() {
+    waitForPendingWrites();
+}
+
+BakedGeometryCache::Key BakedGeometryCache::getKey(const QByteArray& data, const QVariantHash& mapping, const QUrl& url) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(data);
+    // QJsonObject orders its keys, so the same mapping always hashes the same
+    hash.addData(QJsonDocument(QJsonObject::fromVariantHash(mapping)).toJson(QJsonDocument::Compact));
+    hash.addData(url.toEncoded());
+    hash.addData(reinterpret_cast<const char*>(&BAKED_GEOMETRY_VERSION), sizeof(BAKED_GEOMETRY_VERSION));
+    return hash.result().toHex().toStdString();
+}
+
+void BakedGeometryCache::writeGeometry(const Key& key, const FBXGeometry& geometry) {
+    writeFileAsync(key, bakeGeometry(geometry));
+}
+
+BakedGeometryFilePointer BakedGeometryCache::getFile(const Key& key) {
+    return std::static_pointer_cast<BakedGeometryFile>(FileCache::getFile(key));
+}
+
+std::unique_ptr<File> BakedGeometryCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCInfo(file_cache) << "Wrote baked geometry" << metadata.key.c_str();
+    return std::unique_ptr<File>(new BakedGeometryFile(std::move(metadata), filepath));
+}
+
+BakedGeometryFile::BakedGeometryFile(Metadata&& metadata, const std::string& filepath) :
+    cache::File(std::move(metadata), filepath) {}
+
+FBXGeometry::Pointer BakedGeometryFile::getGeometry(const QString& url) const {
+    storage::FileStorage storage(getFilepath().c_str());
+    if (!storage) {
+        return FBXGeometry::Pointer();
+    }
+
+    try {
+        BakedGeometryReader in(storage.data(), storage.size());
+        return unbakeGeometry(in, url);
+    } catch (const QString& error) {
+        qCWarning(modelnetworking) << "Ignoring baked geometry for" << url << ":" << error;
+        return FBXGeometry::Pointer();
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  BakedGeometryCache.h
+//  libraries/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakedGeometryCache_h
+#define hifi_BakedGeometryCache_h
+
+#include <QUrl>
+#include <QVariantHash>
+
+#include <FileCache.h>
+
+#include "FBXReader.h"
+
+class BakedGeometryFile;
+using BakedGeometryFilePointer = std::shared_ptr<BakedGeometryFile>;
+
+// Keeps the FBXGeometry extracted from FBX/OBJ models on disk, so that loading a model we have already seen
+// is a matter of mapping a file and copying its buffers rather than parsing the model again.
+class BakedGeometryCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    BakedGeometryCache(const std::string& dir, const std::string& ext);
+    ~BakedGeometryCache();
+
+    // the key covers everything the extracted geometry depends on: the model data, its mapping and its url
+    static Key getKey(const QByteArray& data, const QVariantHash& mapping, const QUrl& url);
+
+    // the geometry is baked on the calling thread, and written to disk behind its back
+    void writeGeometry(const Key& key, const FBXGeometry& geometry);
+    BakedGeometryFilePointer getFile(const Key& key);
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+};
+
+class BakedGeometryFile : public cache::File {
+    Q_OBJECT
+
+public:
+    // maps the file and rebuilds the geometry, including the model::Mesh of each mesh,
+    // returns null if the file can't be read or was baked by another version
+    FBXGeometry::Pointer getGeometry(const QString& url) const;
+
+protected:
+    friend class BakedGeometryCache;
+
+    BakedGeometryFile(Metadata&& metadata, const std::string& filepath);
+};
+
+#endif // hifi_BakedGeometryCache_h
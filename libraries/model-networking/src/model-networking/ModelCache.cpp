@@ -10,6 +10,9 @@
 //
 
 #include "ModelCache.h"
+
+#include <algorithm>
+
 #include <Finally.h>
 #include <FSTReader.h>
 #include "FBXReader.h"
@@ -18,6 +21,7 @@
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <QCryptographicHash>
 #include <QThreadPool>
 
 #include "ModelNetworkingLogging.h"
@@ -172,17 +176,33 @@ void GeometryReader::run() {
             (_url.path().toLower().endsWith(".fbx") || _url.path().toLower().endsWith(".obj"))) {
             FBXGeometry::Pointer fbxGeometry;
 
-            if (_url.path().toLower().endsWith(".fbx")) {
+            // skip parsing entirely if we have already baked this model
+            auto& bakedGeometryCache = DependencyManager::get<ModelCache>()->_bakedGeometryCache;
+            auto bakedGeometryKey = BakedGeometryCache::getKey(_data, _mapping, _url);
+            if (auto bakedGeometryFile = bakedGeometryCache.getFile(bakedGeometryKey)) {
+                fbxGeometry = bakedGeometryFile->getGeometry(_url.path());
+            }
+
+            if (fbxGeometry) {
+                qCDebug(modelnetworking) << "Loaded baked geometry for" << _url;
+            } else if (_url.path().toLower().endsWith(".fbx")) {
                 fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
                 if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
                     throw QString("empty geometry, possibly due to an unsupported FBX version");
                 }
+                bakedGeometryCache.writeGeometry(bakedGeometryKey, *fbxGeometry);
             } else if (_url.path().toLower().endsWith(".obj")) {
                 fbxGeometry.reset(OBJReader().readOBJ(_data, _mapping, _url));
+                bakedGeometryCache.writeGeometry(bakedGeometryKey, *fbxGeometry);
             } else {
                 throw QString("unsupported format");
             }
 
+            int numSharedMeshes = DependencyManager::get<ModelCache>()->shareMeshes(*fbxGeometry);
+            if (numSharedMeshes > 0) {
+                qCDebug(modelnetworking) << "Shared" << numSharedMeshes << "of" << fbxGeometry->meshes.size() << "meshes of" << _url;
+            }
+
             // Ensure the resource has not been deleted
             auto resource = _resource.toStrongRef();
             if (!resource) {
@@ -258,12 +278,91 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     finishedLoading(true);
 }
 
-ModelCache::ModelCache() {
+const std::string ModelCache::BAKED_GEOMETRY_DIRNAME { "baked_geometry_cache" };
+const std::string ModelCache::BAKED_GEOMETRY_EXT { "geometry" };
+
+ModelCache::ModelCache() :
+    _bakedGeometryCache(BAKED_GEOMETRY_DIRNAME, BAKED_GEOMETRY_EXT) {
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
 }
 
+// Hashes everything the mesh is drawn from: the bytes of its buffers, and how its views slice them
+static std::string getMeshContentKey(const model::Mesh& mesh) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    std::vector<const gpu::Buffer*> buffers;
+
+    auto addValue = [&](uint64_t value) {
+        hash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto addView = [&](const gpu::BufferView& view) {
+        // views into a buffer we have already hashed only refer to it
+        const gpu::Buffer* buffer = view._buffer.get();
+        auto found = std::find(buffers.begin(), buffers.end(), buffer);
+        addValue(found - buffers.begin());
+        if (found == buffers.end()) {
+            buffers.push_back(buffer);
+            if (buffer) {
+                addValue(buffer->getSize());
+                hash.addData(reinterpret_cast<const char*>(buffer->getData()), (int)buffer->getSize());
+            }
+        }
+        addValue(view._offset);
+        addValue(view._size);
+        addValue(view._element.getRaw());
+        addValue(view._stride);
+    };
+
+    addView(mesh.getVertexBuffer());
+    for (int slot = gpu::Stream::NORMAL; slot < gpu::Stream::NUM_INPUT_SLOTS; ++slot) {
+        addView(mesh.getAttributeBuffer(slot));
+    }
+    addView(mesh.getIndexBuffer());
+    addView(mesh.getPartBuffer());
+
+    return hash.result().toHex().toStdString();
+}
+
+model::MeshPointer ModelCache::getSharedMesh(const model::MeshPointer& mesh) {
+    auto key = getMeshContentKey(*mesh);
+
+    std::unique_lock<std::mutex> lock(_sharedMeshesMutex);
+    auto& sharedMesh = _sharedMeshes[key];
+    if (auto existingMesh = sharedMesh.lock()) {
+        return existingMesh;
+    }
+    sharedMesh = mesh;
+
+    // forget the meshes nobody holds anymore, each time the table has doubled
+    if (_sharedMeshes.size() > 2 * _sharedMeshesSweepSize) {
+        for (auto it = _sharedMeshes.begin(); it != _sharedMeshes.end();) {
+            if (it->second.expired()) {
+                it = _sharedMeshes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        _sharedMeshesSweepSize = _sharedMeshes.size();
+    }
+    return mesh;
+}
+
+int ModelCache::shareMeshes(FBXGeometry& geometry) {
+    int numSharedMeshes = 0;
+    for (auto& mesh : geometry.meshes) {
+        if (!mesh._mesh) {
+            continue;
+        }
+        auto sharedMesh = getSharedMesh(mesh._mesh);
+        if (sharedMesh != mesh._mesh) {
+            mesh._mesh = sharedMesh;
+            ++numSharedMeshes;
+        }
+    }
+    return numSharedMeshes;
+}
+
 QSharedPointer<Resource> ModelCache::createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
     const void* extra) {
     Resource* resource = nullptr;
@@ -12,12 +12,16 @@
 #ifndef hifi_ModelCache_h
 #define hifi_ModelCache_h
 
+#include <mutex>
+#include <unordered_map>
+
 #include <DependencyManager.h>
 #include <ResourceCache.h>
 
 #include <model/Material.h>
 #include <model/Asset.h>
 
+#include "BakedGeometryCache.h"
 #include "FBXReader.h"
 #include "TextureCache.h"
 
@@ -145,8 +149,23 @@ protected:
         const void* extra) override;
 
 private:
+    friend class GeometryReader;
+
     ModelCache();
     virtual ~ModelCache() = default;
+
+    static const std::string BAKED_GEOMETRY_DIRNAME;
+    static const std::string BAKED_GEOMETRY_EXT;
+    BakedGeometryCache _bakedGeometryCache;
+
+    // Meshes are interned by their content, so that the same mesh found in models loaded from different urls
+    // is held (and uploaded to the gpu) once. Returns the number of meshes of the geometry that were shared.
+    int shareMeshes(FBXGeometry& geometry);
+    model::MeshPointer getSharedMesh(const model::MeshPointer& mesh);
+
+    std::mutex _sharedMeshesMutex;
+    std::unordered_map<std::string, std::weak_ptr<model::Mesh>> _sharedMeshes;
+    size_t _sharedMeshesSweepSize { 0 };
 };
 
 class NetworkMaterial : public model::Material {
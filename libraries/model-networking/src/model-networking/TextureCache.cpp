@@ -44,14 +44,25 @@ Q_LOGGING_CATEGORY(trace_resource_parse_image, "trace.resource.parse.image")
 Q_LOGGING_CATEGORY(trace_resource_parse_image_raw, "trace.resource.parse.image.raw")
 Q_LOGGING_CATEGORY(trace_resource_parse_image_ktx, "trace.resource.parse.image.ktx")
 
+// Enough for the header and the key/values of a texture we baked, longer key/values are fetched in a second request
+static const int64_t KTX_HEADER_REQUEST_SIZE = 1024;
+// Same as what the GL 4.5 backend uploads when it creates the texture, these mips are fetched with the header
+static const gpu::Vec3u KTX_INITIAL_MIP_DIMENSIONS { 64, 64, 1 };
+
 const std::string TextureCache::KTX_DIRNAME { "ktx_cache" };
 const std::string TextureCache::KTX_EXT { "ktx" };
 
+// How often streaming textures are checked for a mip the renderer wants
+static const int MIP_REQUEST_INTERVAL_MS = 100;
+
 TextureCache::TextureCache() :
     _ktxCache(KTX_DIRNAME, KTX_EXT) {
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
 
+    _mipRequestTimer.setInterval(MIP_REQUEST_INTERVAL_MS);
+    connect(&_mipRequestTimer, &QTimer::timeout, this, &TextureCache::requestStreamedMips);
+
     // Expose enum Type to JS/QML via properties
     // Despite being one-off, this should be fine, because TextureCache is a SINGLETON_DEPENDENCY
     QObject* type = new QObject(this);
@@ -66,6 +77,24 @@ TextureCache::TextureCache() :
 TextureCache::~TextureCache() {
 }
 
+void TextureCache::addStreamingTexture(const QWeakPointer<NetworkTexture>& texture) {
+    _streamingTextures.push_back(texture);
+    if (!_mipRequestTimer.isActive()) {
+        _mipRequestTimer.start();
+    }
+}
+
+void TextureCache::requestStreamedMips() {
+    _streamingTextures.remove_if([](const QWeakPointer<NetworkTexture>& weakTexture) {
+        auto texture = weakTexture.lock();
+        return !texture || !texture->requestNextMip();
+    });
+
+    if (_streamingTextures.empty()) {
+        _mipRequestTimer.stop();
+    }
+}
+
 // use fixed table of permutations. Could also make ordered list programmatically
 // and then shuffle algorithm. For testing, this ensures consistent behavior in each run.
 // this list taken from Ken Perlin's Improved Noise reference implementation (orig. in Java) at
@@ -350,9 +379,34 @@ NetworkTexture::NetworkTexture(const QUrl& url, Type type, const QByteArray& con
     if (!content.isEmpty()) {
         _startedLoading = true;
         QMetaObject::invokeMethod(this, "loadContent", Qt::QueuedConnection, Q_ARG(const QByteArray&, content));
+    } else if (url.isValid() && url.path().endsWith(".ktx", Qt::CaseInsensitive)) {
+        _streamingState = StreamingState::REQUESTING_HEADER;
+        _requestByteRange = ByteRange(0, KTX_HEADER_REQUEST_SIZE);
     }
 }
 
+void NetworkTexture::init() {
+    Resource::init();
+
+    // a refresh starts streaming over from the header
+    if (_streamingState != StreamingState::NOT_STREAMED) {
+        _streamingState = StreamingState::REQUESTING_HEADER;
+        _requestByteRange = ByteRange(0, KTX_HEADER_REQUEST_SIZE);
+        _streamedTexture.reset();
+        _ktxMipLayouts.clear();
+    }
+}
+
+void NetworkTexture::finishedLoading(bool success) {
+    if (!success && _loaded) {
+        // a mip we failed to stream leaves the texture at the resolution it already has
+        qCWarning(modelnetworking) << "Failed to stream mip" << _ktxRequestedLowestMip << "of" << _url;
+        _streamingState = StreamingState::DONE;
+        return;
+    }
+    Resource::finishedLoading(success);
+}
+
 NetworkTexture::TextureLoaderFunc NetworkTexture::getTextureLoader() const {
     if (_type == CUSTOM_TEXTURE) {
         return _textureLoader;
@@ -416,21 +470,191 @@ private:
 };
 
 void NetworkTexture::downloadFinished(const QByteArray& data) {
-    loadContent(data);
+    switch (_streamingState) {
+        case StreamingState::REQUESTING_HEADER:
+            handleKTXHeader(data);
+            break;
+
+        case StreamingState::REQUESTING_INITIAL_MIPS:
+        case StreamingState::REQUESTING_MIP:
+            handleKTXMips(data);
+            break;
+
+        default:
+            loadContent(data);
+            break;
+    }
 }
 
-void NetworkTexture::loadContent(const QByteArray& content) {
-    // Hash the source image to for KTX caching
-    std::string hash;
-    {
-        QCryptographicHash hasher(QCryptographicHash::Md5);
-        hasher.addData(content);
-        hash = hasher.result().toHex().toStdString();
+void NetworkTexture::requestKTXMips(uint16_t lowestLevel, uint16_t highestLevel) {
+    _ktxRequestedLowestMip = lowestLevel;
+    _ktxRequestedHighestMip = highestLevel;
+    _requestByteRange = ByteRange(_ktxMipLayouts[lowestLevel].byteRange.fromInclusive, _ktxMipLayouts[highestLevel].byteRange.toExclusive);
+
+    // the request that got us here is only cleaned up once we return, so start the next one from the event loop
+    QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
+}
+
+void NetworkTexture::handleKTXHeader(const QByteArray& data) {
+    PROFILE_RANGE_EX(resource_parse_image_ktx, __FUNCTION__, 0xffff0000, 0);
+    auto bytes = reinterpret_cast<const ktx::Byte*>(data.data());
+    size_t size = data.size();
+
+    if (size >= sizeof(ktx::Header)) {
+        auto header = reinterpret_cast<const ktx::Header*>(bytes);
+        int64_t headerAndKeyValuesSize = sizeof(ktx::Header) + header->bytesOfKeyValueData;
+        if ((int64_t)size < headerAndKeyValuesSize && _requestByteRange.toExclusive < headerAndKeyValuesSize) {
+            // the key/values didn't fit in our first guess, ask again for exactly what we need
+            _requestByteRange = ByteRange(0, headerAndKeyValuesSize);
+            QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
+            return;
+        }
     }
 
+    if (!ktx::KTX::checkHeaderFromStorage(size, bytes)) {
+        qCWarning(modelnetworking) << "Invalid KTX header for" << _url;
+        finishedLoading(false);
+        return;
+    }
+
+    ktx::Header header;
+    memcpy(&header, bytes, sizeof(ktx::Header));
+    auto keyValues = ktx::KTX::parseKeyValues(header.bytesOfKeyValueData, bytes + sizeof(ktx::Header));
+
+    auto bareKtx = ktx::KTX::createBare(header, keyValues);
+    if (bareKtx) {
+        _streamedTexture.reset(gpu::Texture::createStreamed(bareKtx));
+    }
+    if (!_streamedTexture) {
+        qCWarning(modelnetworking) << "Unable to create a texture from the KTX header of" << _url;
+        finishedLoading(false);
+        return;
+    }
+    _streamedTexture->setSource(_url.toString().toStdString());
+    _streamedTexture->setFallbackTexture(getFallbackTexture());
+
+    uint16_t numLevels = header.getNumberOfLevels();
+    _ktxMipLayouts.clear();
+    for (uint16_t level = 0; level < numLevels; ++level) {
+        int64_t offset = header.evalMipByteOffset(level);
+        KTXMipLayout layout;
+        layout.byteRange = ByteRange(offset, offset + header.evalMipByteSize(level));
+        layout.imageSize = (uint32_t)header.evalImageSize(level);
+        layout.dataSize = header.evalMipDataSize(level);
+        _ktxMipLayouts.push_back(layout);
+    }
+
+    // fetch all the mips the backend uploads up front in one go, so the texture can be shown right away
+    uint16_t initialLevel = numLevels - 1;
+    for (uint16_t level = 0; level < numLevels; ++level) {
+        if (glm::all(glm::lessThanEqual(_streamedTexture->evalMipDimensions(level), KTX_INITIAL_MIP_DIMENSIONS))) {
+            initialLevel = level;
+            break;
+        }
+    }
+
+    _streamingState = StreamingState::REQUESTING_INITIAL_MIPS;
+    requestKTXMips(initialLevel, numLevels - 1);
+}
+
+void NetworkTexture::handleKTXMips(const QByteArray& data) {
+    PROFILE_RANGE_EX(resource_parse_image_ktx, __FUNCTION__, 0xffff0000, 0);
+    auto texture = _streamedTexture;
+    if (!texture) {
+        finishedLoading(false);
+        return;
+    }
+
+    // the mips have to be handed over from the smallest up
+    const int64_t rangeStart = _ktxMipLayouts[_ktxRequestedLowestMip].byteRange.fromInclusive;
+    for (int level = _ktxRequestedHighestMip; level >= _ktxRequestedLowestMip; --level) {
+        const auto& layout = _ktxMipLayouts[level];
+        int64_t offset = layout.byteRange.fromInclusive - rangeStart;
+        if (data.size() < offset + (int64_t)(sizeof(uint32_t) + layout.dataSize)) {
+            qCWarning(modelnetworking) << "Truncated data for mip" << level << "of" << _url;
+            finishedLoading(false);
+            return;
+        }
+
+        // a file that isn't laid out the way its header says can't be streamed, the mips would be read from the wrong place
+        uint32_t imageSize;
+        memcpy(&imageSize, data.data() + offset, sizeof(uint32_t));
+        offset += sizeof(uint32_t);
+        if (imageSize != layout.imageSize) {
+            qCWarning(modelnetworking) << "Mismatched image size" << imageSize << "for mip" << level << "of" << _url
+                << ", expected" << layout.imageSize;
+            finishedLoading(false);
+            return;
+        }
+
+        texture->assignStoredMip(level, layout.dataSize, reinterpret_cast<const gpu::Byte*>(data.data() + offset));
+        if (texture->minAvailableMipLevel() != level) {
+            qCWarning(modelnetworking) << "Mismatched data for mip" << level << "of" << _url;
+            finishedLoading(false);
+            return;
+        }
+    }
+
+    _streamingState = (texture->minAvailableMipLevel() == 0) ? StreamingState::DONE : StreamingState::WAITING_FOR_MIP_REQUEST;
+
+    if (!_loaded) {
+        auto dimensions = texture->getDimensions();
+        setImage(texture, dimensions.x, dimensions.y);
+
+        auto textureCache = static_cast<TextureCache*>(_cache.data());
+        if (textureCache && _streamingState != StreamingState::DONE) {
+            textureCache->addStreamingTexture(qWeakPointerCast<NetworkTexture, Resource>(_self));
+        }
+    } else {
+        setSize(texture->getStoredSize());
+    }
+}
+
+bool NetworkTexture::requestNextMip() {
+    if (_streamingState == StreamingState::REQUESTING_MIP) {
+        return true;
+    }
+    if (_streamingState != StreamingState::WAITING_FOR_MIP_REQUEST || !_streamedTexture) {
+        return false;
+    }
+
+    // the renderer lets the texture know which mips it has room for
+    uint16_t nextLevel = _streamedTexture->minAvailableMipLevel() - 1;
+    if (_streamedTexture->getDesiredMipLevel() <= nextLevel) {
+        _streamingState = StreamingState::REQUESTING_MIP;
+        requestKTXMips(nextLevel, nextLevel);
+    }
+    return true;
+}
+
+// Bump this whenever model::TextureUsage changes the texels it produces, or gpu::Texture::serialize the way it
+// lays them out, so that textures processed by an older version are not picked back up from the KTX cache
+static const int TEXTURE_PROCESSING_VERSION = 3;
+
+std::string NetworkTexture::getProcessedTextureKey(const QByteArray& content) const {
+    if (_type == CUSTOM_TEXTURE) {
+        // we can't tell custom loaders apart, so their results are never shared
+        return std::string();
+    }
+
+    QCryptographicHash hasher(QCryptographicHash::Md5);
+    hasher.addData(content);
+
+    // the same image used as e.g. albedo and normal map turns into two different textures
+    QByteArray variant = QString("type:%1;maxPixels:%2;version:%3")
+        .arg((int)_type).arg(_maxNumPixels).arg(TEXTURE_PROCESSING_VERSION).toUtf8();
+    hasher.addData(variant);
+
+    return hasher.result().toHex().toStdString();
+}
+
+void NetworkTexture::loadContent(const QByteArray& content) {
+    // Hash the source image and how it will be processed for KTX caching
+    std::string hash = getProcessedTextureKey(content);
+
     auto textureCache = static_cast<TextureCache*>(_cache.data());
 
-    if (textureCache != nullptr) {
+    if (textureCache != nullptr && !hash.empty()) {
         // If we already have a live texture with the same hash, use it
         auto texture = textureCache->getTextureByHash(hash);
 
@@ -577,7 +801,7 @@ void ImageReader::read() {
             qCWarning(modelnetworking) << "Unable to serialize texture to KTX " << _url;
         }
 
-        if (memKtx && textureCache) {
+        if (memKtx && textureCache && !_hash.empty()) {
             const char* data = reinterpret_cast<const char*>(memKtx->_storage->data());
             size_t length = memKtx->_storage->size();
             KTXFilePointer file;
@@ -596,7 +820,7 @@ void ImageReader::read() {
         // We replace the texture with the one stored in the cache.  This deals with the possible race condition of two different 
         // images with the same hash being loaded concurrently.  Only one of them will make it into the cache by hash first and will
         // be the winner
-        if (textureCache) {
+        if (textureCache && !_hash.empty()) {
             texture = textureCache->cacheTextureByHash(_hash, texture);
         }
     }
@@ -18,6 +18,7 @@
 #include <QMap>
 #include <QColor>
 #include <QMetaEnum>
+#include <QTimer>
 
 #include <DependencyManager.h>
 #include <ResourceCache.h>
@@ -78,13 +79,19 @@ public:
     TextureLoaderFunc getTextureLoader() const;
     gpu::TexturePointer getFallbackTexture() const;
 
+    /// Returns the key for the processed version of the given source content, which covers the source
+    /// bytes and everything that changes how they are processed. Empty if the result can't be shared.
+    std::string getProcessedTextureKey(const QByteArray& content) const;
+
 signals:
     void networkTextureCreated(const QWeakPointer<NetworkTexture>& self);
 
 protected:
     virtual bool isCacheable() const override { return _loaded; }
 
+    virtual void init() override;
     virtual void downloadFinished(const QByteArray& data) override;
+    virtual void finishedLoading(bool success) override;
 
     Q_INVOKABLE void loadContent(const QByteArray& content);
     Q_INVOKABLE void setImage(gpu::TexturePointer texture, int originalWidth, int originalHeight);
@@ -92,6 +99,25 @@ protected:
 private:
     friend class KTXReader;
     friend class ImageReader;
+    friend class TextureCache;
+
+    // Baked KTX textures are streamed: the header and the smallest mips are fetched first so the texture
+    // can be displayed, then each larger mip is fetched once the renderer wants it
+    enum class StreamingState {
+        NOT_STREAMED,
+        REQUESTING_HEADER,
+        REQUESTING_INITIAL_MIPS,
+        WAITING_FOR_MIP_REQUEST,
+        REQUESTING_MIP,
+        DONE
+    };
+
+    void handleKTXHeader(const QByteArray& data);
+    void handleKTXMips(const QByteArray& data);
+    void requestKTXMips(uint16_t lowestLevel, uint16_t highestLevel);
+
+    // Requests the next mip if the renderer wants it, returns false once there is nothing left to stream
+    bool requestNextMip();
 
     Type _type;
     TextureLoaderFunc _textureLoader { [](const QImage&, const std::string&){ return nullptr; } };
@@ -101,6 +127,18 @@ private:
     int _width { 0 };
     int _height { 0 };
     int _maxNumPixels { ABSOLUTE_MAX_TEXTURE_NUM_PIXELS };
+
+    StreamingState _streamingState { StreamingState::NOT_STREAMED };
+    gpu::TexturePointer _streamedTexture;
+    // Where each mip, with its image size and padding, sits in the remote file, and what it holds there
+    struct KTXMipLayout {
+        ByteRange byteRange;
+        uint32_t imageSize; // a single face for non-array cube maps
+        size_t dataSize; // all the faces
+    };
+    std::vector<KTXMipLayout> _ktxMipLayouts;
+    uint16_t _ktxRequestedLowestMip { 0 };
+    uint16_t _ktxRequestedHighestMip { 0 };
 };
 
 using NetworkTexturePointer = QSharedPointer<NetworkTexture>;
@@ -141,6 +179,9 @@ public:
     gpu::TexturePointer getTextureByHash(const std::string& hash);
     gpu::TexturePointer cacheTextureByHash(const std::string& hash, const gpu::TexturePointer& texture);
 
+private slots:
+    void requestStreamedMips();
+
 protected:
     // Overload ResourceCache::prefetch to allow specifying texture type for loads
     Q_INVOKABLE ScriptableResource* prefetch(const QUrl& url, int type, int maxNumPixels = ABSOLUTE_MAX_TEXTURE_NUM_PIXELS);
@@ -156,6 +197,8 @@ private:
     TextureCache();
     virtual ~TextureCache();
 
+    void addStreamingTexture(const QWeakPointer<NetworkTexture>& texture);
+
     static const std::string KTX_DIRNAME;
     static const std::string KTX_EXT;
     KTXCache _ktxCache;
@@ -163,6 +206,10 @@ private:
     std::unordered_map<std::string, std::weak_ptr<gpu::Texture>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
 
+    // Textures that still have mips to stream, polled for what the renderer wants next
+    std::list<QWeakPointer<NetworkTexture>> _streamingTextures;
+    QTimer _mipRequestTimer;
+
     gpu::TexturePointer _permutationNormalTexture;
     gpu::TexturePointer _whiteTexture;
     gpu::TexturePointer _grayTexture;
@@ -0,0 +1,292 @@
+//
+//  ImageProcessing.cpp
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "ImageProcessing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <tbb/parallel_for.h>
+
+#include <glm/glm.hpp>
+
+using namespace model;
+
+// rows are handed out to the worker threads in blocks of this many
+static const int ROWS_PER_TASK = 16;
+
+template <typename F>
+static void forEachRow(int height, const F& f) {
+    tbb::parallel_for(tbb::blocked_range<int>(0, height, ROWS_PER_TASK), [&](const tbb::blocked_range<int>& rows) {
+        for (int y = rows.begin(); y < rows.end(); ++y) {
+            f(y);
+        }
+    });
+}
+
+static int bytesPerPixel(QImage::Format format) {
+    switch (format) {
+        case QImage::Format_ARGB32:
+        case QImage::Format_RGB32:
+        case QImage::Format_RGBA8888:
+        case QImage::Format_RGBX8888:
+            return 4;
+        case QImage::Format_RGB888:
+            return 3;
+        case QImage::Format_Grayscale8:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Lookup tables for averaging in linear space, linear values are quantized to 12 bits on the way back
+// which is more than enough to round-trip every 8 bit sRGB value
+struct SRGBTables {
+    static const int LINEAR_STEPS = 4096;
+
+    float toLinear[256];
+    uint8_t fromLinear[LINEAR_STEPS];
+
+    SRGBTables() {
+        for (int i = 0; i < 256; ++i) {
+            float s = i / 255.0f;
+            toLinear[i] = (s <= 0.04045f) ? s / 12.92f : powf((s + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < LINEAR_STEPS; ++i) {
+            float l = i / (float)(LINEAR_STEPS - 1);
+            float s = (l <= 0.0031308f) ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+            fromLinear[i] = (uint8_t)glm::clamp((int)(s * 255.0f + 0.5f), 0, 255);
+        }
+    }
+
+    uint8_t average(uint8_t a, uint8_t b, uint8_t c, uint8_t d) const {
+        float l = 0.25f * (toLinear[a] + toLinear[b] + toLinear[c] + toLinear[d]);
+        return fromLinear[(int)(l * (LINEAR_STEPS - 1) + 0.5f)];
+    }
+};
+
+static const SRGBTables& getSRGBTables() {
+    static const SRGBTables tables;
+    return tables;
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// The SIMD kernels widen to 16 bits and round exactly like the scalar path, (a + b + c + d + 2) >> 2,
+// so that a mip doesn't depend on which path (or which tail of a row) produced it. Chaining
+// _mm_avg_epu8 would be cheaper but rounds up twice.
+
+// sums the 2x2 blocks of four 32 bit pixels in two rows, returns the two sums as 16 bit channels
+static inline __m128i sumBlocks4(__m128i row0, __m128i row1) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i left = _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero));
+    __m128i right = _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero));
+
+    // add each even pixel to the odd one next to it, the sums end up in the low 64 bits
+    left = _mm_add_epi16(left, _mm_srli_si128(left, 8));
+    right = _mm_add_epi16(right, _mm_srli_si128(right, 8));
+    return _mm_unpacklo_epi64(left, right);
+}
+
+// sums the 2x2 blocks of sixteen 8 bit pixels in two rows, returns the eight sums as 16 bit values
+static inline __m128i sumBlocks1(__m128i row0, __m128i row1) {
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    __m128i sum0 = _mm_add_epi16(_mm_and_si128(row0, lowBytes), _mm_srli_epi16(row0, 8));
+    __m128i sum1 = _mm_add_epi16(_mm_and_si128(row1, lowBytes), _mm_srli_epi16(row1, 8));
+    return _mm_add_epi16(sum0, sum1);
+}
+
+static inline __m128i averageBlocks(__m128i sum0, __m128i sum1) {
+    const __m128i two = _mm_set1_epi16(2);
+    sum0 = _mm_srli_epi16(_mm_add_epi16(sum0, two), 2);
+    sum1 = _mm_srli_epi16(_mm_add_epi16(sum1, two), 2);
+    return _mm_packus_epi16(sum0, sum1);
+}
+
+// 2x2 box filter of two 32 bit pixel rows, 4 output pixels at a time, returns the number of pixels written
+static int downsampleRow4_SSE(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth) {
+    int x = 0;
+    for (; x + 4 <= dstWidth; x += 4) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(row0 + x * 8 + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(row1 + x * 8 + 16));
+
+        _mm_storeu_si128((__m128i*)(dst + x * 4), averageBlocks(sumBlocks4(a0, b0), sumBlocks4(a1, b1)));
+    }
+    return x;
+}
+
+// 2x2 box filter of two 8 bit pixel rows, 16 output pixels at a time, returns the number of pixels written
+static int downsampleRow1_SSE(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth) {
+    int x = 0;
+    for (; x + 16 <= dstWidth; x += 16) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(row0 + x * 2));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(row0 + x * 2 + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(row1 + x * 2));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(row1 + x * 2 + 16));
+
+        _mm_storeu_si128((__m128i*)(dst + x), averageBlocks(sumBlocks1(a0, b0), sumBlocks1(a1, b1)));
+    }
+    return x;
+}
+
+#else
+
+static int downsampleRow4_SSE(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth) {
+    return 0;
+}
+
+static int downsampleRow1_SSE(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth) {
+    return 0;
+}
+
+#endif
+
+QImage ImageProcessing::downsample(const QImage& srcImage, const QSize& dstSize, bool sRGB) {
+    const int srcWidth = srcImage.width();
+    const int srcHeight = srcImage.height();
+    const int bpp = bytesPerPixel(srcImage.format());
+
+    // each axis is either halved, or already 1 and kept
+    const int stepX = (srcWidth == 1) ? 1 : 2;
+    const int stepY = (srcHeight == 1) ? 1 : 2;
+    if (bpp == 0 || dstSize.width() != srcWidth / stepX || dstSize.height() != srcHeight / stepY) {
+        return srcImage.scaled(dstSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QImage dstImage(dstSize, srcImage.format());
+    const int dstWidth = dstSize.width();
+
+    // in 4 byte formats the last byte is alpha (or padding), which is always averaged linearly
+    const int numColorChannels = (bpp == 4) ? 3 : bpp;
+    const SRGBTables* tables = sRGB ? &getSRGBTables() : nullptr;
+    const bool useSIMD = !sRGB && stepX == 2 && (bpp == 4 || bpp == 1);
+
+    forEachRow(dstSize.height(), [&](int y) {
+        const uint8_t* row0 = srcImage.constScanLine(y * stepY);
+        const uint8_t* row1 = srcImage.constScanLine(y * stepY + stepY - 1);
+        uint8_t* dst = dstImage.scanLine(y);
+
+        int x = 0;
+        if (useSIMD) {
+            x = (bpp == 4) ? downsampleRow4_SSE(row0, row1, dst, dstWidth) : downsampleRow1_SSE(row0, row1, dst, dstWidth);
+        }
+
+        for (; x < dstWidth; ++x) {
+            const uint8_t* p0 = row0 + (x * stepX) * bpp;
+            const uint8_t* p1 = row0 + (x * stepX + stepX - 1) * bpp;
+            const uint8_t* p2 = row1 + (x * stepX) * bpp;
+            const uint8_t* p3 = row1 + (x * stepX + stepX - 1) * bpp;
+            uint8_t* d = dst + x * bpp;
+
+            for (int c = 0; c < bpp; ++c) {
+                if (tables && c < numColorChannels) {
+                    d[c] = tables->average(p0[c], p1[c], p2[c], p3[c]);
+                } else {
+                    d[c] = (uint8_t)((p0[c] + p1[c] + p2[c] + p3[c] + 2) >> 2);
+                }
+            }
+        }
+    });
+
+    return dstImage;
+}
+
+const int RGBA_MAX = 255;
+
+// transform -1 - 1 to 0 - 255 (from sobel value to rgb)
+static int mapComponent(float sobelValue) {
+    const float factor = RGBA_MAX / 2.0f;
+    return (int)((sobelValue + 1.0f) * factor);
+}
+
+QImage ImageProcessing::convertBumpToNormal(const QImage& srcImage) {
+    QImage image = srcImage;
+    if (image.format() != QImage::Format_RGB888) {
+        image = image.convertToFormat(QImage::Format_RGB888);
+    }
+
+    // PR 5540 by AlessandroSigna integrated here as a specialized TextureLoader for bumpmaps
+    // The conversion is done using the Sobel Filter to calculate the derivatives from the grayscale image
+    const float pStrength = 2.0f;
+    const int width = image.width();
+    const int height = image.height();
+    const int RGB_STRIDE = 3;
+
+    QImage result(width, height, QImage::Format_ARGB32);
+
+    forEachRow(height, [&](int y) {
+        // since it's a grayscale image, the value of each component RGB is the same, we read red
+        const uint8_t* prev = image.constScanLine(std::max(y - 1, 0));
+        const uint8_t* row = image.constScanLine(y);
+        const uint8_t* next = image.constScanLine(std::min(y + 1, height - 1));
+        QRgb* dst = reinterpret_cast<QRgb*>(result.scanLine(y));
+
+        for (int x = 0; x < width; ++x) {
+            const int xPrev = std::max(x - 1, 0) * RGB_STRIDE;
+            const int xNext = std::min(x + 1, width - 1) * RGB_STRIDE;
+            const int xCurrent = x * RGB_STRIDE;
+
+            // surrounding pixels
+            const float tl = prev[xPrev];
+            const float t = row[xPrev];
+            const float tr = next[xPrev];
+            const float r = next[xCurrent];
+            const float br = next[xNext];
+            const float b = row[xNext];
+            const float bl = prev[xNext];
+            const float l = prev[xCurrent];
+
+            // apply the sobel filter
+            const float dX = (tr + pStrength * r + br) - (tl + pStrength * l + bl);
+            const float dY = (bl + pStrength * b + br) - (tl + pStrength * t + tr);
+            const float dZ = RGBA_MAX / pStrength;
+
+            glm::vec3 v = glm::normalize(glm::vec3(dX, dY, dZ));
+
+            // convert to rgb from the value obtained computing the filter
+            dst[x] = qRgba(mapComponent(v.x), mapComponent(v.y), mapComponent(v.z), 1);
+        }
+    });
+
+    return result;
+}
+
+QImage ImageProcessing::convertToGrayscale(const QImage& srcImage, bool invert) {
+    QImage image = srcImage;
+    if (image.format() != QImage::Format_ARGB32 && image.format() != QImage::Format_RGB32) {
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    const int width = image.width();
+    QImage result(image.size(), QImage::Format_Grayscale8);
+
+    // simple integer loop over contiguous rows so the compiler can vectorize it
+    const uint32_t invertMask = invert ? 0xFF : 0x00;
+    forEachRow(image.height(), [&](int y) {
+        const QRgb* src = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        uint8_t* dst = result.scanLine(y);
+
+        for (int x = 0; x < width; ++x) {
+            const uint32_t p = src[x];
+            const uint32_t gray = (((p >> 16) & 0xFF) * 11 + ((p >> 8) & 0xFF) * 16 + (p & 0xFF) * 5) / 32;
+            dst[x] = (uint8_t)(gray ^ invertMask);
+        }
+    });
+
+    return result;
+}
@@ -0,0 +1,34 @@
+//
+//  ImageProcessing.h
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_model_ImageProcessing_h
+#define hifi_model_ImageProcessing_h
+
+#include <QImage>
+
+namespace model {
+
+class ImageProcessing {
+public:
+    // Produces the next mip level of srcImage with a 2x2 box filter, dstSize must halve (or keep, for a
+    // dimension that is already 1) each dimension of srcImage. When sRGB is set the color channels are
+    // averaged in linear space. Formats or sizes that the box filter doesn't handle fall back to QImage::scaled.
+    static QImage downsample(const QImage& srcImage, const QSize& dstSize, bool sRGB);
+
+    // Converts a grayscale bump map (read from the red channel) into a tangent space normal map
+    // using a Sobel filter, the result is ARGB32.
+    static QImage convertBumpToNormal(const QImage& bumpImage);
+
+    // Converts to an 8 bit grayscale image, optionally inverting it (e.g. gloss into roughness).
+    static QImage convertToGrayscale(const QImage& srcImage, bool invert);
+};
+
+}
+
+#endif // hifi_model_ImageProcessing_h
@@ -23,9 +23,10 @@
 
 static int requestID = 0;
 
-AssetRequest::AssetRequest(const QString& hash) :
+AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
-    _hash(hash)
+    _hash(hash),
+    _byteRange(byteRange)
 {
 }
 
@@ -65,6 +66,15 @@ void AssetRequest::start() {
         _info.hash = _hash;
         _info.size = _data.size();
         _error = NoError;
+
+        if (_byteRange.isSet()) {
+            if (_byteRange.fromInclusive < _data.size()) {
+                _data = _data.mid(_byteRange.fromInclusive, _byteRange.size());
+            } else {
+                _data.clear();
+                _error = InvalidByteRange;
+            }
+        }
         
         _state = Finished;
         emit finished(this);
@@ -102,12 +112,26 @@ void AssetRequest::start() {
             return;
         }
         
-        _state = WaitingForData;
-        _data.resize(info.size);
-        
         qCDebug(asset_client) << "Got size of " << _hash << " : " << info.size << " bytes";
-        
-        int start = 0, end = _info.size;
+
+        DataOffset start = 0, end = _info.size;
+        if (_byteRange.isSet()) {
+            // the asset server refuses ranges that run past the end of the asset, so cut them short here
+            start = _byteRange.fromInclusive;
+            end = std::min<DataOffset>(_byteRange.toExclusive, _info.size);
+
+            if (start >= end) {
+                qCWarning(asset_client) << "Requested byte range of" << _hash << "is past the end of the asset";
+                _error = InvalidByteRange;
+                _state = Finished;
+                emit finished(this);
+
+                return;
+            }
+        }
+
+        _state = WaitingForData;
+        _data.resize(end - start);
         
         auto assetClient = DependencyManager::get<AssetClient>();
         auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
@@ -138,9 +162,14 @@ void AssetRequest::start() {
             } else {
                 Q_ASSERT(data.size() == (end - start));
                 
-                // we need to check the hash of the received data to make sure it matches what we expect
-                if (hashData(data).toHex() == _hash) {
-                    memcpy(_data.data() + start, data.constData(), data.size());
+                if (_byteRange.isSet()) {
+                    // the hash covers the whole asset, so a part of it can't be verified, nor cached in its place
+                    memcpy(_data.data(), data.constData(), data.size());
+                    _totalReceived += data.size();
+                    emit progress(_totalReceived, end - start);
+                } else if (hashData(data).toHex() == _hash) {
+                    // we need to check the hash of the received data to make sure it matches what we expect
+                    memcpy(_data.data(), data.constData(), data.size());
                     _totalReceived += data.size();
                     emit progress(_totalReceived, _info.size);
                     
@@ -19,6 +19,7 @@
 #include "AssetClient.h"
 
 #include "AssetUtils.h"
+#include "ResourceRequest.h"
 
 class AssetRequest : public QObject {
    Q_OBJECT
@@ -40,7 +41,7 @@ public:
         UnknownError
     };
 
-    AssetRequest(const QString& hash);
+    AssetRequest(const QString& hash, const ByteRange& byteRange = ByteRange());
     virtual ~AssetRequest() override;
 
     Q_INVOKABLE void start();
@@ -63,6 +64,7 @@ private:
     uint64_t _totalReceived { 0 };
     QString _hash;
     QByteArray _data;
+    ByteRange _byteRange;
     int _numPendingRequests { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
     MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
@@ -75,6 +75,12 @@ void DomainHandler::disconnect() {
     setIsConnected(false);
 }
 
+NodeList* DomainHandler::getNodeList() const {
+    // a process may run more than one NodeList (the agent's load generator does), so talk to the domain through our own
+    auto nodeList = qobject_cast<NodeList*>(parent());
+    return nodeList ? nodeList : DependencyManager::get<NodeList>().data();
+}
+
 void DomainHandler::sendDisconnectPacket() {
     // The DomainDisconnect packet is not verified - we're relying on the eventual addition of DTLS to the
     // domain-server connection to stop greifing here
@@ -83,7 +89,7 @@ void DomainHandler::sendDisconnectPacket() {
     static auto disconnectPacket = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
     
     // send the disconnect packet to the current domain server
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto nodeList = getNodeList();
     nodeList->sendUnreliablePacket(*disconnectPacket, _sockAddr);
 }
 
@@ -134,7 +140,7 @@ void DomainHandler::setSockAddr(const HifiSockAddr& sockAddr, const QString& hos
     }
 
     if (!_sockAddr.isNull()) {
-        DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+        getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     }
 
     // some callers may pass a hostname, this is not to be used for lookup but for DTLS certificate verification
@@ -166,7 +172,7 @@ void DomainHandler::setSocketAndID(const QString& hostname, quint16 port, const
             qCDebug(networking, "Looking up DS hostname %s.", _hostname.toLocal8Bit().constData());
             QHostInfo::lookupHost(_hostname, this, SLOT(completedHostnameLookup(const QHostInfo&)));
 
-            DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainHostname);
+            getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainHostname);
 
             UserActivityLogger::getInstance().changedDomain(_hostname);
             emit hostnameChanged(_hostname);
@@ -197,7 +203,7 @@ void DomainHandler::setIceServerHostnameAndID(const QString& iceServerHostname,
         replaceableSockAddr = new (replaceableSockAddr) HifiSockAddr(iceServerHostname, ICE_SERVER_DEFAULT_PORT);
         _iceServerSockAddr.setObjectName("IceServer");
 
-        auto nodeList = DependencyManager::get<NodeList>();
+        auto nodeList = getNodeList();
 
         nodeList->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerHostname);
 
@@ -213,14 +219,14 @@ void DomainHandler::setIceServerHostnameAndID(const QString& iceServerHostname,
 }
 
 void DomainHandler::activateICELocalSocket() {
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     _sockAddr = _icePeer.getLocalSocket();
     _hostname = _sockAddr.getAddress().toString();
     emit completedSocketDiscovery();
 }
 
 void DomainHandler::activateICEPublicSocket() {
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     _sockAddr = _icePeer.getPublicSocket();
     _hostname = _sockAddr.getAddress().toString();
     emit completedSocketDiscovery();
@@ -231,7 +237,7 @@ void DomainHandler::completedHostnameLookup(const QHostInfo& hostInfo) {
         if (hostInfo.addresses()[i].protocol() == QAbstractSocket::IPv4Protocol) {
             _sockAddr.setAddress(hostInfo.addresses()[i]);
 
-            DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+            getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
 
             qCDebug(networking, "DS at %s is at %s", _hostname.toLocal8Bit().constData(),
                    _sockAddr.getAddress().toString().toLocal8Bit().constData());
@@ -249,7 +255,7 @@ void DomainHandler::completedHostnameLookup(const QHostInfo& hostInfo) {
 void DomainHandler::completedIceServerHostnameLookup() {
     qCDebug(networking) << "ICE server socket is at" << _iceServerSockAddr;
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerSocket);
 
     // emit our signal so we can send a heartbeat to ice-server immediately
     emit iceSocketAndIDReceived();
@@ -274,13 +280,12 @@ void DomainHandler::setIsConnected(bool isConnected) {
 void DomainHandler::requestDomainSettings() {
     qCDebug(networking) << "Requesting settings from domain server";
 
-    Assignment::Type assignmentType = Assignment::typeForNodeType(DependencyManager::get<NodeList>()->getOwnerType());
+    Assignment::Type assignmentType = Assignment::typeForNodeType(getNodeList()->getOwnerType());
 
     auto packet = NLPacket::create(PacketType::DomainSettingsRequest, sizeof(assignmentType), true, false);
     packet->writePrimitive(assignmentType);
 
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    nodeList->sendPacket(std::move(packet), _sockAddr);
+    getNodeList()->sendPacket(std::move(packet), _sockAddr);
 
     _settingsTimer.start();
 }
@@ -347,7 +352,7 @@ void DomainHandler::processICEResponsePacket(QSharedPointer<ReceivedMessage> mes
 
     iceResponseStream >> _icePeer;
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSPeerInformation);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSPeerInformation);
 
     if (_icePeer.getUUID() != _pendingDomainID) {
         qCDebug(networking) << "Received a network peer with ID that does not match current domain. Will not attempt connection.";
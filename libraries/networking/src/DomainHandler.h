@@ -26,6 +26,8 @@
 #include "Node.h"
 #include "ReceivedMessage.h"
 
+class NodeList;
+
 const unsigned short DEFAULT_DOMAIN_SERVER_PORT = 40102;
 const unsigned short DEFAULT_DOMAIN_SERVER_DTLS_PORT = 40103;
 const quint16 DOMAIN_SERVER_HTTP_PORT = 40100;
@@ -126,6 +128,7 @@ signals:
     void domainConnectionRefused(QString reasonMessage, int reason, const QString& extraInfo);
 
 private:
+    NodeList* getNodeList() const;
     bool reasonSuggestsLogin(ConnectionRefusedReason reasonCode);
     void sendDisconnectPacket();
     void hardReset();
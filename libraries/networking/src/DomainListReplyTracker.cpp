@@ -0,0 +1,42 @@
+//
+//  DomainListReplyTracker.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListReplyTracker.h"
+
+void DomainListReplyTracker::startPacket(quint64 listVersion, quint32 replyID, quint32 numEntries) {
+    if (_hasReply && listVersion == _listVersion && replyID == _replyID && numEntries == _receivedEntries.size()) {
+        // another packet of the reply we're assembling
+        return;
+    }
+
+    _hasReply = true;
+    _listVersion = listVersion;
+    _replyID = replyID;
+    _receivedEntries.assign(numEntries, false);
+    _numEntriesReceived = 0;
+}
+
+bool DomainListReplyTracker::receiveEntry(quint32 entryIndex) {
+    if (!_hasReply || entryIndex >= _receivedEntries.size() || _receivedEntries[entryIndex]) {
+        return false;
+    }
+
+    _receivedEntries[entryIndex] = true;
+    ++_numEntriesReceived;
+    return true;
+}
+
+void DomainListReplyTracker::reset() {
+    _hasReply = false;
+    _listVersion = 0;
+    _replyID = 0;
+    _receivedEntries.clear();
+    _numEntriesReceived = 0;
+}
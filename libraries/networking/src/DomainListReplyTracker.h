@@ -0,0 +1,42 @@
+//
+//  DomainListReplyTracker.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListReplyTracker_h
+#define hifi_DomainListReplyTracker_h
+
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+// A DomainList reply is spread over several unreliable packets, any of which can be lost, duplicated,
+// or arrive interleaved with the packets of another reply. This tracks which entries of the current
+// reply have made it, so that the list version is only taken once the whole reply has been applied.
+class DomainListReplyTracker {
+public:
+    // call for each packet before its entries, a packet from a different reply starts over
+    void startPacket(quint64 listVersion, quint32 replyID, quint32 numEntries);
+
+    // returns false for an entry we already had (or one outside the reply)
+    bool receiveEntry(quint32 entryIndex);
+
+    bool isComplete() const { return _hasReply && _numEntriesReceived == _receivedEntries.size(); }
+    quint32 getNumEntriesReceived() const { return _numEntriesReceived; }
+
+    void reset();
+
+private:
+    quint64 _listVersion { 0 };
+    quint32 _replyID { 0 };
+    std::vector<bool> _receivedEntries;
+    quint32 _numEntriesReceived { 0 };
+    bool _hasReply { false };
+};
+
+#endif // hifi_DomainListReplyTracker_h
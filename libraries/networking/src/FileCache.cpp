@@ -13,11 +13,16 @@
 
 #include <cstdio>
 #include <cassert>
+#include <condition_variable>
 #include <fstream>
+#include <functional>
 #include <unordered_set>
 
 #include <QDir>
+#include <QFile>
+#include <QTextStream>
 
+#include <GenericQueueThread.h>
 #include <PathUtils.h>
 
 Q_LOGGING_CATEGORY(file_cache, "hifi.file_cache", QtWarningMsg)
@@ -25,6 +30,8 @@ Q_LOGGING_CATEGORY(file_cache, "hifi.file_cache", QtWarningMsg)
 using namespace cache;
 
 static const std::string MANIFEST_NAME = "manifest";
+// evicted files are renamed with this suffix before they are unlinked, so that the unlink can't hit a newer file
+static const std::string TOMBSTONE_EXT = ".deleted";
 
 static const size_t BYTES_PER_MEGABYTES = 1024 * 1024;
 static const size_t BYTES_PER_GIGABYTES = 1024 * BYTES_PER_MEGABYTES;
@@ -32,9 +39,74 @@ const size_t FileCache::DEFAULT_UNUSED_MAX_SIZE = 5 * BYTES_PER_GIGABYTES; // 5G
 const size_t FileCache::MAX_UNUSED_MAX_SIZE = 100 * BYTES_PER_GIGABYTES; // 100GB
 const size_t FileCache::DEFAULT_OFFLINE_MAX_SIZE = 2 * BYTES_PER_GIGABYTES; // 2GB
 
+// once over budget, evict down to this fraction of it so that eviction runs in batches rather than on every file
+static const float EVICTION_LOW_WATER_MARK = 0.9f;
+
+namespace cache {
+
+// Every FileCache shares a single I/O thread, which does the write-behinds, evictions and unlinks
+// so that they don't stall whichever (texture, model, main...) thread happened to trigger them.
+class FileCacheIOThread : public GenericQueueThread<std::function<void()>> {
+public:
+    FileCacheIOThread() {
+        setObjectName("FileCacheIO");
+        initialize(true, QThread::LowPriority);
+    }
+
+    void queueJob(const std::function<void()>& job) {
+        {
+            std::lock_guard<std::mutex> lock(_pendingJobsMutex);
+            ++_pendingJobs;
+        }
+        queueItem(job);
+    }
+
+    // unlike waitIdle, this also waits for the jobs that were taken off the queue but are still running
+    void flush() {
+        std::unique_lock<std::mutex> lock(_pendingJobsMutex);
+        _pendingJobsDone.wait(lock, [this] { return _pendingJobs == 0; });
+    }
+
+protected:
+    bool processQueueItems(const Queue& jobs) override {
+        for (const auto& job : jobs) {
+            job();
+
+            std::lock_guard<std::mutex> lock(_pendingJobsMutex);
+            if (--_pendingJobs == 0) {
+                _pendingJobsDone.notify_all();
+            }
+        }
+        return isStillRunning();
+    }
+
+private:
+    std::mutex _pendingJobsMutex;
+    std::condition_variable _pendingJobsDone;
+    int _pendingJobs { 0 };
+};
+
+}
+
+static std::weak_ptr<FileCacheIOThread> weakIOThread;
+static std::mutex ioThreadMutex;
+
+static std::shared_ptr<FileCacheIOThread> getIOThread() {
+    std::lock_guard<std::mutex> lock(ioThreadMutex);
+    auto ioThread = weakIOThread.lock();
+    if (!ioThread) {
+        ioThread = std::make_shared<FileCacheIOThread>();
+        weakIOThread = ioThread;
+    }
+    return ioThread;
+}
+
 void FileCache::setUnusedFileCacheSize(size_t unusedFilesMaxSize) {
-    _unusedFilesMaxSize = std::min(unusedFilesMaxSize, MAX_UNUSED_MAX_SIZE);
-    reserve(0);
+    {
+        Lock lock(_unusedFilesMutex);
+        _unusedFilesMaxSize = std::min(unusedFilesMaxSize, MAX_UNUSED_MAX_SIZE);
+    }
+    _ioThread->queueJob([this] { reserve(0); });
     emit dirty();
 }
 
@@ -46,10 +118,14 @@ FileCache::FileCache(const std::string& dirname, const std::string& ext, QObject
     QObject(parent),
     _ext(ext),
     _dirname(dirname),
-    _dirpath(PathUtils::getAppLocalDataFilePath(dirname.c_str()).toStdString()) {}
+    _dirpath(PathUtils::getAppLocalDataFilePath(dirname.c_str()).toStdString()),
+    _ioThread(getIOThread()) {}
 
 FileCache::~FileCache() {
+    // let the queued writes land first, so that they are either persisted or unlinked by clear
+    _ioThread->flush();
     clear();
+    _ioThread->flush();
 }
 
 void fileDeleter(File* file) {
@@ -60,20 +136,22 @@ void FileCache::initialize() {
     QDir dir(_dirpath.c_str());
 
     if (dir.exists()) {
-        auto nameFilters = QStringList(("*." + _ext).c_str());
-        auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
-        auto sort = QDir::SortFlags(QDir::Time);
-        auto files = dir.entryList(nameFilters, filters, sort);
-
-        // load persisted files
-        foreach(QString filename, files) {
-            const Key key = filename.section('.', 0, 1).toStdString();
-            const std::string filepath = dir.filePath(filename).toStdString();
-            const size_t length = std::ifstream(filepath, std::ios::binary | std::ios::ate).tellg();
-            addFile(Metadata(key, length), filepath);
+        std::vector<Metadata> manifest;
+        if (loadManifest(manifest)) {
+            // trust the manifest rather than stat every file, the entries whose file is gone are dropped
+            // the first time they are asked for
+            for (auto& metadata : manifest) {
+                std::string filepath = getFilepath(metadata.key);
+                auto file = addFile(std::move(metadata), filepath);
+                if (file) {
+                    file->_restored = true;
+                }
+            }
+            qCDebug(file_cache, "[%s] Initialized %s (%d files from the manifest)", _dirname.c_str(), _dirpath.c_str(),
+                (int)manifest.size());
+        } else {
+            scanDirectory(dir);
         }
-
-        qCDebug(file_cache, "[%s] Initialized %s", _dirname.c_str(), _dirpath.c_str());
     } else {
         dir.mkpath(_dirpath.c_str());
         qCDebug(file_cache, "[%s] Created %s", _dirname.c_str(), _dirpath.c_str());
@@ -82,6 +160,63 @@ void FileCache::initialize() {
     _initialized = true;
 }
 
+void FileCache::scanDirectory(QDir& dir) {
+    auto nameFilters = QStringList(("*." + _ext).c_str());
+    auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
+    // oldest first, so that the most recently used files are the last to be evicted
+    auto sort = QDir::SortFlags(QDir::Time | QDir::Reversed);
+    auto files = dir.entryInfoList(nameFilters, filters, sort);
+
+    foreach(const QFileInfo& fileInfo, files) {
+        const Key key = fileInfo.completeBaseName().toStdString();
+        addFile(Metadata(key, fileInfo.size()), fileInfo.filePath().toStdString());
+    }
+
+    // and drop any write-behind that was cut short, or eviction that didn't get to unlink its file
+    auto leftovers = QStringList({ ("*." + _ext + ".part").c_str(), ("*." + _ext + TOMBSTONE_EXT).c_str() });
+    foreach(const QString& leftoverFilename, dir.entryList(leftovers, filters)) {
+        dir.remove(leftoverFilename);
+    }
+
+    qCDebug(file_cache, "[%s] Initialized %s (%d files, no manifest)", _dirname.c_str(), _dirpath.c_str(), files.size());
+}
+
+// The manifest lists the key and length of the files persisted at shutdown, least recently used first, so that
+// startup neither has to stat them nor loses their LRU order. It is removed once read: if we don't shut down cleanly
+// there is no manifest, and the next startup falls back to scanning the directory.
+bool FileCache::loadManifest(std::vector<Metadata>& files) {
+    QFile manifest(QString::fromStdString(_dirpath + '/' + MANIFEST_NAME));
+    if (!manifest.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream in(&manifest);
+    while (!in.atEnd()) {
+        QStringList entry = in.readLine().split(' ');
+        bool validLength = false;
+        qulonglong length = entry.size() == 2 ? entry[1].toULongLong(&validLength) : 0;
+        if (!entry[0].isEmpty() && validLength) {
+            files.emplace_back(entry[0].toStdString(), (size_t)length);
+        }
+    }
+
+    manifest.remove();
+    return true;
+}
+
+void FileCache::saveManifest(const std::vector<FilePointer>& files) {
+    QFile manifest(QString::fromStdString(_dirpath + '/' + MANIFEST_NAME));
+    if (!manifest.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCWarning(file_cache, "[%s] Failed to write manifest", _dirname.c_str());
+        return;
+    }
+
+    QTextStream out(&manifest);
+    for (const auto& file : files) {
+        out << file->getKey().c_str() << ' ' << (qulonglong)file->getLength() << '\n';
+    }
+}
+
 FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath) {
     FilePointer file(createFile(std::move(metadata), filepath).release(), &fileDeleter);
     if (file) {
@@ -136,6 +271,25 @@ FilePointer FileCache::getFile(const Key& key) {
         if (file) {
             // if it exists, it is active - remove it from the cache
             removeUnusedFile(file);
+
+            // the files restored from the manifest weren't checked at startup, drop the ones that are gone
+            if (file->_restored) {
+                file->_restored = false;
+                FILE* restoredFile = fopen(file->getFilepath().c_str(), "rb");
+                if (restoredFile) {
+                    fclose(restoredFile);
+                } else {
+                    qCWarning(file_cache, "[%s] Dropped %s, its file is gone", _dirname.c_str(), key.c_str());
+                    _files.erase(it);
+                    file->_cache = nullptr;
+                    file->_evicted = true;
+                    _numTotalFiles -= 1;
+                    _totalFilesSize -= file->getLength();
+                    emit dirty();
+                    return FilePointer();
+                }
+            }
+
             qCDebug(file_cache, "[%s] Found %s", _dirname.c_str(), key.c_str());
             emit dirty();
         } else {
@@ -147,24 +301,69 @@ FilePointer FileCache::getFile(const Key& key) {
     return file;
 }
 
+void FileCache::writeFileAsync(const Key& key, const QByteArray& data) {
+    assert(_initialized);
+
+    {
+        Lock lock(_filesMutex);
+        if (_files.find(key) != _files.cend() || !_pendingWrites.insert(key).second) {
+            // already written, or about to be
+            return;
+        }
+    }
+
+    std::string filepath = getFilepath(key);
+    _ioThread->queueJob([this, key, data, filepath] {
+        // write next to the final path and rename, so that nobody ever finds a partially written file
+        std::string partialFilepath = filepath + ".part";
+        FILE* saveFile = fopen(partialFilepath.c_str(), "wb");
+        bool written = saveFile != nullptr &&
+            (data.isEmpty() || fwrite(data.constData(), data.size(), 1, saveFile));
+        written = (saveFile != nullptr && fclose(saveFile) == 0) && written;
+        written = written && rename(partialFilepath.c_str(), filepath.c_str()) == 0;
+
+        if (written) {
+            // nobody holds on to the new file yet, so it goes straight into the unused files
+            addFile(Metadata(key, data.size()), filepath);
+        } else {
+            qCWarning(file_cache, "[%s] Failed to write %s (%s)", _dirname.c_str(), key.c_str(), strerror(errno));
+            errno = 0;
+            remove(partialFilepath.c_str());
+        }
+
+        Lock lock(_filesMutex);
+        _pendingWrites.erase(key);
+    });
+}
+
+void FileCache::waitForPendingWrites() {
+    _ioThread->flush();
+}
+
 std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + '/' + key + '.' + _ext;
 }
 
 void FileCache::addUnusedFile(const FilePointer file) {
+    bool overBudget;
+
     {
         Lock lock(_filesMutex);
         _files[file->getKey()] = file;
     }
 
-    reserve(file->getLength());
-    file->_LRUKey = ++_lastLRUKey;
-
     {
         Lock lock(_unusedFilesMutex);
+        file->_LRUKey = ++_lastLRUKey;
         _unusedFiles.insert({ file->_LRUKey, file });
         _numUnusedFiles += 1;
         _unusedFilesSize += file->getLength();
+        overBudget = _unusedFilesSize > _unusedFilesMaxSize;
+    }
+
+    // evict on the I/O thread rather than on the thread that let go of the file
+    if (overBudget) {
+        _ioThread->queueJob([this] { reserve(0); });
     }
 
     emit dirty();
@@ -181,30 +380,53 @@ void FileCache::removeUnusedFile(const FilePointer file) {
 }
 
 void FileCache::reserve(size_t length) {
-    Lock unusedLock(_unusedFilesMutex);
-    while (!_unusedFiles.empty() &&
-            _unusedFilesSize + length > _unusedFilesMaxSize) {
-        auto it = _unusedFiles.begin();
-        auto file = it->second;
-        auto length = file->getLength();
-
-        unusedLock.unlock();
-        {
+    std::vector<std::string> tombstones;
+
+    {
+        // hold both locks so that the evicted files can't be found, or their keys written again, half way through
+        Lock filesLock(_filesMutex);
+        Lock unusedLock(_unusedFilesMutex);
+        if (_unusedFilesSize + length <= _unusedFilesMaxSize) {
+            return;
+        }
+
+        // least recently used first, until we are comfortably back under budget
+        const size_t targetSize = (size_t)(_unusedFilesMaxSize * EVICTION_LOW_WATER_MARK);
+        while (!_unusedFiles.empty() &&
+                _unusedFilesSize + length > targetSize) {
+            auto it = _unusedFiles.begin();
+            auto file = it->second;
+            auto length = file->getLength();
+
+            // the rename is cheap, the unlink is left for after the locks: once the file is out of the way,
+            // a new file written under the same key can't be unlinked in its place
+            std::string tombstone = file->getFilepath() + TOMBSTONE_EXT;
+            if (rename(file->getFilepath().c_str(), tombstone.c_str()) == 0) {
+                tombstones.push_back(tombstone);
+            } else {
+                remove(file->getFilepath().c_str());
+            }
             file->_cache = nullptr;
-            Lock lock(_filesMutex);
+            file->_evicted = true;
             _files.erase(file->getKey());
+
+            _unusedFiles.erase(it);
+            _numTotalFiles -= 1;
+            _numUnusedFiles -= 1;
+            _totalFilesSize -= length;
+            _unusedFilesSize -= length;
         }
-        unusedLock.lock();
+    }
 
-        _unusedFiles.erase(it);
-        _numTotalFiles -= 1;
-        _numUnusedFiles -= 1;
-        _totalFilesSize -= length;
-        _unusedFilesSize -= length;
+    for (const auto& tombstone : tombstones) {
+        qCInfo(file_cache, "Unlinked %s", tombstone.c_str());
+        remove(tombstone.c_str());
     }
 }
 
 void FileCache::clear() {
+    std::vector<FilePointer> persistedFiles;
+
     Lock unusedFilesLock(_unusedFilesMutex);
     for (const auto& pair : _unusedFiles) {
         auto& file = pair.second;
@@ -214,10 +436,15 @@ void FileCache::clear() {
             _totalFilesSize -= file->getLength();
         } else {
             file->_shouldPersist = true;
+            persistedFiles.push_back(file);
             qCDebug(file_cache, "[%s] Persisting %s", _dirname.c_str(), file->getKey().c_str());
         }
     }
     _unusedFiles.clear();
+
+    if (_initialized) {
+        saveManifest(persistedFiles);
+    }
 }
 
 void File::deleter() {
@@ -225,7 +452,8 @@ void File::deleter() {
         FilePointer self(this, &fileDeleter);
         _cache->addUnusedFile(self);
     } else {
-        deleteLater();
+        // File has no events of its own, so it can go right away (the unlink itself is queued)
+        delete this;
     }
 }
 
@@ -235,9 +463,23 @@ File::File(Metadata&& metadata, const std::string& filepath) :
     _filepath(filepath) {}
 
 File::~File() {
-    QFile file(getFilepath().c_str());
-    if (file.exists() && !_shouldPersist) {
-        qCInfo(file_cache, "Unlinked %s", getFilepath().c_str());
-        file.remove();
+    // evicted files were already moved out of the way by the cache
+    if (_shouldPersist || _evicted) {
+        return;
+    }
+
+    std::string filepath = getFilepath();
+    auto unlink = [filepath] {
+        QFile file(filepath.c_str());
+        if (file.exists()) {
+            qCInfo(file_cache, "Unlinked %s", filepath.c_str());
+            file.remove();
+        }
+    };
+
+    if (auto ioThread = weakIOThread.lock()) {
+        ioThread->queueJob(unlink);
+    } else {
+        unlink();
     }
 }
@@ -17,10 +17,15 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include <QByteArray>
 #include <QObject>
 #include <QLoggingCategory>
 
+class QDir;
+
 Q_DECLARE_LOGGING_CATEGORY(file_cache)
 
 namespace cache {
@@ -28,6 +33,8 @@ namespace cache {
 class File;
 using FilePointer = std::shared_ptr<File>;
 
+class FileCacheIOThread;
+
 class FileCache : public QObject {
     Q_OBJECT
     Q_PROPERTY(size_t numTotal READ getNumTotalFiles NOTIFY dirty)
@@ -50,6 +57,10 @@ public:
 
     void setOfflineFileCacheSize(size_t offlineFilesMaxSize);
 
+    /// block until the writes queued by writeFileAsync have landed, derived classes using it must call this
+    /// in their destructor since the writes end up calling createFile
+    void waitForPendingWrites();
+
     // initialize FileCache with a directory name (not a path, ex.: "temp_jpgs") and an ext (ex.: "jpg")
     FileCache(const std::string& dirname, const std::string& ext, QObject* parent = nullptr);
     virtual ~FileCache();
@@ -72,6 +83,9 @@ public:
     //  auto key = lookup_hash_for(url); // assuming hashing url in create/evictedFile overrides
     //  return getFile(key);
     // }
+    //
+    // derived classes that don't need the file right away should prefer writeFileAsync, which writes (and evicts)
+    // on the cache I/O thread instead of the caller's
 
 signals:
     void dirty();
@@ -83,6 +97,9 @@ protected:
     FilePointer writeFile(const char* data, Metadata&& metadata);
     FilePointer getFile(const Key& key);
 
+    /// queue a write-behind on the I/O thread, the file can be found with getFile once it is fully written
+    void writeFileAsync(const Key& key, const QByteArray& data);
+
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath) = 0;
 
@@ -94,6 +111,10 @@ private:
 
     std::string getFilepath(const Key& key);
 
+    void scanDirectory(QDir& dir);
+    bool loadManifest(std::vector<Metadata>& files);
+    void saveManifest(const std::vector<FilePointer>& files);
+
     FilePointer addFile(Metadata&& metadata, const std::string& filepath);
     void addUnusedFile(const FilePointer file);
     void removeUnusedFile(const FilePointer file);
@@ -110,7 +131,10 @@ private:
     std::string _dirpath;
     bool _initialized { false };
 
+    std::shared_ptr<FileCacheIOThread> _ioThread;
+
     std::unordered_map<Key, std::weak_ptr<File>> _files;
+    std::unordered_set<Key> _pendingWrites;
     Mutex _filesMutex;
 
     std::map<int, FilePointer> _unusedFiles;
@@ -151,6 +175,8 @@ private:
     int _LRUKey { 0 };
 
     bool _shouldPersist { false };
+    bool _evicted { false };
+    bool _restored { false };
 };
 
 }
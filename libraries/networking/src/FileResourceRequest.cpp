@@ -25,8 +25,17 @@ void FileResourceRequest::doSend() {
     QFile file(filename);
     if (file.exists()) {
         if (file.open(QFile::ReadOnly)) {
-            _data = file.readAll();
-            _result = ResourceRequest::Success;
+            if (_byteRange.isSet()) {
+                if (_byteRange.fromInclusive < file.size() && file.seek(_byteRange.fromInclusive)) {
+                    _data = file.read(_byteRange.size());
+                    _result = ResourceRequest::Success;
+                } else {
+                    _result = ResourceRequest::InvalidByteRange;
+                }
+            } else {
+                _data = file.readAll();
+                _result = ResourceRequest::Success;
+            }
         } else {
             _result = ResourceRequest::AccessDenied;
         }
@@ -21,6 +21,8 @@
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 
+static const int HTTP_PARTIAL_CONTENT = 206;
+
 HTTPResourceRequest::~HTTPResourceRequest() {
     if (_reply) {
         _reply->disconnect(this);
@@ -59,6 +61,12 @@ void HTTPResourceRequest::doSend() {
         networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
     }
 
+    if (_byteRange.isSet()) {
+        // HTTP byte ranges include both ends
+        auto byteRange = QString("bytes=%1-%2").arg(_byteRange.fromInclusive).arg(_byteRange.toExclusive - 1);
+        networkRequest.setRawHeader("Range", byteRange.toLatin1());
+    }
+
     _reply = NetworkAccessManager::getInstance().get(networkRequest);
     
     connect(_reply, &QNetworkReply::finished, this, &HTTPResourceRequest::onRequestFinished);
@@ -76,6 +84,10 @@ void HTTPResourceRequest::onRequestFinished() {
     switch(_reply->error()) {
         case QNetworkReply::NoError:
             _data = _reply->readAll();
+            if (_byteRange.isSet() && _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != HTTP_PARTIAL_CONTENT) {
+                // the server (or the disk cache) answered with the whole resource, keep the part that was asked for
+                _data = _data.mid(_byteRange.fromInclusive, _byteRange.size());
+            }
             _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
             _result = Success;
             break;
@@ -490,6 +490,19 @@ NodeData* LimitedNodeList::getOrCreateLinkedData(SharedNodePointer node) {
     return node->getLinkedData();
 }
 
+void LimitedNodeList::updateNodeSnapshot() {
+    // insertions only take a read lock on _nodeMutex, so concurrent writers are serialized here,
+    // and the last one to publish has seen every change made before it
+    std::lock_guard<std::mutex> lock(_nodeSnapshotMutex);
+
+    auto nodes = std::make_shared<NodeSnapshot>();
+    nodes->reserve(_nodeHash.size());
+    for (const UUIDNodePair& nodePair : _nodeHash) {
+        nodes->push_back(nodePair.second);
+    }
+    std::atomic_store(&_nodeSnapshot, std::shared_ptr<const NodeSnapshot>(nodes));
+}
+
 SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
     QReadLocker readLocker(&_nodeMutex);
 
@@ -514,6 +527,8 @@ void LimitedNodeList::eraseAllNodes() {
                 killedNodes.insert(it->second);
                 it = _nodeHash.unsafe_erase(it);
             }
+
+            updateNodeSnapshot();
         }
     }
 
@@ -541,6 +556,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID) {
         {
             QWriteLocker writeLocker(&_nodeMutex);
             _nodeHash.unsafe_erase(it);
+            updateNodeSnapshot();
         }
 
         handleNodeKill(matchingNode);
@@ -610,6 +626,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
                 auto oldSoloNode = previousSoloIt->second;
 
                 _nodeHash.unsafe_erase(previousSoloIt);
+                updateNodeSnapshot();
                 handleNodeKill(oldSoloNode);
 
                 // convert the current lock back to a read lock for insertion of new node
@@ -620,6 +637,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
 
         // insert the new node and release our read lock
         _nodeHash.insert(UUIDNodePair(newNode->getUUID(), newNodePointer));
+        updateNodeSnapshot();
         readLocker.unlock();
 
         qCDebug(networking) << "Added" << *newNode;
@@ -1060,11 +1078,9 @@ void LimitedNodeList::sendPeerQueryToIceServer(const HifiSockAddr& iceServerSock
 }
 
 SharedNodePointer LimitedNodeList::findNodeWithAddr(const HifiSockAddr& addr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&](const UUIDNodePair& pair) {
-        return pair.second->getActiveSocket() ? (*pair.second->getActiveSocket() == addr) : false;
+    return nodeMatchingPredicate([&](const SharedNodePointer& node) {
+        return node->getActiveSocket() ? (*node->getActiveSocket() == addr) : false;
     });
-    return (it != std::end(_nodeHash)) ? it->second : SharedNodePointer();
 }
 
 void LimitedNodeList::sendPacketToIceServer(PacketType packetType, const HifiSockAddr& iceServerSockAddr,
@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -69,6 +70,7 @@ const QString USERNAME_UUID_REPLACEMENT_STATS_KEY = "$username";
 using namespace tbb;
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
+typedef std::vector<SharedNodePointer> NodeSnapshot;
 
 typedef quint8 PingType_t;
 namespace PingType {
@@ -78,6 +80,13 @@ namespace PingType {
     const PingType_t Symmetric = 3;
 }
 
+// each segment of a DomainList packet starts with one of these
+typedef quint8 DomainListEntryType_t;
+namespace DomainListEntryType {
+    const DomainListEntryType_t Node = 0;
+    const DomainListEntryType_t RemovedNode = 1;
+}
+
 class LimitedNodeList : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
@@ -138,7 +147,7 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { return getNodeSnapshot()->size(); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
 
@@ -176,68 +185,59 @@ public:
     SharedNodePointer findNodeWithAddr(const HifiSockAddr& addr);
 
     using value_type = SharedNodePointer;
-    using const_iterator = std::vector<value_type>::const_iterator;
+    using const_iterator = NodeSnapshot::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // The node iterators below walk an immutable snapshot of the node set, republished whenever a node is
+    // added or removed, so they neither lock nor copy. A node killed during the iteration may still be visited,
+    // the snapshot holds a reference to it until the iteration is done.
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor, 
                     int* lockWaitOut = nullptr, 
                     int* nodeTransformOut = nullptr, 
                     int* functorOut = nullptr) {
         auto start = usecTimestampNow();
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
-
-            std::vector<SharedNodePointer> nodes(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), nodes.begin(), [](const NodeHash::value_type& it) {
-                return it.second;
-            });
-            auto endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        auto nodes = getNodeSnapshot();
+        auto endLock = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = (endLock - start);
+        }
+        if (nodeTransformOut) {
+            *nodeTransformOut = 0;
+        }
 
-            functor(nodes.cbegin(), nodes.cend());
-            auto endFunctor = usecTimestampNow();
-            if (functorOut) {
-                *functorOut = (endFunctor - endTransform);
-            }
+        functor(nodes->cbegin(), nodes->cend());
+        auto endFunctor = usecTimestampNow();
+        if (functorOut) {
+            *functorOut = (endFunctor - endLock);
         }
     }
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const SharedNodePointer& node : *nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const SharedNodePointer& node : *nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const SharedNodePointer& node : *nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -245,11 +245,11 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const SharedNodePointer& node : *nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
@@ -264,6 +264,7 @@ public:
     void flagTimeForConnectionStep(ConnectionStep connectionStep);
 
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
+    udt::Socket::QueueDepthsVector sampleQueueDepthsForAllConnections() { return _nodeSocket.sampleQueueDepthsForAllConnections(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
@@ -346,9 +347,15 @@ protected:
 
     bool sockAddrBelongsToNode(const HifiSockAddr& sockAddr) { return findNodeWithAddr(sockAddr) != SharedNodePointer(); }
 
+    // the snapshot is read without locking, call this after changing _nodeHash while holding _nodeMutex
+    void updateNodeSnapshot();
+    std::shared_ptr<const NodeSnapshot> getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
+
     QUuid _sessionUUID;
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex;
+    std::mutex _nodeSnapshotMutex;
+    std::shared_ptr<const NodeSnapshot> _nodeSnapshot { std::make_shared<NodeSnapshot>() };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket;
     HifiSockAddr _localSockAddr;
@@ -383,6 +390,8 @@ protected:
         while (it != _nodeHash.end()) {
             functor(it);
         }
+
+        updateNodeSnapshot();
     }
 
 private slots:
@@ -99,6 +99,14 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     connect(this, &LimitedNodeList::nodeAdded, this, &NodeList::startNodeHolePunch);
     connect(this, &LimitedNodeList::nodeSocketUpdated, this, &NodeList::startNodeHolePunch);
 
+    // if we drop a node on our own (e.g. it went silent) our list no longer matches the domain-server's version of it,
+    // so ask for a full list on the next check in
+    connect(this, &LimitedNodeList::nodeKilled, this, [this] {
+        if (!_isApplyingDomainList) {
+            _domainListVersion = 0;
+        }
+    });
+
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
@@ -130,33 +138,40 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     packetReceiver.registerListener(PacketType::DomainServerPathResponse, this, "processDomainServerPathResponse");
     packetReceiver.registerListener(PacketType::DomainServerRemovedNode, this, "processDomainServerRemovedNode");
     packetReceiver.registerListener(PacketType::UsernameFromIDReply, this, "processUsernameFromIDReply");
+    packetReceiver.registerListener(PacketType::NodeProfileRequest, this, "processNodeProfileRequest");
+
+    connect(&_profileCapture, &ProfileCapture::finished, this, &NodeList::sendProfileToDomainServer);
 }
 
-qint64 NodeList::sendStats(QJsonObject statsObject, HifiSockAddr destination) {
+NodeList* NodeList::createDetached(NodeType_t ownerType) {
+    // bind to an ephemeral port so we never collide with the process NodeList or each other
+    const int EPHEMERAL_PORT = 0;
+    return new NodeList(ownerType, EPHEMERAL_PORT);
+}
+
+qint64 NodeList::sendStats(QByteArray encodedStats, HifiSockAddr destination) {
     if (thread() != QThread::currentThread()) {
         QMetaObject::invokeMethod(this, "sendStats", Qt::QueuedConnection,
-                                  Q_ARG(QJsonObject, statsObject),
+                                  Q_ARG(QByteArray, encodedStats),
                                   Q_ARG(HifiSockAddr, destination));
         return 0;
     }
 
     auto statsPacketList = NLPacketList::create(PacketType::NodeJsonStats, QByteArray(), true, true);
-
-    QJsonDocument jsonDocument(statsObject);
-    statsPacketList->write(jsonDocument.toBinaryData());
+    statsPacketList->write(encodedStats);
 
     sendPacketList(std::move(statsPacketList), destination);
     return 0;
 }
 
-qint64 NodeList::sendStatsToDomainServer(QJsonObject statsObject) {
+qint64 NodeList::sendStatsToDomainServer(QByteArray encodedStats) {
     if (thread() != QThread::currentThread()) {
         QMetaObject::invokeMethod(this, "sendStatsToDomainServer", Qt::QueuedConnection,
-                                  Q_ARG(QJsonObject, statsObject));
+                                  Q_ARG(QByteArray, encodedStats));
         return 0;
     }
 
-    return sendStats(statsObject, _domainHandler.getSockAddr());
+    return sendStats(encodedStats, _domainHandler.getSockAddr());
 }
 
 void NodeList::timePingReply(ReceivedMessage& message, const SharedNodePointer& sendingNode) {
@@ -239,6 +254,9 @@ void NodeList::reset() {
 
     _numNoReplyDomainCheckIns = 0;
 
+    _domainListVersion = 0;
+    _domainListReply.reset();
+
     // lock and clear our set of radius ignored IDs
     _radiusIgnoredSetLock.lockForWrite();
     _radiusIgnoredNodeIDs.clear();
@@ -397,6 +415,11 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // let the domain-server know which version of the node list we have so it can send us a delta
+            packetStream << _domainListVersion;
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -592,7 +615,7 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     // emit our signal so listeners know we just heard from the DS
     emit receivedDomainServerList();
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSList);
+    flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSList);
 
     QDataStream packetStream(message->getMessage());
 
@@ -624,11 +647,53 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     // pull the permissions/right/privileges for this node out of the stream
     NodePermissions newPermissions;
     packetStream >> newPermissions;
+
+    // pull the list version, the version this list is a delta against (0 for a full list),
+    // the ID of this reply and the total number of entries across all packets of the reply
+    quint64 listVersion;
+    quint64 baseVersion;
+    quint32 replyID;
+    quint32 numEntries;
+    packetStream >> listVersion >> baseVersion >> replyID >> numEntries;
+
+    if (listVersion < _domainListVersion) {
+        // this is a reply to an older check in that arrived late, we already have everything in it
+        return;
+    }
+
     setPermissions(newPermissions);
 
-    // pull each node in the packet
+    if (baseVersion != 0 && baseVersion != _domainListVersion) {
+        // a delta against a list we don't have, we can't apply it - ask for a full list next time
+        _domainListVersion = 0;
+        return;
+    }
+
+    _domainListReply.startPacket(listVersion, replyID, numEntries);
+
+    // pull each entry in the packet, applying an entry twice is harmless but it only counts once
+    _isApplyingDomainList = true;
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint32 entryIndex;
+        DomainListEntryType_t entryType;
+        packetStream >> entryIndex >> entryType;
+
+        if (entryType == DomainListEntryType::RemovedNode) {
+            QUuid removedNodeUUID;
+            packetStream >> removedNodeUUID;
+            killNodeWithUUID(removedNodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
+
+        _domainListReply.receiveEntry(entryIndex);
+    }
+    _isApplyingDomainList = false;
+
+    // only take the new version once every entry of this reply has made it to us,
+    // otherwise we keep asking for deltas against the last complete one
+    if (_domainListReply.isComplete()) {
+        _domainListVersion = listVersion;
     }
 }
 
@@ -644,7 +709,11 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+
+    // the domain-server knows about this removal, so it doesn't invalidate our list version
+    _isApplyingDomainList = true;
     killNodeWithUUID(nodeUUID);
+    _isApplyingDomainList = false;
 }
 
 void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
@@ -1101,6 +1170,30 @@ void NodeList::processUsernameFromIDReply(QSharedPointer<ReceivedMessage> messag
     emit usernameFromIDReply(nodeUUIDString, username, machineFingerprintString, isAdmin);
 }
 
+void NodeList::processNodeProfileRequest(QSharedPointer<ReceivedMessage> message) {
+    // only the domain-server can ask for a capture, and never one of a client
+    if (message->getSenderSockAddr() != _domainHandler.getSockAddr() || _ownerType == NodeType::Agent) {
+        return;
+    }
+
+    quint16 seconds;
+    message->readPrimitive(&seconds);
+
+    if (!_profileCapture.start(seconds)) {
+        // let the domain-server know right away that there won't be any trace
+        sendProfileToDomainServer(QByteArray());
+    }
+}
+
+void NodeList::sendProfileToDomainServer(QByteArray trace) {
+    // the flag keeps the reply from being empty when the capture couldn't be made
+    auto profilePacketList = NLPacketList::create(PacketType::NodeProfileReply, QByteArray(), true, true);
+    profilePacketList->writePrimitive((bool)!trace.isEmpty());
+    profilePacketList->write(trace);
+
+    sendPacketList(std::move(profilePacketList), _domainHandler.getSockAddr());
+}
+
 void NodeList::setRequestsDomainListData(bool isRequesting) {
     // Tell the avatar mixer and audio mixer whether I want to receive any additional data to which I might be entitled
     if (_requestsDomainListData == isRequesting) {
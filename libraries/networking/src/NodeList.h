@@ -33,8 +33,10 @@
 #include <SettingHandle.h>
 
 #include "DomainHandler.h"
+#include "DomainListReplyTracker.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
+#include "ProfileCapture.h"
 
 const quint64 DOMAIN_SERVER_CHECK_IN_MSECS = 1 * 1000;
 
@@ -52,11 +54,15 @@ class NodeList : public LimitedNodeList {
     SINGLETON_DEPENDENCY
 
 public:
+    // creates a NodeList beside the process singleton, owned by the caller, so that one process can act as several clients
+    static NodeList* createDetached(NodeType_t ownerType);
+
     NodeType_t getOwnerType() const { return _ownerType.load(); }
     void setOwnerType(NodeType_t ownerType) { _ownerType.store(ownerType); }
 
-    Q_INVOKABLE qint64 sendStats(QJsonObject statsObject, HifiSockAddr destination);
-    Q_INVOKABLE qint64 sendStatsToDomainServer(QJsonObject statsObject);
+    // encodedStats is a payload from a NodeStatsEncoder
+    Q_INVOKABLE qint64 sendStats(QByteArray encodedStats, HifiSockAddr destination);
+    Q_INVOKABLE qint64 sendStatsToDomainServer(QByteArray encodedStats);
 
     int getNumNoReplyDomainCheckIns() const { return _numNoReplyDomainCheckIns; }
     DomainHandler& getDomainHandler() { return _domainHandler; }
@@ -112,6 +118,8 @@ public slots:
 
     void processUsernameFromIDReply(QSharedPointer<ReceivedMessage> message);
 
+    void processNodeProfileRequest(QSharedPointer<ReceivedMessage> message);
+
 #if (PR_BUILD || DEV_BUILD)
     void toggleSendNewerDSConnectVersion(bool shouldSendNewerVersion) { _shouldSendNewerVersion = shouldSendNewerVersion; }
 #endif
@@ -137,6 +145,8 @@ private slots:
 
     void maybeSendIgnoreSetToNode(SharedNodePointer node);
 
+    void sendProfileToDomainServer(QByteArray trace);
+
 private:
     NodeList() : LimitedNodeList(INVALID_PORT, INVALID_PORT) { assert(false); } // Not implemented, needed for DependencyManager templates compile
     NodeList(char ownerType, int socketListenPort = INVALID_PORT, int dtlsListenPort = INVALID_PORT);
@@ -165,6 +175,14 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData;
 
+    // the domain-server versions its node list, we send back the last version we fully applied
+    // so that it can reply with only the changes since then
+    quint64 _domainListVersion { 0 };
+    DomainListReplyTracker _domainListReply;
+    bool _isApplyingDomainList { false };
+
+    ProfileCapture _profileCapture { this };
+
     mutable QReadWriteLock _radiusIgnoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _radiusIgnoredNodeIDs;
     mutable QReadWriteLock _ignoredSetLock;
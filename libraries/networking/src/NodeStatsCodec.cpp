@@ -0,0 +1,393 @@
+//
+//  NodeStatsCodec.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeStatsCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QtEndian>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+#include "NetworkLogging.h"
+
+using namespace NodeStatsCodec;
+
+static const int MAX_KEYS = std::numeric_limits<KeyID>::max();
+static const int ROOT_NODE = 0;
+
+template <typename T>
+static void appendBigEndian(QByteArray& data, T value) {
+    // matches the byte order QDataStream uses when the decoder reads the value back
+    uchar bytes[sizeof(T)];
+    qToBigEndian<T>(value, bytes);
+    data.append(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+static void appendByteArray(QByteArray& data, const QByteArray& bytes) {
+    appendBigEndian<quint32>(data, bytes.size());
+    data.append(bytes);
+}
+
+static bool readValue(QDataStream& stream, QJsonValue& value) {
+    quint8 type;
+    stream >> type;
+
+    switch ((ValueType) type) {
+        case ValueType::Null:
+            value = QJsonValue();
+            break;
+        case ValueType::False:
+            value = false;
+            break;
+        case ValueType::True:
+            value = true;
+            break;
+        case ValueType::Integer: {
+            qint32 number;
+            stream >> number;
+            value = number;
+            break;
+        }
+        case ValueType::Double: {
+            double number;
+            stream >> number;
+            value = number;
+            break;
+        }
+        case ValueType::String: {
+            QByteArray utf8String;
+            stream >> utf8String;
+            value = QString::fromUtf8(utf8String);
+            break;
+        }
+        case ValueType::Array: {
+            QByteArray binaryArray;
+            stream >> binaryArray;
+            value = QJsonDocument::fromBinaryData(binaryArray).array();
+            break;
+        }
+        case ValueType::EmptyObject:
+            value = QJsonObject();
+            break;
+        default:
+            return false;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+NodeStatsEncoder::NodeStatsEncoder() {
+    _encodedValue.reserve(sizeof(quint8) + sizeof(double));
+}
+
+void NodeStatsEncoder::reset() {
+    _packetsSinceFullSnapshot = FULL_SNAPSHOT_INTERVAL;
+}
+
+void NodeStatsEncoder::beginStats() {
+    _isFullSnapshot = _overflowed || _packetsSinceFullSnapshot >= FULL_SNAPSHOT_INTERVAL;
+
+    if (_isFullSnapshot) {
+        // start from an empty key table, the receiver will throw out everything it has
+        _nodes.clear();
+        _nodes.emplace_back(QString(), -1);
+        _leafNodes.clear();
+        _packetsSinceFullSnapshot = 0;
+        _overflowed = false;
+    } else {
+        ++_packetsSinceFullSnapshot;
+    }
+
+    ++_currentStats;
+    _scopes.assign(1, ROOT_NODE);
+    _newKeyNodes.clear();
+    _changedValues.resize(0);
+    _numChangedValues = 0;
+}
+
+int NodeStatsEncoder::childNode(const QString& key) {
+    int parent = _scopes.back();
+
+    auto it = _nodes[parent].children.constFind(key);
+    if (it != _nodes[parent].children.constEnd()) {
+        return it.value();
+    }
+
+    int node = (int) _nodes.size();
+    _nodes[parent].children.insert(key, node);
+    _nodes.emplace_back(key, parent);
+    return node;
+}
+
+QStringList NodeStatsEncoder::pathForNode(int node) const {
+    QStringList path;
+    for (; node != ROOT_NODE; node = _nodes[node].parent) {
+        path.prepend(_nodes[node].name);
+    }
+    return path;
+}
+
+void NodeStatsEncoder::beginObject(const QString& key) {
+    _scopes.push_back(childNode(key));
+}
+
+void NodeStatsEncoder::endObject() {
+    Q_ASSERT(_scopes.size() > 1);
+    _scopes.pop_back();
+}
+
+void NodeStatsEncoder::writeLeaf(const QString& key) {
+    int node = childNode(key);
+    KeyNode& leaf = _nodes[node];
+
+    if (leaf.keyID == -1) {
+        if ((int) _leafNodes.size() >= MAX_KEYS) {
+            // out of keys until the next full snapshot resets the table
+            _overflowed = true;
+            return;
+        }
+
+        leaf.keyID = (int) _leafNodes.size();
+        _leafNodes.push_back(node);
+        _newKeyNodes.push_back(node);
+    }
+
+    leaf.lastWrittenStats = _currentStats;
+
+    if (leaf.lastValue != _encodedValue) {
+        leaf.lastValue = _encodedValue;
+
+        appendBigEndian<KeyID>(_changedValues, leaf.keyID);
+        _changedValues.append(_encodedValue);
+        ++_numChangedValues;
+    }
+}
+
+void NodeStatsEncoder::write(const QString& key, bool value) {
+    _encodedValue.resize(0);
+    _encodedValue.append((char) (value ? ValueType::True : ValueType::False));
+    writeLeaf(key);
+}
+
+void NodeStatsEncoder::write(const QString& key, double value) {
+    _encodedValue.resize(0);
+
+    if (std::floor(value) == value
+        && value >= std::numeric_limits<qint32>::min() && value <= std::numeric_limits<qint32>::max()) {
+        // most of our stats are counters, send those as integers
+        _encodedValue.append((char) ValueType::Integer);
+        appendBigEndian<qint32>(_encodedValue, (qint32) value);
+    } else {
+        quint64 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        _encodedValue.append((char) ValueType::Double);
+        appendBigEndian<quint64>(_encodedValue, bits);
+    }
+
+    writeLeaf(key);
+}
+
+void NodeStatsEncoder::write(const QString& key, const QString& value) {
+    _encodedValue.resize(0);
+    _encodedValue.append((char) ValueType::String);
+    appendByteArray(_encodedValue, value.toUtf8());
+    writeLeaf(key);
+}
+
+void NodeStatsEncoder::write(const QString& key, const QJsonValue& value) {
+    switch (value.type()) {
+        case QJsonValue::Bool:
+            write(key, value.toBool());
+            return;
+        case QJsonValue::Double:
+            write(key, value.toDouble());
+            return;
+        case QJsonValue::String:
+            write(key, value.toString());
+            return;
+        case QJsonValue::Object:
+            if (!value.toObject().isEmpty()) {
+                beginObject(key);
+                writeObject(value.toObject());
+                endObject();
+                return;
+            }
+
+            // only empty objects end up as leaves
+            _encodedValue.resize(0);
+            _encodedValue.append((char) ValueType::EmptyObject);
+            break;
+        case QJsonValue::Array:
+            // arrays are rare in stats, so they are sent whole as a single leaf
+            _encodedValue.resize(0);
+            _encodedValue.append((char) ValueType::Array);
+            appendByteArray(_encodedValue, QJsonDocument(value.toArray()).toBinaryData());
+            break;
+        default:
+            _encodedValue.resize(0);
+            _encodedValue.append((char) ValueType::Null);
+            break;
+    }
+
+    writeLeaf(key);
+}
+
+void NodeStatsEncoder::writeObject(const QJsonObject& object) {
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        write(it.key(), it.value());
+    }
+}
+
+QByteArray NodeStatsEncoder::finishStats() {
+    Q_ASSERT(_scopes.size() == 1);
+
+    std::vector<KeyID> removedKeys;
+    for (int node : _leafNodes) {
+        KeyNode& leaf = _nodes[node];
+        if (!leaf.lastValue.isEmpty() && leaf.lastWrittenStats != _currentStats) {
+            removedKeys.push_back((KeyID) leaf.keyID);
+            leaf.lastValue.clear();
+        }
+    }
+
+    QByteArray encodedStats;
+    QDataStream stream(&encodedStats, QIODevice::WriteOnly);
+
+    stream << (quint8) (_isFullSnapshot ? FullSnapshot : 0);
+
+    stream << (quint16) _newKeyNodes.size();
+    for (int node : _newKeyNodes) {
+        stream << (KeyID) _nodes[node].keyID << pathForNode(node);
+    }
+
+    // changed values are already encoded as key and value, in the order the decoder reads them
+    stream << _numChangedValues;
+    stream.writeRawData(_changedValues.constData(), _changedValues.size());
+
+    stream << (quint16) removedKeys.size();
+    for (auto key : removedKeys) {
+        stream << key;
+    }
+
+    return encodedStats;
+}
+
+QByteArray NodeStatsEncoder::encode(const QJsonObject& statsObject) {
+    beginStats();
+    writeObject(statsObject);
+    return finishStats();
+}
+
+bool NodeStatsDecoder::decode(const QByteArray& encodedStats) {
+    QDataStream stream(encodedStats);
+
+    quint8 flags;
+    stream >> flags;
+
+    if (flags & FullSnapshot) {
+        _keyPaths.clear();
+        _values.clear();
+        _hasSnapshot = true;
+    } else if (!_hasSnapshot) {
+        // we can't apply a delta without having seen the snapshot it is based on, wait for the next one
+        return false;
+    }
+
+    quint16 numNewKeys;
+    stream >> numNewKeys;
+    for (quint16 i = 0; i < numNewKeys && stream.status() == QDataStream::Ok; ++i) {
+        KeyID key;
+        QStringList path;
+        stream >> key >> path;
+        _keyPaths[key] = path;
+    }
+
+    quint16 numChangedValues;
+    stream >> numChangedValues;
+    for (quint16 i = 0; i < numChangedValues; ++i) {
+        KeyID key;
+        QJsonValue value;
+        stream >> key;
+
+        if (!readValue(stream, value) || !_keyPaths.contains(key)) {
+            qCWarning(networking) << "Dropping malformed node stats, waiting for next full snapshot.";
+            _hasSnapshot = false;
+            return false;
+        }
+
+        _values[key] = value;
+    }
+
+    quint16 numRemovedValues;
+    stream >> numRemovedValues;
+    for (quint16 i = 0; i < numRemovedValues; ++i) {
+        KeyID key;
+        stream >> key;
+        _values.remove(key);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(networking) << "Dropping truncated node stats, waiting for next full snapshot.";
+        _hasSnapshot = false;
+        return false;
+    }
+
+    return true;
+}
+
+using PathAndValue = std::pair<QStringList, QJsonValue>;
+
+static QJsonObject buildObject(const std::vector<PathAndValue>& leaves, size_t begin, size_t end, int depth) {
+    QJsonObject object;
+
+    size_t i = begin;
+    while (i < end) {
+        const QString& key = leaves[i].first[depth];
+
+        // leaves are sorted by path, so everything under this key is contiguous
+        size_t groupEnd = i + 1;
+        while (groupEnd < end && leaves[groupEnd].first[depth] == key) {
+            ++groupEnd;
+        }
+
+        if (leaves[i].first.size() == depth + 1) {
+            object[key] = leaves[i].second;
+        } else {
+            object[key] = buildObject(leaves, i, groupEnd, depth + 1);
+        }
+
+        i = groupEnd;
+    }
+
+    return object;
+}
+
+QJsonObject NodeStatsDecoder::toJSON() const {
+    std::vector<PathAndValue> leaves;
+    leaves.reserve(_values.size());
+
+    for (auto it = _values.constBegin(); it != _values.constEnd(); ++it) {
+        const QStringList& path = _keyPaths.value(it.key());
+        if (!path.isEmpty()) {
+            leaves.emplace_back(path, it.value());
+        }
+    }
+
+    std::sort(leaves.begin(), leaves.end(), [](const PathAndValue& a, const PathAndValue& b) {
+        return std::lexicographical_compare(a.first.begin(), a.first.end(), b.first.begin(), b.first.end());
+    });
+
+    return buildObject(leaves, 0, leaves.size(), 0);
+}
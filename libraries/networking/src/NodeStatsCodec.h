@@ -0,0 +1,128 @@
+//
+//  NodeStatsCodec.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeStatsCodec_h
+#define hifi_NodeStatsCodec_h
+
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QStringList>
+
+// Node stats are sent to the domain-server as a flat list of (key, value) leaves instead of a JSON document.
+// Each leaf path is given a numeric key the first time it is sent, and after that only the leaves
+// whose value changed (or that were removed) are written. Every so often a full snapshot is sent, which
+// also resets the key table on both sides so that keys for stats that have gone away don't accumulate.
+namespace NodeStatsCodec {
+    using KeyID = quint16;
+
+    enum Flag : quint8 {
+        FullSnapshot = 0x1
+    };
+
+    enum class ValueType : quint8 {
+        Null = 0,
+        False,
+        True,
+        Integer,
+        Double,
+        String,
+        Array,
+        EmptyObject
+    };
+}
+
+class NodeStatsEncoder {
+public:
+    static const int FULL_SNAPSHOT_INTERVAL = 30;
+
+    NodeStatsEncoder();
+
+    // Producers write their stats straight into the encoder between beginStats and finishStats, nesting them
+    // with beginObject/endObject. Keys are interned per level, so a stat that was already sent costs one hash
+    // lookup and a compare of its encoded value, and nothing is built for stats that didn't change.
+    void beginStats();
+    void beginObject(const QString& key);
+    void endObject();
+
+    void write(const QString& key, bool value);
+    void write(const QString& key, double value);
+    void write(const QString& key, const QString& value);
+    void write(const QString& key, const char* value) { write(key, QString::fromUtf8(value)); }
+
+    // stats that already come as JSON, objects are nested and arrays are sent whole as a single value
+    void write(const QString& key, const QJsonValue& value);
+
+    template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    void write(const QString& key, T value) { write(key, (double) value); }
+
+    // returns the encoded payload for what was written since beginStats, relative to what was previously encoded
+    QByteArray finishStats();
+
+    // same as writing every value of the object between beginStats and finishStats
+    QByteArray encode(const QJsonObject& statsObject);
+
+    // forces the next packet to be a full snapshot, used when the receiver may have lost our state
+    void reset();
+
+private:
+    struct KeyNode {
+        KeyNode(const QString& name, int parent) : name(name), parent(parent) {}
+
+        QString name;
+        int parent;
+        QHash<QString, int> children;
+
+        int keyID { -1 }; // assigned the first time this node is written as a leaf
+        QByteArray lastValue; // encoded value the receiver has, empty if it has none
+        quint32 lastWrittenStats { 0 };
+    };
+
+    int childNode(const QString& key);
+    QStringList pathForNode(int node) const;
+    void writeObject(const QJsonObject& object);
+    void writeLeaf(const QString& key); // writes _encodedValue
+
+    std::vector<KeyNode> _nodes;
+    std::vector<int> _scopes;
+    std::vector<int> _leafNodes; // node for each key ID
+    std::vector<int> _newKeyNodes;
+
+    QByteArray _encodedValue;
+    QByteArray _changedValues;
+    quint16 _numChangedValues { 0 };
+
+    quint32 _currentStats { 0 };
+    bool _isFullSnapshot { false };
+    int _packetsSinceFullSnapshot { FULL_SNAPSHOT_INTERVAL };
+    bool _overflowed { false };
+};
+
+class NodeStatsDecoder {
+public:
+    // applies an encoded payload, returns false if it could not be applied (e.g. a delta without its base)
+    bool decode(const QByteArray& encodedStats);
+
+    bool hasStats() const { return _hasSnapshot; }
+
+    // rebuilds the nested JSON object for the current set of stats - only done when someone asks for it
+    QJsonObject toJSON() const;
+
+private:
+    QHash<NodeStatsCodec::KeyID, QStringList> _keyPaths;
+    QHash<NodeStatsCodec::KeyID, QJsonValue> _values;
+    bool _hasSnapshot { false };
+};
+
+#endif // hifi_NodeStatsCodec_h
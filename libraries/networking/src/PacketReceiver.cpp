@@ -257,7 +257,11 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    // match senders against the node list that owns us, a process may run more than one (the agent's load generator does)
+    auto nodeList = qobject_cast<LimitedNodeList*>(parent());
+    if (!nodeList) {
+        nodeList = DependencyManager::get<LimitedNodeList>().data();
+    }
     
     SharedNodePointer matchingNode;
     
@@ -0,0 +1,210 @@
+//
+//  ProfileCapture.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProfileCapture.h"
+
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QVector>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+#include <Gzip.h>
+#include <NumericalConstants.h>
+#include <Profile.h>
+#include <Trace.h>
+
+#include "LimitedNodeList.h"
+#include "NetworkLogging.h"
+
+static const int SAMPLE_INTERVAL_MSECS = 100;
+
+const int ProfileCapture::MAX_CAPTURE_SECONDS;
+
+struct ThreadTicks {
+    qint64 threadID;
+    QString name;
+    quint64 ticks;
+};
+
+// The cpu time (user and system) of every thread of the process, in clock ticks.
+// Only linux exposes it for every thread, elsewhere the captures don't have thread times.
+static QVector<ThreadTicks> readThreadTicks() {
+    QVector<ThreadTicks> result;
+#ifdef Q_OS_LINUX
+    QDir taskDir("/proc/self/task");
+    for (const auto& threadID : taskDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QFile statFile(taskDir.filePath(threadID + "/stat"));
+        if (!statFile.open(QIODevice::ReadOnly)) {
+            // the thread exited since we listed them
+            continue;
+        }
+        QByteArray stat = statFile.readAll();
+
+        // the name is between parentheses and may contain spaces, the state is the first field after it,
+        // utime and stime are the 14th and 15th fields of the line
+        const int FIRST_FIELD_AFTER_NAME = 3;
+        const int UTIME_FIELD = 14 - FIRST_FIELD_AFTER_NAME;
+        const int STIME_FIELD = 15 - FIRST_FIELD_AFTER_NAME;
+
+        int nameStart = stat.indexOf('(');
+        int nameEnd = stat.lastIndexOf(')');
+        if (nameStart < 0 || nameEnd < nameStart) {
+            continue;
+        }
+        auto fields = stat.mid(nameEnd + 2).split(' ');
+        if (fields.size() <= STIME_FIELD) {
+            continue;
+        }
+
+        ThreadTicks thread;
+        thread.threadID = threadID.toLongLong();
+        thread.name = QString::fromUtf8(stat.mid(nameStart + 1, nameEnd - nameStart - 1));
+        thread.ticks = fields[UTIME_FIELD].toULongLong() + fields[STIME_FIELD].toULongLong();
+        result.push_back(thread);
+    }
+#endif
+    return result;
+}
+
+static double ticksToMsecs(quint64 ticks) {
+#ifdef Q_OS_LINUX
+    static const double TICKS_PER_SECOND = (double)sysconf(_SC_CLK_TCK);
+    return (double)ticks * 1000.0 / TICKS_PER_SECOND;
+#else
+    return 0.0;
+#endif
+}
+
+ProfileCapture::ProfileCapture(QObject* parent) :
+    QObject(parent)
+{
+    _sampleTimer.setInterval(SAMPLE_INTERVAL_MSECS);
+    connect(&_sampleTimer, &QTimer::timeout, this, &ProfileCapture::sample);
+
+    _stopTimer.setSingleShot(true);
+    connect(&_stopTimer, &QTimer::timeout, this, &ProfileCapture::stop);
+}
+
+bool ProfileCapture::start(int seconds) {
+    if (isCapturing() || !DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (tracer->isEnabled()) {
+        qCDebug(networking) << "Not starting a profile capture, the tracer is already tracing";
+        return false;
+    }
+
+    seconds = std::max(1, std::min(seconds, MAX_CAPTURE_SECONDS));
+    qCDebug(networking) << "Starting a" << seconds << "second profile capture";
+
+    _threadTimes.clear();
+    for (const auto& thread : readThreadTicks()) {
+        ThreadTimes& times = _threadTimes[thread.threadID];
+        times.name = thread.name;
+        times.startTicks = thread.ticks;
+        times.lastTicks = thread.ticks;
+    }
+
+    tracer->startTracing();
+
+    _elapsedTimer.start();
+    _lastSampleMsecs = 0;
+    _sampleTimer.start();
+    _stopTimer.start(seconds * (int)MSECS_PER_SECOND);
+    return true;
+}
+
+void ProfileCapture::sample() {
+    qint64 nowMsecs = _elapsedTimer.elapsed();
+    sampleThreadTimes(nowMsecs - _lastSampleMsecs);
+    sampleQueueDepths();
+    _lastSampleMsecs = nowMsecs;
+}
+
+void ProfileCapture::sampleThreadTimes(qint64 elapsedMsecs) {
+    if (elapsedMsecs <= 0) {
+        return;
+    }
+
+    QVariantMap usage;
+    for (const auto& thread : readThreadTicks()) {
+        auto it = _threadTimes.find(thread.threadID);
+        if (it == _threadTimes.end()) {
+            // a thread started during the capture, it will show from the next sample on
+            ThreadTimes times;
+            times.name = thread.name;
+            times.startTicks = thread.ticks;
+            times.lastTicks = thread.ticks;
+            _threadTimes.insert(thread.threadID, times);
+            continue;
+        }
+
+        double percent = ticksToMsecs(thread.ticks - it->lastTicks) * 100.0 / (double)elapsedMsecs;
+        usage[QString("%1 (%2)").arg(thread.name).arg(thread.threadID)] = percent;
+        it->name = thread.name;
+        it->lastTicks = thread.ticks;
+    }
+
+    if (!usage.isEmpty()) {
+        PROFILE_COUNTER(app, "Thread CPU %", usage);
+    }
+}
+
+void ProfileCapture::sampleQueueDepths() {
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    if (!nodeList) {
+        return;
+    }
+
+    for (const auto& connection : nodeList->sampleQueueDepthsForAllConnections()) {
+        const auto& depths = connection.second;
+
+        // name the queue after the node at the other end, if it is one of ours
+        QString name = connection.first.toString();
+        auto node = nodeList->findNodeWithAddr(connection.first);
+        if (node) {
+            name = NodeType::getNodeTypeName(node->getType()) + " " + name;
+        }
+
+        PROFILE_COUNTER(network, "Send queue " + name, {
+            { "queued", depths.queuedPackets },
+            { "unacknowledged", depths.unacknowledgedPackets },
+            { "lost", depths.lostPackets }
+        });
+    }
+}
+
+void ProfileCapture::stop() {
+    _sampleTimer.stop();
+    sample();
+
+    // the total cpu time of every thread during the capture
+    QVariantMap threadTimes;
+    for (auto it = _threadTimes.cbegin(); it != _threadTimes.cend(); ++it) {
+        threadTimes[QString("%1 (%2)").arg(it->name).arg(it.key())] = ticksToMsecs(it->lastTicks - it->startTicks);
+    }
+    PROFILE_INSTANT(app, "Thread CPU time (ms)", "p", threadTimes);
+
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    tracer->stopTracing();
+
+    QByteArray trace;
+    gzip(tracer->serialize(), trace);
+
+    qCDebug(networking) << "Profile capture finished," << trace.size() << "bytes";
+    emit finished(trace);
+}
@@ -0,0 +1,61 @@
+//
+//  ProfileCapture.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ProfileCapture_h
+#define hifi_ProfileCapture_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+// Records a few seconds of trace events for the profiling requests of the domain-server.
+// While it runs, the cpu usage of every thread and the depth of the udt send queues are sampled
+// and added to the trace as counters, so that a frame that missed its deadline can be lined up
+// with what the rest of the process was doing at the time.
+class ProfileCapture : public QObject {
+    Q_OBJECT
+
+public:
+    static const int MAX_CAPTURE_SECONDS = 60;
+
+    ProfileCapture(QObject* parent = nullptr);
+
+    // returns false if there is no tracer, or if it is already tracing (another capture, or a trace started locally)
+    bool start(int seconds);
+    bool isCapturing() const { return _stopTimer.isActive(); }
+
+signals:
+    // the trace as gzipped json, in the chrome tracing format
+    void finished(QByteArray trace);
+
+private slots:
+    void sample();
+    void stop();
+
+private:
+    struct ThreadTimes {
+        QString name;
+        quint64 startTicks { 0 };
+        quint64 lastTicks { 0 };
+    };
+
+    void sampleThreadTimes(qint64 elapsedMsecs);
+    void sampleQueueDepths();
+
+    QTimer _sampleTimer { this };
+    QTimer _stopTimer { this };
+    QElapsedTimer _elapsedTimer;
+    qint64 _lastSampleMsecs { 0 };
+    QHash<qint64, ThreadTimes> _threadTimes;
+};
+
+#endif // hifi_ProfileCapture_h
@@ -0,0 +1,65 @@
+//
+//  RequestLimitAdapter.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RequestLimitAdapter.h"
+
+#include <NumericalConstants.h>
+
+const quint64 RequestLimitAdapter::WINDOW_USECS = 2 * USECS_PER_SECOND;
+
+// throughput changes smaller than this are treated as no change
+static const double THROUGHPUT_TOLERANCE = 0.05;
+
+int RequestLimitAdapter::update(qint64 bytesReceived, bool hasPendingRequests, int currentLimit, quint64 now) {
+    if (_windowStart == 0) {
+        _windowStart = now;
+    }
+
+    _windowBytes += bytesReceived;
+
+    // if we ever run out of pending requests the window measured demand, not what the connection can do
+    if (!hasPendingRequests) {
+        _windowSaturated = false;
+    }
+
+    quint64 elapsed = now - _windowStart;
+    if (elapsed < WINDOW_USECS) {
+        return currentLimit;
+    }
+
+    int newLimit = currentLimit;
+
+    if (_windowSaturated && _windowBytes > 0) {
+        double throughput = (double)_windowBytes / ((double)elapsed / USECS_PER_SECOND);
+
+        if (_lastThroughput > 0.0) {
+            if (throughput < _lastThroughput * (1.0 - THROUGHPUT_TOLERANCE)) {
+                // the last step hurt, go back the other way
+                _step = -_step;
+            } else if (throughput <= _lastThroughput * (1.0 + THROUGHPUT_TOLERANCE)) {
+                // more concurrent requests aren't buying us anything, give some back
+                _step = -1;
+            }
+        }
+
+        _lastThroughput = throughput;
+        newLimit = qBound(MIN_REQUEST_LIMIT, currentLimit + _step, MAX_REQUEST_LIMIT);
+    } else {
+        // start probing upwards again the next time we're backed up
+        _lastThroughput = 0.0;
+        _step = 1;
+    }
+
+    _windowStart = now;
+    _windowBytes = 0;
+    _windowSaturated = true;
+
+    return newLimit;
+}
@@ -0,0 +1,38 @@
+//
+//  RequestLimitAdapter.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RequestLimitAdapter_h
+#define hifi_RequestLimitAdapter_h
+
+#include <QtCore/QtGlobal>
+
+// Tunes how many resource downloads run at once by hill climbing on download throughput.
+// Throughput is measured over fixed windows, and only windows where requests were backed up the whole
+// time count, since otherwise they measure demand rather than what the connection can do. The limit
+// keeps stepping the same way while throughput improves, turns around when it gets worse and
+// steps down when more concurrent requests aren't buying anything.
+class RequestLimitAdapter {
+public:
+    static const quint64 WINDOW_USECS;
+    static const int MIN_REQUEST_LIMIT = 4;
+    static const int MAX_REQUEST_LIMIT = 64;
+
+    // records a finished download and returns the request limit that the measured throughput calls for
+    int update(qint64 bytesReceived, bool hasPendingRequests, int currentLimit, quint64 now);
+
+private:
+    quint64 _windowStart { 0 };
+    qint64 _windowBytes { 0 };
+    bool _windowSaturated { true };
+    double _lastThroughput { 0.0 };
+    int _step { 1 };
+};
+
+#endif // hifi_RequestLimitAdapter_h
@@ -36,15 +36,118 @@ void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resour
 }
 
 void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+
+    int requestID = strongResource->_requestID;
+    float priority = strongResource->getLoadPriority();
+
+    Lock lock(_mutex);
+
+    auto it = _pendingRequestIndices.find(requestID);
+    if (it != _pendingRequestIndices.end()) {
+        // already pending, just make sure it sits at the right priority
+        setPendingRequestPriority(it->second, priority);
+        return;
+    }
+
+    _pendingRequests.push_back({ resource, requestID, priority, _nextPendingOrder++ });
+    _pendingRequestIndices[requestID] = _pendingRequests.size() - 1;
+    siftPendingRequestUp(_pendingRequests.size() - 1);
+}
+
+void ResourceCacheSharedItems::updatePendingRequestPriority(int requestID, float priority) {
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+
+    auto it = _pendingRequestIndices.find(requestID);
+    if (it == _pendingRequestIndices.end()) {
+        return;
+    }
+
+    setPendingRequestPriority(it->second, priority);
+}
+
+void ResourceCacheSharedItems::setPendingRequestPriority(size_t index, float priority) {
+    float previousPriority = _pendingRequests[index].priority;
+    _pendingRequests[index].priority = priority;
+
+    if (priority > previousPriority) {
+        siftPendingRequestUp(index);
+    } else if (priority < previousPriority) {
+        siftPendingRequestDown(index);
+    }
+}
+
+bool ResourceCacheSharedItems::isHigherPriority(const PendingRequest& a, const PendingRequest& b) const {
+    return a.priority > b.priority || (a.priority == b.priority && a.order < b.order);
+}
+
+void ResourceCacheSharedItems::swapPendingRequests(size_t a, size_t b) {
+    std::swap(_pendingRequests[a], _pendingRequests[b]);
+    _pendingRequestIndices[_pendingRequests[a].requestID] = a;
+    _pendingRequestIndices[_pendingRequests[b].requestID] = b;
+}
+
+void ResourceCacheSharedItems::siftPendingRequestUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!isHigherPriority(_pendingRequests[index], _pendingRequests[parent])) {
+            break;
+        }
+        swapPendingRequests(index, parent);
+        index = parent;
+    }
+}
+
+void ResourceCacheSharedItems::siftPendingRequestDown(size_t index) {
+    const size_t size = _pendingRequests.size();
+    while (true) {
+        size_t highest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+
+        if (left < size && isHigherPriority(_pendingRequests[left], _pendingRequests[highest])) {
+            highest = left;
+        }
+        if (right < size && isHigherPriority(_pendingRequests[right], _pendingRequests[highest])) {
+            highest = right;
+        }
+        if (highest == index) {
+            break;
+        }
+        swapPendingRequests(index, highest);
+        index = highest;
+    }
+}
+
+void ResourceCacheSharedItems::removePendingRequestAt(size_t index) {
+    _pendingRequestIndices.erase(_pendingRequests[index].requestID);
+
+    size_t last = _pendingRequests.size() - 1;
+    if (index != last) {
+        _pendingRequests[index] = std::move(_pendingRequests[last]);
+        _pendingRequestIndices[_pendingRequests[index].requestID] = index;
+    }
+    _pendingRequests.pop_back();
+
+    // the request moved into this slot may belong above or below it
+    if (index < _pendingRequests.size()) {
+        if (index > 0 && isHigherPriority(_pendingRequests[index], _pendingRequests[(index - 1) / 2])) {
+            siftPendingRequestUp(index);
+        } else {
+            siftPendingRequestDown(index);
+        }
+    }
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _pendingRequests) {
+    for (const auto& request : _pendingRequests) {
+        auto resource = request.resource.lock();
         if (resource) {
             result.append(resource);
         }
@@ -94,35 +197,34 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
 
-    for (int i = 0; i < _pendingRequests.size();) {
+    while (!_pendingRequests.empty()) {
         // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        auto resource = _pendingRequests.front().resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
+            removePendingRequestAt(0);
             continue;
         }
 
-        // Check load priority
+        // owners that have gone away since the priority was last set can only lower it,
+        // so re-check the top of the heap before handing it out
         float priority = resource->getLoadPriority();
-        if (priority >= highestPriority) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
+        if (priority < _pendingRequests.front().priority) {
+            setPendingRequestPriority(0, priority);
+            continue;
         }
-        i++;
-    }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+        removePendingRequestAt(0);
+        return resource;
     }
 
-    return highestResource;
+    return QSharedPointer<Resource>();
+}
+
+int ResourceCacheSharedItems::adaptRequestLimit(qint64 bytesReceived, int currentLimit) {
+    Lock lock(_mutex);
+    return _requestLimitAdapter.update(bytesReceived, !_pendingRequests.empty(), currentLimit, usecTimestampNow());
 }
 
 ScriptableResource::ScriptableResource(const QUrl& url) :
@@ -488,12 +590,18 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     return true;
 }
 
-void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
+void ResourceCache::requestCompleted(QWeakPointer<Resource> resource, qint64 bytesReceived) {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
     sharedItems->removeRequest(resource);
     --_requestsActive;
 
-    attemptHighestPriorityRequest();
+    if (_adaptiveRequestLimit) {
+        _requestLimit = sharedItems->adaptRequestLimit(bytesReceived, _requestLimit);
+    }
+
+    // fill the request slots that are open now, which can be more than one if the limit went up
+    while (_requestsActive < _requestLimit && attemptHighestPriorityRequest()) {
+    }
 }
 
 bool ResourceCache::attemptHighestPriorityRequest() {
@@ -503,7 +611,8 @@ bool ResourceCache::attemptHighestPriorityRequest() {
 }
 
 const int DEFAULT_REQUEST_LIMIT = 10;
-int ResourceCache::_requestLimit = DEFAULT_REQUEST_LIMIT;
+std::atomic<int> ResourceCache::_requestLimit { DEFAULT_REQUEST_LIMIT };
+std::atomic<bool> ResourceCache::_adaptiveRequestLimit { false };
 int ResourceCache::_requestsActive = 0;
 
 static int requestID = 0;
@@ -533,6 +642,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.insert(owner, priority);
+        updatePendingRequestPriority();
     }
 }
 
@@ -544,11 +654,20 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updatePendingRequestPriority();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.remove(owner);
+        updatePendingRequestPriority();
+    }
+}
+
+void Resource::updatePendingRequestPriority() {
+    // move our place in the pending queue, if we're in it
+    if (_startedLoading && !_request) {
+        DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequestPriority(_requestID, getLoadPriority());
     }
 }
 
@@ -675,6 +794,8 @@ void Resource::makeRequest() {
         PROFILE_ASYNC_END(resource, "Resource:" + getType(), QString::number(_requestID));
         return;
     }
+
+    _request->setByteRange(_requestByteRange);
     
     qCDebug(resourceLog).noquote() << "Starting request for:" << _url.toDisplayString();
     emit loading();
@@ -711,7 +832,8 @@ void Resource::handleReplyFinished() {
         return;
     }
     
-    ResourceCache::requestCompleted(_self);
+    // cached replies don't tell us anything about the network, so they don't count towards throughput
+    ResourceCache::requestCompleted(_self, _request->loadedFromCache() ? 0 : _bytesTotal);
     
     auto result = _request->getResult();
     if (result == ResourceRequest::Success) {
@@ -14,6 +14,8 @@
 
 #include <atomic>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -32,6 +34,7 @@
 
 #include <DependencyManager.h>
 
+#include "RequestLimitAdapter.h"
 #include "ResourceManager.h"
 
 Q_DECLARE_METATYPE(size_t)
@@ -69,18 +72,42 @@ public:
     void appendPendingRequest(QWeakPointer<Resource> newRequest);
     void appendActiveRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
+    void updatePendingRequestPriority(int requestID, float priority);
     QList<QSharedPointer<Resource>> getPendingRequests();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests();
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getLoadingRequestsCount() const;
 
+    // records a finished download and returns the request limit that the measured throughput calls for
+    int adaptRequestLimit(qint64 bytesReceived, int currentLimit);
+
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        int requestID;
+        float priority;
+        uint64_t order;
+    };
+
+    // pending requests are kept in a max-heap on priority (oldest first on ties), with an index
+    // from request ID to heap slot so that a request can be re-prioritized in place
+    bool isHigherPriority(const PendingRequest& a, const PendingRequest& b) const;
+    void setPendingRequestPriority(size_t index, float priority);
+    void swapPendingRequests(size_t a, size_t b);
+    void siftPendingRequestUp(size_t index);
+    void siftPendingRequestDown(size_t index);
+    void removePendingRequestAt(size_t index);
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
+    std::vector<PendingRequest> _pendingRequests;
+    std::unordered_map<int, size_t> _pendingRequestIndices;
+    uint64_t _nextPendingOrder { 0 };
     QList<QWeakPointer<Resource>> _loadingRequests;
+
+    RequestLimitAdapter _requestLimitAdapter;
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -233,6 +260,10 @@ public:
     static void setRequestLimit(int limit);
     static int getRequestLimit() { return _requestLimit; }
 
+    // when enabled the request limit is adjusted from the measured download throughput, off by default
+    static void setAdaptiveRequestLimit(bool adaptive) { _adaptiveRequestLimit = adaptive; }
+    static bool isAdaptiveRequestLimit() { return _adaptiveRequestLimit; }
+
     static int getRequestsActive() { return _requestsActive; }
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
@@ -303,7 +334,7 @@ protected:
     /// Attempt to load a resource if requests are below the limit, otherwise queue the resource for loading
     /// \return true if the resource began loading, otherwise false if the resource is in the pending queue
     static bool attemptRequest(QSharedPointer<Resource> resource);
-    static void requestCompleted(QWeakPointer<Resource> resource);
+    static void requestCompleted(QWeakPointer<Resource> resource, qint64 bytesReceived = 0);
     static bool attemptHighestPriorityRequest();
 
 private:
@@ -313,7 +344,8 @@ private:
     void resetResourceCounters();
     void removeResource(const QUrl& url, qint64 size = 0);
 
-    static int _requestLimit;
+    static std::atomic<int> _requestLimit;
+    static std::atomic<bool> _adaptiveRequestLimit;
     static int _requestsActive;
 
     // Resources
@@ -436,12 +468,13 @@ protected:
 
     /// Called when the download is finished and processed.
     /// This should be called by subclasses that override downloadFinished to mark the end of processing.
-    Q_INVOKABLE void finishedLoading(bool success);
+    Q_INVOKABLE virtual void finishedLoading(bool success);
 
     Q_INVOKABLE void allReferencesCleared();
 
     QUrl _url;
     QUrl _activeUrl;
+    ByteRange _requestByteRange;
     bool _startedLoading = false;
     bool _failedToLoad = false;
     bool _loaded = false;
@@ -455,7 +488,10 @@ private slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
+
+    void updatePendingRequestPriority();
     
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
     
@@ -36,6 +36,7 @@ QString ResourceRequest::getResultString() const {
         case AccessDenied: return "Access Denied";
         case InvalidURL: return "Invalid URL";
         case NotFound: return "Not Found";
+        case InvalidByteRange: return "Invalid Byte Range";
         default: return "Unspecified Error";
     }
 }
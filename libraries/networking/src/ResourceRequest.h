@@ -17,6 +17,19 @@
 
 #include <cstdint>
 
+// A range of bytes of a resource, fromInclusive to toExclusive. The default range is unset, which requests
+// the whole resource.
+struct ByteRange {
+    int64_t fromInclusive { 0 };
+    int64_t toExclusive { 0 };
+
+    ByteRange() {}
+    ByteRange(int64_t from, int64_t to) : fromInclusive(from), toExclusive(to) {}
+
+    bool isSet() const { return fromInclusive < toExclusive; }
+    int64_t size() const { return toExclusive - fromInclusive; }
+};
+
 class ResourceRequest : public QObject {
     Q_OBJECT
 public:
@@ -36,7 +49,8 @@ public:
         ServerUnavailable,
         AccessDenied,
         InvalidURL,
-        NotFound
+        NotFound,
+        InvalidByteRange
     };
     Q_ENUM(Result)
 
@@ -49,6 +63,11 @@ public:
 
     void setCacheEnabled(bool value) { _cacheEnabled = value; }
 
+    // Only fetch part of the resource. A range that runs past the end of the resource is cut short,
+    // so getData() can be smaller than the range.
+    void setByteRange(const ByteRange& byteRange) { _byteRange = byteRange; }
+    const ByteRange& getByteRange() const { return _byteRange; }
+
 public slots:
     void send();
 
@@ -65,6 +84,7 @@ protected:
     QByteArray _data;
     bool _cacheEnabled { true };
     bool _loadedFromCache { false };
+    ByteRange _byteRange;
 };
 
 #endif
@@ -85,31 +85,40 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
     // start sending stats packet once we connect to the domain
     connect(&nodeList->getDomainHandler(), SIGNAL(connectedToDomain(const QString&)), &_statsTimer, SLOT(start()));
 
+    // a domain-server we just connected to has none of the stats we sent before, start with a full snapshot
+    connect(&nodeList->getDomainHandler(), &DomainHandler::connectedToDomain, this, [this] {
+        _statsEncoder.reset();
+    });
+
     // stop sending stats if we disconnect
     connect(&nodeList->getDomainHandler(), &DomainHandler::disconnectedFromDomain, &_statsTimer, &QTimer::stop);
 }
 
-void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObject) {
+NodeStatsEncoder& ThreadedAssignment::beginStatsPacket() {
+    _statsEncoder.beginStats();
+    return _statsEncoder;
+}
+
+void ThreadedAssignment::addPacketStatsAndSendStatsPacket() {
     auto nodeList = DependencyManager::get<NodeList>();
 
     float packetsInPerSecond, bytesInPerSecond, packetsOutPerSecond, bytesOutPerSecond;
     nodeList->getPacketStats(packetsInPerSecond, bytesInPerSecond, packetsOutPerSecond, bytesOutPerSecond);
     nodeList->resetPacketStats();
 
-    QJsonObject ioStats;
-    ioStats["inbound_bytes_per_s"] = bytesInPerSecond;
-    ioStats["inbound_packets_per_s"] = packetsInPerSecond;
-    ioStats["outbound_bytes_per_s"] = bytesOutPerSecond;
-    ioStats["outbound_packets_per_s"] = packetsOutPerSecond;
-
-    statsObject["io_stats"] = ioStats;
+    _statsEncoder.beginObject("io_stats");
+    _statsEncoder.write("inbound_bytes_per_s", bytesInPerSecond);
+    _statsEncoder.write("inbound_packets_per_s", packetsInPerSecond);
+    _statsEncoder.write("outbound_bytes_per_s", bytesOutPerSecond);
+    _statsEncoder.write("outbound_packets_per_s", packetsOutPerSecond);
+    _statsEncoder.endObject();
 
-    nodeList->sendStatsToDomainServer(statsObject);
+    nodeList->sendStatsToDomainServer(_statsEncoder.finishStats());
 }
 
 void ThreadedAssignment::sendStatsPacket() {
-    QJsonObject statsObject;
-    addPacketStatsAndSendStatsPacket(statsObject);
+    beginStatsPacket();
+    addPacketStatsAndSendStatsPacket();
 }
 
 void ThreadedAssignment::checkInWithDomainServerOrExit() {
@@ -17,6 +17,7 @@
 #include "ReceivedMessage.h"
 
 #include "Assignment.h"
+#include "NodeStatsCodec.h"
 
 class ThreadedAssignment : public Assignment {
     Q_OBJECT
@@ -26,7 +27,11 @@ public:
 
     void setFinished(bool isFinished);
     virtual void aboutToFinish() { };
-    void addPacketStatsAndSendStatsPacket(QJsonObject statsObject);
+
+    // stats producers write their stats into the encoder returned by beginStatsPacket,
+    // then addPacketStatsAndSendStatsPacket adds the io stats and sends the packet to the domain-server
+    NodeStatsEncoder& beginStatsPacket();
+    void addPacketStatsAndSendStatsPacket();
 
 public slots:
     /// threaded run of assignment
@@ -44,6 +49,7 @@ protected:
     QTimer _domainServerTimer;
     QTimer _statsTimer;
     int _numQueuedCheckIns { 0 };
+    NodeStatsEncoder _statsEncoder;
     
 protected slots:
     void domainSettingsRequestFailed();
@@ -72,6 +72,8 @@ public:
     void queueReceivedMessagePacket(std::unique_ptr<Packet> packet);
     
     ConnectionStats::Stats sampleStats() { return _stats.sample(); }
+    SendQueue::QueueDepths sampleQueueDepths() const
+        { return _sendQueue ? _sendQueue->sampleQueueDepths() : SendQueue::QueueDepths(); }
     
     bool isActive() const { return _isActive; }
 
@@ -113,7 +113,9 @@ public:
         EntityPhysics,
         EntityServerScriptLog,
         AdjustAvatarSorting,
-        LAST_PACKET_TYPE = AdjustAvatarSorting
+        NodeProfileRequest,
+        NodeProfileReply,
+        LAST_PACKET_TYPE = NodeProfileReply
     };
 };
 
@@ -254,7 +256,19 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    VersionedDeltaLists,
+    IndexedReplyEntries
+};
+
+enum class NodeJsonStatsVersion : PacketVersion {
+    BinaryJSONDocument = 17,
+    BinaryDeltaStats
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    NoLastListVersion = 17,
+    HasLastListVersion
 };
 
 enum class AudioVersion : PacketVersion {
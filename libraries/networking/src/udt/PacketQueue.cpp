@@ -31,6 +31,15 @@ bool PacketQueue::isEmpty() const {
     return (_channels.size() == 1) && _channels.front()->empty();
 }
 
+int PacketQueue::size() const {
+    LockGuard locker(_packetsLock);
+    int size = 0;
+    for (const auto& channel : _channels) {
+        size += (int)channel->size();
+    }
+    return size;
+}
+
 PacketQueue::PacketPointer PacketQueue::takePacket() {
     LockGuard locker(_packetsLock);
     if (isEmpty()) {
@@ -39,6 +39,7 @@ public:
     void queuePacketList(PacketListPointer packetList);
     
     bool isEmpty() const;
+    int size() const; // number of packets in every channel
     PacketPointer takePacket();
     
     Mutex& getLock() { return _packetsLock; }
@@ -402,6 +402,20 @@ void SendQueue::setProbePacketEnabled(bool enabled) {
     _shouldSendProbes = enabled;
 }
 
+SendQueue::QueueDepths SendQueue::sampleQueueDepths() const {
+    QueueDepths depths;
+    depths.queuedPackets = _packets.size();
+    {
+        QReadLocker sentLocker(&_sentLock);
+        depths.unacknowledgedPackets = (int)_sentPackets.size();
+    }
+    {
+        std::lock_guard<std::mutex> nakLocker(_naksLock);
+        depths.lostPackets = _naks.getLength();
+    }
+    return depths;
+}
+
 int SendQueue::maybeSendNewPacket() {
     if (!isFlowWindowFull()) {
         // we didn't re-send a packet, so time to send a new one
@@ -50,6 +50,12 @@ public:
         Stopped
     };
     
+    struct QueueDepths {
+        int queuedPackets { 0 }; // waiting to be sent for the first time
+        int unacknowledgedPackets { 0 }; // sent and waiting for an ACK
+        int lostPackets { 0 }; // NAKed and waiting to be resent
+    };
+
     static std::unique_ptr<SendQueue> create(Socket* socket, HifiSockAddr destination);
 
     virtual ~SendQueue();
@@ -68,6 +74,8 @@ public:
     void setSyncInterval(int syncInterval) { _syncInterval = syncInterval; }
 
     void setProbePacketEnabled(bool enabled);
+
+    QueueDepths sampleQueueDepths() const;
     
 public slots:
     void stop();
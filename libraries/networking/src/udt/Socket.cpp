@@ -503,6 +503,14 @@ Socket::StatsVector Socket::sampleStatsForAllConnections() {
     return result;
 }
 
+Socket::QueueDepthsVector Socket::sampleQueueDepthsForAllConnections() {
+    QueueDepthsVector result;
+    result.reserve(_connectionsHash.size());
+    for (const auto& connectionPair : _connectionsHash) {
+        result.emplace_back(connectionPair.first, connectionPair.second->sampleQueueDepths());
+    }
+    return result;
+}
 
 std::vector<HifiSockAddr> Socket::getConnectionSockAddrs() {
     std::vector<HifiSockAddr> addr;
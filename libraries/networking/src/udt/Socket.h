@@ -53,6 +53,7 @@ class Socket : public QObject {
 
 public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
+    using QueueDepthsVector = std::vector<std::pair<HifiSockAddr, SendQueue::QueueDepths>>;
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
     
@@ -87,6 +88,8 @@ public:
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
     
     StatsVector sampleStatsForAllConnections();
+    // unlike the stats, sampling the queue depths doesn't reset anything
+    QueueDepthsVector sampleQueueDepthsForAllConnections();
 
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
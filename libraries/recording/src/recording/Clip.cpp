@@ -18,6 +18,9 @@
 #include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
+
+#include <limits>
 
 using namespace recording;
 
@@ -54,13 +57,40 @@ float Clip::position() const {
     return Frame::frameTimeToSeconds(positionFrameTime());
 }
 
+void Clip::applyFrameDelta(QByteArray& data, const QByteArray& reference) {
+    Q_ASSERT(data.size() == reference.size());
+    auto target = data.data();
+    auto source = reference.constData();
+    for (int i = 0; i < data.size(); ++i) {
+        target[i] ^= source[i];
+    }
+}
+
+static const int MAX_FRAME_DATA_SIZE = std::numeric_limits<FrameSize>::max();
+
+// The payload as stored in the file: optionally compressed, then prefixed with the delta marker
+QByteArray encodeFrameData(const QByteArray& data, bool compressed, int deltaType = -1) {
+    QByteArray frameData = compressed ? qCompress(data) : data;
+    if (deltaType >= 0) {
+        // the delta marker stays outside the compressed block so readers can index chains without inflating
+        frameData.prepend((char)deltaType);
+    }
+    return frameData;
+}
+
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
+bool writeFrame(QIODevice& output, const Frame& frame, const QByteArray& frameData) {
     if (frame.type == Frame::TYPE_INVALID) {
         qWarning() << "Attempting to write invalid frame";
         return true;
     }
 
+    // the size field is a FrameSize, check before writing anything so we never leave a truncated frame behind
+    if (frameData.size() > MAX_FRAME_DATA_SIZE) {
+        qCWarning(recordingLog) << "Frame of" << frameData.size() << "bytes does not fit in a clip frame";
+        return false;
+    }
+
     auto written = output.write((char*)&(frame.type), sizeof(FrameType));
     if (written != sizeof(FrameType)) {
         return false;
@@ -70,14 +100,10 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
     if (written != sizeof(Frame::Time)) {
         return false;
     }
-    QByteArray frameData = frame.data;
-    if (compressed) {
-        frameData = qCompress(frameData);
-    }
 
-    uint16_t dataSize = frameData.size();
+    FrameSize dataSize = frameData.size();
     written = output.write((char*)&dataSize, sizeof(FrameSize));
-    if (written != sizeof(uint16_t)) {
+    if (written != sizeof(FrameSize)) {
         return false;
     }
 
@@ -92,6 +118,8 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FRAME_DELTA_FLAG = QStringLiteral("delta");
+const QString Clip::FORMAT_VERSION = QStringLiteral("version");
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -102,20 +130,56 @@ bool Clip::write(QIODevice& output) {
 
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
+    // Always mark new files as compressed and delta encoded
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    rootObject.insert(FRAME_DELTA_FLAG, true);
+    rootObject.insert(FORMAT_VERSION, CURRENT_FORMAT_VERSION);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), encodeFrameData(headerFrameData, false))) {
         return false;
     }
 
     seek(0);
 
+    struct DeltaState {
+        QByteArray data;
+        int framesSinceKeyFrame { 0 };
+    };
+    QHash<FrameType, DeltaState> deltaStates;
+
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        auto& state = deltaStates[frame->type];
+        bool isDelta = !state.data.isNull() && state.data.size() == frame->data.size()
+            && state.framesSinceKeyFrame < KEY_FRAME_INTERVAL;
+
+        QByteArray frameData;
+        if (isDelta) {
+            QByteArray deltaData = frame->data;
+            applyFrameDelta(deltaData, state.data);
+            frameData = encodeFrameData(deltaData, true, DeltaFrame);
+            // a delta of noisy data can compress worse than the frame itself, fall back to a key frame if it won't fit
+            if (frameData.size() > MAX_FRAME_DATA_SIZE) {
+                isDelta = false;
+            }
+        }
+        if (!isDelta) {
+            frameData = encodeFrameData(frame->data, true, KeyFrame);
+        }
+
+        if (frameData.size() > MAX_FRAME_DATA_SIZE) {
+            // too big even as a key frame, drop it and start the next frame of this type on a fresh key frame
+            qCWarning(recordingLog) << "Skipping frame of type" << frame->type << "at" << frame->timeOffset
+                << "that is too large for a clip";
+            state.data = QByteArray();
+            continue;
+        }
+
+        if (!writeFrame(output, *frame, frameData)) {
             return false;
         }
+        state.framesSinceKeyFrame = isDelta ? state.framesSinceKeyFrame + 1 : 0;
+        state.data = frame->data;
     }
     return true;
 }
@@ -56,6 +56,19 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    static const QString FRAME_DELTA_FLAG;
+    static const QString FORMAT_VERSION;
+
+    // Version 2 adds delta frames: each frame payload is prefixed with a DeltaFrameType byte and,
+    // for delta frames, holds the XOR against the previous frame of the same type
+    static const int CURRENT_FORMAT_VERSION = 2;
+    // Maximum number of consecutive delta frames of a type before a key frame is forced
+    static const int KEY_FRAME_INTERVAL = 60;
+
+    enum DeltaFrameType : uint8_t {
+        KeyFrame = 0,
+        DeltaFrame = 1
+    };
 
 protected:
     friend class WrapperClip;
@@ -64,6 +77,9 @@ protected:
 
     virtual void reset() = 0;
 
+    // XOR the reference into data, which both encodes and decodes a delta frame.  Sizes must match.
+    static void applyFrameDelta(QByteArray& data, const QByteArray& reference);
+
     mutable Mutex _mutex;
 };
 
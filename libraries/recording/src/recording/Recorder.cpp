@@ -11,8 +11,13 @@
 #include <NumericalConstants.h>
 #include <SharedUtil.h>
 
+#include <QtCore/QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
 #include "impl/BufferClip.h"
+#include "impl/FileClip.h"
 #include "Frame.h"
+#include "Logging.h"
 
 using namespace recording;
 
@@ -76,3 +81,24 @@ ClipPointer Recorder::getClip() {
     return _clip;
 }
 
+void Recorder::saveClip(const QString& filePath, const ClipConstPointer& clip) {
+    if (!clip) {
+        return;
+    }
+
+    // snapshot the frames now, the source clip may still be recording.  The worker only touches the
+    // snapshot, and the watcher reports back on our thread, so we're free to go away before the write finishes.
+    auto snapshot = clip->duplicate();
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, filePath] {
+        emit clipSaved(filePath, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([filePath, snapshot] {
+        bool success = FileClip::write(filePath, snapshot);
+        if (!success) {
+            qCWarning(recordingLog) << "Failed to write clip to" << filePath;
+        }
+        return success;
+    }));
+}
@@ -46,8 +46,13 @@ public:
     // Return the currently recorded content
     ClipPointer getClip();
 
+    // Write a snapshot of the clip to disk on a worker thread, so long captures don't stall
+    // the recording thread.  Emits clipSaved on our thread when the write completes.
+    void saveClip(const QString& filePath, const ClipConstPointer& clip);
+
 signals:
     void recordingStateChanged();
+    void clipSaved(const QString& filePath, bool success);
 
 private:
     using Mutex = std::recursive_mutex;
@@ -41,7 +41,7 @@ QString FileClip::getName() const {
 
 
 bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
-    // FIXME need to move this to a different thread
+    // Blocking, use Recorder::saveClip to write from a worker thread
     //qCDebug(recordingLog) << "Writing clip to file " << fileName << " with " << clip->frameCount() << " frames";
 
     if (0 == clip->frameCount()) {
@@ -77,6 +77,7 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
 
 void PointerClip::reset() {
     _frames.clear();
+    _decodedFrames.clear();
     _data = nullptr;
     _size = 0;
     _header = QJsonDocument();
@@ -113,6 +114,7 @@ void PointerClip::init(uchar* data, size_t size) {
     // Check for compression
     {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+        _delta = _header.object()[FRAME_DELTA_FLAG].toBool();
     }
 
     // Find the type enum translation map and fix up the frame headers
@@ -135,6 +137,75 @@ void PointerClip::init(uchar* data, size_t size) {
         }
     }
 
+    if (_delta) {
+        linkDeltaFrames();
+    }
+}
+
+void PointerClip::linkDeltaFrames() {
+    std::unordered_map<FrameType, size_t> lastFrameOfType;
+    std::vector<PointerFrameHeader> linkedFrames;
+    linkedFrames.reserve(_frames.size());
+
+    for (auto frameHeader : _frames) {
+        // every delta encoded frame carries at least its marker byte
+        if (frameHeader.size == 0) {
+            continue;
+        }
+        frameHeader.keyFrame = (_data[frameHeader.fileOffset] == KeyFrame);
+
+        auto previous = lastFrameOfType.find(frameHeader.type);
+        if (!frameHeader.keyFrame) {
+            if (previous == lastFrameOfType.end()) {
+                qCWarning(recordingLog) << "Delta frame without a preceding key frame, skipping";
+                continue;
+            }
+            frameHeader.previousIndex = previous->second;
+        }
+
+        lastFrameOfType[frameHeader.type] = linkedFrames.size();
+        linkedFrames.push_back(frameHeader);
+    }
+
+    _frames.swap(linkedFrames);
+}
+
+QByteArray PointerClip::readFrameData(size_t frameIndex) const {
+    const auto& header = _frames[frameIndex];
+    if (!_delta) {
+        QByteArray result(reinterpret_cast<char*>(_data) + header.fileOffset, header.size);
+        return _compressed ? qUncompress(result) : result;
+    }
+
+    auto cached = _decodedFrames.find(header.type);
+    if (cached != _decodedFrames.end() && cached->second.index == frameIndex) {
+        return cached->second.data;
+    }
+
+    // skip the delta marker
+    QByteArray result(reinterpret_cast<char*>(_data) + header.fileOffset + 1, header.size - 1);
+    if (_compressed) {
+        result = qUncompress(result);
+    }
+
+    if (!header.keyFrame) {
+        // chains are at most KEY_FRAME_INTERVAL long, and during playback the previous frame is cached
+        QByteArray reference;
+        if (cached != _decodedFrames.end() && cached->second.index == header.previousIndex) {
+            reference = cached->second.data;
+        } else {
+            reference = readFrameData(header.previousIndex);
+        }
+
+        if (reference.size() != result.size()) {
+            qCWarning(recordingLog) << "Delta frame size mismatch, invalid file";
+            return QByteArray();
+        }
+        applyFrameDelta(result, reference);
+    }
+
+    _decodedFrames[header.type] = { frameIndex, result };
+    return result;
 }
 
 // Internal only function, needs no locking
@@ -146,10 +217,7 @@ FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
         result->type = header.type;
         result->timeOffset = header.timeOffset;
         if (header.size) {
-            result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
-            if (_compressed) {
-                result->data = qUncompress(result->data);
-            }
+            result->data = readFrameData(frameIndex);
         }
     }
     return result;
@@ -13,6 +13,7 @@
 #include "ArrayClip.h"
 
 #include <mutex>
+#include <unordered_map>
 
 #include <QtCore/QJsonDocument>
 
@@ -25,6 +26,9 @@ struct PointerFrameHeader : public FrameHeader {
     Frame::Time timeOffset;
     uint16_t size;
     quint64 fileOffset;
+    // Only meaningful for delta encoded clips
+    bool keyFrame { true };
+    size_t previousIndex { 0 };
 };
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
@@ -47,10 +51,22 @@ public:
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+    QByteArray readFrameData(size_t index) const;
+    void linkDeltaFrames();
+
+    struct DecodedFrame {
+        size_t index;
+        QByteArray data;
+    };
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+    bool _delta { false };
+    // The most recently decoded frame of each type, so sequential playback of a delta chain
+    // only inflates one frame per read
+    mutable std::unordered_map<FrameType, DecodedFrame> _decodedFrames;
 };
 
 }
@@ -12,6 +12,8 @@
 #include "RenderUtilsLogging.h"
 
 
+#include <tbb/parallel_for.h>
+
 #include <gpu/Context.h>
 
 #include <gpu/StandardShaderLib.h>
@@ -118,6 +120,7 @@ void LightClusters::setDimensions(glm::uvec3 gridDims, uint32_t listBudget) {
         theFrustumGrid.dims = configDimensions;
         theFrustumGrid.generateGridPlanes(_gridPlanes[0], _gridPlanes[1], _gridPlanes[2]);
         _clusterResourcesInvalid = true;
+        _gridVersion++;
     }
 
     auto configListBudget = std::min(MAX_GRID_DIMENSIONS.w, listBudget);
@@ -137,6 +140,10 @@ uint32_t LightClusters::getNumClusters() const {
         return;
     }
     _clusterResourcesInvalid = false;
+
+    // the new buffers start empty, every light needs to be binned in them again
+    _gridVersion++;
+
     auto numClusters = getNumClusters();
     if (numClusters != (uint32_t) _clusterGrid.size()) {
         _clusterGrid.clear();
@@ -173,23 +180,34 @@ void LightClusters::setRangeNearFar(float rangeNear, float rangeFar) {
 
     if (changed) {
         _frustumGridBuffer.edit().generateGridPlanes(_gridPlanes[0], _gridPlanes[1], _gridPlanes[2]);
+        _gridVersion++;
     }
 }
 
 void LightClusters::updateFrustum(const ViewFrustum& frustum) {
     _frustum = frustum;
 
-    _frustumGridBuffer.edit().updateFrustum(frustum);
+    // Only touch the grid when the view changed, so that a still view keeps its lights binned
+    FrustumGrid frustumGrid(_frustumGridBuffer.get());
+    frustumGrid.updateFrustum(frustum);
 
-    if (true) {
-        _frustumGridBuffer.edit().generateGridPlanes(_gridPlanes[0], _gridPlanes[1], _gridPlanes[2]);
+    const auto& currentGrid = _frustumGridBuffer.get();
+    if (frustumGrid.frustumNear != currentGrid.frustumNear || frustumGrid.frustumFar != currentGrid.frustumFar ||
+            frustumGrid.eyeToGridProj != currentGrid.eyeToGridProj || frustumGrid.worldToEyeMat != currentGrid.worldToEyeMat) {
+        auto& theFrustumGrid = _frustumGridBuffer.edit();
+        theFrustumGrid = frustumGrid;
+        theFrustumGrid.generateGridPlanes(_gridPlanes[0], _gridPlanes[1], _gridPlanes[2]);
+        _gridVersion++;
     }
 }
 
 void LightClusters::updateLightStage(const LightStagePointer& lightStage) {
-    _lightStage = lightStage;
-    
-  }
+    if (_lightStage != lightStage) {
+        // the light ids are those of the stage
+        _lightStage = lightStage;
+        _gridVersion++;
+    }
+}
 
 void LightClusters::updateLightFrame(const LightStage::Frame& lightFrame, bool points, bool spots) {
 
@@ -236,15 +254,15 @@ bool reduceSphereToPlane(const glm::vec4& sphere, const glm::vec4& plane, glm::v
 }
 
 
-uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
+uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, const glm::vec4& eyePosRadius,
+    std::vector<uint32_t>& clusters) {
     glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
 
     for (auto y = yMin; (y <= yMax); y++) {
         for (auto x = xMin; (x <= xMax); x++) {
             auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * zSlice;
-            clusterGrid[index].emplace_back(lightId);
+            clusters.push_back(index);
             numClustersTouched++;
         }
     }
@@ -252,31 +270,13 @@ uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes pl
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
-    glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
-    uint32_t numClustersTouched = 0;
-
-    for (auto z = zMin; (z <= zMax); z++) {
-        for (auto y = yMin; (y <= yMax); y++) {
-            for (auto x = xMin; (x <= xMax); x++) {
-                auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * z;
-                clusterGrid[index].emplace_back(lightId);
-                numClustersTouched++;
-            }
-        }
-    }
-
-    return numClustersTouched;
-}
-
-uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
-    glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
+uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, const glm::vec4& eyePosRadius,
+    std::vector<uint32_t>& clusters) {
     uint32_t numClustersTouched = 0;
     const auto& xPlanes = planes[0];
     const auto& yPlanes = planes[1];
     const auto& zPlanes = planes[2];
+    const int numClusters = grid.frustumGrid_numClusters();
 
     // FInd the light origin cluster
     auto centerCluster = grid.frustumGrid_eyeToClusterPos(glm::vec3(eyePosRadius));
@@ -324,11 +324,11 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
 
             for (; (x <= xs); x++) {
                 auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
-                if (index < (int)clusterGrid.size()) {
-                    clusterGrid[index].emplace_back(lightId);
+                if (index < numClusters) {
+                    clusters.push_back(index);
                     numClustersTouched++;
                 } else {
-                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
+                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << numClusters << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
                 }
             }
         }
@@ -337,210 +337,283 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
     return numClustersTouched;
 }
 
-glm::ivec3 LightClusters::updateClusters() {
-    // Make sure resource are in good shape
-    updateClusterResource();
-
-    // Clean up last info
-    uint32_t numClusters = (uint32_t)_clusterGrid.size();
+// Finds the clusters touched by a light, returns false if the light is outside of the grid
+static bool binLight(FrustumGrid& theFrustumGrid, const FrustumGrid::Planes gridPlanes[3], const glm::vec3& worldOri, float radius, std::vector<uint32_t>& clusters) {
+    clusters.clear();
 
-    std::vector< std::vector< LightIndex > > clusterGridPoint(numClusters);
-    std::vector< std::vector< LightIndex > > clusterGridSpot(numClusters);
+    // Bring into frustum eye space
+    auto eyeOri = theFrustumGrid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
 
-    _clusterGrid.clear();
-    _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
+    // Remove light that slipped through and is not in the z range
+    float eyeZMax = eyeOri.z - radius;
+    if (eyeZMax > -theFrustumGrid.rangeNear) {
+        return false;
+    }
+    float eyeZMin = eyeOri.z + radius;
+    bool beyondFar = false;
+    if (eyeZMin < -theFrustumGrid.rangeFar) {
+        beyondFar = true;
+    }
 
-    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
-    _clusterContent.clear();
-    _clusterContent.resize(maxNumIndices, INVALID_LIGHT);
+    // Get z slices
+    int zMin = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
+    int zMax = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
+    // That should never happen
+    if (zMin == -2 && zMax == -2) {
+        return false;
+    }
 
+    // Before Range NEar just apss, range neatr == true near for now
+    if ((zMin == -1) && (zMax == -1)) {
+        return false;
+    }
 
-    auto theFrustumGrid(_frustumGridBuffer.get());
+    // CLamp the z range 
+    zMin = std::max(0, zMin);
 
-    glm::ivec3 gridPosToOffset(1, theFrustumGrid.dims.x, theFrustumGrid.dims.x * theFrustumGrid.dims.y);
+    auto xLeftDistance = radius - distanceToPlane(eyeOri, gridPlanes[0][0]);
+    auto xRightDistance = radius + distanceToPlane(eyeOri, gridPlanes[0].back());
 
-    uint32_t numClusterTouched = 0;
-    uint32_t numLightsIn = _visibleLightIndices[0];
-    uint32_t numClusteredLights = 0;
-    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
-        auto lightId = _visibleLightIndices[lightNum];
-        auto light = _lightStage->getLight(lightId);
-        if (!light) {
-            continue;
-        }
+    auto yBottomDistance = radius - distanceToPlane(eyeOri, gridPlanes[1][0]);
+    auto yTopDistance = radius + distanceToPlane(eyeOri, gridPlanes[1].back());
 
-        auto worldOri = light->getPosition();
-        auto radius = light->getMaximumRadius();
-        bool isSpot = light->isSpot();
+    if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
+        return false;
+    }
 
-        // Bring into frustum eye space
-        auto eyeOri = theFrustumGrid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
+    // find 2D corners of the sphere in grid
+    int xMin { 0 };
+    int xMax { theFrustumGrid.dims.x - 1 };
+    int yMin { 0 };
+    int yMax { theFrustumGrid.dims.y - 1 };
 
-        // Remove light that slipped through and is not in the z range
-        float eyeZMax = eyeOri.z - radius;
-        if (eyeZMax > -theFrustumGrid.rangeNear) {
-            continue;
-        }
-        float eyeZMin = eyeOri.z + radius;
-        bool beyondFar = false;
-        if (eyeZMin < -theFrustumGrid.rangeFar) {
-            beyondFar = true;
-        }
+    float radius2 = radius * radius;
 
-        // Get z slices
-        int zMin = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
-        int zMax = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
-        // That should never happen
-        if (zMin == -2 && zMax == -2) {
-            continue;
-        }
+    auto eyeOriH = glm::vec3(eyeOri);
+    auto eyeOriV = glm::vec3(eyeOri);
 
-        // Before Range NEar just apss, range neatr == true near for now
-        if ((zMin == -1) && (zMax == -1)) {
-            continue;
-        }
+    eyeOriH.y = 0.0f;
+    eyeOriV.x = 0.0f;
 
-        // CLamp the z range 
-        zMin = std::max(0, zMin);
+    float eyeOriLen2H = glm::length2(eyeOriH);
+    float eyeOriLen2V = glm::length2(eyeOriV);
 
-        auto xLeftDistance = radius - distanceToPlane(eyeOri, _gridPlanes[0][0]);
-        auto xRightDistance = radius + distanceToPlane(eyeOri, _gridPlanes[0].back());
+    if ((eyeOriLen2H > radius2)) {
+        float eyeOriLenH = sqrt(eyeOriLen2H);
 
-        auto yBottomDistance = radius - distanceToPlane(eyeOri, _gridPlanes[1][0]);
-        auto yTopDistance = radius + distanceToPlane(eyeOri, _gridPlanes[1].back());
+        auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
 
-        if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
-            continue;
-        }
+        float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
 
-        // find 2D corners of the sphere in grid
-        int xMin { 0 };
-        int xMax { theFrustumGrid.dims.x - 1 };
-        int yMin { 0 };
-        int yMax { theFrustumGrid.dims.y - 1 };
+        float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
 
-        float radius2 = radius * radius;
+        float eyeToTangentCircleSinH = radius / eyeOriLenH;
 
-        auto eyeOriH = glm::vec3(eyeOri);
-        auto eyeOriV = glm::vec3(eyeOri);
 
-        eyeOriH.y = 0.0f;
-        eyeOriV.x = 0.0f;
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
+        glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
 
-        float eyeOriLen2H = glm::length2(eyeOriH);
-        float eyeOriLen2V = glm::length2(eyeOriV);
+        auto lc = theFrustumGrid.frustumGrid_eyeToClusterDirH(leftDir);
+        if (lc > xMax) {
+            lc = xMin;
+        }
+        auto rc = theFrustumGrid.frustumGrid_eyeToClusterDirH(rightDir);
+        if (rc < 0) {
+            rc = xMax;
+        }
+        xMin = std::max(xMin, lc);
+        xMax = std::min(rc, xMax);
+        assert(xMin <= xMax);
+    }
 
-        if ((eyeOriLen2H > radius2)) {
-            float eyeOriLenH = sqrt(eyeOriLen2H);
+    if ((eyeOriLen2V > radius2)) {
+        float eyeOriLenV = sqrt(eyeOriLen2V);
 
-            auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
+        auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
 
-            float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
+        float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
 
-            float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
+        float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
 
-            float eyeToTangentCircleSinH = radius / eyeOriLenH;
+        float eyeToTangentCircleSinV = radius / eyeOriLenV;
 
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
-            glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+        glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
 
-            auto lc = theFrustumGrid.frustumGrid_eyeToClusterDirH(leftDir);
-            if (lc > xMax) {
-                lc = xMin;
-            }
-            auto rc = theFrustumGrid.frustumGrid_eyeToClusterDirH(rightDir);
-            if (rc < 0) {
-                rc = xMax;
-            }
-            xMin = std::max(xMin, lc);
-            xMax = std::min(rc, xMax);
-            assert(xMin <= xMax);
+        auto bc = theFrustumGrid.frustumGrid_eyeToClusterDirV(bottomDir);
+        auto tc = theFrustumGrid.frustumGrid_eyeToClusterDirV(topDir);
+        if (bc > yMax) {
+            bc = yMin;
+        }
+        if (tc < 0) {
+            tc = yMax;
         }
+        yMin = std::max(yMin, bc);
+        yMax =std::min(tc, yMax);
+        assert(yMin <= yMax);
+    }
 
-        if ((eyeOriLen2V > radius2)) {
-            float eyeOriLenV = sqrt(eyeOriLen2V);
+    // now voxelize
+    if (beyondFar) {
+        scanLightVolumeBoxSlice(theFrustumGrid, gridPlanes, zMin, yMin, yMax, xMin, xMax, glm::vec4(glm::vec3(eyeOri), radius), clusters);
+    } else {
+        scanLightVolumeSphere(theFrustumGrid, gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, glm::vec4(glm::vec3(eyeOri), radius), clusters);
+    }
+    return true;
+}
 
-            auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
+// Copies the range of the source that differs from the destination, and uploads it
+template <typename T>
+static void updateDirtyRange(const std::vector<T>& source, std::vector<T>& destination, size_t count, const gpu::BufferPointer& buffer) {
+    size_t first = 0;
+    while (first < count && source[first] == destination[first]) {
+        ++first;
+    }
+    if (first == count) {
+        return;
+    }
+    size_t last = count - 1;
+    while (last > first && source[last] == destination[last]) {
+        --last;
+    }
 
-            float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
+    size_t dirtyCount = last - first + 1;
+    memcpy(destination.data() + first, source.data() + first, dirtyCount * sizeof(T));
+    buffer->setSubData(first * sizeof(T), dirtyCount * sizeof(T), (const gpu::Byte*) (destination.data() + first));
+}
 
-            float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
+glm::ivec3 LightClusters::updateClusters() {
+    // Make sure resource are in good shape
+    updateClusterResource();
 
-            float eyeToTangentCircleSinV = radius / eyeOriLenV;
+    uint32_t numClusters = (uint32_t)_clusterGrid.size();
+    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
 
+    auto theFrustumGrid(_frustumGridBuffer.get());
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
-            glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+    // Gather the lights of the frame, only the ones that moved or changed, or all of them when the grid moved,
+    // need to be binned again
+    _clusteredLights.clear();
+    _dirtyLights.clear();
+    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
+        auto lightId = _visibleLightIndices[lightNum];
+        auto light = _lightStage->getLight(lightId);
+        if (!light) {
+            continue;
+        }
+        _clusteredLights.push_back(lightId);
 
-            auto bc = theFrustumGrid.frustumGrid_eyeToClusterDirV(bottomDir);
-            auto tc = theFrustumGrid.frustumGrid_eyeToClusterDirV(topDir);
-            if (bc > yMax) {
-                bc = yMin;
-            }
-            if (tc < 0) {
-                tc = yMax;
-            }
-            yMin = std::max(yMin, bc);
-            yMax =std::min(tc, yMax);
-            assert(yMin <= yMax);
+        if (lightId >= (LightID)_binnedLights.size()) {
+            _binnedLights.resize(lightId + 1);
         }
+        auto& binnedLight = _binnedLights[lightId];
 
-        // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
-        if (beyondFar) {
-            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        } else {
-            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
+        auto position = light->getPosition();
+        auto radius = light->getMaximumRadius();
+        bool isSpot = light->isSpot();
+        if (binnedLight.gridVersion != _gridVersion || binnedLight.position != position ||
+                binnedLight.radius != radius || binnedLight.isSpot != isSpot) {
+            binnedLight.position = position;
+            binnedLight.radius = radius;
+            binnedLight.isSpot = isSpot;
+            binnedLight.gridVersion = _gridVersion;
+            _dirtyLights.push_back(lightId);
         }
+    }
+
+    // Nothing to do if the same lights are in the same place
+    if (_dirtyLights.empty() && _clusteredLights == _lastClusteredLights) {
+        return _lastClusteringStats;
+    }
+    _lastClusteredLights = _clusteredLights;
 
+    // Bin the lights that changed on the worker threads, each light fills its own list of clusters
+    const size_t LIGHTS_PER_TASK = 8;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _dirtyLights.size(), LIGHTS_PER_TASK), [&](const tbb::blocked_range<size_t>& range) {
+        auto frustumGrid = theFrustumGrid;
+        for (auto i = range.begin(); i < range.end(); ++i) {
+            auto& binnedLight = _binnedLights[_dirtyLights[i]];
+            binnedLight.isClustered = binLight(frustumGrid, _gridPlanes, binnedLight.position, binnedLight.radius, binnedLight.clusters);
+        }
+    });
+
+    // Count the point and spot lights of every cluster
+    _clusterCounts.assign(numClusters * 2, 0);
+    uint32_t numClusterTouched = 0;
+    uint32_t numLightsIn = _visibleLightIndices[0];
+    uint32_t numClusteredLights = 0;
+    for (auto lightId : _clusteredLights) {
+        const auto& binnedLight = _binnedLights[lightId];
+        if (!binnedLight.isClustered) {
+            continue;
+        }
+        uint32_t countOffset = binnedLight.isSpot ? 1 : 0;
+        for (auto cluster : binnedLight.clusters) {
+            _clusterCounts[cluster * 2 + countOffset]++;
+        }
+        numClusterTouched += (uint32_t)binnedLight.clusters.size();
         numClusteredLights++;
     }
 
     // Lights have been gathered now reexpress in terms of 2 sequential buffers
     // Start filling from near to far and stops if it overflows
-    bool checkBudget = false;
-    if (numClusterTouched > maxNumIndices) {
-        checkBudget = true;
-    }
+    _nextClusterGrid.assign(numClusters, EMPTY_CLUSTER);
     uint16_t indexOffset = 0;
-    for (int i = 0; i < (int) clusterGridPoint.size(); i++) {
-        auto& clusterPoint = clusterGridPoint[i];
-        auto& clusterSpot = clusterGridSpot[i];
-
-        uint8_t numLightsPoint = ((uint8_t)clusterPoint.size());
-        uint8_t numLightsSpot = ((uint8_t)clusterSpot.size());
+    for (uint32_t i = 0; i < numClusters; i++) {
+        // a cluster can't reference more than 255 lights of each kind
+        uint8_t numLightsPoint = (uint8_t)std::min(_clusterCounts[i * 2], (uint32_t)0xFF);
+        uint8_t numLightsSpot = (uint8_t)std::min(_clusterCounts[i * 2 + 1], (uint32_t)0xFF);
         uint16_t numLights = numLightsPoint + numLightsSpot;
         uint16_t offset = indexOffset;
 
         // Check for overflow
-        if (checkBudget) {
-            if ((indexOffset + numLights) > (uint16_t) maxNumIndices) {
-                break;
-            }
+        if ((uint32_t)(indexOffset + numLights) > maxNumIndices) {
+            break;
         }
 
         // Encode the cluster grid: [ ContentOffset - 16bits, Num Point LIghts - 8bits, Num Spot Lights - 8bits] 
-        _clusterGrid[i] = (uint32_t)((0xFF000000 & (numLightsSpot << 24)) | (0x00FF0000 & (numLightsPoint << 16)) | (0x0000FFFF & offset));
+        _nextClusterGrid[i] = (uint32_t)((0xFF000000 & (numLightsSpot << 24)) | (0x00FF0000 & (numLightsPoint << 16)) | (0x0000FFFF & offset));
 
+        // from now on the counts are where the next light of each kind goes in the content
+        _clusterCounts[i * 2] = offset;
+        _clusterCounts[i * 2 + 1] = offset + numLightsPoint;
+        indexOffset += numLights;
+    }
 
-        if (numLightsPoint) {
-            memcpy(_clusterContent.data() + indexOffset, clusterPoint.data(), numLightsPoint * sizeof(LightIndex));
-            indexOffset += numLightsPoint;
+    // Then fill the content, in the order of the lights
+    _nextClusterContent.resize(maxNumIndices);
+    for (auto lightId : _clusteredLights) {
+        const auto& binnedLight = _binnedLights[lightId];
+        if (!binnedLight.isClustered) {
+            continue;
         }
-        if (numLightsSpot) {
-            memcpy(_clusterContent.data() + indexOffset, clusterSpot.data(), numLightsSpot * sizeof(LightIndex));
-            indexOffset += numLightsSpot;
+        uint32_t countOffset = binnedLight.isSpot ? 1 : 0;
+        for (auto cluster : binnedLight.clusters) {
+            uint32_t encoded = _nextClusterGrid[cluster];
+            if (encoded == EMPTY_CLUSTER) {
+                // beyond the budget
+                continue;
+            }
+            uint32_t end = (encoded & 0x0000FFFF) + ((encoded >> 16) & 0xFF);
+            if (binnedLight.isSpot) {
+                end += (encoded >> 24) & 0xFF;
+            }
+            auto& next = _clusterCounts[cluster * 2 + countOffset];
+            if (next < end) {
+                _nextClusterContent[next++] = (LightIndex)lightId;
+            }
         }
     }
 
-    // update the buffers
-    _clusterGridBuffer._buffer->setData(_clusterGridBuffer._size, (gpu::Byte*) _clusterGrid.data());
-    _clusterContentBuffer._buffer->setSubData(0, indexOffset * sizeof(LightIndex), (gpu::Byte*) _clusterContent.data());
-    
-    return glm::ivec3(numLightsIn, numClusteredLights, numClusterTouched);
+    // update the ranges of the buffers that changed
+    updateDirtyRange(_nextClusterGrid, _clusterGrid, numClusters, _clusterGridBuffer._buffer);
+    updateDirtyRange(_nextClusterContent, _clusterContent, indexOffset, _clusterContentBuffer._buffer);
+
+    _lastClusteringStats = glm::ivec3(numLightsIn, numClusteredLights, numClusterTouched);
+    return _lastClusteringStats;
 }
 
 
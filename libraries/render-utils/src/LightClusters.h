@@ -111,6 +111,29 @@ public:
 
     bool _clusterResourcesInvalid { true };
     void updateClusterResource();
+
+    // What a light was binned with, it is binned again only when any of it or the grid changed
+    struct BinnedLight {
+        glm::vec3 position;
+        float radius { 0.0f };
+        bool isSpot { false };
+        bool isClustered { false };
+        uint32_t gridVersion { 0 };
+        std::vector<uint32_t> clusters;
+    };
+
+    // bumped every time the grid moves or changes shape
+    uint32_t _gridVersion { 1 };
+    std::vector<BinnedLight> _binnedLights; // by LightID
+    LightStage::LightIndices _clusteredLights;
+    LightStage::LightIndices _lastClusteredLights;
+    std::vector<LightID> _dirtyLights;
+    glm::ivec3 _lastClusteringStats { 0 };
+
+    // scratch of updateClusters, the grid and content are only copied to the gpu buffers where they changed
+    std::vector<uint32_t> _clusterCounts;
+    std::vector<uint32_t> _nextClusterGrid;
+    std::vector<LightIndex> _nextClusterContent;
 };
 
 using LightClustersPointer = std::shared_ptr<LightClusters>;
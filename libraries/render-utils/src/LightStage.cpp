@@ -13,6 +13,9 @@
 
 #include "LightStage.h"
 
+// in meters, the keylight frustum moves along the light and its size changes by whole steps of this
+static const float KEYLIGHT_GRID_SIZE = 1.0f;
+
 LightStage::Shadow::Shadow(model::LightPointer light) : _light{ light}, _frustum{ std::make_shared<ViewFrustum>() } {
     framebuffer = gpu::FramebufferPointer(gpu::Framebuffer::createShadowmap(MAP_SIZE));
     map = framebuffer->getDepthStencilBuffer();
@@ -37,36 +40,41 @@ void LightStage::Shadow::setKeylightFrustum(const ViewFrustum& viewFrustum, floa
     }
     _frustum->setOrientation(orientation);
 
-    // Position the keylight frustum
-    _frustum->setPosition(viewFrustum.getPosition() - (nearDepth + farDepth)*direction);
+    // The keylight frustum holds the sphere around the view position that contains the view frustum, so that it doesn't
+    // change as the view turns, and it moves with the view by whole shadow map texels across the light and by whole grid
+    // cells along it: the shadows don't shimmer, and the shadow map can be kept while the view stays within a texel
+    const auto& viewPosition = viewFrustum.getPosition();
+    auto nearCorners = viewFrustum.getCorners(nearDepth);
+    auto farCorners = viewFrustum.getCorners(farDepth);
+    float radius = 0.0f;
+    for (const auto& corner : { nearCorners.bottomLeft, nearCorners.bottomRight, nearCorners.topLeft, nearCorners.topRight,
+            farCorners.bottomLeft, farCorners.bottomRight, farCorners.topLeft, farCorners.topRight }) {
+        radius = glm::max(radius, glm::distance(viewPosition, corner));
+    }
+    radius = glm::ceil(radius / KEYLIGHT_GRID_SIZE) * KEYLIGHT_GRID_SIZE;
+    const float texelSize = 2.0f * radius / MAP_SIZE;
+
+    // The view position in the keylight space, whose axes are the columns of the orientation
+    const glm::mat3 axes = glm::mat3_cast(orientation);
+    const vec3 lightViewPosition = viewPosition * axes;
+
+    // Position the keylight frustum on the grid, back along the light
+    const vec3 lightPosition = glm::floor(lightViewPosition / KEYLIGHT_GRID_SIZE) * KEYLIGHT_GRID_SIZE +
+        vec3(0.0f, 0.0f, nearDepth + farDepth);
+    _frustum->setPosition(axes * lightPosition);
 
     const Transform view{ _frustum->getView()};
     const Transform viewInverse{ view.getInverseMatrix() };
 
-    auto nearCorners = viewFrustum.getCorners(nearDepth);
-    auto farCorners = viewFrustum.getCorners(farDepth);
-
-    vec3 min{ viewInverse.transform(nearCorners.bottomLeft) };
-    vec3 max{ min };
-    // Expand keylight frustum  to fit view frustum
-    auto fitFrustum = [&min, &max, &viewInverse](const vec3& viewCorner) {
-        const auto corner = viewInverse.transform(viewCorner);
-
-        min.x = glm::min(min.x, corner.x);
-        min.y = glm::min(min.y, corner.y);
-        min.z = glm::min(min.z, corner.z);
-
-        max.x = glm::max(max.x, corner.x);
-        max.y = glm::max(max.y, corner.y);
-        max.z = glm::max(max.z, corner.z);
-    };
-    fitFrustum(nearCorners.bottomRight);
-    fitFrustum(nearCorners.topLeft);
-    fitFrustum(nearCorners.topRight);
-    fitFrustum(farCorners.bottomLeft);
-    fitFrustum(farCorners.bottomRight);
-    fitFrustum(farCorners.topLeft);
-    fitFrustum(farCorners.topRight);
+    // Fit the sphere on the texels, the depth range is the same for the whole grid cell
+    vec3 min;
+    vec3 max;
+    min.x = glm::floor((lightViewPosition.x - radius) / texelSize) * texelSize - lightPosition.x;
+    min.y = glm::floor((lightViewPosition.y - radius) / texelSize) * texelSize - lightPosition.y;
+    min.z = -radius - (nearDepth + farDepth);
+    max.x = min.x + 2.0f * radius;
+    max.y = min.y + 2.0f * radius;
+    max.z = radius + KEYLIGHT_GRID_SIZE - (nearDepth + farDepth);
 
     glm::mat4 ortho = glm::ortho<float>(min.x, max.x, min.y, max.y, -max.z, -min.z);
     _frustum->setProjection(ortho);
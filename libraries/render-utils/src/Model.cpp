@@ -236,37 +236,33 @@ void Model::updateRenderItems() {
         uint32_t deleteGeometryCounter = self->_deleteGeometryCounter;
 
         render::PendingChanges pendingChanges;
-        foreach (auto itemID, self->_modelMeshRenderItemsMap.keys()) {
-            pendingChanges.updateItem<ModelMeshPartPayload>(itemID, [deleteGeometryCounter](ModelMeshPartPayload& data) {
-                if (data._model && data._model->isLoaded()) {
-                    // Ensure the model geometry was not reset between frames
-                    if (deleteGeometryCounter == data._model->_deleteGeometryCounter) {
-                        Transform modelTransform = data._model->getTransform();
-                        modelTransform.setScale(glm::vec3(1.0f));
-
-                        const Model::MeshState& state = data._model->getMeshState(data._meshIndex);
-                        Transform renderTransform = modelTransform;
-                        if (state.clusterMatrices.size() == 1) {
-                            renderTransform = modelTransform.worldTransform(Transform(state.clusterMatrices[0]));
-                        }
-                        data.updateTransformForSkinnedMesh(renderTransform, modelTransform, state.clusterBuffer);
+        pendingChanges.updateItems<ModelMeshPartPayload>(self->_modelMeshRenderItemsMap.keys(), [deleteGeometryCounter](ModelMeshPartPayload& data) {
+            if (data._model && data._model->isLoaded()) {
+                // Ensure the model geometry was not reset between frames
+                if (deleteGeometryCounter == data._model->_deleteGeometryCounter) {
+                    Transform modelTransform = data._model->getTransform();
+                    modelTransform.setScale(glm::vec3(1.0f));
+
+                    const Model::MeshState& state = data._model->getMeshState(data._meshIndex);
+                    Transform renderTransform = modelTransform;
+                    if (state.clusterMatrices.size() == 1) {
+                        renderTransform = modelTransform.worldTransform(Transform(state.clusterMatrices[0]));
                     }
+                    data.updateTransformForSkinnedMesh(renderTransform, modelTransform, state.clusterBuffer);
                 }
-            });
-        }
+            }
+        });
 
         // collision mesh does not share the same unit scale as the FBX file's mesh: only apply offset
         Transform collisionMeshOffset;
         collisionMeshOffset.setIdentity();
         Transform modelTransform = self->getTransform();
-		foreach(auto itemID, self->_collisionRenderItemsMap.keys()) {
-            pendingChanges.updateItem<MeshPartPayload>(itemID, [modelTransform, collisionMeshOffset](MeshPartPayload& data) {
-                // update the model transform for this render item.
-                data.updateTransform(modelTransform, collisionMeshOffset);
-            });
-        }
+        pendingChanges.updateItems<MeshPartPayload>(self->_collisionRenderItemsMap.keys(), [modelTransform, collisionMeshOffset](MeshPartPayload& data) {
+            // update the model transform for this render item.
+            data.updateTransform(modelTransform, collisionMeshOffset);
+        });
 
-        scene->enqueuePendingChanges(pendingChanges);
+        scene->enqueuePendingChanges(std::move(pendingChanges));
     });
 }
 
@@ -122,6 +122,7 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
 
     // Light Clustering
     // Create the cluster grid of lights, cpu job for now
+    // It fills the cluster grid and content gpu buffers, so it stays out of any concurrent group
     const auto lightClusteringPassInputs = LightClusteringPass::Inputs(deferredFrameTransform, lightingModel, linearDepthTarget).hasVarying();
     const auto lightClusters = addJob<LightClusteringPass>("LightClustering", lightClusteringPassInputs);
     
@@ -287,10 +288,16 @@ void DrawStateSortDeferred::run(const SceneContextPointer& sceneContext, const R
 
     RenderArgs* args = renderContext->args;
 
-    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
-        args->_batch = &batch;
+    // From the lighting model define a global shapKey ORED with individiual keys
+    ShapeKey::Builder keyBuilder;
+    if (lightingModel->isWireframeEnabled()) {
+        keyBuilder.withWireframe();
+    }
+    ShapeKey globalKey = keyBuilder.build();
+    args->_globalShapeKey = globalKey._flags.to_ulong();
 
-        // Setup camera, projection and viewport for all items
+    // Setup camera, projection, viewport and lighting model for all items
+    auto setupBatch = [&](gpu::Batch& batch) {
         batch.setViewportTransform(args->_viewport);
         batch.setStateScissorRect(args->_viewport);
 
@@ -302,25 +309,25 @@ void DrawStateSortDeferred::run(const SceneContextPointer& sceneContext, const R
         batch.setProjectionTransform(projMat);
         batch.setViewTransform(viewMat);
 
-        // Setup lighting model for all items;
         batch.setUniformBuffer(render::ShapePipeline::Slot::LIGHTING_MODEL, lightingModel->getParametersBuffer());
+    };
 
-        // From the lighting model define a global shapKey ORED with individiual keys
-        ShapeKey::Builder keyBuilder;
-        if (lightingModel->isWireframeEnabled()) {
-            keyBuilder.withWireframe();
-        }
-        ShapeKey globalKey = keyBuilder.build();
-        args->_globalShapeKey = globalKey._flags.to_ulong();
+    if (_concurrentRecording) {
+        renderShapesConcurrently(sceneContext, renderContext, _shapePlumber, inItems, setupBatch, _stateSort, _maxDrawn, globalKey);
+    } else {
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+            setupBatch(batch);
 
-        if (_stateSort) {
-            renderStateSortShapes(sceneContext, renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        } else {
-            renderShapes(sceneContext, renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        }
-        args->_batch = nullptr;
-        args->_globalShapeKey = 0;
-    });
+            if (_stateSort) {
+                renderStateSortShapes(sceneContext, renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            } else {
+                renderShapes(sceneContext, renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            }
+            args->_batch = nullptr;
+        });
+    }
+    args->_globalShapeKey = 0;
 
     config->setNumDrawn((int)inItems.size());
 }
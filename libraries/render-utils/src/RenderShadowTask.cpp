@@ -31,6 +31,43 @@
 
 using namespace render;
 
+bool RenderShadowCache::update(const Scene& scene, const LightStage::Shadow& shadow, const RenderArgs* args) {
+    bool isValid = _enabled && _hasRendered &&
+        (shadow.framebuffer == _framebuffer) &&
+        (shadow.getView() == _view) && (shadow.getProjection() == _projection) &&
+        (args->_sizeScale == _sizeScale) && (args->_boundaryLevelAdjust == _boundaryLevelAdjust);
+
+    // The changes processed since the last frame must all be out of the keylight frustum,
+    // if some changes went by unseen, assume they weren't
+    auto changeStamp = scene.getChangeStamp();
+    if (isValid && (changeStamp != _changeStamp)) {
+        if (changeStamp != _changeStamp + 1) {
+            isValid = false;
+        } else {
+            const auto& frustum = *shadow.getFrustum();
+            for (const auto& bound : scene.getChangedBounds()) {
+                if (frustum.boxIntersectsFrustum(bound)) {
+                    isValid = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!isValid) {
+        // The shadow map is rendered again for this frame
+        _framebuffer = shadow.framebuffer;
+        _view = shadow.getView();
+        _projection = shadow.getProjection();
+        _sizeScale = args->_sizeScale;
+        _boundaryLevelAdjust = args->_boundaryLevelAdjust;
+        _hasRendered = _enabled;
+    }
+    _changeStamp = changeStamp;
+    _isValid = isValid;
+    return isValid;
+}
+
 void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
                           const render::ShapeBounds& inShapes) {
     assert(renderContext->args);
@@ -90,7 +127,9 @@ void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const
     });
 }
 
-RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) {
+RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) :
+    _cache(std::make_shared<RenderShadowCache>())
+{
     cullFunctor = cullFunctor ? cullFunctor : [](const RenderArgs*, const AABox&){ return true; };
 
     // Prepare the ShapePipeline
@@ -115,26 +154,29 @@ RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) {
             skinProgram, state);
     }
 
-    const auto cachedMode = addJob<RenderShadowSetup>("Setup");
+    const auto cachedMode = addJob<RenderShadowSetup>("Setup", _cache);
+
+    // The shadow casters are only selected and rendered again when the shadow map of the previous frame can't be reused
 
     // CPU jobs:
     // Fetch and cull the items from the scene
-    auto shadowFilter = ItemFilter::Builder::visibleWorldItems().withTypeShape().withOpaque().withoutLayered();
-    const auto shadowSelection = addJob<FetchSpatialTree>("FetchShadowSelection", shadowFilter);
-    const auto culledShadowSelection = addJob<CullSpatialSelection>("CullShadowSelection", shadowSelection, cullFunctor, RenderDetails::SHADOW, shadowFilter);
+    auto shadowFilter = ItemFilter::Builder::shadowCasters();
+    const auto shadowSelection = addJob<RenderShadowCached<FetchSpatialTree>>("FetchShadowSelection", _cache, shadowFilter);
+    const auto culledShadowSelection = addJob<RenderShadowCached<CullSpatialSelection>>("CullShadowSelection", shadowSelection, _cache, cullFunctor, RenderDetails::SHADOW, shadowFilter);
 
     // Sort
-    const auto sortedPipelines = addJob<PipelineSortShapes>("PipelineSortShadowSort", culledShadowSelection);
-    const auto sortedShapes = addJob<DepthSortShapes>("DepthSortShadowMap", sortedPipelines);
+    const auto sortedPipelines = addJob<RenderShadowCached<PipelineSortShapes>>("PipelineSortShadowSort", culledShadowSelection, _cache);
+    const auto sortedShapes = addJob<RenderShadowCached<DepthSortShapes>>("DepthSortShadowMap", sortedPipelines, _cache);
 
     // GPU jobs: Render to shadow map
-    addJob<RenderShadowMap>("RenderShadowMap", sortedShapes, shapePlumber);
+    addJob<RenderShadowCached<RenderShadowMap>>("RenderShadowMap", sortedShapes, _cache, shapePlumber);
 
     addJob<RenderShadowTeardown>("Teardown", cachedMode);
 }
 
 void RenderShadowTask::configure(const Config& configuration) {
     DependencyManager::get<DeferredLightingEffect>()->setShadowMapEnabled(configuration.enabled);
+    _cache->setEnabled(configuration.cached);
     // This is a task, so must still propogate configure() to its Jobs
     Task::configure(configuration);
 }
@@ -152,6 +194,9 @@ void RenderShadowSetup::run(const SceneContextPointer& sceneContext, const rende
     const int SHADOW_FAR_DEPTH = 20;
     globalShadow->setKeylightFrustum(args->getViewFrustum(), nearDepth, nearClip + SHADOW_FAR_DEPTH);
 
+    // Decide if the shadow map of the previous frame can be kept
+    _cache->update(*sceneContext->_scene, *globalShadow, args);
+
     // Set the keylight render args
     args->pushViewFrustum(*(globalShadow->getFrustum()));
     args->_renderMode = RenderArgs::SHADOW_RENDER_MODE;
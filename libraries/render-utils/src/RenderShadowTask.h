@@ -17,8 +17,71 @@
 
 #include <render/CullTask.h>
 
+#include "LightStage.h"
+
 class ViewFrustum;
 
+// Keeps the shadow map of the last frame as long as it would be rendered the same: the keylight frustum and the lod
+// didn't change, and none of the items changed in the scene since then was in the keylight frustum.
+// The keylight frustum is snapped to the shadow map texels (see LightStage::Shadow::setKeylightFrustum), so it stays
+// the same while the view turns or moves by less than a texel.
+class RenderShadowCache {
+public:
+    void setEnabled(bool enabled) { _enabled = enabled; invalidate(); }
+    void invalidate() { _isValid = false; _hasRendered = false; }
+
+    // Checks the frame against the one the shadow map was rendered for, once the keylight frustum is set
+    bool update(const render::Scene& scene, const LightStage::Shadow& shadow, const RenderArgs* args);
+
+    // True if the shadow casters don't need to be selected and rendered again this frame
+    bool isValid() const { return _isValid; }
+
+private:
+    bool _enabled { true };
+    bool _isValid { false };
+    bool _hasRendered { false };
+
+    gpu::FramebufferPointer _framebuffer;
+    glm::mat4 _view;
+    glm::mat4 _projection;
+    float _sizeScale { 1.0f };
+    int _boundaryLevelAdjust { 0 };
+    uint32_t _changeStamp { 0 };
+};
+using RenderShadowCachePointer = std::shared_ptr<RenderShadowCache>;
+
+template <class M> struct RenderShadowJobTraits;
+template <class T, class C, class I, class O> struct RenderShadowJobTraits<render::Job::Model<T, C, I, O>> {
+    using Config = C;
+    using Input = I;
+    using Output = O;
+};
+
+// Runs a job of the shadow task only when the shadow map has to be rendered again,
+// otherwise its output is left as it was the last time the shadow map was rendered
+template <class T> class RenderShadowCached {
+public:
+    using Traits = RenderShadowJobTraits<typename T::JobModel>;
+    using Config = typename Traits::Config;
+    using JobModel = render::Job::Model<RenderShadowCached<T>, Config, typename Traits::Input, typename Traits::Output>;
+
+    template <class... A>
+    RenderShadowCached(RenderShadowCachePointer cache, A&&... args) : _cache(cache), _job(std::forward<A>(args)...) {}
+
+    void configure(const Config& config) { render::jobConfigure(_job, config); }
+
+    template <class... A>
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, A&&... args) {
+        if (!_cache->isValid()) {
+            _job.run(sceneContext, renderContext, std::forward<A>(args)...);
+        }
+    }
+
+protected:
+    RenderShadowCachePointer _cache;
+    T _job;
+};
+
 class RenderShadowMap {
 public:
     using JobModel = render::Job::ModelI<RenderShadowMap, render::ShapeBounds>;
@@ -34,9 +97,13 @@ protected:
 class RenderShadowTaskConfig : public render::Task::Config::Persistent {
     Q_OBJECT
     Q_PROPERTY(bool enabled MEMBER enabled NOTIFY dirty)
+    Q_PROPERTY(bool cached MEMBER cached NOTIFY dirty)
 public:
     RenderShadowTaskConfig() : render::Task::Config::Persistent("Shadows", false) {}
 
+    // Reuse the shadow map of the previous frame when nothing it shows changed and the view didn't move by a texel
+    bool cached { true };
+
 signals:
     void dirty();
 };
@@ -49,13 +116,21 @@ public:
     RenderShadowTask(render::CullFunctor shouldRender);
 
     void configure(const Config& configuration);
+
+protected:
+    RenderShadowCachePointer _cache;
 };
 
 class RenderShadowSetup {
 public:
     using Output = RenderArgs::RenderMode;
     using JobModel = render::Job::ModelO<RenderShadowSetup, Output>;
+
+    RenderShadowSetup(RenderShadowCachePointer cache) : _cache(cache) {}
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, Output& output);
+
+protected:
+    RenderShadowCachePointer _cache;
 };
 
 class RenderShadowTeardown {
@@ -114,12 +114,131 @@ void CullSpatialSelection::configure(const Config& config) {
     _skipCulling = config.skipCulling;
 }
 
+// The frustum planes, with the normals split into components to be broadcast against several boxes
+struct FrustumPlanes {
+    float nx[NUM_FRUSTUM_PLANES];
+    float ny[NUM_FRUSTUM_PLANES];
+    float nz[NUM_FRUSTUM_PLANES];
+    float d[NUM_FRUSTUM_PLANES];
+
+    FrustumPlanes(const ViewFrustum& frustum) {
+        const ::Plane* planes = frustum.getPlanes();
+        for (int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+            nx[i] = planes[i].getNormal().x;
+            ny[i] = planes[i].getNormal().y;
+            nz[i] = planes[i].getNormal().z;
+            d[i] = planes[i].getDCoefficient();
+        }
+    }
+};
+
+// Same test as ViewFrustum::boxIntersectsFrustum, the box vertex farthest along each plane normal must not be behind it
+static bool boundIntersectsFrustum(const FrustumPlanes& planes, const ItemBoundCache& bounds, ItemID id) {
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        float x = (planes.nx[i] > 0.0f) ? bounds.cornerX[id] + bounds.scaleX[id] : bounds.cornerX[id];
+        float y = (planes.ny[i] > 0.0f) ? bounds.cornerY[id] + bounds.scaleY[id] : bounds.cornerY[id];
+        float z = (planes.nz[i] > 0.0f) ? bounds.cornerZ[id] + bounds.scaleZ[id] : bounds.cornerZ[id];
+        if (planes.d[i] + (planes.nx[i] * x + planes.ny[i] * y + planes.nz[i] * z) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// on x86 architecture, assume that SSE is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+// Tests the bounds of 4 items at a time against all the planes, returns the number of items tested
+static size_t boundsIntersectFrustum_SSE(const FrustumPlanes& planes, const ItemBoundCache& bounds,
+                                         const ItemID* ids, size_t numIDs, uint8_t* inView) {
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= numIDs; i += 4) {
+        const ItemID* id = ids + i;
+        const __m128 cornerX = _mm_setr_ps(bounds.cornerX[id[0]], bounds.cornerX[id[1]], bounds.cornerX[id[2]], bounds.cornerX[id[3]]);
+        const __m128 cornerY = _mm_setr_ps(bounds.cornerY[id[0]], bounds.cornerY[id[1]], bounds.cornerY[id[2]], bounds.cornerY[id[3]]);
+        const __m128 cornerZ = _mm_setr_ps(bounds.cornerZ[id[0]], bounds.cornerZ[id[1]], bounds.cornerZ[id[2]], bounds.cornerZ[id[3]]);
+        const __m128 farX = _mm_add_ps(cornerX, _mm_setr_ps(bounds.scaleX[id[0]], bounds.scaleX[id[1]], bounds.scaleX[id[2]], bounds.scaleX[id[3]]));
+        const __m128 farY = _mm_add_ps(cornerY, _mm_setr_ps(bounds.scaleY[id[0]], bounds.scaleY[id[1]], bounds.scaleY[id[2]], bounds.scaleY[id[3]]));
+        const __m128 farZ = _mm_add_ps(cornerZ, _mm_setr_ps(bounds.scaleZ[id[0]], bounds.scaleZ[id[1]], bounds.scaleZ[id[2]], bounds.scaleZ[id[3]]));
+
+        int outside = 0;
+        for (int p = 0; p < NUM_FRUSTUM_PLANES && outside != 0xF; ++p) {
+            // the normal is the same for the 4 boxes, so is the choice of their farthest vertex
+            const __m128 x = (planes.nx[p] > 0.0f) ? farX : cornerX;
+            const __m128 y = (planes.ny[p] > 0.0f) ? farY : cornerY;
+            const __m128 z = (planes.nz[p] > 0.0f) ? farZ : cornerZ;
+            __m128 dot = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), x), _mm_mul_ps(_mm_set1_ps(planes.ny[p]), y));
+            dot = _mm_add_ps(dot, _mm_mul_ps(_mm_set1_ps(planes.nz[p]), z));
+            const __m128 distance = _mm_add_ps(_mm_set1_ps(planes.d[p]), dot);
+            outside |= _mm_movemask_ps(_mm_cmplt_ps(distance, zero));
+        }
+
+        inView[i] = !(outside & 0x1);
+        inView[i + 1] = !(outside & 0x2);
+        inView[i + 2] = !(outside & 0x4);
+        inView[i + 3] = !(outside & 0x8);
+    }
+    return i;
+}
+
+#else
+
+static size_t boundsIntersectFrustum_SSE(const FrustumPlanes& planes, const ItemBoundCache& bounds,
+                                         const ItemID* ids, size_t numIDs, uint8_t* inView) {
+    return 0;
+}
+
+#endif
+
+// Appends the items passing the filter to outItems, with the bound of the scene's cache
+static void filterItems(const ItemFilter& filter, const ItemBoundCache& bounds, const ItemIDs& ids, ItemBounds& outItems) {
+    for (auto id : ids) {
+        if (filter.test(bounds.getKey(id))) {
+            outItems.emplace_back(id, bounds.getBound(id));
+        }
+    }
+}
+
+// Appends the items passing the filter and intersecting the frustum to outItems, returns the number out of view
+static int filterAndFrustumCullItems(const ItemFilter& filter, const ItemBoundCache& bounds, const FrustumPlanes& planes,
+                                     const ItemIDs& ids, ItemIDs& candidates, std::vector<uint8_t>& inView, ItemBounds& outItems) {
+    candidates.clear();
+    for (auto id : ids) {
+        if (filter.test(bounds.getKey(id))) {
+            candidates.push_back(id);
+        }
+    }
+
+    inView.resize(candidates.size());
+    size_t i = boundsIntersectFrustum_SSE(planes, bounds, candidates.data(), candidates.size(), inView.data());
+    for (; i < candidates.size(); ++i) {
+        inView[i] = boundIntersectsFrustum(planes, bounds, candidates[i]);
+    }
+
+    int numOutOfView = 0;
+    for (i = 0; i < candidates.size(); ++i) {
+        if (inView[i]) {
+            outItems.emplace_back(candidates[i], bounds.getBound(candidates[i]));
+        } else {
+            ++numOutOfView;
+        }
+    }
+    return numOutOfView;
+}
+
 void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
     const ItemSpatialTree::ItemSelection& inSelection, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
     RenderArgs* args = renderContext->args;
     auto& scene = sceneContext->_scene;
+    const auto& bounds = scene->getItemBoundCache();
 
     auto& details = args->_details.edit(_detailType);
     details._considered += (int)inSelection.numItems();
@@ -133,7 +252,7 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
         args->pushViewFrustum(_frozenFrutstum); // replace the true view frustum by the frozen one
     }
 
-    // Culling Frustum / solidAngle test helper class
+    // Culling solidAngle test helper class, the frustum test is done on the bound cache
     struct Test {
         CullFunctor _functor;
         RenderArgs* _args;
@@ -156,14 +275,6 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
             */
         }
 
-        bool frustumTest(const AABox& bound) {
-            if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-                _renderDetails._outOfView++;
-                return false;
-            }
-            return true;
-        }
-
         bool solidAngleTest(const AABox& bound) {
             // FIXME: Keep this code here even though we don't use it yet
             //auto eyeToPoint = bound.calcCenter() - _eyePos;
@@ -183,7 +294,7 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
     outItems.clear();
     outItems.reserve(inSelection.numItems());
 
-    // Now get the bound, and
+    // Now get the bound from the scene's cache, and
     // filter individually against the _filter
     // visibility cull if partially selected ( octree cell contianing it was partial)
     // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
@@ -192,72 +303,42 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
         // inside & fit items: filter only, culling is disabled
         {
             PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+            filterItems(_filter, bounds, inSelection.insideItems, outItems);
         }
 
         // inside & subcell items: filter only, culling is disabled
         {
             PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+            filterItems(_filter, bounds, inSelection.insideSubcellItems, outItems);
         }
 
         // partial & fit items: filter only, culling is disabled
         {
             PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+            filterItems(_filter, bounds, inSelection.partialItems, outItems);
         }
 
         // partial & subcell items: filter only, culling is disabled
         {
             PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+            filterItems(_filter, bounds, inSelection.partialSubcellItems, outItems);
         }
 
     } else {
+        const FrustumPlanes planes(args->getViewFrustum());
 
         // inside & fit items: easy, just filter
         {
             PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+            filterItems(_filter, bounds, inSelection.insideItems, outItems);
         }
 
         // inside & subcell items: filter & distance cull
         {
             PerformanceTimer perfTimer("insideSmallItems");
             for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
+                if (_filter.test(bounds.getKey(id))) {
+                    ItemBound itemBound(id, bounds.getBound(id));
                     if (test.solidAngleTest(itemBound.bound)) {
                         outItems.emplace_back(itemBound);
                     }
@@ -268,31 +349,19 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
         // partial & fit items: filter & frustum cull
         {
             PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
+            details._outOfView += filterAndFrustumCullItems(_filter, bounds, planes, inSelection.partialItems,
+                _candidates, _candidatesInView, outItems);
         }
 
         // partial & subcell items:: filter & frutum cull & solidangle cull
         {
             PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                        }
-                    }
-                }
-            }
+            auto firstInView = outItems.size();
+            details._outOfView += filterAndFrustumCullItems(_filter, bounds, planes, inSelection.partialSubcellItems,
+                _candidates, _candidatesInView, outItems);
+            outItems.erase(std::remove_if(outItems.begin() + firstInView, outItems.end(), [&](const ItemBound& itemBound) {
+                return !test.solidAngleTest(itemBound.bound);
+            }), outItems.end());
         }
     }
 
@@ -89,6 +89,10 @@ namespace render {
         bool _justFrozeFrustum{ false };
         bool _skipCulling{ false };
         ViewFrustum _frozenFrutstum;
+
+        // scratch space of the frustum culling, kept between frames
+        ItemIDs _candidates;
+        std::vector<uint8_t> _candidatesInView;
     public:
         using Config = CullSpatialSelectionConfig;
         using JobModel = Job::ModelIO<CullSpatialSelection, ItemSpatialTree::ItemSelection, ItemBounds, Config>;
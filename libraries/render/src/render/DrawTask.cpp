@@ -15,6 +15,8 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <tbb/parallel_for.h>
+
 #include <PerfStat.h>
 #include <ViewFrustum.h>
 #include <gpu/Context.h>
@@ -123,6 +125,125 @@ void render::renderStateSortShapes(const SceneContextPointer& sceneContext, cons
     }
 }
 
+void render::renderShapesConcurrently(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, const BatchSetup& setupBatch, bool stateSort,
+    int maxDrawnItems, const ShapeKey& globalKey) {
+    auto& scene = sceneContext->_scene;
+    RenderArgs* args = renderContext->args;
+
+    int numItemsToDraw = (int)inItems.size();
+    if (maxDrawnItems != -1) {
+        numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
+    }
+
+    // The PerformanceTimers used by pickPipeline and the items can't be shared across threads
+    int numBatches = glm::min(numItemsToDraw / MIN_ITEMS_PER_BATCH, MAX_CONCURRENT_BATCHES);
+    if (numBatches <= 1 || PerformanceTimer::isActive()) {
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+            setupBatch(batch);
+            if (stateSort) {
+                renderStateSortShapes(sceneContext, renderContext, shapeContext, inItems, maxDrawnItems, globalKey);
+            } else {
+                renderShapes(sceneContext, renderContext, shapeContext, inItems, maxDrawnItems, globalKey);
+            }
+            args->_batch = nullptr;
+        });
+        return;
+    }
+
+    // Resolve the pipeline of every item on this thread, in the order they are drawn,
+    // items with their own pipeline have none and come last when sorting
+    struct ShapeDraw {
+        const Item* item;
+        ShapePipelinePointer pipeline;
+    };
+    std::vector<ShapeDraw> draws;
+    draws.reserve(numItemsToDraw);
+    {
+        using SortedPipelines = std::vector<ShapeKey>;
+        using SortedShapes = std::unordered_map<ShapeKey, std::vector<const Item*>, ShapeKey::Hash, ShapeKey::KeyEqual>;
+        SortedPipelines sortedPipelines;
+        SortedShapes sortedShapes;
+        std::vector<const Item*> ownPipelineBucket;
+
+        for (auto i = 0; i < numItemsToDraw; ++i) {
+            const Item* item = &scene->getItem(inItems[i].id);
+            assert(item->getKey().isShape());
+            auto key = item->getShapeKey() | globalKey;
+            if (key.isValid() && !key.hasOwnPipeline()) {
+                if (stateSort) {
+                    auto& bucket = sortedShapes[key];
+                    if (bucket.empty()) {
+                        sortedPipelines.push_back(key);
+                    }
+                    bucket.push_back(item);
+                } else if (auto pipeline = shapeContext->findPipeline(key)) {
+                    draws.push_back({ item, pipeline });
+                }
+            } else if (key.hasOwnPipeline()) {
+                if (stateSort) {
+                    ownPipelineBucket.push_back(item);
+                } else {
+                    draws.push_back({ item, nullptr });
+                }
+            } else {
+                qCDebug(renderlogging) << "Item could not be rendered with invalid key" << key;
+            }
+        }
+
+        for (auto& pipelineKey : sortedPipelines) {
+            auto pipeline = shapeContext->findPipeline(pipelineKey);
+            if (!pipeline) {
+                continue;
+            }
+            for (auto item : sortedShapes[pipelineKey]) {
+                draws.push_back({ item, pipeline });
+            }
+        }
+        for (auto item : ownPipelineBucket) {
+            draws.push_back({ item, nullptr });
+        }
+    }
+
+    // Record one contiguous range of the draws per batch
+    const int numDraws = (int)draws.size();
+    numBatches = glm::clamp(numDraws / MIN_ITEMS_PER_BATCH, 1, numBatches);
+    std::vector<gpu::BatchPointer> batches(numBatches);
+    std::vector<RenderDetails> details(numBatches);
+
+    tbb::parallel_for(0, numBatches, [&](int b) {
+        auto batch = args->_context->acquireBatch();
+        RenderArgs batchArgs(*args);
+        batchArgs._batch = batch.get();
+        batchArgs._details = RenderDetails();
+        setupBatch(*batch);
+
+        const int begin = (int)((int64_t)numDraws * b / numBatches);
+        const int end = (int)((int64_t)numDraws * (b + 1) / numBatches);
+        ShapePipelinePointer currentPipeline;
+        for (int i = begin; i < end; ++i) {
+            const auto& draw = draws[i];
+            if (draw.pipeline && draw.pipeline != currentPipeline) {
+                batch->setPipeline(draw.pipeline->pipeline);
+                draw.pipeline->prepare(*batch);
+            }
+            currentPipeline = draw.pipeline;
+            batchArgs._pipeline = draw.pipeline;
+            draw.item->render(&batchArgs);
+        }
+
+        batches[b] = batch;
+        details[b] = batchArgs._details;
+    });
+
+    for (int b = 0; b < numBatches; ++b) {
+        args->_context->appendFrameBatch(batches[b]);
+        args->_details._materialSwitches += details[b]._materialSwitches;
+        args->_details._trianglesRendered += details[b]._trianglesRendered;
+    }
+}
+
 void DrawLight::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inLights) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -20,6 +20,15 @@ void renderItems(const SceneContextPointer& sceneContext, const RenderContextPoi
 void renderShapes(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 void renderStateSortShapes(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 
+// Records the shapes into several batches on worker threads, each batch starting with the state recorded by setupBatch.
+// The batches are appended to the frame in the same order as the serial versions above would draw the items.
+// The render of the items MUST be safe to call concurrently; falls back to a single batch for small inputs.
+using BatchSetup = std::function<void(gpu::Batch& batch)>;
+// A batch is only worth recording apart for at least this many items
+const int MIN_ITEMS_PER_BATCH = 128;
+const int MAX_CONCURRENT_BATCHES = 16;
+void renderShapesConcurrently(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, const BatchSetup& setupBatch, bool stateSort, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
@@ -10,6 +10,7 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
 #include <numeric>
 #include <gpu/Batch.h>
 #include "Logging.h"
@@ -43,14 +44,42 @@ void PendingChanges::merge(const PendingChanges& changes) {
     _updateFunctors.insert(_updateFunctors.end(), changes._updateFunctors.begin(), changes._updateFunctors.end());
 }
 
+void ItemBoundCache::resize(size_t size) {
+    keys.resize(size);
+    cornerX.resize(size, AABox().getCorner().x);
+    cornerY.resize(size, AABox().getCorner().y);
+    cornerZ.resize(size, AABox().getCorner().z);
+    scaleX.resize(size, 0.0f);
+    scaleY.resize(size, 0.0f);
+    scaleZ.resize(size, 0.0f);
+}
+
+void ItemBoundCache::set(ItemID id, const ItemKey& key, const AABox& bound) {
+    keys[id] = key;
+    cornerX[id] = bound.getCorner().x;
+    cornerY[id] = bound.getCorner().y;
+    cornerZ[id] = bound.getCorner().z;
+    scaleX[id] = bound.getScale().x;
+    scaleY[id] = bound.getScale().y;
+    scaleZ[id] = bound.getScale().z;
+}
+
 Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
     _items.push_back(Item()); // add the itemID #0 to nothing
+    _itemBoundCache.resize(_items.size());
 }
 
 Scene::~Scene() {
     qCDebug(renderlogging) << "Scene::~Scene()";
+
+    auto node = _changeQueueHead.exchange(nullptr);
+    while (node) {
+        auto next = node->_next;
+        delete node;
+        node = next;
+    }
 }
 
 ItemID Scene::allocateID() {
@@ -64,28 +93,26 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueuePendingChanges(const PendingChanges& pendingChanges) {
-    _changeQueueMutex.lock();
-    _changeQueue.push(pendingChanges);
-    _changeQueueMutex.unlock();
+    enqueuePendingChanges(PendingChanges(pendingChanges));
 }
 
-void consolidateChangeQueue(PendingChangesQueue& queue, PendingChanges& singleBatch) {
-    while (!queue.empty()) {
-        const auto& pendingChanges = queue.front();
-        singleBatch.merge(pendingChanges);
-        queue.pop();
-    };
+void Scene::enqueuePendingChanges(PendingChanges&& pendingChanges) {
+    auto node = new PendingChangesNode(std::move(pendingChanges));
+    node->_next = _changeQueueHead.load(std::memory_order_relaxed);
+    while (!_changeQueueHead.compare_exchange_weak(node->_next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
 }
- 
+
 void Scene::processPendingChangesQueue() {
     PROFILE_RANGE(render, __FUNCTION__);
-    PendingChanges consolidatedPendingChanges;
 
-    {
-        std::unique_lock<std::mutex> lock(_changeQueueMutex);
-        consolidateChangeQueue(_changeQueue, consolidatedPendingChanges);
+    // Take all the enqueued changes at once, and put them back in the order they were enqueued
+    std::vector<PendingChangesNode*> pendingNodes;
+    for (auto node = _changeQueueHead.exchange(nullptr, std::memory_order_acquire); node; node = node->_next) {
+        pendingNodes.push_back(node);
     }
-    
+    std::reverse(pendingNodes.begin(), pendingNodes.end());
+
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
         // Here we should be able to check the value of last ItemID allocated 
@@ -93,25 +120,58 @@ void Scene::processPendingChangesQueue() {
         ItemID maxID = _IDAllocator.load();
         if (maxID > _items.size()) {
             _items.resize(maxID + 100); // allocate the maxId and more
+            _itemBoundCache.resize(_items.size());
         }
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the pendingChanges
 
+        _changedBounds.clear();
+        _changeStamp++;
+
         // resets and potential NEW items
-        resetItems(consolidatedPendingChanges._resetItems, consolidatedPendingChanges._resetPayloads);
+        for (auto node : pendingNodes) {
+            resetItems(node->_changes._resetItems, node->_changes._resetPayloads);
+        }
 
         // Update the numItemsAtomic counter AFTER the reset changes went through
         _numAllocatedItems.exchange(maxID);
 
         // updates
-        updateItems(consolidatedPendingChanges._updatedItems, consolidatedPendingChanges._updateFunctors);
+        for (auto node : pendingNodes) {
+            updateItems(node->_changes._updatedItems, node->_changes._updateFunctors);
+        }
 
         // removes
-        removeItems(consolidatedPendingChanges._removedItems);
+        for (auto node : pendingNodes) {
+            removeItems(node->_changes._removedItems);
+        }
+
+        // Clean the cells left empty by the moved and removed items once for the whole batch
+        _masterSpatialTree.compact();
 
         // Update the numItemsAtomic counter AFTER the pending changes went through
         _numAllocatedItems.exchange(maxID);
     }
+
+    for (auto node : pendingNodes) {
+        delete node;
+    }
+}
+
+void Scene::recordChange(ItemID id, const ItemKey& newKey, const AABox& newBound) {
+    // Only the shadow casters matter to the jobs caching their results, the other changes would only invalidate them
+    static const ItemFilter shadowCasterFilter = ItemFilter::Builder::shadowCasters();
+
+    // The bound cache still has the key and bound before the change, the bound is null for the items which weren't spatial
+    bool wasCaster = shadowCasterFilter.test(_itemBoundCache.getKey(id));
+    bool isCaster = shadowCasterFilter.test(newKey);
+    auto oldBound = _itemBoundCache.getBound(id);
+    if (wasCaster && !oldBound.isNull()) {
+        _changedBounds.push_back(oldBound);
+    }
+    if (isCaster && !newBound.isNull() && !(wasCaster && newBound == oldBound)) {
+        _changedBounds.push_back(newBound);
+    }
 }
 
 void Scene::resetItems(const ItemIDs& ids, Payloads& payloads) {
@@ -129,10 +189,15 @@ void Scene::resetItems(const ItemIDs& ids, Payloads& payloads) {
         // Update the item's container
         assert((oldKey.isSpatial() == newKey.isSpatial()) || oldKey._flags.none());
         if (newKey.isSpatial()) {
-            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), resetID, newKey);
+            auto newBound = item.getBound();
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, newBound, resetID, newKey);
             item.resetCell(newCell, newKey.isSmall());
+            recordChange(resetID, item.getKey(), newBound);
+            _itemBoundCache.set(resetID, item.getKey(), newBound);
         } else {
+            recordChange(resetID, item.getKey(), AABox());
             _masterNonspatialSet.insert(resetID);
+            _itemBoundCache.set(resetID, item.getKey(), AABox());
         }
 
         // next loop
@@ -156,6 +221,8 @@ void Scene::removeItems(const ItemIDs& ids) {
 
         // Kill it
         item.kill();
+        recordChange(removedID, ItemKey(), AABox());
+        _itemBoundCache.set(removedID, ItemKey(), AABox());
     }
 }
 
@@ -178,16 +245,17 @@ void Scene::updateItems(const ItemIDs& ids, UpdateFunctors& functors) {
         auto newKey = item.getKey();
 
         // Update the item's container
+        auto newBound = newKey.isSpatial() ? item.getBound() : AABox();
         if (oldKey.isSpatial() == newKey.isSpatial()) {
             if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, newBound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             }
         } else {
             if (newKey.isSpatial()) {
                 _masterNonspatialSet.erase(updateID);
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, newBound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             } else {
                 _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
@@ -196,6 +264,8 @@ void Scene::updateItems(const ItemIDs& ids, UpdateFunctors& functors) {
                 _masterNonspatialSet.insert(updateID);
             }
         }
+        recordChange(updateID, item.getKey(), newBound);
+        _itemBoundCache.set(updateID, item.getKey(), newBound);
 
 
         // next loop
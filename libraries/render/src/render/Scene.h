@@ -22,8 +22,13 @@ class Engine;
 class PendingChanges {
 public:
     PendingChanges() {}
+    PendingChanges(const PendingChanges& changes) = default;
+    PendingChanges(PendingChanges&& changes) = default;
     ~PendingChanges() {}
 
+    PendingChanges& operator=(const PendingChanges& changes) = default;
+    PendingChanges& operator=(PendingChanges&& changes) = default;
+
     void resetItem(ItemID id, const PayloadPointer& payload);
     void removeItem(ItemID id);
 
@@ -34,6 +39,14 @@ public:
     void updateItem(ItemID id, const UpdateFunctorPointer& functor);
     void updateItem(ItemID id) { updateItem(id, nullptr); }
 
+    // The same update for several items of one type, all sharing a single functor
+    template <class T, class IDs> void updateItems(const IDs& ids, std::function<void(T&)> func) {
+        UpdateFunctorPointer functor = std::make_shared<UpdateFunctor<T>>(func);
+        for (auto id : ids) {
+            updateItem(id, functor);
+        }
+    }
+
     void merge(const PendingChanges& changes);
 
     ItemIDs _resetItems; 
@@ -44,7 +57,35 @@ public:
 
 protected:
 };
-typedef std::queue<PendingChanges> PendingChangesQueue;
+
+// A PendingChanges waiting in the scene, the nodes are pushed by any thread without locking
+// and taken all at once by the render thread
+class PendingChangesNode {
+public:
+    PendingChangesNode(PendingChanges&& changes) : _changes(std::move(changes)) {}
+
+    PendingChanges _changes;
+    PendingChangesNode* _next { nullptr };
+};
+
+
+// A contiguous copy of the key and bound of every item, indexed by ItemID and refreshed as the pending changes
+// go through. The bounds are laid out one array per component, so that the culling can test several boxes
+// at once without calling into the payloads.
+class ItemBoundCache {
+public:
+    void resize(size_t size);
+    void set(ItemID id, const ItemKey& key, const AABox& bound);
+
+    const ItemKey& getKey(ItemID id) const { return keys[id]; }
+    AABox getBound(ItemID id) const {
+        return AABox(glm::vec3(cornerX[id], cornerY[id], cornerZ[id]), glm::vec3(scaleX[id], scaleY[id], scaleZ[id]));
+    }
+
+    std::vector<ItemKey> keys;
+    std::vector<float> cornerX, cornerY, cornerZ;
+    std::vector<float> scaleX, scaleY, scaleZ;
+};
 
 
 // Scene is a container for Items
@@ -66,8 +107,9 @@ public:
     // THis is the total number of allocated items, this a threadsafe call
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
-    // Enqueue change batch to the scene
+    // Enqueue change batch to the scene, this a threadsafe and lock free call
     void enqueuePendingChanges(const PendingChanges& pendingChanges);
+    void enqueuePendingChanges(PendingChanges&& pendingChanges);
 
     // Process the penging changes equeued
     void processPendingChangesQueue();
@@ -81,25 +123,38 @@ public:
     // Same as getItem, checking if the id is valid
     const Item getItemSafe(const ItemID& id) const { if (isAllocatedID(id)) { return _items[id]; } else { return Item(); } }
 
+    // Access the key and bound of the items, as of the last processed pending changes
+    const ItemBoundCache& getItemBoundCache() const { return _itemBoundCache; }
+
     // Access the spatialized items
     const ItemSpatialTree& getSpatialTree() const { return _masterSpatialTree; }
 
     // Access non-spatialized items (overlays, backgrounds)
     const ItemIDSet& getNonspatialSet() const { return _masterNonspatialSet; }
 
+    // The bounds of the shadow casters reset, updated or removed by the last processPendingChangesQueue,
+    // both before and after the change, so that the jobs caching their results can tell if they are still valid.
+    // The stamp counts the calls to processPendingChangesQueue, a job that missed one has to assume everything changed.
+    const std::vector<AABox>& getChangedBounds() const { return _changedBounds; }
+    uint32_t getChangeStamp() const { return _changeStamp; }
+
 protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _changeQueueMutex;
-    PendingChangesQueue _changeQueue;
+    std::atomic<PendingChangesNode*> _changeQueueHead { nullptr }; // the most recently enqueued first
 
     // The actual database
     // database of items is protected for editing by a mutex
     std::mutex _itemsMutex;
     Item::Vector _items;
+    ItemBoundCache _itemBoundCache;
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
+    std::vector<AABox> _changedBounds;
+    uint32_t _changeStamp { 0 };
+
+    void recordChange(ItemID id, const ItemKey& newKey, const AABox& newBound);
 
     void resetItems(const ItemIDs& ids, Payloads& payloads);
     void removeItems(const ItemIDs& ids);
@@ -94,12 +94,8 @@ void ShapePlumber::addPipeline(const Filter& filter, const gpu::ShaderPointer& p
     addPipelineHelper(filter, key, 0, shapePipeline);
 }
 
-const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Key& key) const {
+const ShapePipelinePointer ShapePlumber::findPipeline(const Key& key) const {
     assert(!_pipelineMap.empty());
-    assert(args);
-    assert(args->_batch);
-
-    PerformanceTimer perfTimer("ShapePlumber::pickPipeline");
 
     const auto& pipelineIterator = _pipelineMap.find(key);
     if (pipelineIterator == _pipelineMap.end()) {
@@ -110,17 +106,27 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
         }
         return PipelinePointer(nullptr);
     }
+    return pipelineIterator->second;
+}
+
+const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Key& key) const {
+    assert(args);
+    assert(args->_batch);
+
+    PerformanceTimer perfTimer("ShapePlumber::pickPipeline");
+
+    PipelinePointer shapePipeline = findPipeline(key);
+    if (!shapePipeline) {
+        return PipelinePointer(nullptr);
+    }
 
-    PipelinePointer shapePipeline(pipelineIterator->second);
     auto& batch = args->_batch;
 
     // Setup the one pipeline (to rule them all)
     batch->setPipeline(shapePipeline->pipeline);
 
     // Run the pipeline's BatchSetter on the passed in batch
-    if (shapePipeline->batchSetter) {
-        shapePipeline->batchSetter(*shapePipeline, *batch);
-    }
+    shapePipeline->prepare(*batch);
 
     return shapePipeline;
 }
@@ -277,6 +277,10 @@ public:
 
     const PipelinePointer pickPipeline(RenderArgs* args, const Key& key) const;
 
+    // The pipeline for the key, without setting it up in a batch
+    // MUST not be called concurrently, as missing keys are logged once
+    const PipelinePointer findPipeline(const Key& key) const;
+
 protected:
     void addPipelineHelper(const Filter& filter, Key key, int bit, const PipelinePointer& pipeline);
     PipelineMap _pipelineMap;
@@ -10,6 +10,8 @@
 //
 #include "SpatialTree.h"
 
+#include <algorithm>
+
 #include <ViewFrustum.h>
 
 
@@ -34,6 +36,8 @@ const float Octree::INV_DEPTH_DIM[] = {
     1.0f / 16384.0f,
     1.0f / 32768.0f };
 
+const float Octree::LOOSE_CELL_MARGIN = 0.25f;
+
 /*
 const float Octree::COORD_SUBCELL_WIDTH[] = { // 2 ^ MAX_DEPTH / 2 ^ (depth + 1)
     16384.0f,
@@ -182,6 +186,57 @@ void Octree::cleanCellBranch(Index index) {
     }
 }
 
+void Octree::compact() {
+    if (_emptiedCells.empty()) {
+        return;
+    }
+
+    for (auto index : _emptiedCells) {
+        // The cell may have been freed already while cleaning the branch of one of its children,
+        // or filled again since it was emptied
+        if (checkCellIndex(index) && !isCellFree(index)) {
+            cleanCellBranch(index);
+        }
+    }
+    _emptiedCells.clear();
+
+    // Reuse the lowest indices first so the used cells and bricks gather at the beginning of the pools,
+    // and drop the free ones at the end
+    struct Tool {
+        static void trimPool(Indices& freeIndices, size_t& poolSize) {
+            std::sort(freeIndices.begin(), freeIndices.end(), std::greater<Index>());
+            size_t numTrimmed = 0;
+            while ((numTrimmed < freeIndices.size()) && (freeIndices[numTrimmed] == (Index)(poolSize - 1))) {
+                numTrimmed++;
+                poolSize--;
+            }
+            freeIndices.erase(freeIndices.begin(), freeIndices.begin() + numTrimmed);
+        }
+    };
+
+    size_t numCells = _cells.size();
+    Tool::trimPool(_freeCells, numCells);
+    _cells.resize(numCells);
+
+    size_t numBricks = _bricks.size();
+    Tool::trimPool(_freeBricks, numBricks);
+    _bricks.resize(numBricks);
+}
+
+Octree::Index Octree::indexCell(const Location& loc) {
+    // Walk down from the root, allocating the missing cells on the way, without building the path
+    Index currentIndex = ROOT_CELL;
+    for (Depth depth = ROOT_DEPTH + 1; depth <= loc.depth; depth++) {
+        Location location(loc.pos >> Coord3(loc.depth - depth), depth);
+        currentIndex = allocateCell(currentIndex, location);
+        if (currentIndex == INVALID_CELL) {
+            // no more cellID available, stop allocating
+            break;
+        }
+    }
+    return currentIndex;
+}
+
 Octree::Indices Octree::indexCellPath(const Locations& path) {
     // First through the allocated cells
     Indices cellPath = indexConcreteCellPath(path);
@@ -354,9 +409,9 @@ bool ItemSpatialTree::removeItem(Index cellIdx, const ItemKey& key, const ItemID
         success = true;
     }, false); // do not create brick!
 
-    // Because we know the cell is now empty, lets try to clean the octree here
+    // Because we know the cell is now empty, clean the octree there on the next compact
     if (emptyCell) {
-        cleanCellBranch(cellIdx);
+        _emptiedCells.push_back(cellIdx);
     }
 
     return success;
@@ -368,6 +423,24 @@ ItemSpatialTree::Index ItemSpatialTree::resetItem(Index oldCell, const ItemKey&
         Coord3f minCoordf, maxCoordf;
         auto location = evalLocation(bound, minCoordf, maxCoordf);
 
+        // Stay in the current cell if the item still fits in its loose bound,
+        // unless the item now fits in a cell more than one level deeper
+        bool stayInCell = false;
+        if (oldCell != INVALID_CELL) {
+            auto oldLocation = getConcreteCell(oldCell).getlocation();
+            if (location == oldLocation) {
+                stayInCell = true;
+            } else if (location.depth <= oldLocation.depth + 1) {
+                float cellWidth = getDepthDimensionf(Depth(METRIC_COORD_DEPTH - oldLocation.depth));
+                Coord3f looseMin = Coord3f(oldLocation.pos) * cellWidth - Coord3f(LOOSE_CELL_MARGIN * cellWidth);
+                Coord3f looseMax = looseMin + Coord3f((1.0f + 2.0f * LOOSE_CELL_MARGIN) * cellWidth);
+                stayInCell = glm::all(glm::greaterThanEqual(minCoordf, looseMin)) && glm::all(glm::lessThanEqual(maxCoordf, looseMax));
+            }
+            if (stayInCell) {
+                location = oldLocation;
+            }
+        }
+
         // Compare range size vs cell location size and tag itemKey accordingly
         // If Item bound fits in sub cell then tag as small
         auto rangeSizef = maxCoordf - minCoordf;
@@ -379,7 +452,7 @@ ItemSpatialTree::Index ItemSpatialTree::resetItem(Index oldCell, const ItemKey&
             newKey.setSmaller(false);
         }
 
-        newCell = indexCell(location);
+        newCell = (stayInCell ? oldCell : indexCell(location));
     } else {
         // A very rare case, if we were adding items with boundary semantic expressed in view space
     }
@@ -465,8 +538,10 @@ Octree::Location::Intersection Octree::Location::intersectCell(const Location& c
         }
     };
 
-    Coord3f cellSize = Coord3f(Octree::getInvDepthDimension(cell.depth));
-    Coord3f cellPos = Coord3f(cell.pos) * cellSize;
+    // Test the loose bound of the cell
+    float cellWidth = Octree::getInvDepthDimension(cell.depth);
+    Coord3f cellPos = Coord3f(cell.pos) * cellWidth - Coord3f(LOOSE_CELL_MARGIN * cellWidth);
+    Coord3f cellSize = Coord3f((1.0f + 2.0f * LOOSE_CELL_MARGIN) * cellWidth);
 
     bool partialFlag = false;
     for (int p = 0; p < ViewFrustum::NUM_PLANES; p++) {
@@ -520,7 +595,7 @@ int Octree::selectTraverse(Index cellID, CellSelection& selection, const Frustum
 
             // Test for lod
             auto cellLocation = cell.getlocation();
-            float lod = selector.testSolidAngle(cellLocation.getCenter(), Octree::getCoordSubcellWidth(cellLocation.depth));
+            float lod = selector.testSolidAngle(cellLocation.getCenter(), Octree::getLooseCoordSubcellWidth(cellLocation.depth));
             if (lod < 0.0f) {
                 return 0;
                 break;
@@ -548,7 +623,7 @@ int  Octree::selectBranch(Index cellID, CellSelection& selection, const FrustumS
     auto cell = getConcreteCell(cellID);
 
     auto cellLocation = cell.getlocation();
-    float lod = selector.testSolidAngle(cellLocation.getCenter(), Octree::getCoordSubcellWidth(cellLocation.depth));
+    float lod = selector.testSolidAngle(cellLocation.getCenter(), Octree::getLooseCoordSubcellWidth(cellLocation.depth));
     if (lod < 0.0f) {
         return 0;
     }
@@ -108,6 +108,12 @@ namespace render {
 
         static Coord depthBitmask(Depth depth) { return Coord(1 << (MAX_DEPTH - depth)); }
 
+        // The cells are loose: the items stored in a cell may overflow its bound by this fraction of the cell width
+        // on every side, so that an item moving a little doesn't have to change cell.
+        // The frustum selection tests the loose bound of the cells.
+        static const float LOOSE_CELL_MARGIN;
+        static float getLooseCoordSubcellWidth(Depth depth) { return (1.0f + 2.0f * LOOSE_CELL_MARGIN) * getCoordSubcellWidth(depth); }
+
         static Depth coordToDepth(Coord length) {
             Depth depth = MAX_DEPTH;
             while (length) {
@@ -157,7 +163,7 @@ namespace render {
             static Location evalFromRange(const Coord3& minCoord, const Coord3& maxCoord, Depth rangeDepth = MAX_DEPTH);
 
 
-            // Eval the intersection test against a frustum
+            // Eval the intersection test of the loose bound of the cell against a frustum
             enum Intersection {
                 Outside = 0,
                 Intersect,
@@ -252,10 +258,15 @@ namespace render {
         // Apply the same logic to the parent cell
         void cleanCellBranch(Index index);
 
+        // Clean the branches of the cells emptied since the last call, then trim the free cells and bricks
+        // at the end of the pools. Emptied cells are kept until then, so that items moving from cell to cell
+        // during a frame reuse them instead of freeing and allocating them again.
+        void compact();
+
         // Indexing/Allocating the cells as the tree gets populated
         // Return the cell Index/Indices at the specified location/path, allocate all the cells on the path from the root if needed
         Indices indexCellPath(const Locations& path);
-        Index indexCell(const Location& loc) { return indexCellPath(Location::pathTo(loc)).back(); }
+        Index indexCell(const Location& loc);
 
         // Same as indexCellPath except that NO cells are allocated, only the COncrete cells previously allocated
         // the returned indices stops at the last existing cell on the requested path.
@@ -347,6 +358,8 @@ namespace render {
         Index allocateBrick();
         void freeBrick(Index index);
 
+        bool isCellFree(Index index) const { return (index != ROOT_CELL) && !getConcreteCell(index).hasParent(); }
+
         Cell& editCell(Index index) {
             assert(checkCellIndex(index));
             return _cells[index];
@@ -356,8 +369,9 @@ namespace render {
         // Octree members
         Cells _cells = Cells(1, Cell()); // start with only the Cell root
         Bricks _bricks;
-        Indices _freeCells; // stack of free cells to be reused for allocation
-        Indices _freeBricks; // stack of free bricks to be reused for allocation
+        Indices _freeCells; // stack of free cells to be reused for allocation, the lowest index on top after compact()
+        Indices _freeBricks; // stack of free bricks to be reused for allocation, the lowest index on top after compact()
+        Indices _emptiedCells; // cells whose brick was emptied since the last compact()
     };
 }
 
@@ -436,10 +450,13 @@ namespace render {
 
         // Managing itemsInserting items in cells
         // Cells need to have been allocated first calling indexCell
+        // The cells emptied by removeItem are only cleaned by the next compact()
         Index insertItem(Index cellIdx, const ItemKey& key, const ItemID& item);
         bool updateItem(Index cellIdx, const ItemKey& oldKey, const ItemKey& key, const ItemID& item);
         bool removeItem(Index cellIdx, const ItemKey& key, const ItemID& item);
 
+        // The item stays in its current cell as long as its bound fits in the loose bound of the cell
+        // and the item didn't shrink to fit a much deeper cell
         Index resetItem(Index oldCell, const ItemKey& oldKey, const AABox& bound, const ItemID& item, ItemKey& newKey);
 
         // Selection and traverse
@@ -11,6 +11,8 @@
 
 #include <QtCore/QThread>
 
+#include <tbb/parallel_for.h>
+
 #include "Task.h"
 
 using namespace render;
@@ -24,3 +26,26 @@ void TaskConfig::refresh() {
     _task->configure(*this);
 }
 
+void Task::runJobs(Jobs& jobs, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    size_t begin = 0;
+    while (begin < jobs.size()) {
+        size_t end = begin + 1;
+        int group = jobs[begin].getConcurrentGroup();
+        if (group >= 0) {
+            while (end < jobs.size() && jobs[end].getConcurrentGroup() == group) {
+                ++end;
+            }
+        }
+
+        if (end - begin == 1) {
+            jobs[begin].run(sceneContext, renderContext);
+        } else {
+            tbb::parallel_for(begin, end, [&](size_t i) {
+                // the job's config is handed through the render context, so each job gets its own
+                auto jobContext = std::make_shared<RenderContext>(*renderContext);
+                jobs[i].runConcurrently(sceneContext, jobContext);
+            });
+        }
+        begin = end;
+    }
+}
@@ -575,8 +575,24 @@ public:
         return concept->_data;
     }
 
+    // The jobs of a concurrent group only read their input and write their output (no gpu work, no edits
+    // of the RenderArgs), so that they can run on the worker threads, a job out of any group has a negative group
+    int getConcurrentGroup() const { return _concurrentGroup; }
+    void setConcurrentGroup(int group) { _concurrentGroup = group; }
+
     void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
         PerformanceTimer perfTimer(_name.c_str());
+        runTimed(sceneContext, renderContext);
+    }
+
+    // The PerformanceTimer records are not thread safe, a job run concurrently reports
+    // its run time through its config and the profiler only
+    void runConcurrently(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+        runTimed(sceneContext, renderContext);
+    }
+
+    protected:
+    void runTimed(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
         PROFILE_RANGE(render, _name.c_str());
         auto start = usecTimestampNow();
 
@@ -585,9 +601,9 @@ public:
         _concept->setCPURunTime((double)(usecTimestampNow() - start) / 1000.0);
     }
 
-    protected:
     ConceptPointer _concept;
     std::string _name = "";
+    int _concurrentGroup { -1 };
 };
 
 // A task is a specialized job to run a collection of other jobs
@@ -623,9 +639,7 @@ public:
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) override {
             auto config = std::static_pointer_cast<Config>(_config);
             if (config->alwaysEnabled || config->enabled) {
-                for (auto job : _data._jobs) {
-                    job.run(sceneContext, renderContext);
-                }
+                Task::runJobs(_data._jobs, sceneContext, renderContext);
             }
         }
     };
@@ -636,6 +650,7 @@ public:
     // Create a new job in the container's queue; returns the job's output
     template <class T, class... A> const Varying addJob(std::string name, const Varying& input, A&&... args) {
         _jobs.emplace_back(name, std::make_shared<typename T::JobModel>(input, std::forward<A>(args)...));
+        _jobs.back().setConcurrentGroup(_concurrentGroup);
         QConfigPointer config = _jobs.back().getConfiguration();
         config->setParent(getConfiguration().get());
         config->setObjectName(name.c_str());
@@ -655,6 +670,11 @@ public:
         return addJob<T>(name, input, std::forward<A>(args)...);
     }
 
+    // The jobs added between these calls form a concurrent group (see Job::getConcurrentGroup), they run in parallel
+    // so none of them may take the output of another as input
+    void beginConcurrentJobs() { _concurrentGroup = ++_numConcurrentGroups; }
+    void endConcurrentJobs() { _concurrentGroup = -1; }
+
     template <class O> void setOutput(O&& output) {
         _output = Varying(output);
     }
@@ -693,17 +713,21 @@ public:
     }
 
     void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
-        for (auto job : _jobs) {
-            job.run(sceneContext, renderContext);
-        }
+        runJobs(_jobs, sceneContext, renderContext);
     }
 
 protected:
+    // Runs the jobs in order, the jobs of a concurrent group are spread on the worker threads
+    // and done before the next job starts
+    static void runJobs(Jobs& jobs, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
+
     template <class T, class C> friend class Model;
 
     QConfigPointer _config;
     Jobs _jobs;
     Varying _output;
+    int _concurrentGroup { -1 };
+    int _numConcurrentGroups { 0 };
 };
 
 }
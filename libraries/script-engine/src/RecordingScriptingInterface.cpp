@@ -34,6 +34,8 @@ static const QString HFR_EXTENSION = "hfr";
 RecordingScriptingInterface::RecordingScriptingInterface() {
     _player = DependencyManager::get<Deck>();
     _recorder = DependencyManager::get<Recorder>();
+
+    connect(_recorder.data(), &Recorder::clipSaved, this, &RecordingScriptingInterface::recordingSaved);
 }
 
 bool RecordingScriptingInterface::isPlaying() const {
@@ -183,7 +185,7 @@ void RecordingScriptingInterface::saveRecording(const QString& filename) {
         return;
     }
 
-    recording::Clip::toFile(filename, _lastClip);
+    _recorder->saveClip(filename, _lastClip);
 }
 
 bool RecordingScriptingInterface::saveRecordingToAsset(QScriptValue getClipAtpUrl) {
@@ -61,10 +61,14 @@ public slots:
 
     float recorderElapsed() const;
 
+    // Writes in the background, recordingSaved reports the outcome
     void saveRecording(const QString& filename);
     bool saveRecordingToAsset(QScriptValue getClipAtpUrl);
     void loadLastRecording();
 
+signals:
+    void recordingSaved(const QString& filename, bool success);
+
 protected:
     using Mutex = std::recursive_mutex;
     using Locker = std::unique_lock<Mutex>;
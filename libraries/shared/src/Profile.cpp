@@ -11,6 +11,7 @@
 Q_LOGGING_CATEGORY(trace_app, "trace.app")
 Q_LOGGING_CATEGORY(trace_app_detail, "trace.app.detail")
 Q_LOGGING_CATEGORY(trace_metadata, "trace.metadata")
+Q_LOGGING_CATEGORY(trace_mixer, "trace.mixer")
 Q_LOGGING_CATEGORY(trace_network, "trace.network")
 Q_LOGGING_CATEGORY(trace_parse, "trace.parse")
 Q_LOGGING_CATEGORY(trace_render, "trace.render")
@@ -37,31 +38,73 @@ static bool tracingEnabled() {
     return DependencyManager::get<tracing::Tracer>()->isEnabled();
 }
 
-Duration::Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _name(name), _category(category) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+#if defined(NSIGHT_TRACING)
+static void pushNsightRange(const char* name, uint32_t argbColor, uint64_t payload) {
+    nvtxEventAttributes_t eventAttrib { 0 };
+    eventAttrib.version = NVTX_VERSION;
+    eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    eventAttrib.colorType = NVTX_COLOR_ARGB;
+    eventAttrib.color = argbColor;
+    eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
+    eventAttrib.message.ascii = name;
+    eventAttrib.payload.llValue = payload;
+    eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+
+    nvtxRangePushEx(&eventAttrib);
+}
+#endif
 
+Duration::Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _name(name), _category(category) {
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (tracer && tracer->isEnabled() && category.isDebugEnabled()) {
+        _compact = baseArgs.empty();
+        if (_compact) {
+            tracer->traceCompactEvent(_category, _name, tracing::DurationBegin, payload, true);
+        } else {
+            QVariantMap args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+            tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
+        _traced = true;
 #if defined(NSIGHT_TRACING)
-        nvtxEventAttributes_t eventAttrib { 0 };
-        eventAttrib.version = NVTX_VERSION;
-        eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
-        eventAttrib.colorType = NVTX_COLOR_ARGB;
-        eventAttrib.color = argbColor;
-        eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
-        eventAttrib.message.ascii = name.toUtf8().data();
-        eventAttrib.payload.llValue = payload;
-        eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+        pushNsightRange(name.toUtf8().constData(), argbColor, payload);
+#endif
+    }
+}
 
-        nvtxRangePushEx(&eventAttrib);
+Duration::Duration(const QLoggingCategory& category, const char* name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _charName(name), _category(category) {
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (tracer && tracer->isEnabled() && category.isDebugEnabled()) {
+        _compact = baseArgs.empty();
+        if (_compact) {
+            tracer->traceCompactEvent(_category, _charName, tracing::DurationBegin, payload, true);
+        } else {
+            _name = name;
+            QVariantMap args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+            tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
+        _traced = true;
+#if defined(NSIGHT_TRACING)
+        pushNsightRange(name, argbColor, payload);
 #endif
     }
 }
 
 Duration::~Duration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
-        tracing::traceEvent(_category, _name, tracing::DurationEnd);
+    if (_traced) {
+        // the end event only needs the name, the args went with the begin event, but it goes the same way as
+        // the begin event for the thread buffer to keep count of the ranges left open in it
+        auto tracer = DependencyManager::get<tracing::Tracer>();
+        if (tracer && !_compact) {
+            tracing::traceEvent(_category, _name, tracing::DurationEnd);
+        } else if (tracer) {
+            if (_charName && _name.isNull()) {
+                tracer->traceCompactEvent(_category, _charName, tracing::DurationEnd, 0, false);
+            } else {
+                tracer->traceCompactEvent(_category, _name, tracing::DurationEnd, 0, false);
+            }
+        }
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
 #endif
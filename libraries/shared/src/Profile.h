@@ -17,6 +17,7 @@
 Q_DECLARE_LOGGING_CATEGORY(trace_app)
 Q_DECLARE_LOGGING_CATEGORY(trace_app_detail)
 Q_DECLARE_LOGGING_CATEGORY(trace_metadata)
+Q_DECLARE_LOGGING_CATEGORY(trace_mixer)
 Q_DECLARE_LOGGING_CATEGORY(trace_network)
 Q_DECLARE_LOGGING_CATEGORY(trace_render)
 Q_DECLARE_LOGGING_CATEGORY(trace_render_detail)
@@ -36,6 +37,8 @@ Q_DECLARE_LOGGING_CATEGORY(trace_simulation_physics_detail)
 class Duration {
 public:
     Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
+    // Same as above without building a QString, for literal names
+    Duration(const QLoggingCategory& category, const char* name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
     ~Duration();
 
     static uint64_t beginRange(const QLoggingCategory& category, const char* name, uint32_t argbColor);
@@ -43,7 +46,11 @@ public:
 
 private:
     QString _name;
+    const char* _charName { nullptr };
     const QLoggingCategory& _category;
+    bool _traced { false };
+    // whether the range began as a compact event or, with args, as a full one
+    bool _compact { false };
 };
 
 inline void asyncBegin(const QLoggingCategory& category, const QString& name, const QString& id, const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap()) {
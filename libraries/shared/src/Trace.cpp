@@ -8,7 +8,9 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
+#include <unordered_map>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -35,10 +37,141 @@
 
 using namespace tracing;
 
+// 32 bytes a record, so 256KB for each thread that traces
+static const uint64_t THREAD_BUFFER_SIZE = 1 << 13;
+static const std::chrono::milliseconds DRAIN_INTERVAL { 50 };
+
+static std::atomic<uint64_t> nextTracerID { 1 };
+
+static TraceTimestamp now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+namespace tracing {
+
+// A ring of the compact events of one thread, written only by that thread and read only by the drain
+class ThreadTraceBuffer {
+public:
+    ThreadTraceBuffer(qint64 threadID) : threadID(threadID), _records(THREAD_BUFFER_SIZE) {}
+
+    // Events are dropped rather than waiting when the drain falls behind, a duration range at a time so that
+    // every begin that makes it in has its end: each recorded begin keeps a slot for its end, and once a begin
+    // is dropped everything up to its end is dropped with it.
+    void push(const TraceRecord& record, uint32_t sessionID) {
+        if (sessionID != _sessionID) {
+            // the ranges left open by the previous session were never closed in it
+            _sessionID = sessionID;
+            _numOpenRanges = 0;
+            _droppedRangeDepth = 0;
+        }
+
+        if (record.type == DurationBegin) {
+            if (_droppedRangeDepth == 0 && tryPush(record, 2)) {
+                ++_numOpenRanges;
+            } else {
+                ++_droppedRangeDepth;
+                _numDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else if (record.type == DurationEnd && _droppedRangeDepth > 0) {
+            --_droppedRangeDepth;
+            _numDropped.fetch_add(1, std::memory_order_relaxed);
+        } else if (record.type == DurationEnd && _numOpenRanges > 0) {
+            // the slot it takes was kept when its begin was recorded, so this can't fail
+            --_numOpenRanges;
+            tryPush(record, 1);
+        } else if (!tryPush(record, 1)) {
+            _numDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename F>
+    void drain(F f) {
+        uint64_t tail = _tail.load(std::memory_order_relaxed);
+        uint64_t head = _head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            f(_records[tail & (THREAD_BUFFER_SIZE - 1)]);
+        }
+        _tail.store(tail, std::memory_order_release);
+    }
+
+    uint32_t takeNumDropped() { return _numDropped.exchange(0); }
+
+    // Called by the thread writing the buffer when it stops, its last records go with it
+    void retire() { _retired.store(true, std::memory_order_release); }
+    bool isRetired() const { return _retired.load(std::memory_order_acquire); }
+
+    const qint64 threadID;
+
+    // Names already interned by this thread, only accessed by this thread
+    struct CachedName {
+        uint32_t id;
+        QByteArray name;
+    };
+    std::unordered_map<const char*, CachedName> charNameIDs;
+    QHash<QString, uint32_t> stringNameIDs;
+
+private:
+    // records only if, besides the slots kept for the ends of the open ranges, there are this many free slots
+    bool tryPush(const TraceRecord& record, uint64_t numSlots) {
+        uint64_t head = _head.load(std::memory_order_relaxed);
+        uint64_t used = head - _tail.load(std::memory_order_acquire);
+        if (used + _numOpenRanges + numSlots > THREAD_BUFFER_SIZE) {
+            return false;
+        }
+        _records[head & (THREAD_BUFFER_SIZE - 1)] = record;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::vector<TraceRecord> _records;
+    std::atomic<uint64_t> _head { 0 };
+    std::atomic<uint64_t> _tail { 0 };
+    std::atomic<uint32_t> _numDropped { 0 };
+    std::atomic<bool> _retired { false };
+
+    // only accessed by the thread writing the buffer
+    uint32_t _sessionID { 0 };
+    uint64_t _numOpenRanges { 0 };
+    uint64_t _droppedRangeDepth { 0 };
+};
+
+}
+
+// The buffer of the calling thread, for the tracer it was created by. The thread and the tracer share it,
+// so that it outlives either of them, and the buffer is retired when the thread exits or traces for another tracer.
+struct ThreadBufferCache {
+    ~ThreadBufferCache() {
+        if (buffer) {
+            buffer->retire();
+        }
+    }
+
+    uint64_t tracerID { 0 };
+    std::shared_ptr<ThreadTraceBuffer> buffer;
+};
+static thread_local ThreadBufferCache threadBufferCache;
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+Tracer::Tracer() :
+    _tracerID(nextTracerID++),
+    _processID(QCoreApplication::applicationPid())
+{
+}
+
+Tracer::~Tracer() {
+    if (_drainThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(_drainMutex);
+            _drainThreadStopping = true;
+        }
+        _drainCondition.notify_one();
+        _drainThread.join();
+    }
+}
+
 void Tracer::startTracing() {
     std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
@@ -47,6 +180,16 @@ void Tracer::startTracing() {
     }
 
     _events.clear();
+    drainThreadBuffers(true);
+    {
+        std::lock_guard<std::mutex> drainGuard(_drainMutex);
+        _drainedEvents.clear();
+        _drainThreadStopping = false;
+    }
+    if (!_drainThread.joinable()) {
+        _drainThread = std::thread(&Tracer::runDrainThread, this);
+    }
+    ++_sessionID;
     _enabled = true;
 }
 
@@ -57,6 +200,171 @@ void Tracer::stopTracing() {
         return;
     }
     _enabled = false;
+
+    if (_drainThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> drainGuard(_drainMutex);
+            _drainThreadStopping = true;
+        }
+        _drainCondition.notify_one();
+        _drainThread.join();
+    }
+    // the events recorded before tracing stopped are kept for serialize
+    drainThreadBuffers();
+}
+
+void Tracer::runDrainThread() {
+    std::unique_lock<std::mutex> lock(_drainMutex);
+    while (!_drainThreadStopping) {
+        _drainCondition.wait_for(lock, DRAIN_INTERVAL);
+        lock.unlock();
+        drainThreadBuffers();
+        lock.lock();
+    }
+}
+
+ThreadTraceBuffer* Tracer::getThreadBuffer() {
+    if (threadBufferCache.tracerID != _tracerID) {
+        if (threadBufferCache.buffer) {
+            threadBufferCache.buffer->retire();
+        }
+        auto buffer = std::make_shared<ThreadTraceBuffer>(int64_t(QThread::currentThreadId()));
+        {
+            std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+            _threadBuffers.push_back(buffer);
+        }
+        threadBufferCache.tracerID = _tracerID;
+        threadBufferCache.buffer = buffer;
+    }
+    return threadBufferCache.buffer.get();
+}
+
+static QByteArray escapeJson(const QString& string) {
+    QByteArray escaped;
+    for (auto c : string.toUtf8()) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    escaped += QString("\\u%1").arg((int)c, 4, 16, QChar('0')).toLatin1();
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+uint32_t Tracer::internName(const QString& name) {
+    std::lock_guard<std::mutex> guard(_namesMutex);
+    auto it = _nameIDs.find(name);
+    if (it != _nameIDs.end()) {
+        return it.value();
+    }
+    uint32_t id = (uint32_t)_names.size();
+    _names.push_back(escapeJson(name));
+    _nameIDs.insert(name, id);
+    return id;
+}
+
+void Tracer::traceCompactEvent(const QLoggingCategory& category, const char* name, EventType type, uint64_t payload, bool hasPayload) {
+    if (!_enabled) {
+        return;
+    }
+    auto buffer = getThreadBuffer();
+
+    // the pointer alone may be reused for another name, so the content is checked too
+    auto& cached = buffer->charNameIDs[name];
+    if (cached.name.isNull() || qstrcmp(cached.name.constData(), name) != 0) {
+        cached.name = QByteArray(name);
+        cached.id = internName(QString::fromUtf8(name));
+    }
+
+    buffer->push({ now(), payload, &category, cached.id, type, hasPayload }, _sessionID);
+}
+
+void Tracer::traceCompactEvent(const QLoggingCategory& category, const QString& name, EventType type, uint64_t payload, bool hasPayload) {
+    if (!_enabled) {
+        return;
+    }
+    auto buffer = getThreadBuffer();
+
+    auto it = buffer->stringNameIDs.find(name);
+    if (it == buffer->stringNameIDs.end()) {
+        it = buffer->stringNameIDs.insert(name, internName(name));
+    }
+
+    buffer->push({ now(), payload, &category, it.value(), type, hasPayload }, _sessionID);
+}
+
+void Tracer::drainThreadBuffers(bool discard) {
+    // a buffer retired before this drain holds all the records of its thread, it is dropped once they are drained
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> retiredBuffers;
+    {
+        std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+        for (auto& buffer : _threadBuffers) {
+            buffers.push_back(buffer);
+            if (buffer->isRetired()) {
+                retiredBuffers.push_back(buffer);
+            }
+        }
+    }
+
+    // only one thread drains at a time, the drained json is appended under the same lock
+    std::lock_guard<std::mutex> drainGuard(_drainMutex);
+    std::lock_guard<std::mutex> namesGuard(_namesMutex);
+    const QByteArray processID = QByteArray::number(_processID);
+    for (auto buffer : buffers) {
+        const QByteArray threadID = QByteArray::number(buffer->threadID);
+        buffer->drain([&](const TraceRecord& record) {
+            if (discard) {
+                return;
+            }
+            QByteArray& out = _drainedEvents;
+            if (!out.isEmpty()) {
+                out += ",\n";
+            }
+            out += "{\"name\":\"";
+            out += _names[record.nameID];
+            out += "\",\"cat\":\"";
+            out += record.category->categoryName();
+            out += "\",\"ph\":\"";
+            out += (char)record.type;
+            out += "\",\"ts\":";
+            out += QByteArray::number((qulonglong)record.timestamp);
+            out += ",\"pid\":";
+            out += processID;
+            out += ",\"tid\":";
+            out += threadID;
+            if (record.hasPayload) {
+                out += ",\"args\":{\"nv_payload\":";
+                out += QByteArray::number((qulonglong)record.payload);
+                out += "}";
+            }
+            out += "}";
+        });
+
+        auto numDropped = buffer->takeNumDropped();
+        if (numDropped > 0 && !discard) {
+            qWarning() << "Tracer dropped" << numDropped << "events of thread" << buffer->threadID;
+        }
+    }
+
+    if (!retiredBuffers.empty()) {
+        std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+        for (auto& buffer : retiredBuffers) {
+            // another drain may have dropped it already
+            auto it = std::find(_threadBuffers.begin(), _threadBuffers.end(), buffer);
+            if (it != _threadBuffers.end()) {
+                _threadBuffers.erase(it);
+            }
+        }
+    }
 }
 
 void TraceEvent::writeJson(QTextStream& out) const {
@@ -104,6 +412,47 @@ void TraceEvent::writeJson(QTextStream& out) const {
 #endif
 }
 
+QByteArray Tracer::serialize() {
+    std::list<TraceEvent> currentEvents;
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        currentEvents.swap(_events);
+        for (auto& event : _metadataEvents) {
+            currentEvents.push_back(event);
+        }
+    }
+
+    QByteArray compactEvents;
+    drainThreadBuffers();
+    {
+        std::lock_guard<std::mutex> guard(_drainMutex);
+        compactEvents.swap(_drainedEvents);
+    }
+
+    QByteArray data;
+    {
+        QTextStream out(&data);
+        out << "[\n";
+        bool first = true;
+        for (const auto& event : currentEvents) {
+            if (first) {
+                first = false;
+            } else {
+                out << ",\n";
+            }
+            event.writeJson(out);
+        }
+        if (!compactEvents.isEmpty()) {
+            if (!first) {
+                out << ",\n";
+            }
+            out << compactEvents;
+        }
+        out << "\n]";
+    }
+    return data;
+}
+
 void Tracer::serialize(const QString& originalPath) {
 
     QString path = originalPath;
@@ -128,36 +477,12 @@ void Tracer::serialize(const QString& originalPath) {
 
 
 
-    std::list<TraceEvent> currentEvents;
-    {
-        std::lock_guard<std::mutex> guard(_eventsMutex);
-        currentEvents.swap(_events);
-        for (auto& event : _metadataEvents) {
-            currentEvents.push_back(event);
-        }
-    }
-
     // If the file exists and we can't remove it, fail early
     if (QFileInfo(path).exists() && !QFile::remove(path)) {
         return;
     }
 
-    // If we can't open a temp file for writing, fail early
-    QByteArray data;
-    {
-        QTextStream out(&data);
-        out << "[\n";
-        bool first = true;
-        for (const auto& event : currentEvents) {
-            if (first) {
-                first = false;
-            } else {
-                out << ",\n";
-            }
-            event.writeJson(out);
-        }
-        out << "\n]";
-    }
+    QByteArray data = serialize();
 
     if (path.endsWith(".gz")) {
         QByteArray compressed;
@@ -247,6 +572,11 @@ void Tracer::traceEvent(const QLoggingCategory& category,
         return;
     }
 
+    if ((type == DurationBegin || type == DurationEnd) && id.isEmpty() && args.empty() && extra.empty()) {
+        traceCompactEvent(category, name, type, 0, false);
+        return;
+    }
+
     auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
     auto processID = QCoreApplication::applicationPid();
     auto threadID = int64_t(QThread::currentThreadId());
@@ -10,8 +10,14 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -76,16 +82,38 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+// An event without id nor args, the name is interned and only its index is kept
+struct TraceRecord {
+    TraceTimestamp timestamp;
+    uint64_t payload;
+    const QLoggingCategory* category;
+    uint32_t nameID;
+    EventType type;
+    bool hasPayload;
+};
+
+class ThreadTraceBuffer;
+
 class Tracer : public Dependency {
 public:
+    Tracer();
+    ~Tracer();
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         const QString& id = "", 
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
+    // Duration events and the like, recorded in a buffer of the calling thread without locking nor allocating,
+    // and turned into json by a background thread
+    void traceCompactEvent(const QLoggingCategory& category, const char* name, EventType type, uint64_t payload, bool hasPayload);
+    void traceCompactEvent(const QLoggingCategory& category, const QString& name, EventType type, uint64_t payload, bool hasPayload);
+
     void startTracing();
     void stopTracing();
     void serialize(const QString& file);
+    // the events recorded so far as a json trace, they are consumed
+    QByteArray serialize();
     bool isEnabled() const { return _enabled; }
 
 private:
@@ -95,10 +123,37 @@ private:
         const QString& id = "",
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
-    bool _enabled { false };
+    ThreadTraceBuffer* getThreadBuffer();
+    uint32_t internName(const QString& name);
+    void drainThreadBuffers(bool discard = false);
+    void runDrainThread();
+
+    std::atomic<bool> _enabled { false };
+    // bumped every time tracing starts, so that the thread buffers forget the ranges left open by the last time
+    std::atomic<uint32_t> _sessionID { 0 };
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+
+    const uint64_t _tracerID;
+    const qint64 _processID;
+
+    // the buffers of the threads tracing, shared with their thread until it exits and its last records are drained
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> _threadBuffers;
+    std::mutex _threadBuffersMutex;
+
+    // interned names, already escaped for json
+    std::vector<QByteArray> _names;
+    QHash<QString, uint32_t> _nameIDs;
+    std::mutex _namesMutex;
+
+    // the compact events drained so far, as json
+    QByteArray _drainedEvents;
+    std::mutex _drainMutex;
+
+    std::thread _drainThread;
+    std::condition_variable _drainCondition;
+    bool _drainThreadStopping { false };
 };
 
 inline void traceEvent(const QLoggingCategory& category, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
@@ -0,0 +1,103 @@
+"use strict";
+/*jslint vars: true, plusplus: true*/
+/*global Agent, Script, print*/
+//
+//  avatarLoadGenerator.js
+//  scripts/developer/tests/performance/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Run as an assignment-client agent script against a local domain to benchmark the avatar and audio mixers.
+//  One agent simulates numAvatars avatars, each with its own domain session, that walk in circles (or replay
+//  a local .hfr clip) and stream a tone. After a warm up it averages what the mixers send back and prints it.
+//
+//  Options go in the script URL query, e.g. avatarLoadGenerator.js?numAvatars=200&seconds=60&clip=/tmp/walk.hfr
+
+var WARM_UP_SECONDS = 10;
+var DEFAULT_SECONDS = 60;
+var STATS_INTERVAL_MS = 1000;
+
+function getQueryOptions() {
+    var options = {};
+    var url = Script.resolvePath("");
+    var queryStart = url.indexOf("?");
+    if (queryStart === -1) {
+        return options;
+    }
+    url.slice(queryStart + 1).split("&").forEach(function (pair) {
+        var parts = pair.split("=");
+        if (parts.length === 2) {
+            options[decodeURIComponent(parts[0])] = decodeURIComponent(parts[1]);
+        }
+    });
+    return options;
+}
+
+var query = getQueryOptions();
+var options = {
+    numAvatars: parseInt(query.numAvatars || "10", 10),
+    seed: parseInt(query.seed || "1", 10),
+    spread: parseFloat(query.spread || "20")
+};
+if (query.clip) {
+    options.clip = query.clip;
+}
+var measuredSeconds = parseInt(query.seconds || DEFAULT_SECONDS, 10);
+
+var STAT_NAMES = [
+    "avatar_data_packets_sent_per_second",
+    "audio_packets_sent_per_second",
+    "avatar_mixer_packets_received_per_second",
+    "avatar_mixer_bytes_received_per_second",
+    "audio_mixer_packets_received_per_second",
+    "audio_mixer_bytes_received_per_second"
+];
+var totals = {};
+STAT_NAMES.forEach(function (name) {
+    totals[name] = 0;
+});
+var samples = 0;
+var elapsedSeconds = 0;
+
+function printSummary() {
+    print("avatarLoadGenerator: " + options.numAvatars + " avatars, averaged over " + samples + " seconds");
+    STAT_NAMES.forEach(function (name) {
+        print("  " + name + ": " + (samples ? (totals[name] / samples).toFixed(1) : "n/a"));
+    });
+}
+
+var statsInterval = Script.setInterval(function () {
+    var stats = Agent.getLoadGeneratorStats();
+    elapsedSeconds++;
+
+    print("avatarLoadGenerator: " + elapsedSeconds + "s, " + stats.avatar_mixer_connections + "/" + stats.avatars +
+        " avatar mixer and " + stats.audio_mixer_connections + "/" + stats.avatars + " audio mixer connections");
+
+    // wait for every avatar to be in both mixers before measuring
+    if (elapsedSeconds <= WARM_UP_SECONDS ||
+            stats.avatar_mixer_connections !== stats.avatars || stats.audio_mixer_connections !== stats.avatars) {
+        return;
+    }
+
+    STAT_NAMES.forEach(function (name) {
+        totals[name] += stats[name];
+    });
+    samples++;
+
+    if (samples >= measuredSeconds) {
+        Script.clearInterval(statsInterval);
+        printSummary();
+        Agent.stopLoadGenerator();
+        Script.stop();
+    }
+}, STATS_INTERVAL_MS);
+
+Script.scriptEnding.connect(function () {
+    Agent.stopLoadGenerator();
+});
+
+print("avatarLoadGenerator: starting " + JSON.stringify(options));
+Agent.startLoadGenerator(options);
@@ -0,0 +1,26 @@
+//
+//  ReferenceFBXReader.h
+//  tests/fbx-reader-perf/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReferenceFBXReader_h
+#define hifi_ReferenceFBXReader_h
+
+#include <FBXReader.h>
+
+class QIODevice;
+
+namespace reference {
+
+// The QDataStream binary FBX parser that FBXReader used before parsing straight out of memory,
+// kept as the baseline the new parser is timed and checked against
+FBXNode parseBinaryFBX(QIODevice* device);
+
+}
+
+#endif // hifi_ReferenceFBXReader_h
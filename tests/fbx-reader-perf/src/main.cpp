@@ -0,0 +1,153 @@
+//
+//  main.cpp
+//  tests/fbx-reader-perf/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+// Times FBXReader::parseFBX against the QDataStream parser it replaced on every binary FBX file of a corpus,
+// and checks that both produce the same node tree.
+//
+//   fbx-reader-perf-test <corpus directory> [--runs N]
+//
+// Prints the average parse times of each file and of the whole corpus.
+
+#include <algorithm>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTextStream>
+#include <QtGui/QGuiApplication>
+
+#include <FBXReader.h>
+
+#include "ReferenceFBXReader.h"
+
+static const int DEFAULT_RUNS = 5;
+
+template<class T> static bool arraysEqual(const QVariant& a, const QVariant& b) {
+    return a.value<QVector<T>>() == b.value<QVector<T>>();
+}
+
+static bool propertiesEqual(const QVariant& a, const QVariant& b) {
+    if (a.userType() != b.userType()) {
+        return false;
+    }
+    if (a.userType() == qMetaTypeId<QVector<float>>()) {
+        return arraysEqual<float>(a, b);
+    } else if (a.userType() == qMetaTypeId<QVector<double>>()) {
+        return arraysEqual<double>(a, b);
+    } else if (a.userType() == qMetaTypeId<QVector<qint32>>()) {
+        return arraysEqual<qint32>(a, b);
+    } else if (a.userType() == qMetaTypeId<QVector<qint64>>()) {
+        return arraysEqual<qint64>(a, b);
+    } else if (a.userType() == qMetaTypeId<QVector<bool>>()) {
+        return arraysEqual<bool>(a, b);
+    }
+    return a == b;
+}
+
+static bool nodesEqual(const FBXNode& a, const FBXNode& b) {
+    if (a.name != b.name || a.properties.size() != b.properties.size() || a.children.size() != b.children.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.properties.size(); i++) {
+        if (!propertiesEqual(a.properties.at(i), b.properties.at(i))) {
+            return false;
+        }
+    }
+    for (int i = 0; i < a.children.size(); i++) {
+        if (!nodesEqual(a.children.at(i), b.children.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// both parsers read the file from memory, so that disk reads aren't part of the timing
+template<class Parse> static qint64 timeParse(const QByteArray& data, FBXNode& result, Parse parse) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QElapsedTimer timer;
+    timer.start();
+    result = parse(&buffer);
+    return timer.nsecsElapsed();
+}
+
+int main(int argc, char** argv) {
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addPositionalArgument("corpus", "Directory of the FBX files to parse");
+    QCommandLineOption runsOption("runs", "Number of times each file is parsed by each reader", "N", QString::number(DEFAULT_RUNS));
+    parser.addOption(runsOption);
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+    QDir corpus(parser.positionalArguments().first());
+    const int runs = std::max(1, parser.value(runsOption).toInt());
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    const QByteArray BINARY_PROLOG = "Kaydara FBX Binary  ";
+    qint64 totalBytes = 0;
+    qint64 totalNsecs = 0;
+    qint64 totalReferenceNsecs = 0;
+    int numFiles = 0;
+    foreach (const QString& fileName, corpus.entryList({ "*.fbx" }, QDir::Files, QDir::Name)) {
+        QFile file(corpus.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly)) {
+            err << "can't open " << fileName << endl;
+            return 1;
+        }
+        QByteArray data = file.readAll();
+        if (!data.startsWith(BINARY_PROLOG)) {
+            // the text parser didn't change, there is nothing to compare
+            continue;
+        }
+
+        qint64 nsecs = 0;
+        qint64 referenceNsecs = 0;
+        try {
+            for (int run = 0; run < runs; ++run) {
+                FBXNode parsed;
+                FBXNode expected;
+                nsecs += timeParse(data, parsed, FBXReader::parseFBX);
+                referenceNsecs += timeParse(data, expected, reference::parseBinaryFBX);
+                if (run == 0 && !nodesEqual(parsed, expected)) {
+                    err << fileName << ": the parsers disagree" << endl;
+                    return 1;
+                }
+            }
+        } catch (const QString& error) {
+            err << fileName << ": " << error << endl;
+            return 1;
+        }
+
+        out << fileName << ": " << data.size() << " bytes, parsed in " << nsecs / runs / 1.0e6 << " ms, reference "
+            << referenceNsecs / runs / 1.0e6 << " ms" << endl;
+        totalBytes += data.size();
+        totalNsecs += nsecs;
+        totalReferenceNsecs += referenceNsecs;
+        ++numFiles;
+    }
+
+    if (numFiles == 0) {
+        err << "no binary FBX files in " << corpus.path() << endl;
+        return 1;
+    }
+    out << "Parsed " << numFiles << " files, " << totalBytes << " bytes, in " << totalNsecs / runs / 1.0e6
+        << " ms on average, reference " << totalReferenceNsecs / runs / 1.0e6 << " ms, over " << runs << " runs" << endl;
+    return 0;
+}
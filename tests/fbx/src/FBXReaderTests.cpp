@@ -0,0 +1,264 @@
+//
+//  FBXReaderTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXReaderTests.h"
+
+#include <QtCore/QBuffer>
+
+#include <FBXReader.h>
+
+QTEST_MAIN(FBXReaderTests)
+
+const quint32 VERSION_FBX2015 = 7400;
+const quint32 VERSION_FBX2016 = 7500;
+
+// test files are only ever written and read on little endian hosts, so values are appended as they are in memory
+template<class T> static void appendValue(QByteArray& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<class T> static void appendArray(QByteArray& out, char type, const QVector<T>& values, bool compress) {
+    QByteArray data(reinterpret_cast<const char*>(values.constData()), values.size() * sizeof(T));
+    if (compress) {
+        // drop the length that qCompress puts in front of the zlib stream
+        data = qCompress(data).mid(sizeof(quint32));
+    }
+    out.append(type);
+    appendValue<quint32>(out, values.size());
+    appendValue<quint32>(out, compress ? 1 : 0);
+    appendValue<quint32>(out, data.size());
+    out.append(data);
+}
+
+static void appendProperty(QByteArray& out, const QVariant& property) {
+    int type = property.userType();
+    if (type == QMetaType::Int) {
+        out.append('I');
+        appendValue<qint32>(out, property.toInt());
+    } else if (type == QMetaType::LongLong) {
+        out.append('L');
+        appendValue<qint64>(out, property.toLongLong());
+    } else if (type == QMetaType::Double) {
+        out.append('D');
+        appendValue<double>(out, property.toDouble());
+    } else if (type == QMetaType::QByteArray) {
+        QByteArray string = property.toByteArray();
+        out.append('S');
+        appendValue<quint32>(out, string.size());
+        out.append(string);
+    } else if (type == qMetaTypeId<QVector<float>>()) {
+        appendArray(out, 'f', property.value<QVector<float>>(), true);
+    } else if (type == qMetaTypeId<QVector<double>>()) {
+        appendArray(out, 'd', property.value<QVector<double>>(), true);
+    } else if (type == qMetaTypeId<QVector<qint32>>()) {
+        appendArray(out, 'i', property.value<QVector<qint32>>(), false);
+    } else {
+        QFAIL("unsupported property type");
+    }
+}
+
+static void appendNodeHeader(QByteArray& out, qint64 endOffset, quint64 propertyCount, quint64 propertyListLength,
+                             bool has64BitPositions) {
+    if (has64BitPositions) {
+        appendValue<qint64>(out, endOffset);
+        appendValue<quint64>(out, propertyCount);
+        appendValue<quint64>(out, propertyListLength);
+    } else {
+        appendValue<qint32>(out, endOffset);
+        appendValue<quint32>(out, propertyCount);
+        appendValue<quint32>(out, propertyListLength);
+    }
+}
+
+static void appendNullNode(QByteArray& out, bool has64BitPositions) {
+    appendNodeHeader(out, 0, 0, 0, has64BitPositions);
+    out.append('\0');
+}
+
+static void appendNode(QByteArray& out, const FBXNode& node, bool has64BitPositions) {
+    // the header is patched once the end offset and the property list length are known
+    int headerStart = out.size();
+    appendNodeHeader(out, 0, 0, 0, has64BitPositions);
+    out.append((char)node.name.size());
+    out.append(node.name);
+
+    int propertiesStart = out.size();
+    foreach (const QVariant& property, node.properties) {
+        appendProperty(out, property);
+    }
+    int propertyListLength = out.size() - propertiesStart;
+
+    foreach (const FBXNode& child, node.children) {
+        appendNode(out, child, has64BitPositions);
+    }
+    if (!node.children.isEmpty()) {
+        appendNullNode(out, has64BitPositions);
+    }
+
+    QByteArray header;
+    appendNodeHeader(header, out.size(), node.properties.size(), propertyListLength, has64BitPositions);
+    out.replace(headerStart, header.size(), header);
+}
+
+static QByteArray writeBinaryFBX(const FBXNode& top, quint32 version) {
+    QByteArray out("Kaydara FBX Binary  ");
+    out.append('\0');
+    out.append('\x1A');
+    out.append('\0');
+    appendValue<quint32>(out, version);
+
+    bool has64BitPositions = (version >= VERSION_FBX2016);
+    foreach (const FBXNode& child, top.children) {
+        appendNode(out, child, has64BitPositions);
+    }
+    appendNullNode(out, has64BitPositions);
+    return out;
+}
+
+static FBXNode makeNode(const QByteArray& name, const QVariantList& properties, const FBXNodeList& children = FBXNodeList()) {
+    FBXNode node;
+    node.name = name;
+    node.properties = properties;
+    node.children = children;
+    return node;
+}
+
+static FBXNode makeTestTree() {
+    QVector<double> vertices;
+    QVector<qint32> indices;
+    QVector<float> weights;
+    for (int i = 0; i < 3000; i++) {
+        vertices.append(i * 0.5);
+        indices.append(i % 2 ? i : -i - 1);
+        weights.append(i / 3000.0f);
+    }
+
+    FBXNode mesh = makeNode("Geometry", { (qint64)12345, QByteArray("Mesh\0\1Geometry", 15), QByteArray("Mesh") }, {
+        makeNode("Vertices", { QVariant::fromValue(vertices) }),
+        makeNode("PolygonVertexIndex", { QVariant::fromValue(indices) }),
+        makeNode("Weights", { QVariant::fromValue(weights) }),
+        makeNode("Empty", { QVariant::fromValue(QVector<float>()) })
+    });
+
+    FBXNode top;
+    top.children = {
+        makeNode("FBXHeaderExtension", { 1003 }, { makeNode("FBXVersion", { 7400 }) }),
+        makeNode("Objects", {}, { mesh, makeNode("Model", { (qint64)54321, 2.5 }) })
+    };
+    return top;
+}
+
+static bool propertiesEqual(const QVariant& a, const QVariant& b) {
+    if (a.userType() != b.userType()) {
+        return false;
+    }
+    if (a.userType() == qMetaTypeId<QVector<float>>()) {
+        return a.value<QVector<float>>() == b.value<QVector<float>>();
+    } else if (a.userType() == qMetaTypeId<QVector<double>>()) {
+        return a.value<QVector<double>>() == b.value<QVector<double>>();
+    } else if (a.userType() == qMetaTypeId<QVector<qint32>>()) {
+        return a.value<QVector<qint32>>() == b.value<QVector<qint32>>();
+    } else if (a.userType() == qMetaTypeId<QVector<qint64>>()) {
+        return a.value<QVector<qint64>>() == b.value<QVector<qint64>>();
+    } else if (a.userType() == qMetaTypeId<QVector<bool>>()) {
+        return a.value<QVector<bool>>() == b.value<QVector<bool>>();
+    }
+    return a == b;
+}
+
+static bool nodesEqual(const FBXNode& a, const FBXNode& b) {
+    if (a.name != b.name || a.properties.size() != b.properties.size() || a.children.size() != b.children.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.properties.size(); i++) {
+        if (!propertiesEqual(a.properties.at(i), b.properties.at(i))) {
+            return false;
+        }
+    }
+    for (int i = 0; i < a.children.size(); i++) {
+        if (!nodesEqual(a.children.at(i), b.children.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static FBXNode parseBinaryFBX(const QByteArray& data) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return FBXReader::parseFBX(&buffer);
+}
+
+void FBXReaderTests::parseBinaryTest() {
+    FBXNode expected = makeTestTree();
+    FBXNode parsed = parseBinaryFBX(writeBinaryFBX(expected, VERSION_FBX2015));
+    QVERIFY(nodesEqual(parsed, expected));
+}
+
+void FBXReaderTests::parseBinary64Test() {
+    FBXNode expected = makeTestTree();
+    FBXNode parsed = parseBinaryFBX(writeBinaryFBX(expected, VERSION_FBX2016));
+    QVERIFY(nodesEqual(parsed, expected));
+}
+
+void FBXReaderTests::corruptBinaryTest() {
+    QByteArray data = writeBinaryFBX(makeTestTree(), VERSION_FBX2015);
+
+    QByteArray truncated = data.left(data.size() / 2);
+    QVERIFY_EXCEPTION_THROWN(parseBinaryFBX(truncated), QString);
+
+    // stomp on the middle of the first compressed array
+    QByteArray corrupt = data;
+    int arrayStart = corrupt.indexOf("Vertices") + (int)strlen("Vertices") + 1 + 3 * sizeof(quint32);
+    for (int i = 0; i < 16; i++) {
+        corrupt[arrayStart + 4 + i] = (char)0xFF;
+    }
+    QVERIFY_EXCEPTION_THROWN(parseBinaryFBX(corrupt), QString);
+}
+
+// A small FBX 7.4 file written by hand: an Objects node holding a Model node with an int, a string and an
+// uncompressed int array, and a Vertices node with a deflated float array.
+static const char FIXTURE_FBX[] =
+    "\x4b\x61\x79\x64\x61\x72\x61\x20\x46\x42\x58\x20\x42\x69\x6e\x61\x72\x79\x20\x20\x00\x1a\x00\xe8"
+    "\x1c\x00\x00\xa3\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x07\x4f\x62\x6a\x65\x63\x74\x73\x62"
+    "\x00\x00\x00\x03\x00\x00\x00\x21\x00\x00\x00\x05\x4d\x6f\x64\x65\x6c\x49\x07\x00\x00\x00\x53\x02"
+    "\x00\x00\x00\x61\x62\x69\x02\x00\x00\x00\x00\x00\x00\x00\x08\x00\x00\x00\x01\x00\x00\x00\xfe\xff"
+    "\xff\xff\x96\x00\x00\x00\x01\x00\x00\x00\x1f\x00\x00\x00\x08\x56\x65\x72\x74\x69\x63\x65\x73\x66"
+    "\x03\x00\x00\x00\x01\x00\x00\x00\x12\x00\x00\x00\x78\x9c\x63\x60\x60\xb0\x67\x60\x38\x00\xc4\x0a"
+    "\x0e\x00\x08\x7e\x01\x9f\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00";
+
+void FBXReaderTests::fixtureTest() {
+    FBXNode parsed = parseBinaryFBX(QByteArray(FIXTURE_FBX, sizeof(FIXTURE_FBX) - 1));
+
+    FBXNode expected;
+    expected.children = {
+        makeNode("Objects", {}, {
+            makeNode("Model", { 7, QByteArray("ab"), QVariant::fromValue(QVector<qint32> { 1, -2 }) }),
+            makeNode("Vertices", { QVariant::fromValue(QVector<float> { 0.5f, 1.5f, 2.5f }) })
+        })
+    };
+    QVERIFY(nodesEqual(parsed, expected));
+}
+
+void FBXReaderTests::detachedArraysTest() {
+    QByteArray data = writeBinaryFBX(makeTestTree(), VERSION_FBX2015);
+    FBXNode parsed = parseBinaryFBX(data);
+
+    // the tree is the only owner of each inflated array, so a copy of a property detaches on write
+    // and leaves the parsed tree alone
+    const FBXNode& vertices = parsed.children.at(1).children.at(0).children.at(0);
+    QVector<double> values = vertices.properties.at(0).value<QVector<double>>();
+    values[0] = -1.0;
+    QCOMPARE(vertices.properties.at(0).value<QVector<double>>().at(0), 0.0);
+
+    QVERIFY(nodesEqual(parsed, makeTestTree()));
+}
@@ -0,0 +1,35 @@
+//
+//  FBXReaderTests.h
+//  tests/fbx/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXReaderTests_h
+#define hifi_FBXReaderTests_h
+
+#include <QtTest/QtTest>
+
+class FBXReaderTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a binary file with 32 bit node headers parses into the expected tree
+    void parseBinaryTest();
+
+    // Test the same for the 64 bit node headers used from FBX 2016 on
+    void parseBinary64Test();
+
+    // Test that corrupt compressed arrays and truncated files are reported
+    void corruptBinaryTest();
+
+    // Test that a small hand written file parses into the expected tree
+    void fixtureTest();
+
+    // Test that the arrays in a parsed tree aren't shared with anything outside of it
+    void detachedArraysTest();
+};
+
+#endif // hifi_FBXReaderTests_h
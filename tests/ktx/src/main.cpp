@@ -80,6 +80,102 @@ QString getRootPath() {
 const QString TEST_IMAGE = getRootPath() + "/scripts/developer/tests/cube_texture.png";
 const QString TEST_IMAGE_KTX = getRootPath() + "/scripts/developer/tests/cube_texture.ktx";
 
+// Streaming relies on finding the mips of a file from its header alone
+void checkStreamedLayout(const ktx::KTXUniquePointer& ktxMemory) {
+    const auto& header = *ktxMemory->getHeader();
+    auto startMemory = ktxMemory->_storage->data();
+    Q_ASSERT(header.evalStorageSize() == ktxMemory->_storage->size());
+    Q_ASSERT(ktxMemory->_images.size() == header.getNumberOfLevels());
+    for (uint32_t level = 0; level < ktxMemory->_images.size(); ++level) {
+        const auto& image = ktxMemory->_images[level];
+        size_t offset = image._faceBytes[0] - startMemory;
+        Q_ASSERT(offset == header.evalMipByteOffset(level) + sizeof(uint32_t));
+        Q_ASSERT(*reinterpret_cast<const uint32_t*>(startMemory + offset - sizeof(uint32_t)) == header.evalImageSize(level));
+        Q_ASSERT(image._faceSize == header.evalFaceSize(level));
+        Q_ASSERT(image._imageSize == header.evalMipDataSize(level));
+    }
+
+    auto bareKtx = ktx::KTX::createBare(header, ktxMemory->_keyValues);
+    Q_ASSERT(bareKtx->_images.size() == ktxMemory->_images.size());
+    for (uint16_t level = 0; level < ktxMemory->_images.size(); ++level) {
+        const auto& image = ktxMemory->_images[level];
+        bool written = bareKtx->writeMipData(level, image._faceBytes[0], image._imageSize);
+        Q_ASSERT(written);
+        Q_UNUSED(written);
+    }
+    Q_ASSERT(bareKtx->_storage->size() == ktxMemory->_storage->size());
+    Q_ASSERT(0 == memcmp(bareKtx->_storage->data(), startMemory, ktxMemory->_storage->size()));
+}
+
+// Roughness, metallic and gloss maps are single channel, so the rows of their small mips are shorter than 4 bytes.
+// Mips assigned with tightly packed rows are written with their rows padded, like QImage mips already are.
+void checkGrayscaleLayout() {
+    const uint16_t SIZE = 6;
+    std::unique_ptr<gpu::Texture> texture(gpu::Texture::create2D(gpu::Element::COLOR_R_8, SIZE, SIZE));
+    texture->setStoredMipFormat(gpu::Element::COLOR_R_8);
+    std::vector<std::vector<uint8_t>> mips;
+    for (uint16_t level = 0; level < texture->evalNumMips(); ++level) {
+        std::vector<uint8_t> texels(texture->evalMipWidth(level) * texture->evalMipHeight(level));
+        for (size_t i = 0; i < texels.size(); ++i) {
+            texels[i] = (uint8_t)(level * 64 + i);
+        }
+        texture->assignStoredMip(level, texels.size(), texels.data());
+        mips.push_back(texels);
+    }
+
+    auto ktxMemory = gpu::Texture::serialize(*texture);
+    Q_ASSERT(ktxMemory);
+    checkStreamedLayout(ktxMemory);
+
+    const auto& header = *ktxMemory->getHeader();
+    for (uint16_t level = 0; level < mips.size(); ++level) {
+        const auto& image = ktxMemory->_images[level];
+        uint32_t width = header.evalPixelWidth(level);
+        Q_ASSERT(header.evalRowSize(level) % 4 == 0);
+        for (uint32_t row = 0; row < header.evalPixelHeight(level); ++row) {
+            Q_ASSERT(0 == memcmp(image._faceBytes[0] + row * header.evalRowSize(level), mips[level].data() + row * width, width));
+        }
+    }
+    // the 3x3 mip takes 3 rows of 4 bytes, not 9 bytes
+    Q_ASSERT(ktxMemory->_images[1]._imageSize == 12);
+}
+
+// Non-array cube maps store the image size of a single face
+void checkCubeLayout() {
+    const uint16_t SIZE = 4;
+    std::unique_ptr<gpu::Texture> texture(gpu::Texture::createCube(gpu::Element::COLOR_RGBA_32, SIZE));
+    texture->setStoredMipFormat(gpu::Element::COLOR_RGBA_32);
+    for (uint16_t level = 0; level < texture->evalNumMips(); ++level) {
+        uint16_t width = texture->evalMipWidth(level);
+        for (uint8_t face = 0; face < gpu::Texture::CUBE_FACE_COUNT; ++face) {
+            std::vector<uint8_t> texels(width * width * 4, (uint8_t)(level * 16 + face));
+            texture->assignStoredMipFace(level, face, texels.size(), texels.data());
+        }
+    }
+
+    auto ktxMemory = gpu::Texture::serialize(*texture);
+    Q_ASSERT(ktxMemory);
+    checkStreamedLayout(ktxMemory);
+
+    const auto& header = *ktxMemory->getHeader();
+    for (uint16_t level = 0; level < ktxMemory->_images.size(); ++level) {
+        const auto& image = ktxMemory->_images[level];
+        Q_ASSERT(image._numFaces == gpu::Texture::CUBE_FACE_COUNT);
+        Q_ASSERT(header.evalImageSize(level) == image._faceSize);
+        for (uint8_t face = 0; face < gpu::Texture::CUBE_FACE_COUNT; ++face) {
+            Q_ASSERT(image._faceBytes[face][0] == (uint8_t)(level * 16 + face));
+        }
+    }
+
+    // and read back the same
+    auto ktxCopy = ktx::KTX::create(std::make_shared<storage::MemoryStorage>(ktxMemory->_storage->size(), ktxMemory->_storage->data()));
+    Q_ASSERT(ktxCopy->_images.size() == ktxMemory->_images.size());
+    for (uint16_t level = 0; level < ktxCopy->_images.size(); ++level) {
+        Q_ASSERT(ktxCopy->_images[level]._faceSize == ktxMemory->_images[level]._faceSize);
+        Q_ASSERT(ktxCopy->_images[level]._faceBytes[5][0] == (uint8_t)(level * 16 + 5));
+    }
+}
+
 int main(int argc, char** argv) {
     QApplication app(argc, argv);
     QCoreApplication::setApplicationName("KTX");
@@ -142,6 +238,11 @@ int main(int argc, char** argv) {
             }
         }
     }
+
+    checkStreamedLayout(ktxMemory);
+    checkGrayscaleLayout();
+    checkCubeLayout();
+
     testTexture->setKtxBacking(ktxFile);
     return 0;
 }
@@ -0,0 +1,467 @@
+//
+//  BakedGeometryCacheTests.cpp
+//  tests/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakedGeometryCacheTests.h"
+
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
+
+#include <PathUtils.h>
+#include <model-networking/BakedGeometryCache.h>
+
+QTEST_MAIN(BakedGeometryCacheTests)
+
+static const std::string CACHE_DIRNAME = "baked_geometry_cache_tests";
+static const std::string CACHE_EXT = "bgc";
+
+// offsets into the file header: magic, version, structure length, data offset and data length
+static const int VERSION_OFFSET = 4;
+static const int STRUCTURE_LENGTH_OFFSET = 8;
+static const int DATA_LENGTH_OFFSET = 24;
+static const int HEADER_SIZE = 32;
+
+static FBXTexture makeTexture(const QString& name) {
+    FBXTexture texture;
+    texture.name = name;
+    texture.filename = name.toUtf8() + ".png";
+    texture.transform.setTranslation(glm::vec3(0.5f, 0.25f, 0.0f));
+    texture.transform.setScale(glm::vec3(2.0f, 2.0f, 1.0f));
+    texture.texcoordSet = 1;
+    texture.texcoordSetName = "uv1";
+    texture.isBumpmap = true;
+    return texture;
+}
+
+// a small, skinned, textured and animated quad, with every field set to something other than its default
+static FBXGeometry makeGeometry() {
+    FBXGeometry geometry;
+    geometry.originalURL = "file:///quad.fbx";
+    geometry.author = "author";
+    geometry.applicationName = "application";
+
+    FBXJoint joint;
+    joint.shapeInfo.points = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f) };
+    joint.freeLineage = { 0 };
+    joint.isFree = true;
+    joint.parentIndex = -1;
+    joint.distanceToParent = 0.5f;
+    joint.translation = glm::vec3(1.0f, 2.0f, 3.0f);
+    joint.preTransform = glm::mat4(2.0f);
+    joint.preRotation = glm::quat(0.0f, 1.0f, 0.0f, 0.0f);
+    joint.rotation = glm::quat(0.0f, 0.0f, 1.0f, 0.0f);
+    joint.postRotation = glm::quat(0.0f, 0.0f, 0.0f, 1.0f);
+    joint.postTransform = glm::mat4(3.0f);
+    joint.transform = glm::mat4(4.0f);
+    joint.rotationMin = glm::vec3(-1.0f);
+    joint.rotationMax = glm::vec3(1.0f);
+    joint.inverseDefaultRotation = glm::quat(0.5f, 0.5f, 0.5f, 0.5f);
+    joint.inverseBindRotation = glm::quat(-0.5f, 0.5f, 0.5f, 0.5f);
+    joint.bindTransform = glm::mat4(5.0f);
+    joint.name = "Hips";
+    joint.isSkeletonJoint = true;
+    joint.bindTransformFoundInCluster = true;
+    joint.hasGeometricOffset = true;
+    joint.geometricTranslation = glm::vec3(0.1f);
+    joint.geometricRotation = glm::quat(0.0f, 0.0f, 0.0f, -1.0f);
+    joint.geometricScaling = glm::vec3(0.2f);
+    geometry.joints.append(joint);
+    geometry.jointIndices.insert(joint.name, 1);
+    geometry.hasSkeletonJoints = true;
+
+    FBXMesh mesh;
+    FBXMeshPart part;
+    part.quadIndices = { 0, 1, 2, 3 };
+    part.quadTrianglesIndices = { 0, 1, 2, 0, 2, 3 };
+    part.materialID = "material";
+    mesh.parts.append(part);
+    mesh.vertices = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    mesh.normals = QVector<glm::vec3>(4, glm::vec3(0.0f, 0.0f, 1.0f));
+    mesh.tangents = QVector<glm::vec3>(4, glm::vec3(1.0f, 0.0f, 0.0f));
+    mesh.colors = QVector<glm::vec3>(4, glm::vec3(0.25f, 0.5f, 0.75f));
+    mesh.texCoords = { glm::vec2(0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f), glm::vec2(0.0f, 1.0f) };
+    mesh.texCoords1 = mesh.texCoords;
+    mesh.clusterIndices = QVector<glm::vec4>(4, glm::vec4(0.0f));
+    mesh.clusterWeights = QVector<glm::vec4>(4, glm::vec4(1.0f, 0.0f, 0.0f, 0.0f));
+    FBXCluster cluster;
+    cluster.jointIndex = 0;
+    cluster.inverseBindMatrix = glm::mat4(6.0f);
+    mesh.clusters.append(cluster);
+    mesh.meshExtents.minimum = glm::vec3(0.0f);
+    mesh.meshExtents.maximum = glm::vec3(1.0f, 1.0f, 0.0f);
+    mesh.modelTransform = glm::mat4(7.0f);
+    mesh.isEye = true;
+    FBXBlendshape blendshape;
+    blendshape.indices = { 2 };
+    blendshape.vertices = { glm::vec3(0.0f, 0.0f, 1.0f) };
+    blendshape.normals = { glm::vec3(0.0f, 1.0f, 0.0f) };
+    mesh.blendshapes.append(blendshape);
+    mesh.meshIndex = 3;
+    geometry.meshes.append(mesh);
+
+    FBXMaterial material(glm::vec3(0.8f), glm::vec3(0.1f), glm::vec3(0.2f), 12.0f, 0.9f);
+    material.diffuseFactor = 0.5f;
+    material.specularFactor = 0.25f;
+    material.emissiveFactor = 0.125f;
+    material.metallic = 0.3f;
+    material.roughness = 0.4f;
+    material.emissiveIntensity = 2.0f;
+    material.ambientFactor = 0.75f;
+    material.materialID = "material";
+    material.name = "Material";
+    material.shadingModel = "phong";
+    material._material = std::make_shared<model::Material>();
+    material._material->setEmissive(material.emissiveColor, false);
+    material._material->setAlbedo(material.diffuseColor, false);
+    material._material->setFresnel(material.specularColor, false);
+    material._material->setRoughness(material.roughness);
+    material._material->setMetallic(material.metallic);
+    material._material->setScattering(0.6f);
+    material._material->setOpacity(material.opacity);
+    material._material->setUnlit(true);
+    material.normalTexture = makeTexture("normal");
+    material.albedoTexture = makeTexture("albedo");
+    material.lightmapTexture = makeTexture("lightmap");
+    material.lightmapParams = glm::vec2(0.5f, 2.0f);
+    material.isPBSMaterial = true;
+    material.useNormalMap = true;
+    material.useAlbedoMap = true;
+    geometry.materials.insert(material.materialID, material);
+
+    geometry.offset = glm::mat4(8.0f);
+    geometry.leftEyeJointIndex = 1;
+    geometry.rightEyeJointIndex = 2;
+    geometry.neckJointIndex = 3;
+    geometry.rootJointIndex = 0;
+    geometry.leanJointIndex = 4;
+    geometry.headJointIndex = 5;
+    geometry.leftHandJointIndex = 6;
+    geometry.rightHandJointIndex = 7;
+    geometry.leftToeJointIndex = 8;
+    geometry.rightToeJointIndex = 9;
+    geometry.leftEyeSize = 0.01f;
+    geometry.rightEyeSize = 0.02f;
+    geometry.humanIKJointIndices = { 0, -1, 0 };
+    geometry.palmDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+    geometry.neckPivot = glm::vec3(0.0f, 1.5f, 0.0f);
+    geometry.bindExtents.minimum = glm::vec3(-1.0f);
+    geometry.bindExtents.maximum = glm::vec3(1.0f);
+    geometry.meshExtents = mesh.meshExtents;
+
+    FBXAnimationFrame frame;
+    frame.rotations = { glm::quat(0.0f, 1.0f, 0.0f, 0.0f) };
+    frame.translations = { glm::vec3(0.0f, 0.1f, 0.0f) };
+    geometry.animationFrames = { frame, frame };
+
+    geometry.meshIndicesToModelNames.insert(0, "Quad");
+    geometry.blendshapeChannelNames = { "Smile" };
+    return geometry;
+}
+
+static void compareTextures(const FBXTexture& actual, const FBXTexture& expected) {
+    QCOMPARE(actual.name, expected.name);
+    QCOMPARE(actual.filename, expected.filename);
+    QCOMPARE(actual.content, expected.content);
+    QCOMPARE(actual.transform.isIdentity(), expected.transform.isIdentity());
+    QCOMPARE(actual.transform.getTranslation(), expected.transform.getTranslation());
+    QCOMPARE(actual.transform.getRotation(), expected.transform.getRotation());
+    QCOMPARE(actual.transform.getScale(), expected.transform.getScale());
+    QCOMPARE(actual.maxNumPixels, expected.maxNumPixels);
+    QCOMPARE(actual.texcoordSet, expected.texcoordSet);
+    QCOMPARE(actual.texcoordSetName, expected.texcoordSetName);
+    QCOMPARE(actual.isBumpmap, expected.isBumpmap);
+}
+
+static void compareJoints(const FBXJoint& actual, const FBXJoint& expected) {
+    QCOMPARE(actual.shapeInfo.points, expected.shapeInfo.points);
+    QCOMPARE(actual.freeLineage, expected.freeLineage);
+    QCOMPARE(actual.isFree, expected.isFree);
+    QCOMPARE(actual.parentIndex, expected.parentIndex);
+    QCOMPARE(actual.distanceToParent, expected.distanceToParent);
+    QCOMPARE(actual.translation, expected.translation);
+    QCOMPARE(actual.preTransform, expected.preTransform);
+    QCOMPARE(actual.preRotation, expected.preRotation);
+    QCOMPARE(actual.rotation, expected.rotation);
+    QCOMPARE(actual.postRotation, expected.postRotation);
+    QCOMPARE(actual.postTransform, expected.postTransform);
+    QCOMPARE(actual.transform, expected.transform);
+    QCOMPARE(actual.rotationMin, expected.rotationMin);
+    QCOMPARE(actual.rotationMax, expected.rotationMax);
+    QCOMPARE(actual.inverseDefaultRotation, expected.inverseDefaultRotation);
+    QCOMPARE(actual.inverseBindRotation, expected.inverseBindRotation);
+    QCOMPARE(actual.bindTransform, expected.bindTransform);
+    QCOMPARE(actual.name, expected.name);
+    QCOMPARE(actual.isSkeletonJoint, expected.isSkeletonJoint);
+    QCOMPARE(actual.bindTransformFoundInCluster, expected.bindTransformFoundInCluster);
+    QCOMPARE(actual.hasGeometricOffset, expected.hasGeometricOffset);
+    QCOMPARE(actual.geometricTranslation, expected.geometricTranslation);
+    QCOMPARE(actual.geometricRotation, expected.geometricRotation);
+    QCOMPARE(actual.geometricScaling, expected.geometricScaling);
+}
+
+static void compareMeshes(const FBXMesh& actual, const FBXMesh& expected) {
+    QCOMPARE(actual.parts.size(), expected.parts.size());
+    for (int i = 0; i < expected.parts.size(); ++i) {
+        QCOMPARE(actual.parts[i].quadIndices, expected.parts[i].quadIndices);
+        QCOMPARE(actual.parts[i].quadTrianglesIndices, expected.parts[i].quadTrianglesIndices);
+        QCOMPARE(actual.parts[i].triangleIndices, expected.parts[i].triangleIndices);
+        QCOMPARE(actual.parts[i].materialID, expected.parts[i].materialID);
+    }
+    QCOMPARE(actual.vertices, expected.vertices);
+    QCOMPARE(actual.normals, expected.normals);
+    QCOMPARE(actual.tangents, expected.tangents);
+    QCOMPARE(actual.colors, expected.colors);
+    QCOMPARE(actual.texCoords, expected.texCoords);
+    QCOMPARE(actual.texCoords1, expected.texCoords1);
+    QCOMPARE(actual.clusterIndices, expected.clusterIndices);
+    QCOMPARE(actual.clusterWeights, expected.clusterWeights);
+    QCOMPARE(actual.clusters.size(), expected.clusters.size());
+    for (int i = 0; i < expected.clusters.size(); ++i) {
+        QCOMPARE(actual.clusters[i].jointIndex, expected.clusters[i].jointIndex);
+        QCOMPARE(actual.clusters[i].inverseBindMatrix, expected.clusters[i].inverseBindMatrix);
+    }
+    QCOMPARE(actual.meshExtents.minimum, expected.meshExtents.minimum);
+    QCOMPARE(actual.meshExtents.maximum, expected.meshExtents.maximum);
+    QCOMPARE(actual.modelTransform, expected.modelTransform);
+    QCOMPARE(actual.isEye, expected.isEye);
+    QCOMPARE(actual.blendshapes.size(), expected.blendshapes.size());
+    for (int i = 0; i < expected.blendshapes.size(); ++i) {
+        QCOMPARE(actual.blendshapes[i].indices, expected.blendshapes[i].indices);
+        QCOMPARE(actual.blendshapes[i].vertices, expected.blendshapes[i].vertices);
+        QCOMPARE(actual.blendshapes[i].normals, expected.blendshapes[i].normals);
+    }
+    QCOMPARE(actual.meshIndex, expected.meshIndex);
+}
+
+static void compareMaterials(const FBXMaterial& actual, const FBXMaterial& expected) {
+    QCOMPARE(actual.diffuseColor, expected.diffuseColor);
+    QCOMPARE(actual.diffuseFactor, expected.diffuseFactor);
+    QCOMPARE(actual.specularColor, expected.specularColor);
+    QCOMPARE(actual.specularFactor, expected.specularFactor);
+    QCOMPARE(actual.emissiveColor, expected.emissiveColor);
+    QCOMPARE(actual.emissiveFactor, expected.emissiveFactor);
+    QCOMPARE(actual.shininess, expected.shininess);
+    QCOMPARE(actual.opacity, expected.opacity);
+    QCOMPARE(actual.metallic, expected.metallic);
+    QCOMPARE(actual.roughness, expected.roughness);
+    QCOMPARE(actual.emissiveIntensity, expected.emissiveIntensity);
+    QCOMPARE(actual.ambientFactor, expected.ambientFactor);
+    QCOMPARE(actual.materialID, expected.materialID);
+    QCOMPARE(actual.name, expected.name);
+    QCOMPARE(actual.shadingModel, expected.shadingModel);
+
+    QCOMPARE((bool)actual._material, (bool)expected._material);
+    if (expected._material) {
+        QCOMPARE(actual._material->getEmissive(false), expected._material->getEmissive(false));
+        QCOMPARE(actual._material->getAlbedo(false), expected._material->getAlbedo(false));
+        QCOMPARE(actual._material->getFresnel(false), expected._material->getFresnel(false));
+        QCOMPARE(actual._material->getRoughness(), expected._material->getRoughness());
+        QCOMPARE(actual._material->getMetallic(), expected._material->getMetallic());
+        QCOMPARE(actual._material->getScattering(), expected._material->getScattering());
+        QCOMPARE(actual._material->getOpacity(), expected._material->getOpacity());
+        QCOMPARE(actual._material->isUnlit(), expected._material->isUnlit());
+        // the key drives the render pipeline, it has to come out the same as the one the readers built
+        QCOMPARE(actual._material->getKey()._flags, expected._material->getKey()._flags);
+    }
+
+    compareTextures(actual.normalTexture, expected.normalTexture);
+    compareTextures(actual.albedoTexture, expected.albedoTexture);
+    compareTextures(actual.opacityTexture, expected.opacityTexture);
+    compareTextures(actual.glossTexture, expected.glossTexture);
+    compareTextures(actual.roughnessTexture, expected.roughnessTexture);
+    compareTextures(actual.specularTexture, expected.specularTexture);
+    compareTextures(actual.metallicTexture, expected.metallicTexture);
+    compareTextures(actual.emissiveTexture, expected.emissiveTexture);
+    compareTextures(actual.occlusionTexture, expected.occlusionTexture);
+    compareTextures(actual.scatteringTexture, expected.scatteringTexture);
+    compareTextures(actual.lightmapTexture, expected.lightmapTexture);
+    QCOMPARE(actual.lightmapParams, expected.lightmapParams);
+
+    QCOMPARE(actual.isPBSMaterial, expected.isPBSMaterial);
+    QCOMPARE(actual.useNormalMap, expected.useNormalMap);
+    QCOMPARE(actual.useAlbedoMap, expected.useAlbedoMap);
+    QCOMPARE(actual.useOpacityMap, expected.useOpacityMap);
+    QCOMPARE(actual.useRoughnessMap, expected.useRoughnessMap);
+    QCOMPARE(actual.useSpecularMap, expected.useSpecularMap);
+    QCOMPARE(actual.useMetallicMap, expected.useMetallicMap);
+    QCOMPARE(actual.useEmissiveMap, expected.useEmissiveMap);
+    QCOMPARE(actual.useOcclusionMap, expected.useOcclusionMap);
+}
+
+// the geometry is written behind our back, wait for it to land in the cache
+static BakedGeometryFilePointer bake(BakedGeometryCache& cache, const FBXGeometry& geometry, const QUrl& url) {
+    auto key = BakedGeometryCache::getKey(url.toEncoded(), QVariantHash(), url);
+    cache.writeGeometry(key, geometry);
+    cache.waitForPendingWrites();
+    return cache.getFile(key);
+}
+
+static QByteArray readFile(const BakedGeometryFilePointer& file) {
+    QFile in(file->getFilepath().c_str());
+    in.open(QIODevice::ReadOnly);
+    return in.readAll();
+}
+
+static void overwriteFile(const BakedGeometryFilePointer& file, const QByteArray& contents) {
+    QFile out(file->getFilepath().c_str());
+    out.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    out.write(contents);
+}
+
+template <typename T> static void setValue(QByteArray& bytes, int offset, T value) {
+    memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+void BakedGeometryCacheTests::initTestCase() {
+    // keep the cache out of the real application data
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(PathUtils::getAppLocalDataFilePath(CACHE_DIRNAME.c_str())).removeRecursively();
+}
+
+void BakedGeometryCacheTests::cleanupTestCase() {
+    QDir(PathUtils::getAppLocalDataFilePath(CACHE_DIRNAME.c_str())).removeRecursively();
+}
+
+void BakedGeometryCacheTests::roundTripTest() {
+    BakedGeometryCache cache(CACHE_DIRNAME, CACHE_EXT);
+    const QUrl url("file:///roundTrip.fbx");
+    const FBXGeometry expected = makeGeometry();
+
+    auto file = bake(cache, expected, url);
+    QVERIFY(file != nullptr);
+    auto actual = file->getGeometry(url.toString());
+    QVERIFY(actual != nullptr);
+
+    QCOMPARE(actual->originalURL, expected.originalURL);
+    QCOMPARE(actual->author, expected.author);
+    QCOMPARE(actual->applicationName, expected.applicationName);
+
+    QCOMPARE(actual->joints.size(), expected.joints.size());
+    for (int i = 0; i < expected.joints.size(); ++i) {
+        compareJoints(actual->joints[i], expected.joints[i]);
+    }
+    QCOMPARE(actual->jointIndices, expected.jointIndices);
+    QCOMPARE(actual->hasSkeletonJoints, expected.hasSkeletonJoints);
+
+    QCOMPARE(actual->meshes.size(), expected.meshes.size());
+    for (int i = 0; i < expected.meshes.size(); ++i) {
+        const FBXMesh& mesh = actual->meshes[i];
+        compareMeshes(mesh, expected.meshes[i]);
+
+        // the model::Mesh is rebuilt from the arrays, the quad is drawn as two triangles
+        QVERIFY(mesh._mesh != nullptr);
+        QCOMPARE(mesh._mesh->getNumVertices(), (size_t)mesh.vertices.size());
+        QCOMPARE(mesh._mesh->getNumIndices(), (size_t)mesh.parts[0].quadTrianglesIndices.size());
+        QCOMPARE(mesh._mesh->getNumParts(), (size_t)mesh.parts.size());
+    }
+
+    QCOMPARE(actual->materials.keys(), expected.materials.keys());
+    for (auto it = expected.materials.constBegin(); it != expected.materials.constEnd(); ++it) {
+        compareMaterials(actual->materials[it.key()], it.value());
+    }
+
+    QCOMPARE(actual->offset, expected.offset);
+    QCOMPARE(actual->leftEyeJointIndex, expected.leftEyeJointIndex);
+    QCOMPARE(actual->rightEyeJointIndex, expected.rightEyeJointIndex);
+    QCOMPARE(actual->neckJointIndex, expected.neckJointIndex);
+    QCOMPARE(actual->rootJointIndex, expected.rootJointIndex);
+    QCOMPARE(actual->leanJointIndex, expected.leanJointIndex);
+    QCOMPARE(actual->headJointIndex, expected.headJointIndex);
+    QCOMPARE(actual->leftHandJointIndex, expected.leftHandJointIndex);
+    QCOMPARE(actual->rightHandJointIndex, expected.rightHandJointIndex);
+    QCOMPARE(actual->leftToeJointIndex, expected.leftToeJointIndex);
+    QCOMPARE(actual->rightToeJointIndex, expected.rightToeJointIndex);
+    QCOMPARE(actual->leftEyeSize, expected.leftEyeSize);
+    QCOMPARE(actual->rightEyeSize, expected.rightEyeSize);
+    QCOMPARE(actual->humanIKJointIndices, expected.humanIKJointIndices);
+    QCOMPARE(actual->palmDirection, expected.palmDirection);
+    QCOMPARE(actual->neckPivot, expected.neckPivot);
+    QCOMPARE(actual->bindExtents.minimum, expected.bindExtents.minimum);
+    QCOMPARE(actual->bindExtents.maximum, expected.bindExtents.maximum);
+    QCOMPARE(actual->meshExtents.minimum, expected.meshExtents.minimum);
+    QCOMPARE(actual->meshExtents.maximum, expected.meshExtents.maximum);
+
+    QCOMPARE(actual->animationFrames.size(), expected.animationFrames.size());
+    for (int i = 0; i < expected.animationFrames.size(); ++i) {
+        QCOMPARE(actual->animationFrames[i].rotations, expected.animationFrames[i].rotations);
+        QCOMPARE(actual->animationFrames[i].translations, expected.animationFrames[i].translations);
+    }
+
+    QCOMPARE(actual->meshIndicesToModelNames, expected.meshIndicesToModelNames);
+    QCOMPARE(actual->blendshapeChannelNames, expected.blendshapeChannelNames);
+}
+
+void BakedGeometryCacheTests::truncatedFileTest() {
+    BakedGeometryCache cache(CACHE_DIRNAME, CACHE_EXT);
+    const QUrl url("file:///truncated.fbx");
+
+    auto file = bake(cache, makeGeometry(), url);
+    QVERIFY(file != nullptr);
+    const QByteArray baked = readFile(file);
+    QVERIFY(baked.size() > HEADER_SIZE);
+
+    // empty, inside the header, inside the structure, and one byte short of the end of the data
+    for (int length : { 0, HEADER_SIZE - 1, HEADER_SIZE, HEADER_SIZE + 1, baked.size() / 2, baked.size() - 1 }) {
+        overwriteFile(file, baked.left(length));
+        QVERIFY2(!file->getGeometry(url.toString()), qPrintable(QString("truncated to %1 bytes").arg(length)));
+    }
+
+    overwriteFile(file, baked);
+    QVERIFY(file->getGeometry(url.toString()) != nullptr);
+}
+
+void BakedGeometryCacheTests::corruptFileTest() {
+    BakedGeometryCache cache(CACHE_DIRNAME, CACHE_EXT);
+    const QUrl url("file:///corrupt.fbx");
+
+    auto file = bake(cache, makeGeometry(), url);
+    QVERIFY(file != nullptr);
+    const QByteArray baked = readFile(file);
+
+    QByteArray badMagic = baked;
+    badMagic[0] = 'X';
+    overwriteFile(file, badMagic);
+    QVERIFY(!file->getGeometry(url.toString()));
+
+    QByteArray badVersion = baked;
+    setValue<quint32>(badVersion, VERSION_OFFSET, 0);
+    overwriteFile(file, badVersion);
+    QVERIFY(!file->getGeometry(url.toString()));
+
+    QByteArray longStructure = baked;
+    setValue<quint64>(longStructure, STRUCTURE_LENGTH_OFFSET, std::numeric_limits<quint64>::max());
+    overwriteFile(file, longStructure);
+    QVERIFY(!file->getGeometry(url.toString()));
+
+    QByteArray longData = baked;
+    setValue<quint64>(longData, DATA_LENGTH_OFFSET, std::numeric_limits<quint64>::max());
+    overwriteFile(file, longData);
+    QVERIFY(!file->getGeometry(url.toString()));
+
+    // every array now points past the end of the data
+    QByteArray shortData = baked;
+    setValue<quint64>(shortData, DATA_LENGTH_OFFSET, 0);
+    overwriteFile(file, shortData);
+    QVERIFY(!file->getGeometry(url.toString()));
+
+    // every string length and count in the structure is now huge
+    quint64 structureLength;
+    memcpy(&structureLength, baked.constData() + STRUCTURE_LENGTH_OFFSET, sizeof(structureLength));
+    QByteArray garbage = baked;
+    memset(garbage.data() + HEADER_SIZE, 0xff, structureLength);
+    overwriteFile(file, garbage);
+    QVERIFY(!file->getGeometry(url.toString()));
+
+    overwriteFile(file, baked);
+    QVERIFY(file->getGeometry(url.toString()) != nullptr);
+}
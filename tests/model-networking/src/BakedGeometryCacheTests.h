@@ -0,0 +1,32 @@
+//
+//  BakedGeometryCacheTests.h
+//  tests/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakedGeometryCacheTests_h
+#define hifi_BakedGeometryCacheTests_h
+
+#include <QtTest/QtTest>
+
+class BakedGeometryCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Test that a baked geometry reads back field by field, with its model::Mesh rebuilt
+    void roundTripTest();
+
+    // Test that a baked file cut short anywhere is ignored
+    void truncatedFileTest();
+
+    // Test that a baked file with a bad magic, version or lengths is ignored
+    void corruptFileTest();
+};
+
+#endif // hifi_BakedGeometryCacheTests_h
@@ -0,0 +1,134 @@
+//
+//  ImageProcessingTests.cpp
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ImageProcessingTests.h"
+
+#include <cstdint>
+
+#include <model/ImageProcessing.h>
+
+QTEST_MAIN(ImageProcessingTests)
+
+using namespace model;
+
+// 2x2 blocks and their expected averages, picked so that rounding twice (averaging pairs of pairs) gets them wrong
+struct ReferenceBlock {
+    uint8_t topLeft, topRight, bottomLeft, bottomRight;
+    uint8_t average;
+};
+
+static const ReferenceBlock REFERENCE_BLOCKS[] = {
+    { 0, 0, 0, 1, 0 },
+    { 1, 1, 1, 2, 1 },
+    { 10, 20, 30, 41, 25 },
+    { 255, 255, 255, 254, 255 },
+    { 0, 255, 255, 0, 128 },
+    { 3, 4, 4, 4, 4 }
+};
+static const int NUM_REFERENCE_BLOCKS = sizeof(REFERENCE_BLOCKS) / sizeof(ReferenceBlock);
+
+// wide enough that the SIMD path handles the start of the row and the scalar path the rest
+static const int REFERENCE_MIP_WIDTH = 37;
+
+static const ReferenceBlock& referenceBlockAt(int x, int y, int channel) {
+    return REFERENCE_BLOCKS[(x + 2 * y + channel) % NUM_REFERENCE_BLOCKS];
+}
+
+static QImage makeReferenceImage(QImage::Format format, int bytesPerPixel, int mipHeight) {
+    QImage image(REFERENCE_MIP_WIDTH * 2, mipHeight * 2, format);
+    for (int y = 0; y < mipHeight; ++y) {
+        uint8_t* top = image.scanLine(y * 2);
+        uint8_t* bottom = image.scanLine(y * 2 + 1);
+        for (int x = 0; x < REFERENCE_MIP_WIDTH; ++x) {
+            for (int c = 0; c < bytesPerPixel; ++c) {
+                const auto& block = referenceBlockAt(x, y, c);
+                top[(x * 2) * bytesPerPixel + c] = block.topLeft;
+                top[(x * 2 + 1) * bytesPerPixel + c] = block.topRight;
+                bottom[(x * 2) * bytesPerPixel + c] = block.bottomLeft;
+                bottom[(x * 2 + 1) * bytesPerPixel + c] = block.bottomRight;
+            }
+        }
+    }
+    return image;
+}
+
+static void verifyReferenceMip(const QImage& mip, int bytesPerPixel) {
+    for (int y = 0; y < mip.height(); ++y) {
+        const uint8_t* row = mip.constScanLine(y);
+        for (int x = 0; x < mip.width(); ++x) {
+            for (int c = 0; c < bytesPerPixel; ++c) {
+                QCOMPARE(row[x * bytesPerPixel + c], referenceBlockAt(x, y, c).average);
+            }
+        }
+    }
+}
+
+void ImageProcessingTests::grayscaleReferenceMipTest() {
+    const int MIP_HEIGHT = 3;
+    auto image = makeReferenceImage(QImage::Format_Grayscale8, 1, MIP_HEIGHT);
+
+    auto mip = ImageProcessing::downsample(image, QSize(REFERENCE_MIP_WIDTH, MIP_HEIGHT), false);
+    QCOMPARE(mip.format(), QImage::Format_Grayscale8);
+    verifyReferenceMip(mip, 1);
+}
+
+void ImageProcessingTests::argbReferenceMipTest() {
+    const int MIP_HEIGHT = 3;
+    auto image = makeReferenceImage(QImage::Format_ARGB32, 4, MIP_HEIGHT);
+
+    auto mip = ImageProcessing::downsample(image, QSize(REFERENCE_MIP_WIDTH, MIP_HEIGHT), false);
+    QCOMPARE(mip.format(), QImage::Format_ARGB32);
+    verifyReferenceMip(mip, 4);
+}
+
+void ImageProcessingTests::oddSizesTest() {
+    const QImage::Format FORMATS[] = { QImage::Format_Grayscale8, QImage::Format_ARGB32, QImage::Format_RGB888 };
+    const int BYTES_PER_PIXEL[] = { 1, 4, 3 };
+
+    qsrand(1);
+
+    for (int f = 0; f < 3; ++f) {
+        const int bpp = BYTES_PER_PIXEL[f];
+
+        for (int srcWidth = 1; srcWidth <= 70; ++srcWidth) {
+            const int srcHeight = (srcWidth % 3) + 1;
+            QImage image(srcWidth, srcHeight, FORMATS[f]);
+            for (int y = 0; y < srcHeight; ++y) {
+                uint8_t* row = image.scanLine(y);
+                for (int i = 0; i < srcWidth * bpp; ++i) {
+                    row[i] = (uint8_t)(qrand() & 0xFF);
+                }
+            }
+
+            // odd dimensions drop their last row or column, dimensions of 1 are kept
+            const int stepX = (srcWidth == 1) ? 1 : 2;
+            const int stepY = (srcHeight == 1) ? 1 : 2;
+            QSize dstSize(srcWidth / stepX, srcHeight / stepY);
+
+            auto mip = ImageProcessing::downsample(image, dstSize, false);
+            QCOMPARE(mip.size(), dstSize);
+
+            // the scalar rule that every path has to match
+            for (int y = 0; y < dstSize.height(); ++y) {
+                const uint8_t* row0 = image.constScanLine(y * stepY);
+                const uint8_t* row1 = image.constScanLine(y * stepY + stepY - 1);
+                const uint8_t* dst = mip.constScanLine(y);
+
+                for (int x = 0; x < dstSize.width(); ++x) {
+                    for (int c = 0; c < bpp; ++c) {
+                        int sum = row0[(x * stepX) * bpp + c] + row0[(x * stepX + stepX - 1) * bpp + c] +
+                            row1[(x * stepX) * bpp + c] + row1[(x * stepX + stepX - 1) * bpp + c];
+                        QCOMPARE((int)dst[x * bpp + c], (sum + 2) >> 2);
+                    }
+                }
+            }
+        }
+    }
+}
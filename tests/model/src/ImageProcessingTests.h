@@ -0,0 +1,29 @@
+//
+//  ImageProcessingTests.h
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ImageProcessingTests_h
+#define hifi_ImageProcessingTests_h
+
+#include <QtTest/QtTest>
+
+class ImageProcessingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a downsampled 8 bit mip matches hand computed values, including the rounding
+    void grayscaleReferenceMipTest();
+
+    // Test that a downsampled 32 bit mip matches hand computed values, including the rounding
+    void argbReferenceMipTest();
+
+    // Test that the SIMD and scalar paths agree, over widths that leave tails of every length
+    void oddSizesTest();
+};
+
+#endif // hifi_ImageProcessingTests_h
@@ -0,0 +1,112 @@
+//
+//  DomainListReplyTrackerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListReplyTrackerTests.h"
+
+#include <DomainListReplyTracker.h>
+
+QTEST_MAIN(DomainListReplyTrackerTests)
+
+static const quint64 LIST_VERSION = 1000;
+static const quint32 NUM_ENTRIES = 5;
+
+// feeds one DomainList packet holding the given entries of a reply
+static void receivePacket(DomainListReplyTracker& tracker, quint64 listVersion, quint32 replyID,
+                          std::initializer_list<quint32> entryIndices) {
+    tracker.startPacket(listVersion, replyID, NUM_ENTRIES);
+    for (auto entryIndex : entryIndices) {
+        tracker.receiveEntry(entryIndex);
+    }
+}
+
+void DomainListReplyTrackerTests::completeReplyTest() {
+    DomainListReplyTracker tracker;
+    QVERIFY(!tracker.isComplete());
+
+    receivePacket(tracker, LIST_VERSION, 1, { 0, 1 });
+    QVERIFY(!tracker.isComplete());
+
+    // packets of a reply can arrive in any order
+    receivePacket(tracker, LIST_VERSION, 1, { 4 });
+    receivePacket(tracker, LIST_VERSION, 1, { 2, 3 });
+    QVERIFY(tracker.isComplete());
+    QCOMPARE(tracker.getNumEntriesReceived(), NUM_ENTRIES);
+}
+
+void DomainListReplyTrackerTests::emptyReplyTest() {
+    DomainListReplyTracker tracker;
+
+    // a node with nothing in its list still gets one packet, which completes the reply
+    tracker.startPacket(LIST_VERSION, 1, 0);
+    QVERIFY(tracker.isComplete());
+}
+
+void DomainListReplyTrackerTests::lostPacketTest() {
+    DomainListReplyTracker tracker;
+
+    // the packet holding entries 2 and 3 is lost
+    receivePacket(tracker, LIST_VERSION, 1, { 0, 1 });
+    receivePacket(tracker, LIST_VERSION, 1, { 4 });
+    QVERIFY(!tracker.isComplete());
+
+    // the next check in gets a new reply for the same list version, which has to arrive whole on its own
+    receivePacket(tracker, LIST_VERSION, 2, { 2, 3 });
+    QVERIFY(!tracker.isComplete());
+    QCOMPARE(tracker.getNumEntriesReceived(), (quint32)2);
+
+    receivePacket(tracker, LIST_VERSION, 2, { 0, 1 });
+    receivePacket(tracker, LIST_VERSION, 2, { 4 });
+    QVERIFY(tracker.isComplete());
+}
+
+void DomainListReplyTrackerTests::duplicatePacketTest() {
+    DomainListReplyTracker tracker;
+
+    // a duplicated packet brings the entry count up to the total, but entry 4 is still missing
+    receivePacket(tracker, LIST_VERSION, 1, { 0, 1 });
+    receivePacket(tracker, LIST_VERSION, 1, { 0, 1 });
+    receivePacket(tracker, LIST_VERSION, 1, { 2, 3 });
+    QVERIFY(!tracker.isComplete());
+    QCOMPARE(tracker.getNumEntriesReceived(), (quint32)4);
+
+    tracker.startPacket(LIST_VERSION, 1, NUM_ENTRIES);
+    QVERIFY(!tracker.receiveEntry(2));
+    QVERIFY(!tracker.receiveEntry(NUM_ENTRIES));
+    QVERIFY(tracker.receiveEntry(4));
+    QVERIFY(tracker.isComplete());
+}
+
+void DomainListReplyTrackerTests::interleavedRepliesTest() {
+    DomainListReplyTracker tracker;
+
+    // a late packet of an older reply arrives while we assemble a newer one, entries of the two never add up
+    receivePacket(tracker, LIST_VERSION, 2, { 0, 1 });
+    receivePacket(tracker, LIST_VERSION, 1, { 2, 3, 4 });
+    receivePacket(tracker, LIST_VERSION, 2, { 2, 3 });
+    QVERIFY(!tracker.isComplete());
+
+    // nor do entries of replies for different list versions, even with the same reply ID
+    receivePacket(tracker, LIST_VERSION, 3, { 0, 1, 2, 3 });
+    receivePacket(tracker, LIST_VERSION + 1, 3, { 4 });
+    QVERIFY(!tracker.isComplete());
+}
+
+void DomainListReplyTrackerTests::resetTest() {
+    DomainListReplyTracker tracker;
+
+    receivePacket(tracker, LIST_VERSION, 1, { 0, 1, 2, 3 });
+    tracker.reset();
+    QVERIFY(!tracker.isComplete());
+
+    // after a reset (e.g. a new domain) the same reply starts over
+    receivePacket(tracker, LIST_VERSION, 1, { 4 });
+    QVERIFY(!tracker.isComplete());
+    QCOMPARE(tracker.getNumEntriesReceived(), (quint32)1);
+}
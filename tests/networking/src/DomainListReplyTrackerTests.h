@@ -0,0 +1,27 @@
+//
+//  DomainListReplyTrackerTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListReplyTrackerTests_h
+#define hifi_DomainListReplyTrackerTests_h
+
+#include <QtTest/QtTest>
+
+class DomainListReplyTrackerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void completeReplyTest();
+    void emptyReplyTest();
+    void lostPacketTest();
+    void duplicatePacketTest();
+    void interleavedRepliesTest();
+    void resetTest();
+};
+
+#endif // hifi_DomainListReplyTrackerTests_h
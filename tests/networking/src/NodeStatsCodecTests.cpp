@@ -0,0 +1,133 @@
+//
+//  NodeStatsCodecTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeStatsCodecTests.h"
+
+#include <QtCore/QJsonArray>
+
+#include <NodeStatsCodec.h>
+
+QTEST_MAIN(NodeStatsCodecTests)
+
+static QJsonObject makeStats(int packetsSent) {
+    QJsonObject ioStats;
+    ioStats["inbound_bytes_per_s"] = 1234.5;
+    ioStats["outbound_packets_per_s"] = packetsSent;
+
+    QJsonObject listener;
+    ioStats["empty"] = QJsonObject();
+    listener["codec"] = "opus";
+    listener["muted"] = false;
+
+    QJsonObject stats;
+    stats["io_stats"] = ioStats;
+    stats["listeners"] = QJsonObject { { "listener-1", listener } };
+    stats["ranges"] = QJsonArray { 1, 2, 3 };
+    stats["nothing"] = QJsonValue();
+
+    return stats;
+}
+
+void NodeStatsCodecTests::roundTripTest() {
+    NodeStatsEncoder encoder;
+    NodeStatsDecoder decoder;
+
+    auto stats = makeStats(10);
+
+    QVERIFY(decoder.decode(encoder.encode(stats)));
+    QVERIFY(decoder.hasStats());
+    QCOMPARE(decoder.toJSON(), stats);
+}
+
+void NodeStatsCodecTests::deltaTest() {
+    NodeStatsEncoder encoder;
+    NodeStatsDecoder decoder;
+
+    auto stats = makeStats(10);
+    auto fullSnapshot = encoder.encode(stats);
+    QVERIFY(decoder.decode(fullSnapshot));
+
+    // change one value, add a listener and drop another key
+    stats = makeStats(11);
+    QJsonObject listeners = stats["listeners"].toObject();
+    listeners["listener-2"] = QJsonObject { { "codec", "pcm" } };
+    stats["listeners"] = listeners;
+    stats.remove("ranges");
+
+    auto delta = encoder.encode(stats);
+    QVERIFY(delta.size() < fullSnapshot.size());
+    QVERIFY(decoder.decode(delta));
+    QCOMPARE(decoder.toJSON(), stats);
+
+    // nothing changed, so the delta should be tiny
+    auto emptyDelta = encoder.encode(stats);
+    QVERIFY(emptyDelta.size() < delta.size());
+    QVERIFY(decoder.decode(emptyDelta));
+    QCOMPARE(decoder.toJSON(), stats);
+}
+
+void NodeStatsCodecTests::missingSnapshotTest() {
+    NodeStatsEncoder encoder;
+    NodeStatsDecoder decoder;
+
+    // the decoder never sees the first full snapshot
+    encoder.encode(makeStats(10));
+    QVERIFY(!decoder.decode(encoder.encode(makeStats(11))));
+    QVERIFY(!decoder.hasStats());
+
+    // once the encoder is reset it sends a full snapshot that the decoder can use
+    encoder.reset();
+    auto stats = makeStats(12);
+    QVERIFY(decoder.decode(encoder.encode(stats)));
+    QCOMPARE(decoder.toJSON(), stats);
+}
+
+static QByteArray writeStats(NodeStatsEncoder& encoder, quint64 packetsSent) {
+    // written in the order a QJsonObject iterates, so that the keys match encoding makeStats
+    encoder.beginStats();
+
+    encoder.beginObject("io_stats");
+    encoder.write("empty", QJsonObject());
+    encoder.write("inbound_bytes_per_s", 1234.5f);
+    encoder.write("outbound_packets_per_s", packetsSent);
+    encoder.endObject();
+
+    encoder.beginObject("listeners");
+    encoder.beginObject("listener-1");
+    encoder.write("codec", "opus");
+    encoder.write("muted", false);
+    encoder.endObject();
+    encoder.endObject();
+
+    encoder.write("nothing", QJsonValue());
+    encoder.write("ranges", QJsonArray { 1, 2, 3 });
+
+    return encoder.finishStats();
+}
+
+void NodeStatsCodecTests::writeTest() {
+    NodeStatsEncoder encoder;
+    NodeStatsDecoder decoder;
+
+    auto fullSnapshot = writeStats(encoder, 10);
+    QVERIFY(decoder.decode(fullSnapshot));
+    QCOMPARE(decoder.toJSON(), makeStats(10));
+
+    // only the counter changed, so only it should be sent
+    auto delta = writeStats(encoder, 11);
+    QVERIFY(delta.size() < fullSnapshot.size());
+    QVERIFY(decoder.decode(delta));
+    QCOMPARE(decoder.toJSON(), makeStats(11));
+
+    // writing the same stats as JSON produces the same payload
+    NodeStatsEncoder jsonEncoder;
+    jsonEncoder.encode(makeStats(10));
+    QCOMPARE(jsonEncoder.encode(makeStats(11)), delta);
+}
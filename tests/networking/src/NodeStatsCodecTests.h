@@ -0,0 +1,32 @@
+//
+//  NodeStatsCodecTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeStatsCodecTests_h
+#define hifi_NodeStatsCodecTests_h
+
+#include <QtTest/QtTest>
+
+class NodeStatsCodecTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a full snapshot decodes back to the same JSON
+    void roundTripTest();
+
+    // Test that deltas apply changes, additions and removals
+    void deltaTest();
+
+    // Test that deltas are ignored until a full snapshot is received
+    void missingSnapshotTest();
+
+    // Test that stats written straight into the encoder decode to the matching JSON
+    void writeTest();
+};
+
+#endif // hifi_NodeStatsCodecTests_h
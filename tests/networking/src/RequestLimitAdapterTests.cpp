@@ -0,0 +1,105 @@
+//
+//  RequestLimitAdapterTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RequestLimitAdapterTests.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <NumericalConstants.h>
+#include <RequestLimitAdapter.h>
+
+QTEST_MAIN(RequestLimitAdapterTests)
+
+static const int START_LIMIT = 10;
+static const quint64 START_TIME = 1000;
+static const qint64 BYTES_PER_REQUEST_PER_SECOND = 100000;
+
+// runs whole windows against a connection whose throughput is given by the request limit,
+// returning the limit after each window
+static std::vector<int> runWindows(RequestLimitAdapter& adapter, int numWindows,
+                                   std::function<qint64(int)> bytesPerSecondForLimit) {
+    quint64 now = START_TIME;
+    int limit = adapter.update(0, true, START_LIMIT, now);
+
+    std::vector<int> limits;
+    for (int i = 0; i < numWindows; ++i) {
+        now += RequestLimitAdapter::WINDOW_USECS;
+        qint64 bytes = bytesPerSecondForLimit(limit) * (qint64)(RequestLimitAdapter::WINDOW_USECS / USECS_PER_SECOND);
+        limit = adapter.update(bytes, true, limit, now);
+        limits.push_back(limit);
+    }
+    return limits;
+}
+
+void RequestLimitAdapterTests::climbToSaturationTest() {
+    RequestLimitAdapter adapter;
+
+    // the connection is full at 12 concurrent requests
+    const int SATURATED_LIMIT = 12;
+    auto limits = runWindows(adapter, 30, [&](int limit) {
+        return std::min(limit, SATURATED_LIMIT) * BYTES_PER_REQUEST_PER_SECOND;
+    });
+
+    // it climbs one step per window while throughput improves
+    QCOMPARE(limits[0], START_LIMIT + 1);
+    QCOMPARE(limits[1], START_LIMIT + 2);
+
+    // and then hovers around the point where it stops improving
+    for (size_t i = 10; i < limits.size(); ++i) {
+        QVERIFY(limits[i] >= SATURATED_LIMIT - 1);
+        QVERIFY(limits[i] <= SATURATED_LIMIT + 1);
+    }
+}
+
+void RequestLimitAdapterTests::flatThroughputTest() {
+    RequestLimitAdapter adapter;
+
+    auto limits = runWindows(adapter, 30, [](int) {
+        return 4 * BYTES_PER_REQUEST_PER_SECOND;
+    });
+
+    QCOMPARE(limits.back(), RequestLimitAdapter::MIN_REQUEST_LIMIT);
+    QVERIFY(*std::min_element(limits.begin(), limits.end()) >= RequestLimitAdapter::MIN_REQUEST_LIMIT);
+}
+
+void RequestLimitAdapterTests::unsaturatedWindowTest() {
+    RequestLimitAdapter adapter;
+
+    quint64 now = START_TIME;
+    QCOMPARE(adapter.update(0, true, START_LIMIT, now), START_LIMIT);
+
+    // the queue ran dry part way through, so the window says nothing about the connection
+    now += RequestLimitAdapter::WINDOW_USECS / 2;
+    QCOMPARE(adapter.update(BYTES_PER_REQUEST_PER_SECOND, false, START_LIMIT, now), START_LIMIT);
+    now += RequestLimitAdapter::WINDOW_USECS / 2;
+    QCOMPARE(adapter.update(BYTES_PER_REQUEST_PER_SECOND, true, START_LIMIT, now), START_LIMIT);
+
+    // the next window is backed up again and starts probing upwards
+    now += RequestLimitAdapter::WINDOW_USECS;
+    QCOMPARE(adapter.update(BYTES_PER_REQUEST_PER_SECOND, true, START_LIMIT, now), START_LIMIT + 1);
+}
+
+void RequestLimitAdapterTests::partialWindowTest() {
+    RequestLimitAdapter adapter;
+
+    quint64 now = START_TIME;
+    adapter.update(0, true, START_LIMIT, now);
+
+    // downloads finishing within a window only add to it
+    for (int i = 0; i < 10; ++i) {
+        now += RequestLimitAdapter::WINDOW_USECS / 20;
+        QCOMPARE(adapter.update(BYTES_PER_REQUEST_PER_SECOND, true, START_LIMIT, now), START_LIMIT);
+    }
+
+    now += RequestLimitAdapter::WINDOW_USECS / 2;
+    QCOMPARE(adapter.update(BYTES_PER_REQUEST_PER_SECOND, true, START_LIMIT, now), START_LIMIT + 1);
+}
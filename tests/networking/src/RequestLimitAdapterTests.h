@@ -0,0 +1,32 @@
+//
+//  RequestLimitAdapterTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RequestLimitAdapterTests_h
+#define hifi_RequestLimitAdapterTests_h
+
+#include <QtTest/QtTest>
+
+class RequestLimitAdapterTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the limit climbs to where throughput stops improving and stays around it
+    void climbToSaturationTest();
+
+    // Test that the limit backs off to the minimum when concurrency doesn't help at all
+    void flatThroughputTest();
+
+    // Test that windows where the queue ran dry don't move the limit
+    void unsaturatedWindowTest();
+
+    // Test that the limit only moves once per window
+    void partialWindowTest();
+};
+
+#endif // hifi_RequestLimitAdapterTests_h
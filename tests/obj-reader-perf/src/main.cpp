@@ -0,0 +1,127 @@
+//
+//  main.cpp
+//  tests/obj-reader-perf/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+// Times OBJReader on a generated grid of quads, big enough to be split into many chunks, and checks that the
+// groups spanning chunk boundaries come out whole and in order.
+//
+//   obj-reader-perf-test [--grid N] [--rows-per-group N] [--runs N]
+//
+// Prints the size of the file and the average time it took to read.
+
+#include <algorithm>
+#include <memory>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTextStream>
+#include <QtGui/QGuiApplication>
+
+#include <OBJReader.h>
+
+static const int DEFAULT_GRID_SIZE = 400;
+static const int DEFAULT_ROWS_PER_GROUP = 50;
+static const int DEFAULT_RUNS = 10;
+
+// a grid of quads, with a group and a material change every few rows
+static QByteArray makeGrid(int gridSize, int rowsPerGroup) {
+    QByteArray model;
+    for (int y = 0; y <= gridSize; ++y) {
+        for (int x = 0; x <= gridSize; ++x) {
+            model += QString("v %1 %2 %3\nvt %4 %5\n").arg(x * 0.01, 0, 'f', 6).arg(y * 0.01, 0, 'f', 6).arg((x + y) % 7 * 0.001, 0, 'f', 6)
+                .arg(x / (float)gridSize, 0, 'f', 6).arg(y / (float)gridSize, 0, 'f', 6).toLatin1();
+        }
+    }
+    for (int y = 0; y < gridSize; ++y) {
+        if (y % rowsPerGroup == 0) {
+            model += QString("g rows%1\nusemtl material%2\n").arg(y).arg(y / rowsPerGroup).toLatin1();
+        }
+        for (int x = 0; x < gridSize; ++x) {
+            int corner = y * (gridSize + 1) + x + 1;
+            int above = corner + gridSize + 1;
+            model += QString("f %1/%1 %2/%2 %3/%3 %4/%4\n").arg(corner).arg(corner + 1).arg(above + 1).arg(above).toLatin1();
+        }
+    }
+    return model;
+}
+
+static bool checkGrid(const FBXGeometry& geometry, int gridSize, int rowsPerGroup, QTextStream& err) {
+    const FBXMesh& mesh = geometry.meshes[0];
+    const int numGroups = (gridSize + rowsPerGroup - 1) / rowsPerGroup;
+    if (mesh.parts.size() != numGroups) {
+        err << "expected " << numGroups << " parts, got " << mesh.parts.size() << endl;
+        return false;
+    }
+    for (int i = 0; i < numGroups; ++i) {
+        const int numRows = std::min(rowsPerGroup, gridSize - i * rowsPerGroup);
+        if (mesh.parts[i].triangleIndices.size() != numRows * gridSize * 6) {
+            err << "part " << i << " has " << mesh.parts[i].triangleIndices.size() << " indices" << endl;
+            return false;
+        }
+        if (mesh.parts[i].materialID != QString("material%1").arg(i)) {
+            err << "part " << i << " has material " << mesh.parts[i].materialID << endl;
+            return false;
+        }
+    }
+    if (mesh.vertices.size() != gridSize * gridSize * 6) {
+        err << "expected " << gridSize * gridSize * 6 << " vertices, got " << mesh.vertices.size() << endl;
+        return false;
+    }
+
+    // the last face starts at the corner one step in from the far end of the grid
+    const glm::vec3 lastFaceCorner = mesh.vertices[mesh.vertices.size() - 6];
+    if (lastFaceCorner.x != (gridSize - 1) * 0.01f || lastFaceCorner.y != (gridSize - 1) * 0.01f) {
+        err << "the last face is out of place" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption gridOption("grid", "Number of quads along each side of the grid", "N", QString::number(DEFAULT_GRID_SIZE));
+    QCommandLineOption rowsPerGroupOption("rows-per-group", "Number of rows of quads in each group", "N",
+        QString::number(DEFAULT_ROWS_PER_GROUP));
+    QCommandLineOption runsOption("runs", "Number of times the file is read", "N", QString::number(DEFAULT_RUNS));
+    parser.addOption(gridOption);
+    parser.addOption(rowsPerGroupOption);
+    parser.addOption(runsOption);
+    parser.process(app);
+
+    const int gridSize = std::max(1, parser.value(gridOption).toInt());
+    const int rowsPerGroup = std::max(1, parser.value(rowsPerGroupOption).toInt());
+    const int runs = std::max(1, parser.value(runsOption).toInt());
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    const QByteArray grid = makeGrid(gridSize, rowsPerGroup);
+
+    qint64 totalNsecs = 0;
+    for (int run = 0; run < runs; ++run) {
+        // readOBJ takes the model by reference, give every run a copy of its own
+        QByteArray model = grid;
+
+        QElapsedTimer timer;
+        timer.start();
+        std::unique_ptr<FBXGeometry> geometry(OBJReader().readOBJ(model, QVariantHash()));
+        totalNsecs += timer.nsecsElapsed();
+
+        if (!checkGrid(*geometry, gridSize, rowsPerGroup, err)) {
+            return 1;
+        }
+    }
+
+    out << "Read " << grid.size() << " bytes of OBJ in " << totalNsecs / runs / 1.0e6 << " ms on average over "
+        << runs << " runs" << endl;
+    return 0;
+}
@@ -0,0 +1,110 @@
+//
+//  OBJReaderTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OBJReaderTests.h"
+
+#include <memory>
+
+#include <OBJReader.h>
+
+QTEST_MAIN(OBJReaderTests)
+
+static std::unique_ptr<FBXGeometry> readOBJ(QByteArray model) {
+    return std::unique_ptr<FBXGeometry>(OBJReader().readOBJ(model, QVariantHash()));
+}
+
+void OBJReaderTests::parseTest() {
+    QByteArray model =
+        "# This file uses centimeters as units\n"
+        "v 0 0 0\n"
+        "v 100 0 0\n"
+        "v 100 100 0\n"
+        "v 0 100 0\n"
+        "vt 0 0\n"
+        "vt 1 0\n"
+        "vt 1 1\n"
+        "vt 0 1\n"
+        "vn 0 0 1\n"
+        "g first\n"
+        "usemtl red\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\r\n"
+        "g second\n"
+        "usemtl blue\n"
+        "f -4//1 -3//1 -2//1\n"
+        "g empty\n";
+
+    auto geometry = readOBJ(model);
+    QCOMPARE(geometry->meshes.size(), 1);
+    const FBXMesh& mesh = geometry->meshes[0];
+
+    // the quad is split into two triangles, the empty group doesn't make a part
+    QCOMPARE(mesh.parts.size(), 2);
+    QCOMPARE(mesh.parts[0].triangleIndices.size(), 6);
+    QCOMPARE(mesh.parts[1].triangleIndices.size(), 3);
+    QCOMPARE(mesh.parts[0].materialID, QString("red"));
+    QCOMPARE(mesh.parts[1].materialID, QString("blue"));
+    QVERIFY(geometry->materials.contains("red"));
+    QVERIFY(geometry->materials.contains("blue"));
+
+    QCOMPARE(mesh.vertices.size(), 9);
+    // scaled from centimeters
+    QCOMPARE(mesh.vertices[1], glm::vec3(1.0f, 0.0f, 0.0f));
+    QCOMPARE(mesh.vertices[5], glm::vec3(0.0f, 1.0f, 0.0f));
+    QCOMPARE(mesh.normals[0], glm::vec3(0.0f, 0.0f, 1.0f));
+    // v is flipped
+    QCOMPARE(mesh.texCoords[0], glm::vec2(0.0f, 1.0f));
+    QCOMPARE(mesh.texCoords[2], glm::vec2(1.0f, 0.0f));
+    // the relative indices refer to the first three vertices
+    QCOMPARE(mesh.vertices[6], glm::vec3(0.0f));
+    QCOMPARE(mesh.vertices[8], glm::vec3(1.0f, 1.0f, 0.0f));
+    // faces without texture coordinates get the default corner
+    QCOMPARE(mesh.texCoords[6], glm::vec2(0.0f, 1.0f));
+}
+
+void OBJReaderTests::numberFormatTest() {
+    QByteArray model =
+        "v 1.5e2 -2.25E-1 +3\n"
+        "v .5 5. -0.0078125 1.0\n"
+        "v 3.14159265358979323846264 1e10 2.5e-3\n"
+        "f 1 2 3\n";
+
+    auto geometry = readOBJ(model);
+    const FBXMesh& mesh = geometry->meshes[0];
+    QCOMPARE(mesh.vertices.size(), 3);
+    QCOMPARE(mesh.vertices[0], glm::vec3(150.0f, -0.225f, 3.0f));
+    QCOMPARE(mesh.vertices[1], glm::vec3(0.5f, 5.0f, -0.0078125f));
+    // more digits than fit in the mantissa
+    QCOMPARE(mesh.vertices[2].x, 3.14159265f);
+    QCOMPARE(mesh.vertices[2].y, 1e10f);
+    QCOMPARE(mesh.vertices[2].z, 2.5e-3f);
+}
+
+void OBJReaderTests::malformedNumberTest() {
+    const QByteArray VALID_LINES =
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "f 1 2 3\n";
+
+    // strtod would take the first three, and the last one would read as 1.5 followed by junk
+    for (const char* badLine : { "v nan 0 0\n", "v inf 0 0\n", "v 0 -infinity 0\n", "v 1.5cm 0 0\n",
+                                 "v 0 0\n", "v 0 0 1e\n", "vn 0 0 1,0\n", "vt nan 0\n" }) {
+        // the bad line sits between good ones, nothing of the model is kept
+        QByteArray model = VALID_LINES + badLine + VALID_LINES;
+        auto geometry = readOBJ(model);
+        QVERIFY2(geometry->meshes[0].vertices.isEmpty(), badLine);
+        QVERIFY2(geometry->meshes[0].parts.isEmpty(), badLine);
+    }
+
+    // whatever follows the three coordinates of a vertex is ignored, as long as it is separated from them
+    auto geometry = readOBJ("v 1 2 3 junk\nv 0 0 0\nv 0 1 0\nf 1 2 3\n");
+    QCOMPARE(geometry->meshes[0].vertices.size(), 3);
+    QCOMPARE(geometry->meshes[0].vertices[0], glm::vec3(1.0f, 2.0f, 3.0f));
+}
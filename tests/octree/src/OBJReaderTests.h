@@ -0,0 +1,29 @@
+//
+//  OBJReaderTests.h
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OBJReaderTests_h
+#define hifi_OBJReaderTests_h
+
+#include <QtTest/QtTest>
+
+class OBJReaderTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test groups, materials, quads, relative indices and the unit hints of a small file
+    void parseTest();
+
+    // Test the number formats the float parser has to accept
+    void numberFormatTest();
+
+    // Test that numbers the float parser doesn't accept reject the whole model
+    void malformedNumberTest();
+};
+
+#endif // hifi_OBJReaderTests_h
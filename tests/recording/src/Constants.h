@@ -15,6 +15,7 @@
 
 static const QString HEADER_NAME = "com.highfidelity.recording.Header";
 static const QString TEST_NAME = "com.highfidelity.recording.Test";
+static const QString SECOND_TEST_NAME = "com.highfidelity.recording.SecondTest";
 
 #endif // hifi_FrameTests_h
 
@@ -3,6 +3,9 @@
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QString>
 
+#include <limits>
+#include <random>
+
 #ifdef Q_OS_WIN32
 #include <Windows.h>
 #endif
@@ -97,6 +100,109 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+static QByteArray randomBytes(std::mt19937& generator, int size) {
+    QByteArray result(size, 0);
+    for (int i = 0; i < size; ++i) {
+        result[i] = (char)(generator() & 0xFF);
+    }
+    return result;
+}
+
+static void compareClips(const Clip::Pointer& readClip, const Clip::Pointer& writeClip) {
+    QVERIFY(readClip->frameCount() == writeClip->frameCount());
+    readClip->seek(0);
+    writeClip->seek(0);
+    for (auto readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(); readFrame && writeFrame;
+        readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame()) {
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+}
+
+void testDeltaFramePersist() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    auto secondFrameType = Frame::registerFrameType(SECOND_TEST_NAME);
+    std::mt19937 generator(1);
+
+    // two interleaved frame types with small changes between frames, so most are written as deltas.
+    // Run past the key frame interval and change the payload size part way, both of which force key frames.
+    auto writeClip = Clip::newClip();
+    QByteArray data = randomBytes(generator, 256);
+    QByteArray secondData = randomBytes(generator, 64);
+    const int NUM_FRAMES = 2 * Clip::KEY_FRAME_INTERVAL + 10;
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        if (i == Clip::KEY_FRAME_INTERVAL / 2) {
+            data.append(randomBytes(generator, 16));
+        }
+        data[(int)(generator() % data.size())] = (char)(generator() & 0xFF);
+        secondData[i % secondData.size()] = (char)i;
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(2 * i), data));
+        writeClip->addFrame(std::make_shared<Frame>(secondFrameType, (float)(2 * i + 1), secondData));
+    }
+
+    Clip::toFile(fileName, writeClip);
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    compareClips(readClip, writeClip);
+
+    // random access has to rebuild the delta chain from the last key frame
+    readClip->seekFrameTime(2 * (Clip::KEY_FRAME_INTERVAL + 5));
+    writeClip->seekFrameTime(2 * (Clip::KEY_FRAME_INTERVAL + 5));
+    auto readFrame = readClip->nextFrame();
+    auto writeFrame = writeClip->nextFrame();
+    QVERIFY(readFrame && writeFrame);
+    QVERIFY(readFrame->data == writeFrame->data);
+}
+
+void testOversizedFramePersist() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    std::mt19937 generator(2);
+    const int FRAME_SIZE = std::numeric_limits<FrameSize>::max() - 1;
+    const int HALF_FRAME_SIZE = FRAME_SIZE / 2;
+
+    // each frame is half noise and compresses to about half a frame, but their XOR is all noise
+    // and won't fit in a FrameSize once compressed, so the second frame has to be written as a key frame
+    QByteArray first = randomBytes(generator, HALF_FRAME_SIZE) + QByteArray(FRAME_SIZE - HALF_FRAME_SIZE, 0);
+    QByteArray second = QByteArray(HALF_FRAME_SIZE, 0) + randomBytes(generator, FRAME_SIZE - HALF_FRAME_SIZE);
+
+    auto writeClip = Clip::newClip();
+    writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, 0.0f, first));
+    writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, 1.0f, second));
+    writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, 2.0f, second));
+
+    Clip::toFile(fileName, writeClip);
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    compareClips(readClip, writeClip);
+
+    // a frame that doesn't fit even as a key frame is dropped rather than written with a truncated size
+    writeClip = Clip::newClip();
+    writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, 0.0f, first));
+    writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, 1.0f, randomBytes(generator, 2 * FRAME_SIZE)));
+    writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, 2.0f, second));
+
+    Clip::toFile(fileName, writeClip);
+    readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == 2);
+    readClip->seek(0);
+    QVERIFY(readClip->nextFrame()->data == first);
+    QVERIFY(readClip->nextFrame()->data == second);
+}
+
 #ifdef Q_OS_WIN32
 void myMessageHandler(QtMsgType type, const QMessageLogContext & context, const QString & msg) {
     OutputDebugStringA(msg.toLocal8Bit().toStdString().c_str());
@@ -111,4 +217,6 @@ int main(int, const char**) {
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testDeltaFramePersist();
+    testOversizedFramePersist();
 }
\ No newline at end of file
@@ -0,0 +1,288 @@
+//
+//  main.cpp
+//  tests/render-engine-perf/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+// Runs the full render engine (fetch / cull / sort, shadow and deferred tasks) against the gpu null backend,
+// so that the cpu cost of preparing a frame can be measured without a gpu or a window.
+//
+//   render-engine-perf-test [--frames N] [--items N] [--moving PERCENT] [--concurrent-recording] [--still-camera]
+//
+// Prints the average time and allocations per frame, and the average run time of every job.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMap>
+#include <QtGui/QGuiApplication>
+
+#include <gpu/Context.h>
+#include <gpu/null/NullBackend.h>
+
+#include <DependencyManager.h>
+#include <StatTracker.h>
+#include <Trace.h>
+#include <ResourceCache.h>
+#include <AddressManager.h>
+#include <NodeList.h>
+#include <PathUtils.h>
+
+#include <model/Stage.h>
+#include <render/Engine.h>
+#include <render/RenderFetchCullSortTask.h>
+#include <TextureCache.h>
+#include <FramebufferCache.h>
+#include <GeometryCache.h>
+#include <DeferredLightingEffect.h>
+#include <RenderShadowTask.h>
+#include <RenderDeferredTask.h>
+
+// Count every allocation made while the frames are prepared
+static std::atomic<uint64_t> numAllocations { 0 };
+static std::atomic<uint64_t> numAllocatedBytes { 0 };
+
+void* operator new(size_t size) {
+    ++numAllocations;
+    numAllocatedBytes += size;
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void* pointer) noexcept {
+    operator delete(pointer);
+}
+
+// A box standing for any shape in the scene, it draws itself with the geometry cache
+class BenchmarkShape {
+public:
+    using Payload = render::Payload<BenchmarkShape>;
+    using Pointer = Payload::DataPointer;
+
+    Transform transform;
+    AABox bound;
+    bool transparent { false };
+
+    void setPosition(const glm::vec3& position) {
+        transform.setTranslation(position);
+        bound = AABox(position - 0.5f * glm::vec3(transform.getScale()), glm::vec3(transform.getScale()));
+    }
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const BenchmarkShape::Pointer& shape) {
+        auto builder = ItemKey::Builder().withTypeShape().withShadowCaster();
+        if (shape->transparent) {
+            builder.withTransparent();
+        }
+        return builder.build();
+    }
+
+    template <> const Item::Bound payloadGetBound(const BenchmarkShape::Pointer& shape) {
+        return shape->bound;
+    }
+
+    template <> void payloadRender(const BenchmarkShape::Pointer& shape, RenderArgs* args) {
+        gpu::Batch& batch = *args->_batch;
+        batch.setModelTransform(shape->transform);
+        DependencyManager::get<GeometryCache>()->renderCube(batch);
+    }
+}
+
+class JobStats {
+public:
+    double totalTime { 0.0 };
+    int numRuns { 0 };
+};
+
+// Path of a job config in the engine, e.g. RenderDeferredTask/DrawOpaqueDeferred
+static QString getJobPath(const QObject* config, const QObject* root) {
+    QString path = config->objectName();
+    for (auto parent = config->parent(); parent && parent != root; parent = parent->parent()) {
+        path = parent->objectName() + "/" + path;
+    }
+    return path;
+}
+
+int main(int argc, char** argv) {
+    // no window is ever shown
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("RenderEnginePerf");
+    QCoreApplication::setOrganizationName("High Fidelity");
+    QCoreApplication::setOrganizationDomain("highfidelity.com");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures the cpu cost of the render engine on the gpu null backend");
+    parser.addHelpOption();
+    const QCommandLineOption framesOption("frames", "Number of frames to render", "N", "500");
+    const QCommandLineOption itemsOption("items", "Number of shapes in the scene", "N", "20000");
+    const QCommandLineOption movingOption("moving", "Percentage of the shapes moving every frame", "PERCENT", "10");
+    parser.addOption(framesOption);
+    parser.addOption(itemsOption);
+    const QCommandLineOption concurrentOption("concurrent-recording", "Record the opaque shapes on worker threads");
+    parser.addOption(movingOption);
+    parser.addOption(concurrentOption);
+    const QCommandLineOption stillCameraOption("still-camera", "Keep the camera still, so that the shadow map can be reused");
+    parser.addOption(stillCameraOption);
+    parser.process(app);
+    const int numFrames = std::max(parser.value(framesOption).toInt(), 1);
+    const int numItems = std::max(parser.value(itemsOption).toInt(), 1);
+    const int numMovingItems = numItems * glm::clamp(parser.value(movingOption).toInt(), 0, 100) / 100;
+
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<tracing::Tracer>();
+    DependencyManager::set<StatTracker>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+    DependencyManager::set<DeferredLightingEffect>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<TextureCache>();
+    DependencyManager::set<FramebufferCache>();
+    DependencyManager::set<GeometryCache>();
+    DependencyManager::set<PathUtils>();
+
+    gpu::Context::init<gpu::null::Backend>();
+    auto gpuContext = std::make_shared<gpu::Context>();
+    DependencyManager::get<DeferredLightingEffect>()->init();
+
+    // Same engine as the interface
+    render::CullFunctor cullFunctor = [](const RenderArgs* args, const AABox& bounds) {
+        return true;
+    };
+    render::EnginePointer renderEngine { new render::Engine() };
+    renderEngine->addJob<RenderShadowTask>("RenderShadowTask", cullFunctor);
+    const auto items = renderEngine->addJob<RenderFetchCullSortTask>("FetchCullSort", cullFunctor);
+    renderEngine->addJob<RenderDeferredTask>("RenderDeferredTask", items.get<RenderFetchCullSortTask::Output>());
+    renderEngine->load();
+
+    const float SCENE_SIZE = 1000.0f;
+    render::ScenePointer scene { new render::Scene(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE) };
+    renderEngine->registerScene(scene);
+
+    // A synthetic scene: boxes of various sizes scattered around the camera, a quarter of them transparent
+    std::mt19937 random(0);
+    std::uniform_real_distribution<float> randomPosition(-0.4f * SCENE_SIZE, 0.4f * SCENE_SIZE);
+    std::uniform_real_distribution<float> randomScale(0.1f, 10.0f);
+    std::vector<render::ItemID> itemIDs;
+    {
+        render::PendingChanges pendingChanges;
+        for (int i = 0; i < numItems; ++i) {
+            auto shape = std::make_shared<BenchmarkShape>();
+            shape->transform.setScale(randomScale(random));
+            shape->setPosition(glm::vec3(randomPosition(random), randomPosition(random), randomPosition(random)));
+            shape->transparent = (i % 4) == 0;
+
+            auto itemID = scene->allocateID();
+            pendingChanges.resetItem(itemID, std::make_shared<BenchmarkShape::Payload>(shape));
+            itemIDs.push_back(itemID);
+        }
+        scene->enqueuePendingChanges(std::move(pendingChanges));
+        scene->processPendingChangesQueue();
+    }
+
+    model::SunSkyStage sunSkyStage;
+    const QSize FRAMEBUFFER_SIZE(1920, 1080);
+    auto framebufferCache = DependencyManager::get<FramebufferCache>();
+    framebufferCache->setFrameBufferSize(FRAMEBUFFER_SIZE);
+
+    ViewFrustum viewFrustum;
+    viewFrustum.setProjection(glm::perspective(glm::radians(60.0f),
+        (float)FRAMEBUFFER_SIZE.width() / (float)FRAMEBUFFER_SIZE.height(), 0.1f, SCENE_SIZE));
+
+    auto engineConfig = renderEngine->getConfiguration();
+    if (parser.isSet(concurrentOption)) {
+        engineConfig->getConfig("DrawOpaqueDeferred")->setProperty("concurrentRecording", true);
+    }
+    QMap<QString, JobStats> jobStats;
+    uint64_t totalUsecs = 0;
+    uint64_t totalAllocations = 0;
+    uint64_t totalAllocatedBytes = 0;
+
+    QElapsedTimer frameTimer;
+    for (int frame = 0; frame < numFrames; ++frame) {
+        // Move some of the shapes, as dynamic content would
+        render::PendingChanges pendingChanges;
+        for (int i = 0; i < numMovingItems; ++i) {
+            auto position = glm::vec3(randomPosition(random), randomPosition(random), randomPosition(random));
+            pendingChanges.updateItem<BenchmarkShape>(itemIDs[(frame * numMovingItems + i) % numItems],
+                [position](BenchmarkShape& shape) {
+                    shape.setPosition(position);
+                });
+        }
+        scene->enqueuePendingChanges(std::move(pendingChanges));
+
+        // Turn the camera around
+        float angle = parser.isSet(stillCameraOption) ? 0.0f : glm::two_pi<float>() * (float)frame / (float)numFrames;
+        viewFrustum.setPosition(glm::vec3(0.0f));
+        viewFrustum.setOrientation(glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f)));
+        viewFrustum.calculate();
+
+        RenderArgs renderArgs(gpuContext, nullptr, DEFAULT_OCTREE_SIZE_SCALE, 0,
+            RenderArgs::DEFAULT_RENDER_MODE, RenderArgs::MONO, RenderArgs::RENDER_DEBUG_NONE);
+        renderArgs.setViewFrustum(viewFrustum);
+        renderArgs._viewport = glm::ivec4(0, 0, FRAMEBUFFER_SIZE.width(), FRAMEBUFFER_SIZE.height());
+        renderArgs._blitFramebuffer = framebufferCache->getFramebuffer();
+
+        const uint64_t allocationsBefore = numAllocations;
+        const uint64_t allocatedBytesBefore = numAllocatedBytes;
+        frameTimer.start();
+
+        DependencyManager::get<DeferredLightingEffect>()->setGlobalLight(sunSkyStage.getSunLight());
+        scene->processPendingChangesQueue();
+
+        gpuContext->beginFrame();
+        renderEngine->getRenderContext()->args = &renderArgs;
+        renderEngine->run();
+        auto gpuFrame = gpuContext->endFrame();
+
+        totalUsecs += frameTimer.nsecsElapsed() / 1000;
+        totalAllocations += numAllocations - allocationsBefore;
+        totalAllocatedBytes += numAllocatedBytes - allocatedBytesBefore;
+
+        // The null backend doesn't execute the batches, this only releases the frame resources
+        gpuContext->consumeFrameUpdates(gpuFrame);
+        framebufferCache->releaseFramebuffer(renderArgs._blitFramebuffer);
+
+        for (auto jobConfig : engineConfig->findChildren<render::JobConfig*>()) {
+            auto& stats = jobStats[getJobPath(jobConfig, engineConfig.get())];
+            stats.totalTime += jobConfig->getCPURunTime();
+            stats.numRuns++;
+        }
+    }
+
+    qInfo() << "Rendered" << numFrames << "frames of" << numItems << "items," << numMovingItems << "moving per frame";
+    qInfo() << "  frame:" << (double)totalUsecs / (double)numFrames / 1000.0 << "ms,"
+        << totalAllocations / numFrames << "allocations," << totalAllocatedBytes / numFrames << "bytes";
+    for (auto it = jobStats.cbegin(); it != jobStats.cend(); ++it) {
+        qInfo().noquote() << " " << it.key() << ":" << it.value().totalTime / (double)it.value().numRuns << "ms";
+    }
+
+    renderEngine.reset();
+    scene.reset();
+    DependencyManager::destroy<FramebufferCache>();
+    DependencyManager::destroy<TextureCache>();
+    DependencyManager::destroy<GeometryCache>();
+    DependencyManager::destroy<NodeList>();
+    return 0;
+}
@@ -0,0 +1,193 @@
+//
+//  DrawTaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DrawTaskTests.h"
+
+#include <algorithm>
+
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <render/DrawTask.h>
+
+QTEST_MAIN(DrawTaskTests)
+
+using namespace render;
+
+// A shape drawing its index as the start vertex of a triangle
+class TestShape {
+public:
+    using Payload = render::Payload<TestShape>;
+    using Pointer = Payload::DataPointer;
+
+    TestShape(uint32_t index, const ShapeKey& key, const gpu::PipelinePointer& ownPipeline) :
+        index(index), key(key), ownPipeline(ownPipeline) {}
+
+    uint32_t index;
+    ShapeKey key;
+    gpu::PipelinePointer ownPipeline;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const TestShape::Pointer& shape) {
+        return ItemKey::Builder::opaqueShape().build();
+    }
+    template <> const Item::Bound payloadGetBound(const TestShape::Pointer& shape) {
+        return Item::Bound(glm::vec3((float)shape->index), 1.0f);
+    }
+    template <> const ShapeKey shapeGetShapeKey(const TestShape::Pointer& shape) {
+        return shape->key;
+    }
+    template <> void payloadRender(const TestShape::Pointer& shape, RenderArgs* args) {
+        if (shape->key.hasOwnPipeline()) {
+            args->_batch->setPipeline(shape->ownPipeline);
+        }
+        args->_batch->draw(gpu::TRIANGLES, 3, shape->index);
+    }
+}
+
+// the shaders are never compiled without a backend
+static gpu::ShaderPointer createProgram() {
+    return gpu::Shader::createProgram(gpu::Shader::createVertex(std::string()), gpu::Shader::createPixel(std::string()));
+}
+
+// The shapes cycle through an opaque pipeline, a translucent one and their own
+class ShapeScene {
+public:
+    ShapeScene(int numShapes) : scene(std::make_shared<Scene>(glm::vec3(-16384.0f), 32768.0f)) {
+        plumber->addPipeline(ShapeKey::Filter::Builder().withOpaque().build(), createProgram(), std::make_shared<gpu::State>());
+        plumber->addPipeline(ShapeKey::Filter::Builder().withTranslucent().build(), createProgram(), std::make_shared<gpu::State>());
+        const ShapeKey keys[] = { ShapeKey::Builder().build(), ShapeKey::Builder().withTranslucent().build(),
+            ShapeKey::Builder().withOwnPipeline().build() };
+        pipelines = { plumber->findPipeline(keys[0])->pipeline, plumber->findPipeline(keys[1])->pipeline,
+            gpu::Pipeline::create(createProgram(), std::make_shared<gpu::State>()) };
+
+        PendingChanges changes;
+        for (int i = 0; i < numShapes; ++i) {
+            auto id = scene->allocateID();
+            auto shape = std::make_shared<TestShape>(i, keys[i % 3], pipelines[2]);
+            changes.resetItem(id, std::make_shared<TestShape::Payload>(shape));
+            items.emplace_back(id);
+        }
+        scene->enqueuePendingChanges(changes);
+        scene->processPendingChangesQueue();
+    }
+
+    ScenePointer scene;
+    ShapePlumberPointer plumber { std::make_shared<ShapePlumber>() };
+    std::vector<gpu::PipelinePointer> pipelines;
+    ItemBounds items;
+};
+
+static void setupBatch(gpu::Batch& batch) {
+    batch.setProjectionTransform(glm::mat4());
+}
+
+static gpu::FramePointer recordFrame(const ShapeScene& shapes, bool concurrent, bool stateSort, int maxDrawnItems) {
+    auto context = std::make_shared<gpu::Context>();
+    RenderArgs args(context);
+    auto sceneContext = std::make_shared<SceneContext>();
+    sceneContext->_scene = shapes.scene;
+    auto renderContext = std::make_shared<RenderContext>();
+    renderContext->args = &args;
+
+    context->beginFrame();
+    if (concurrent) {
+        renderShapesConcurrently(sceneContext, renderContext, shapes.plumber, shapes.items, setupBatch, stateSort, maxDrawnItems);
+    } else {
+        gpu::doInBatch(context, [&](gpu::Batch& batch) {
+            args._batch = &batch;
+            setupBatch(batch);
+            if (stateSort) {
+                renderStateSortShapes(sceneContext, renderContext, shapes.plumber, shapes.items, maxDrawnItems);
+            } else {
+                renderShapes(sceneContext, renderContext, shapes.plumber, shapes.items, maxDrawnItems);
+            }
+            args._batch = nullptr;
+        });
+    }
+    return context->endFrame();
+}
+
+// The commands of the batches one after the other, with their params and the pipelines by index. The setup
+// of each batch and the pipeline changes keeping the current pipeline are left out, they depend on where batches start
+static QStringList recordedCommands(const gpu::Frame::Batches& batches, const std::vector<gpu::PipelinePointer>& pipelines) {
+    QStringList commands;
+    gpu::PipelinePointer currentPipeline;
+    for (const auto& batch : batches) {
+        const auto& batchCommands = batch->getCommands();
+        const auto& offsets = batch->getCommandOffsets();
+        const auto& params = batch->getParams();
+        for (size_t i = 0; i < batchCommands.size(); ++i) {
+            size_t begin = offsets[i];
+            size_t end = (i + 1 < batchCommands.size()) ? offsets[i + 1] : params.size();
+            auto command = batchCommands[i];
+            if (command == gpu::Batch::COMMAND_setProjectionTransform) {
+                continue;
+            }
+            if (command == gpu::Batch::COMMAND_setPipeline) {
+                auto pipeline = batch->_pipelines.get(params[begin]._uint);
+                if (pipeline != currentPipeline) {
+                    currentPipeline = pipeline;
+                    auto index = std::find(pipelines.begin(), pipelines.end(), pipeline) - pipelines.begin();
+                    commands << QString("setPipeline %1").arg(index);
+                }
+                continue;
+            }
+            QString text = QString::number(command);
+            for (size_t p = begin; p < end; ++p) {
+                text += " " + QString::number(params[p]._uint);
+            }
+            commands << text;
+        }
+    }
+    return commands;
+}
+
+static bool startWithSetup(const gpu::Frame::Batches& batches) {
+    for (const auto& batch : batches) {
+        if (batch->getCommands().empty() || batch->getCommands().front() != gpu::Batch::COMMAND_setProjectionTransform) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DrawTaskTests::fewShapesTest() {
+    ShapeScene shapes(10);
+    for (bool stateSort : { false, true }) {
+        auto serial = recordFrame(shapes, false, stateSort, -1);
+        auto concurrent = recordFrame(shapes, true, stateSort, -1);
+        QCOMPARE((int)concurrent->batches.size(), 1);
+        QVERIFY(startWithSetup(concurrent->batches));
+        auto commands = recordedCommands(concurrent->batches, shapes.pipelines);
+        QCOMPARE(commands.count(), 10 + (stateSort ? 3 : 10));
+        QCOMPARE(commands, recordedCommands(serial->batches, shapes.pipelines));
+    }
+}
+
+void DrawTaskTests::batchRangesTest() {
+    const int NUM_BATCHES = 3;
+    ShapeScene shapes(NUM_BATCHES * MIN_ITEMS_PER_BATCH + MIN_ITEMS_PER_BATCH / 2);
+    for (bool stateSort : { false, true }) {
+        auto serial = recordFrame(shapes, false, stateSort, -1);
+        auto concurrent = recordFrame(shapes, true, stateSort, -1);
+        QCOMPARE((int)concurrent->batches.size(), NUM_BATCHES);
+        QVERIFY(startWithSetup(concurrent->batches));
+        QCOMPARE(recordedCommands(concurrent->batches, shapes.pipelines), recordedCommands(serial->batches, shapes.pipelines));
+
+        // only the first items are drawn, in fewer batches
+        const int MAX_DRAWN = 2 * MIN_ITEMS_PER_BATCH + 1;
+        serial = recordFrame(shapes, false, stateSort, MAX_DRAWN);
+        concurrent = recordFrame(shapes, true, stateSort, MAX_DRAWN);
+        QCOMPARE((int)concurrent->batches.size(), 2);
+        QVERIFY(startWithSetup(concurrent->batches));
+        QCOMPARE(recordedCommands(concurrent->batches, shapes.pipelines), recordedCommands(serial->batches, shapes.pipelines));
+    }
+}
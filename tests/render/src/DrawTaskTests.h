@@ -0,0 +1,27 @@
+//
+//  DrawTaskTests.h
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DrawTaskTests_h
+#define hifi_DrawTaskTests_h
+
+#include <QtTest/QtTest>
+
+class DrawTaskTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a few shapes recorded concurrently go in a single batch recorded like the serial one
+    void fewShapesTest();
+
+    // Test that the batches of the concurrent recording, one per range of MIN_ITEMS_PER_BATCH shapes,
+    // add up to the same commands as the serial recording, sorted by pipeline or not
+    void batchRangesTest();
+};
+
+#endif // hifi_DrawTaskTests_h
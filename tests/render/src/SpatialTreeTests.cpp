@@ -0,0 +1,114 @@
+//
+//  SpatialTreeTests.cpp
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatialTreeTests.h"
+
+#include <algorithm>
+
+#include <render/SpatialTree.h>
+
+QTEST_MAIN(SpatialTreeTests)
+
+using namespace render;
+
+// with this size the metric coordinates of the tree are meters from its origin, and a cell at depth d is 2^(15 - d) wide
+static const float TREE_SIZE = 32768.0f;
+static const ItemID ITEM = 1;
+
+// an 8m box in the 16m wide cell at (1, 1, 1), at depth 11, whose loose bound spans 12m to 36m on every axis
+static const AABox START_BOUND(glm::vec3(20.0f), 8.0f);
+static const Octree::Depth START_DEPTH = 11;
+
+static Octree::Index moveItem(ItemSpatialTree& tree, Octree::Index cell, const AABox& bound, ItemKey& key) {
+    ItemKey oldKey = key;
+    return tree.resetItem(cell, oldKey, bound, ITEM, key);
+}
+
+static bool cellHasItem(const ItemSpatialTree& tree, Octree::Index cell) {
+    const auto& concreteCell = tree.getConcreteCell(cell);
+    if (!concreteCell.hasBrick()) {
+        return false;
+    }
+    const auto& brick = tree.getConcreteBrick(concreteCell.brick());
+    return std::find(brick.items.begin(), brick.items.end(), ITEM) != brick.items.end() ||
+        std::find(brick.subcellItems.begin(), brick.subcellItems.end(), ITEM) != brick.subcellItems.end();
+}
+
+void SpatialTreeTests::stayInCellTest() {
+    ItemSpatialTree tree(glm::vec3(0.0f), TREE_SIZE);
+    ItemKey key = ItemKey::Builder().withTypeShape().build();
+
+    auto cell = moveItem(tree, Octree::INVALID_CELL, START_BOUND, key);
+    QVERIFY(cell != Octree::INVALID_CELL);
+    QCOMPARE(tree.getCellLocation(cell).depth, START_DEPTH);
+    QCOMPARE(tree.getCellLocation(cell).pos, Octree::Coord3(1));
+    QVERIFY(cellHasItem(tree, cell));
+    const int numCells = tree.getNumAllocatedCells();
+
+    // across the edge of the cell, into the margin
+    QCOMPARE(moveItem(tree, cell, AABox(glm::vec3(26.0f), 8.0f), key), cell);
+    // grown into the margin on both sides
+    QCOMPARE(moveItem(tree, cell, AABox(glm::vec3(13.0f), 22.0f), key), cell);
+    // shrunk to fit a cell one level deeper
+    QCOMPARE(moveItem(tree, cell, AABox(glm::vec3(16.5f), 7.0f), key), cell);
+
+    QVERIFY(cellHasItem(tree, cell));
+    QCOMPARE(tree.getNumAllocatedCells(), numCells);
+}
+
+void SpatialTreeTests::leaveCellTest() {
+    ItemSpatialTree tree(glm::vec3(0.0f), TREE_SIZE);
+    ItemKey key = ItemKey::Builder().withTypeShape().build();
+
+    auto cell = moveItem(tree, Octree::INVALID_CELL, START_BOUND, key);
+
+    // out of the loose bound, into the 32m wide cell at (1, 1, 1)
+    auto movedCell = moveItem(tree, cell, AABox(glm::vec3(40.0f), 8.0f), key);
+    QVERIFY(movedCell != cell);
+    QCOMPARE(tree.getCellLocation(movedCell).depth, Octree::Depth(START_DEPTH - 1));
+    QVERIFY(cellHasItem(tree, movedCell));
+    QVERIFY(!cellHasItem(tree, cell));
+
+    // still inside that loose bound, but small enough for a cell four levels deeper
+    auto shrunkCell = moveItem(tree, movedCell, AABox(glm::vec3(40.2f), 1.0f), key);
+    QVERIFY(shrunkCell != movedCell);
+    QCOMPARE(tree.getCellLocation(shrunkCell).depth, Octree::Depth(START_DEPTH + 3));
+    QVERIFY(cellHasItem(tree, shrunkCell));
+    QVERIFY(!cellHasItem(tree, movedCell));
+}
+
+void SpatialTreeTests::compactTest() {
+    ItemSpatialTree tree(glm::vec3(0.0f), TREE_SIZE);
+    ItemKey key = ItemKey::Builder().withTypeShape().build();
+
+    auto cell = moveItem(tree, Octree::INVALID_CELL, START_BOUND, key);
+    auto movedCell = moveItem(tree, cell, AABox(glm::vec3(40.0f), 8.0f), key);
+    const int numCells = tree.getNumAllocatedCells();
+
+    // the emptied cell is kept until the next compact, and reused when the item comes back
+    QCOMPARE(tree.getNumFreeCells(), 0);
+    QCOMPARE(tree.getCellLocation(cell).depth, START_DEPTH);
+    QCOMPARE(moveItem(tree, movedCell, START_BOUND, key), cell);
+    QCOMPARE(tree.getNumAllocatedCells(), numCells);
+
+    // the cell the item left was the last one allocated, so it is freed and trimmed off the pool
+    tree.compact();
+    QCOMPARE(tree.getNumAllocatedCells(), numCells - 1);
+    QCOMPARE(tree.getNumFreeCells(), 0);
+    QVERIFY(cellHasItem(tree, cell));
+    QCOMPARE(tree.getCellLocation(cell).depth, START_DEPTH);
+
+    // removing the last item doesn't touch the tree until the next compact, which takes it back to the root alone
+    QVERIFY(tree.removeItem(cell, key, ITEM));
+    QCOMPARE(tree.getNumAllocatedCells(), numCells - 1);
+    tree.compact();
+    QCOMPARE(tree.getNumAllocatedCells(), 1);
+    QCOMPARE(tree.getNumFreeCells(), 0);
+}
@@ -0,0 +1,29 @@
+//
+//  SpatialTreeTests.h
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatialTreeTests_h
+#define hifi_SpatialTreeTests_h
+
+#include <QtTest/QtTest>
+
+class SpatialTreeTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that an item moving or growing within the loose bound of its cell stays in it
+    void stayInCellTest();
+
+    // Test that an item leaves its cell when it moves out of the loose bound or shrinks to fit a much deeper cell
+    void leaveCellTest();
+
+    // Test that emptied cells are kept until compact, reused if filled again, and freed and trimmed by it
+    void compactTest();
+};
+
+#endif // hifi_SpatialTreeTests_h
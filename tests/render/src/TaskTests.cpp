@@ -0,0 +1,135 @@
+//
+//  TaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TaskTests.h"
+
+#include <atomic>
+
+#include <render/Task.h>
+
+QTEST_MAIN(TaskTests)
+
+using namespace render;
+
+// long enough to stand out of the timer resolution in the run times of the jobs
+static const unsigned long JOB_MSECS = 20;
+
+// the jobs stamp their output with the ticks of this clock when they begin and end
+static std::atomic<int> jobClock { 0 };
+
+struct Stamp {
+    int value { 0 };
+    int begin { -1 };
+    int end { -1 };
+};
+
+class Source {
+public:
+    using JobModel = Job::ModelO<Source, Stamp>;
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, Stamp& output) {
+        output.begin = jobClock++;
+        output.value = 1;
+        output.end = jobClock++;
+    }
+};
+
+class Scale {
+public:
+    using JobModel = Job::ModelIO<Scale, Stamp, Stamp>;
+
+    Scale(int factor) : _factor(factor) {}
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Stamp& input, Stamp& output) {
+        output.begin = jobClock++;
+        QThread::msleep(JOB_MSECS);
+        output.value = input.value * _factor;
+        output.end = jobClock++;
+    }
+
+protected:
+    int _factor;
+};
+
+class Sum {
+public:
+    using Inputs = VaryingSet2<Stamp, Stamp>;
+    using JobModel = Job::ModelIO<Sum, Inputs, Stamp>;
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Inputs& inputs, Stamp& output) {
+        output.begin = jobClock++;
+        output.value = inputs.get0().value + inputs.get1().value;
+        output.end = jobClock++;
+    }
+};
+
+// source -> (x2, x3) -> (x5, x7) -> sum, the scales of each step form a concurrent group
+class ScaleTask : public Task {
+public:
+    using JobModel = Model<ScaleTask>;
+
+    ScaleTask() {
+        source = addJob<Source>("Source");
+
+        beginConcurrentJobs();
+        firstScales[0] = addJob<Scale>("Scale2", source, 2);
+        firstScales[1] = addJob<Scale>("Scale3", source, 3);
+        endConcurrentJobs();
+
+        beginConcurrentJobs();
+        secondScales[0] = addJob<Scale>("Scale5", firstScales[0], 5);
+        secondScales[1] = addJob<Scale>("Scale7", firstScales[1], 7);
+        endConcurrentJobs();
+
+        sum = addJob<Sum>("Sum", Sum::Inputs(secondScales[0], secondScales[1]).hasVarying());
+    }
+
+    Varying source;
+    Varying firstScales[2];
+    Varying secondScales[2];
+    Varying sum;
+};
+
+void TaskTests::concurrentGroupsTest() {
+    ScaleTask task;
+    auto sceneContext = std::make_shared<SceneContext>();
+    auto renderContext = std::make_shared<RenderContext>();
+    renderContext->args = nullptr;
+
+    jobClock = 0;
+    task.run(sceneContext, renderContext);
+
+    const auto& source = task.source.get<Stamp>();
+    const auto& sum = task.sum.get<Stamp>();
+    QCOMPARE(task.firstScales[0].get<Stamp>().value, 2);
+    QCOMPARE(task.firstScales[1].get<Stamp>().value, 3);
+    QCOMPARE(task.secondScales[0].get<Stamp>().value, 10);
+    QCOMPARE(task.secondScales[1].get<Stamp>().value, 21);
+    QCOMPARE(sum.value, 31);
+
+    // a group starts after the job before it ended, and ends before the job after it starts
+    for (const auto& first : task.firstScales) {
+        QVERIFY(first.get<Stamp>().begin > source.end);
+        for (const auto& second : task.secondScales) {
+            QVERIFY(second.get<Stamp>().begin > first.get<Stamp>().end);
+        }
+    }
+    for (const auto& second : task.secondScales) {
+        QVERIFY(sum.begin > second.get<Stamp>().end);
+    }
+
+    // the concurrent jobs don't go through PerformanceTimer, their config holds their own run time
+    auto config = task.getConfiguration();
+    for (auto name : { "Scale2", "Scale3", "Scale5", "Scale7" }) {
+        auto jobConfig = config->getConfig<Scale>(name);
+        QVERIFY(jobConfig);
+        QVERIFY(jobConfig->getCPURunTime() >= JOB_MSECS / 2);
+    }
+}
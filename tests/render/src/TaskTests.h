@@ -0,0 +1,25 @@
+//
+//  TaskTests.h
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TaskTests_h
+#define hifi_TaskTests_h
+
+#include <QtTest/QtTest>
+
+class TaskTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the jobs of consecutive concurrent groups produce the same outputs as sequential jobs,
+    // that each group runs after the jobs it reads from and before the jobs reading from it, and that every job
+    // of a group reports its own run time
+    void concurrentGroupsTest();
+};
+
+#endif // hifi_TaskTests_h
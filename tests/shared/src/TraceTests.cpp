@@ -8,6 +8,8 @@
 
 #include "TraceTests.h"
 
+#include <thread>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
 
@@ -45,3 +47,111 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testCompactEventsFromThreads() {
+    const QString COMPACT_OUTPUT_FILE = "traces/testCompactTrace.json";
+    const int NUM_THREADS = 4;
+    const int NUM_RANGES = 1000;
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([] {
+                for (int i = 0; i < NUM_RANGES; ++i) {
+                    PROFILE_RANGE(test, "TestThreadEvent")
+                    {
+                        PROFILE_RANGE(test, QString("TestThreadEvent \"quoted\""))
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    tracer->stopTracing();
+
+    QString path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/" + COMPACT_OUTPUT_FILE;
+    tracer->serialize(COMPACT_OUTPUT_FILE);
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    auto document = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    int numBegins = 0;
+    int numEnds = 0;
+    QSet<qint64> threadIDs;
+    for (const auto& value : document.array()) {
+        auto event = value.toObject();
+        if (!event["name"].toString().startsWith("TestThreadEvent")) {
+            continue;
+        }
+        if (event["ph"].toString() == "B") {
+            ++numBegins;
+        } else if (event["ph"].toString() == "E") {
+            ++numEnds;
+        }
+        threadIDs.insert((qint64)event["tid"].toDouble());
+    }
+    QCOMPARE(numBegins, 2 * NUM_THREADS * NUM_RANGES);
+    QCOMPARE(numEnds, 2 * NUM_THREADS * NUM_RANGES);
+    QCOMPARE(threadIDs.size(), NUM_THREADS);
+}
+
+void TraceTests::testCompactEventsOverflow() {
+    // far more records than a thread buffer holds, recorded well within one drain interval
+    const int NUM_RANGES = 100000;
+    // some ranges have args, they aren't compact and never dropped
+    const int ARGS_RANGE_INTERVAL = 1000;
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    std::thread([] {
+        PROFILE_RANGE(test, "TestOverflowOuter")
+        for (int i = 0; i < NUM_RANGES; ++i) {
+            PROFILE_RANGE(test, "TestOverflowRange")
+            {
+                PROFILE_RANGE(test, QString("TestOverflowNested"))
+                if (i % ARGS_RANGE_INTERVAL == 0) {
+                    PROFILE_RANGE_EX(test, "TestOverflowArgs", 0xff0000ff, i, { { "i", i } })
+                }
+            }
+        }
+    }).join();
+    tracer->stopTracing();
+
+    QJsonParseError error;
+    auto document = QJsonDocument::fromJson(tracer->serialize(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    // whatever was dropped, every begin is closed by the end of the same range
+    QStringList openRanges;
+    int numBegins = 0;
+    int numArgsBegins = 0;
+    for (const auto& value : document.array()) {
+        auto event = value.toObject();
+        QString name = event["name"].toString();
+        if (!name.startsWith("TestOverflow")) {
+            continue;
+        }
+        if (event["ph"].toString() == "B" && name == "TestOverflowArgs") {
+            openRanges.append(name);
+            ++numArgsBegins;
+        } else if (event["ph"].toString() == "B") {
+            openRanges.append(name);
+            ++numBegins;
+        } else if (event["ph"].toString() == "E") {
+            QVERIFY(!openRanges.isEmpty());
+            QCOMPARE(openRanges.takeLast(), name);
+        }
+    }
+    QVERIFY(openRanges.isEmpty());
+
+    // the outer range was recorded before the buffer filled up, and some of the inner ones were dropped
+    QVERIFY(numBegins > 0);
+    QVERIFY(numBegins < 2 * NUM_RANGES + 1);
+    QCOMPARE(numArgsBegins, NUM_RANGES / ARGS_RANGE_INTERVAL);
+}
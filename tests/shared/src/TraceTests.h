@@ -15,6 +15,8 @@ class TraceTests : public QObject {
     Q_OBJECT
 private slots:
     void testTraceSerialization();
+    void testCompactEventsFromThreads();
+    void testCompactEventsOverflow();
 };
 
 #endif // hifi_TraceTests_h